@@ -105,6 +105,7 @@ ControlInterface::ControlInterface(QObject *parent)
       pcore(new ModCore(this))
 #endif
 {
+    registerEnableDeviceRecordMetaType();
     initPolicy(QDBusConnection::SystemBus, QString(SERVICE_CONFIG_DIR) + "other/deepin-devicecontrol.json");
     initConnects();
 }
@@ -137,6 +138,21 @@ QString ControlInterface::getAuthorizedInfo()
     return EnableSqlManager::getInstance()->authorizedInfo();
 }
 
+qulonglong ControlInterface::getEnableRevision()
+{
+    return EnableSqlManager::getInstance()->revision();
+}
+
+EnableDeviceRecordList ControlInterface::getRemoveRecords()
+{
+    return EnableSqlManager::getInstance()->removedRecords();
+}
+
+EnableDeviceRecordList ControlInterface::getAuthorizedRecords()
+{
+    return EnableSqlManager::getInstance()->authorizedRecords();
+}
+
 bool ControlInterface::enable(const QString &hclass, const QString &name, const QString &path, const QString &value, bool enable_device, const QString strDriver)
 {
     if (!getUserAuthorPasswd())
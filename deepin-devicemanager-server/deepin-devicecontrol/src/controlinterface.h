@@ -8,6 +8,7 @@
 #define CONTROLINTERFACE_H
 
 #include "commonfunction.h"
+#include "EnableDeviceRecord.h"
 
 #include <qdbusservice.h>
 #include <QObject>
@@ -49,6 +50,21 @@ public slots:
      * @return
      */
     Q_SCRIPTABLE QString getAuthorizedInfo();
+    /**
+     * @brief getEnableRevision 获取禁用设备表的修改计数,客户端据此判断缓存是否失效
+     * @return 修改计数
+     */
+    Q_SCRIPTABLE qulonglong getEnableRevision();
+    /**
+     * @brief getRemoveRecords 获取通过remove文件禁用的设备记录
+     * @return a(sssss) 类型、名称、路径、唯一标识、驱动
+     */
+    Q_SCRIPTABLE EnableDeviceRecordList getRemoveRecords();
+    /**
+     * @brief getAuthorizedRecords 获取通过authorized文件禁用的设备记录
+     * @return a(sssss) 类型、名称、路径、唯一标识、驱动
+     */
+    Q_SCRIPTABLE EnableDeviceRecordList getAuthorizedRecords();
     /**
      * @brief enable 启用禁用设备
      * @param hclass 类型
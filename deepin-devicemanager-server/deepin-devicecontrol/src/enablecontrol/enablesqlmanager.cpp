@@ -9,6 +9,7 @@
 #include <QLoggingCategory>
 #include <QDir>
 #include <QSqlError>
+#include <QDateTime>
 #define DB_PATH "/var/lib/deepin-devicemanager/"
 #define DB_FILE "enable.db"
 #define DB_CONNECT_NAME "device-enable"
@@ -36,7 +37,9 @@ void EnableSqlManager::insertDataToRemoveTable(const QString &hclass, const QStr
 
     if (!m_sqlQuery.exec()) {
         qCInfo(appLog) << Q_FUNC_INFO << m_sqlQuery.lastError();
+        return;
     }
+    increaseRevision();
 }
 
 void EnableSqlManager::removeDateFromRemoveTable(const QString &path)
@@ -46,7 +49,9 @@ void EnableSqlManager::removeDateFromRemoveTable(const QString &path)
     m_sqlQuery.bindValue(":path", QVariant(path));
     if (!m_sqlQuery.exec()) {
         qCInfo(appLog) << m_sqlQuery.lastError();
+        return;
     }
+    increaseRevision();
 }
 
 void EnableSqlManager::insertDataToAuthorizedTable(const QString &hclass, const QString &name, const QString &path, const QString &unique_id, bool exist, const QString &strDriver)
@@ -69,7 +74,9 @@ void EnableSqlManager::insertDataToAuthorizedTable(const QString &hclass, const
 
     if (!m_sqlQuery.exec()) {
         qCInfo(appLog) << Q_FUNC_INFO << m_sqlQuery.lastError();
+        return;
     }
+    increaseRevision();
 }
 
 void EnableSqlManager::removeDataFromAuthorizedTable(const QString &key)
@@ -79,7 +86,9 @@ void EnableSqlManager::removeDataFromAuthorizedTable(const QString &key)
     m_sqlQuery.bindValue(":key", QVariant(key));
     if (!m_sqlQuery.exec()) {
         qCInfo(appLog) << m_sqlQuery.lastError();
+        return;
     }
+    increaseRevision();
 }
 
 void EnableSqlManager::updateDataToAuthorizedTable(const QString &unique_id, const QString &path)
@@ -90,7 +99,9 @@ void EnableSqlManager::updateDataToAuthorizedTable(const QString &unique_id, con
     m_sqlQuery.bindValue(":unique_id", QVariant(unique_id));
     if (!m_sqlQuery.exec()) {
         qCInfo(appLog) << m_sqlQuery.lastError();
+        return;
     }
+    increaseRevision();
 }
 
 void EnableSqlManager::clearEnableFromAuthorizedTable()
@@ -98,7 +109,9 @@ void EnableSqlManager::clearEnableFromAuthorizedTable()
     QString sql = QString("DELETE FROM %1 WHERE enable='%2';").arg(DB_TABLE_AUTHORIZED).arg(true);
     if (!m_sqlQuery.exec(sql)) {
         qCInfo(appLog) << m_sqlQuery.lastError();
+        return;
     }
+    increaseRevision();
 }
 
 void EnableSqlManager::insertDataToPrinterTable(const QString &hclass, const QString &name, const QString &path)
@@ -189,6 +202,47 @@ QString EnableSqlManager::authorizedInfo()
     return info;
 }
 
+EnableDeviceRecordList EnableSqlManager::removedRecords()
+{
+    return records(DB_TABLE_REMOVE);
+}
+
+EnableDeviceRecordList EnableSqlManager::authorizedRecords()
+{
+    return records(DB_TABLE_AUTHORIZED);
+}
+
+qulonglong EnableSqlManager::revision()
+{
+    return m_Revision.load();
+}
+
+EnableDeviceRecordList EnableSqlManager::records(const QString &table)
+{
+    EnableDeviceRecordList lst;
+    QString sql = QString("SELECT class,name,path,unique_id,driver FROM %1;").arg(table);
+    if (!m_sqlQuery.exec(sql)) {
+        qCInfo(appLog) << Q_FUNC_INFO << m_sqlQuery.lastError();
+        return lst;
+    }
+
+    while (m_sqlQuery.next()) {
+        EnableDeviceRecord record;
+        record.hclass = m_sqlQuery.value(0).toString();
+        record.name = m_sqlQuery.value(1).toString();
+        record.path = m_sqlQuery.value(2).toString();
+        record.uniqueId = m_sqlQuery.value(3).toString();
+        record.driver = m_sqlQuery.value(4).toString();
+        lst.append(record);
+    }
+    return lst;
+}
+
+void EnableSqlManager::increaseRevision()
+{
+    ++m_Revision;
+}
+
 QString EnableSqlManager::authorizedPath(const QString &unique_id)
 {
     QString sql = QString("SELECT path FROM %1 WHERE unique_id=%2;").arg(DB_TABLE_AUTHORIZED).arg(":unique_id");
@@ -359,6 +413,7 @@ void EnableSqlManager::setMonitorWorkingFlag(const bool &flag)
 
 EnableSqlManager::EnableSqlManager(QObject *parent)
     : QObject(parent)
+    , m_Revision(static_cast<qulonglong>(QDateTime::currentMSecsSinceEpoch()))
 {
     initDB();
 }
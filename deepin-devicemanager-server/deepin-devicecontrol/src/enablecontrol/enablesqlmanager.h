@@ -5,12 +5,15 @@
 #ifndef ENABLECONFIG_H
 #define ENABLECONFIG_H
 
+#include "EnableDeviceRecord.h"
+
 #include <QMap>
 #include <QList>
 #include <QObject>
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <mutex>
+#include <atomic>
 
 class EnableSqlManager : public QObject
 {
@@ -118,6 +121,24 @@ public:
      */
     QString authorizedInfo();
 
+    /**
+     * @brief removedRecords 获取remove表中的所有记录
+     * @return 被禁用设备的记录
+     */
+    EnableDeviceRecordList removedRecords();
+
+    /**
+     * @brief authorizedRecords 获取authorized表中的所有记录
+     * @return 被禁用设备的记录
+     */
+    EnableDeviceRecordList authorizedRecords();
+
+    /**
+     * @brief revision remove表和authorized表的修改计数,表内容变化时递增
+     * @return 修改计数
+     */
+    qulonglong revision();
+
     /**
      * @brief authorizedPath
      * @return
@@ -209,11 +230,25 @@ protected:
 private:
     void initDB();
 
+    /**
+     * @brief records 获取表中的禁用设备记录
+     * @param table 表名
+     * @return 禁用设备记录
+     */
+    EnableDeviceRecordList records(const QString &table);
+
+    /**
+     * @brief increaseRevision remove表或authorized表修改成功后递增修改计数
+     */
+    void increaseRevision();
+
 private:
     static std::atomic<EnableSqlManager *> s_Instance;
     static std::mutex                  m_mutex;
     QSqlDatabase                       m_db;
     QSqlQuery                          m_sqlQuery;
+    // 计数以服务启动时间为起点而不是 0:服务空闲退出后重新启动,从 0 开始会再次产生客户端已缓存过的计数值,客户端将误认为禁用表未变化
+    std::atomic<qulonglong>            m_Revision;     //<! 禁用表的修改计数
 };
 
 #endif // ENABLECONFIG_H
@@ -48,3 +48,46 @@ void DebugTimeManager::endPointLinux(const QString &point, const QString &sub)
         qCInfo(appLog) << QString("[GRABPOINT] %1 %2 time=%3ms").arg(point).arg(m_MapPoint[point].desc).arg(m_MapPoint[point].time);
     }
 }
+
+void DebugTimeManager::traceStartup(const QString &stage)
+{
+    if (m_StartupFinished)
+        return;
+
+    if (!m_StartupTimer.isValid())
+        m_StartupTimer.start();
+
+    StartupStage info;
+    info.name = stage;
+    info.nsecs = m_StartupTimer.nsecsElapsed();
+    m_StartupStages.append(info);
+}
+
+QStringList DebugTimeManager::startupReport() const
+{
+    QStringList report;
+    qint64 last = 0;
+    foreach (const StartupStage &stage, m_StartupStages) {
+        report.append(QString("%1 ms (+%2 ms) %3")
+                      .arg(stage.nsecs / 1000000.0, 8, 'f', 1)
+                      .arg((stage.nsecs - last) / 1000000.0, 7, 'f', 1)
+                      .arg(stage.name));
+        last = stage.nsecs;
+    }
+    return report;
+}
+
+void DebugTimeManager::finishStartup()
+{
+    if (m_StartupFinished)
+        return;
+
+    foreach (const QString &line, startupReport())
+        qCInfo(appLog) << "[STARTUP]" << qPrintable(line);
+    m_StartupFinished = true;
+}
+
+bool DebugTimeManager::startupFinished() const
+{
+    return m_StartupFinished;
+}
@@ -8,7 +8,10 @@
 
 #include <QObject>
 #include <QMap>
+#include <QList>
+#include <QStringList>
 #include <QString>
+#include <QElapsedTimer>
 
 #include "config.h"
 
@@ -24,6 +27,10 @@
 #define PERF_PRINT_END_SUB(point,sub)
 #endif
 
+// 启动关键路径打点,开销很小,不受 PERF_ON 控制
+#define STARTUP_TRACE(stage) DebugTimeManager::getInstance()->traceStartup(stage)
+#define STARTUP_FINISH() DebugTimeManager::getInstance()->finishStartup()
+
 /**
  * @brief The PointInfo struct
  */
@@ -32,6 +39,15 @@ struct PointInfo {
     qint64  time;
 };
 
+/**
+ * @brief The StartupStage struct
+ * 启动过程中的一个阶段
+ */
+struct StartupStage {
+    QString name;       //<! 阶段名称
+    qint64  nsecs;      //<! 距离开始打点的时间,纳秒
+};
+
 class DebugTimeManager
 {
 public:
@@ -65,6 +81,28 @@ public:
      */
     void endPointLinux(const QString &point, const QString &sub = "");
 
+    /**
+     * @brief traceStartup : 记录启动阶段,启动报告输出后不再记录
+     * @param stage : 阶段名称
+     */
+    void traceStartup(const QString &stage);
+
+    /**
+     * @brief startupReport : 启动报告,每个阶段一行,包含与上一阶段的间隔和累计时间
+     * @return 报告内容
+     */
+    QStringList startupReport() const;
+
+    /**
+     * @brief finishStartup : 启动结束,输出启动报告,只输出一次
+     */
+    void finishStartup();
+
+    /**
+     * @brief startupFinished : 是否已输出启动报告
+     */
+    bool startupFinished() const;
+
 protected:
     DebugTimeManager();
 
@@ -72,6 +110,9 @@ protected:
 private:
     static DebugTimeManager    *s_Instance;      //<! singal install
     QMap<QString, PointInfo>    m_MapPoint;      //<! 保存所打的点
+    QElapsedTimer               m_StartupTimer;  //<! 启动打点计时,第一次打点时开始
+    QList<StartupStage>         m_StartupStages; //<! 启动阶段
+    bool                        m_StartupFinished = false; //<! 是否已输出启动报告
 
 };
 
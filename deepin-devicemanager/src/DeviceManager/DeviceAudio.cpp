@@ -234,8 +234,10 @@ void DeviceAudio::setInfoFromCatAudio(const QMap<QString, QString> &mapInfo)
 
 bool DeviceAudio::setAudioChipFromDmesg(const QString &info)
 {
+    invalidateAttribs();
     // 设置声卡芯片型号
     m_Chip = info;
+    addContentHash("Chip", info);
     return true;
 }
 
@@ -267,6 +269,7 @@ const QString &DeviceAudio::uniqueID() const
 }
 EnableDeviceStatus DeviceAudio::setEnable(bool e)
 {
+    invalidateAttribs();
     if (!m_SysPath.contains("usb")) {
         m_UniqueID = m_Name;
     }
@@ -180,6 +180,7 @@ const QString DeviceBluetooth::getOverviewInfo()
 
 EnableDeviceStatus DeviceBluetooth::setEnable(bool e)
 {
+    invalidateAttribs();
     if (m_SerialID.isEmpty()) {
         return EDS_NoSerial;
     }
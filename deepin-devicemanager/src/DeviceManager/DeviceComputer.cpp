@@ -51,30 +51,40 @@ const QString &DeviceComputer::driver() const
 
 void DeviceComputer::setHomeUrl(const QString &value)
 {
+    invalidateAttribs();
+    addContentHash("HomeUrl", value);
     // 设置主页网站
     m_HomeUrl = value;
 }
 
 void DeviceComputer::setOsDescription(const QString &value)
 {
+    invalidateAttribs();
+    addContentHash("OsDescription", value);
     // 设置操作系统描述
     m_OsDescription = value;
 }
 
 void DeviceComputer::setOS(const QString &value)
 {
+    invalidateAttribs();
+    addContentHash("OS", value);
     // 设置操作系统
     m_OS = value;
 }
 
 void DeviceComputer::setVendor(const QString &value)
 {
+    invalidateAttribs();
+    addContentHash("Vendor", value);
     // 设置制造商
     m_Vendor = value;
 }
 
 void DeviceComputer::setName(const QString &value)
 {
+    invalidateAttribs();
+    addContentHash("Name", value);
     // 设置计算机名称
     m_Name = value;
     if (m_Name.contains("None", Qt::CaseInsensitive))
@@ -83,12 +93,16 @@ void DeviceComputer::setName(const QString &value)
 
 void DeviceComputer::setType(const QString &value)
 {
+    invalidateAttribs();
+    addContentHash("Type", value);
     // 设置设备类型
     m_Type = value;
 }
 
 void DeviceComputer::setVendor(const QString &dm1Vendor, const QString &dm2Vendor)
 {
+    invalidateAttribs();
+    addContentHash("Vendor", dm1Vendor + "\n" + dm2Vendor);
     // 设置制造商
     if (dm1Vendor.contains("System manufacturer"))
         m_Vendor = dm2Vendor;
@@ -98,6 +112,8 @@ void DeviceComputer::setVendor(const QString &dm1Vendor, const QString &dm2Vendo
 
 void DeviceComputer::setName(const QString &dm1Name, const QString &dm2Name, const QString &dm1Family, const QString &dm1Version)
 {
+    invalidateAttribs();
+    addContentHash("Name", dm1Name + "\n" + dm2Name + "\n" + dm1Family + "\n" + dm1Version);
     // name
     QString pname;
     if (dm1Name.contains("System Product Name"))
@@ -14,6 +14,7 @@ DeviceCpu::DeviceCpu()
     , m_ThreadNum("")
     , m_Frequency("")
     , m_CurFrequency("")
+    , m_SampledFrequency("")
     , m_BogoMIPS("")
     , m_Architecture(""),
       m_Familly("")
@@ -180,13 +181,32 @@ void DeviceCpu::setInfoFromLscpu(const QMap<QString, QString> &mapInfo)
 
 void DeviceCpu::setCurFreq(const QString &curFreq)
 {
+    invalidateAttribs();
     if (!curFreq.isEmpty())
         m_CurFrequency = curFreq;
+    addContentHash("CurFreq", curFreq);
 }
 
 void DeviceCpu::setFrequencyIsCur(const bool &flag)
 {
+    invalidateAttribs();
     m_FrequencyIsCur = flag;
+    addContentHash("FrequencyIsCur", flag ? "1" : "0");
+}
+
+void DeviceCpu::setSampledFreq(const QString &curFreq, const QString &statistics)
+{
+    if (m_CurFrequency == curFreq && m_SampledFrequency == statistics)
+        return;
+    invalidateAttribs();
+    m_CurFrequency = curFreq;
+    m_SampledFrequency = statistics;
+    addContentHash("SampledFreq", curFreq + "\n" + statistics);
+}
+
+const QString &DeviceCpu::physicalID() const
+{
+    return m_PhysicalID;
 }
 
 void DeviceCpu::setInfoFromLshw(const QMap<QString, QString> &mapInfo)
@@ -276,6 +296,9 @@ void DeviceCpu::loadOtherDeviceInfo()
     addOtherDeviceInfo(tr("L1i Cache"), m_CacheL1Order);
     addOtherDeviceInfo(tr("L1d Cache"), m_CacheL1Data);
     addOtherDeviceInfo(tr("Stepping"), m_Step);
+    // 只显示采样得到的频率
+    addOtherDeviceInfo(tr("Speed (Min / Avg / Max)"), m_SampledFrequency);
+    addOtherDeviceInfo(tr("Current Speed"), m_SampledFrequency.isEmpty() ? QString() : m_CurFrequency);
 
     // 将QMap<QString, QString>内容转存为QList<QPair<QString, QString>>
     mapInfoToList();
@@ -86,6 +86,19 @@ public:
      */
     void setFrequencyIsCur(const bool &flag);
 
+    /**
+     * @brief setSampledFreq:设置采样得到的当前频率和最小/平均/最大频率
+     * @param curFreq:当前频率
+     * @param statistics:最小/平均/最大频率
+     */
+    void setSampledFreq(const QString &curFreq, const QString &statistics);
+
+    /**
+     * @brief physicalID:逻辑处理器序号
+     * @return processor
+     */
+    const QString &physicalID() const;
+
     /**
         * @brief setInfoFromTomlOneByOne:设置从toml里面获取的信息
         * @param mapInfo:由toml获取的信息map
@@ -150,6 +163,7 @@ private:
     QString           m_Frequency;          //<! 频率
     QString           m_CurFrequency;       //<! 当前频率
     QString           m_MaxFrequency;       //<! 最大频率
+    QString           m_SampledFrequency;   //<! 采样的最小/平均/最大频率
     QString           m_BogoMIPS;           //<! BogoMIPS
     QString           m_Architecture;       //<! 架构
     QString           m_Familly;            //<! 家族
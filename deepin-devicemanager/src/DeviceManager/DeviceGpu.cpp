@@ -226,6 +226,9 @@ bool DeviceGpu::setHwinfoInfo(const QMap<QString, QString> &mapInfo)
 
 void DeviceGpu::setXrandrInfo(const QMap<QString, QString> &mapInfo)
 {
+    invalidateAttribs();
+    for (auto it = mapInfo.begin(); it != mapInfo.end(); ++it)
+        addContentHash(it.key(), it.value());
     // 设置分辨率属性
     m_MinimumResolution = mapInfo["minResolution"];
     m_CurrentResolution = mapInfo["curResolution"];
@@ -129,6 +129,7 @@ const QString DeviceImage::getOverviewInfo()
 
 EnableDeviceStatus DeviceImage::setEnable(bool e)
 {
+    invalidateAttribs();
     if (m_SerialID.isEmpty()) {
         return EDS_NoSerial;
     }
@@ -0,0 +1,194 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "DeviceIndex.h"
+#include "DeviceInfo.h"
+
+// 其它头文件
+#include <algorithm>
+
+const QString DeviceIndex::ShortKey = "*";
+
+DeviceIndex::DeviceIndex()
+    : m_Serial(0)
+    , m_SyncedRevision(0)
+{
+
+}
+
+void DeviceIndex::insert(DeviceBaseInfo *device)
+{
+    if (!device)
+        return;
+
+    // 地址已登记(设备列表被直接清空后地址被复用)时重新登记
+    if (m_Keys.contains(device))
+        remove(device);
+
+    if (!m_Order.contains(device))
+        m_Order.insert(device, m_Serial++);
+
+    const QList<QPair<int, QString> > keys = deviceKeys(device);
+    for (const QPair<int, QString> &key : keys)
+        m_Index[key.first][key.second].append(device);
+    m_Keys.insert(device, keys);
+    m_Revision.insert(device, device->revision());
+}
+
+void DeviceIndex::remove(DeviceBaseInfo *device)
+{
+    if (!m_Keys.contains(device))
+        return;
+
+    const QList<QPair<int, QString> > keys = m_Keys.take(device);
+    m_Revision.remove(device);
+    for (const QPair<int, QString> &key : keys) {
+        QHash<QString, QList<DeviceBaseInfo *> >::iterator it = m_Index[key.first].find(key.second);
+        if (it == m_Index[key.first].end())
+            continue;
+        it->removeOne(device);
+        if (it->isEmpty())
+            m_Index[key.first].erase(it);
+    }
+    m_Order.remove(device);
+}
+
+void DeviceIndex::update(DeviceBaseInfo *device)
+{
+    if (!m_Keys.contains(device))
+        return;
+
+    // 保留原有顺序,只替换索引键
+    quint64 order = m_Order.value(device);
+    remove(device);
+    m_Order.insert(device, order);
+    insert(device);
+}
+
+void DeviceIndex::clear()
+{
+    for (int i = 0; i < IK_Count; ++i)
+        m_Index[i].clear();
+    m_Keys.clear();
+    m_Order.clear();
+    m_Revision.clear();
+    m_Serial = 0;
+    m_SyncedRevision = 0;
+}
+
+void DeviceIndex::rebuild(const QList<DeviceBaseInfo *> &lst)
+{
+    clear();
+    m_SyncedRevision = DeviceBaseInfo::lastRevision();
+    foreach (DeviceBaseInfo *device, lst)
+        insert(device);
+}
+
+void DeviceIndex::sync(const QList<DeviceBaseInfo *> &lst)
+{
+    if (m_Keys.size() != lst.size()) {
+        rebuild(lst);
+        return;
+    }
+
+    // 没有任何设备的属性变化时无需检查
+    const int revision = DeviceBaseInfo::lastRevision();
+    if (revision == m_SyncedRevision)
+        return;
+
+    // 唯一值、sysfs路径、modalias、VID等在设备加入后仍可能被 lshw、toml 等信息修改,按当前属性重新登记
+    foreach (DeviceBaseInfo *device, lst) {
+        if (!m_Keys.contains(device)) {
+            rebuild(lst);
+            return;
+        }
+        if (device->revision() != m_Revision.value(device))
+            update(device);
+    }
+    m_SyncedRevision = revision;
+}
+
+QList<DeviceBaseInfo *> DeviceIndex::find(IndexKey key, const QString &value) const
+{
+    if (key < 0 || key >= IK_Count)
+        return QList<DeviceBaseInfo *>();
+    return ordered(m_Index[key].value(value));
+}
+
+QList<DeviceBaseInfo *> DeviceIndex::ordered(const QList<DeviceBaseInfo *> &lst) const
+{
+    QList<DeviceBaseInfo *> result = lst;
+    std::sort(result.begin(), result.end(), [this](DeviceBaseInfo *a, DeviceBaseInfo *b) {
+        return m_Order.value(a) < m_Order.value(b);
+    });
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+int DeviceIndex::size() const
+{
+    return m_Keys.size();
+}
+
+QString DeviceIndex::uniqueIDKey(const QString &uniqueID)
+{
+    // 同一设备的不同接口只有末位序号不同,例如 1.1:1.1 -> 1.1:1.0
+    QString key = uniqueID;
+    if (!key.isEmpty()) {
+        QChar last = key.at(key.size() - 1);
+        if (last >= QChar('1') && last <= QChar('9'))
+            key[key.size() - 1] = QChar('0');
+    }
+    return key;
+}
+
+QString DeviceIndex::modaliasKey(const QString &modalias)
+{
+    return modalias.trimmed().toLower();
+}
+
+QString DeviceIndex::vidpidKey(const QString &vid, const QString &pid)
+{
+    if (vid.isEmpty() && pid.isEmpty())
+        return "";
+    return vid.toLower().remove("0x") + ":" + pid.toLower().remove("0x");
+}
+
+QString DeviceIndex::vendorNameKey(const QString &vendor, const QString &name)
+{
+    return vendor.toLower() + "\n" + name.toLower();
+}
+
+QList<QPair<int, QString> > DeviceIndex::deviceKeys(DeviceBaseInfo *device)
+{
+    QList<QPair<int, QString> > keys;
+    keys << qMakePair(int(IK_UniqueID), uniqueIDKey(device->uniqueID()));
+    keys << qMakePair(int(IK_SysPath), device->sysPath());
+    keys << qMakePair(int(IK_Modalias), modaliasKey(device->getModalias()));
+    keys << qMakePair(int(IK_VIDAndPID), device->getVIDAndPID());
+    keys << qMakePair(int(IK_VendorName), vendorNameKey(device->vendor(), device->name()));
+
+    // 与 findByVIDPID 一致:VID、PID 都存在时精确比较,否则判断 VIDAndPID 是否包含规则中的 vid 和 pid
+    const QString vidAndPid = device->getVIDAndPID().toLower();
+    if (!device->getVID().isEmpty() && !device->getPID().isEmpty()) {
+        keys << qMakePair(int(IK_VIDPID), vidpidKey(device->getVID(), device->getPID()));
+    } else if (!vidAndPid.isEmpty()) {
+        QStringList windows;
+        for (int i = 0; i + 4 <= vidAndPid.size(); ++i) {
+            QString window = vidAndPid.mid(i, 4);
+            if (!windows.contains(window))
+                windows.append(window);
+        }
+        foreach (const QString &window, windows)
+            keys << qMakePair(int(IK_VIDPIDWindow), window);
+        keys << qMakePair(int(IK_VIDPIDWindow), ShortKey);
+    }
+
+    // 与 findByModalias 一致:自定义 modalias 包含 VIDAndPID 去掉 0x 后的前 4 位
+    const QString vid = QString(vidAndPid).remove("0x").left(4);
+    if (!vid.isEmpty())
+        keys << qMakePair(int(IK_VID), vid.size() < 4 ? ShortKey : vid);
+    return keys;
+}
@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DEVICEINDEX_H
+#define DEVICEINDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QHash>
+#include <QPair>
+
+class DeviceBaseInfo;
+
+/**
+ * @brief The DeviceIndex class
+ * 设备查找索引,按唯一值、sysfs路径、规范化的modalias、VID:PID及厂商名称建立哈希索引
+ * 索引只用于缩小候选范围,调用方仍需按原有规则校验候选设备
+ * VID相关的键取自匹配规则实际比较的属性,保证规则能匹配的设备一定在候选范围内
+ */
+class DeviceIndex
+{
+public:
+    /**
+     * @brief The IndexKey enum
+     * 索引键类型
+     */
+    enum IndexKey {
+        IK_UniqueID,      // 唯一值,末位序号归零
+        IK_SysPath,       // sysfs 路径
+        IK_Modalias,      // 小写 modalias
+        IK_VIDAndPID,     // 原始 VIDAndPID,用于查找重复设备
+        IK_VIDPID,        // VID、PID 均存在时的小写 vid:pid,去掉 0x
+        IK_VIDPIDWindow,  // VID 或 PID 为空时小写 VIDAndPID 中所有 4 位子串,按包含关系匹配
+        IK_VID,           // 小写 VIDAndPID 去掉 0x 后的前 4 位,用于自定义 modalias 的模糊匹配
+        IK_VendorName,    // 小写 vendor + name
+        IK_Count
+    };
+
+    /**
+     * @brief ShortKey:VIDAndPID 过短,无法按 4 位子串登记时使用的键,这类设备只能逐一比较
+     */
+    static const QString ShortKey;
+
+    DeviceIndex();
+
+    /**
+     * @brief insert:将设备加入索引,设备的先后顺序按首次加入的顺序记录
+     * @param device:设备指针
+     */
+    void insert(DeviceBaseInfo *device);
+
+    /**
+     * @brief remove:将设备从索引中移除
+     * @param device:设备指针
+     */
+    void remove(DeviceBaseInfo *device);
+
+    /**
+     * @brief update:设备属性变化后重新登记索引键,保持原有顺序
+     * @param device:设备指针
+     */
+    void update(DeviceBaseInfo *device);
+
+    /**
+     * @brief clear:清空索引
+     */
+    void clear();
+
+    /**
+     * @brief rebuild:按设备列表重建索引
+     * @param lst:设备列表
+     */
+    void rebuild(const QList<DeviceBaseInfo *> &lst);
+
+    /**
+     * @brief sync:设备数量与列表不一致时(列表被直接修改过)重建索引,
+     * 登记后属性发生变化的设备按当前属性重新登记
+     * @param lst:设备列表
+     */
+    void sync(const QList<DeviceBaseInfo *> &lst);
+
+    /**
+     * @brief find:查找索引键对应的设备
+     * @param key:索引键类型
+     * @param value:规范化后的键值
+     * @return 按加入顺序排列的设备列表
+     */
+    QList<DeviceBaseInfo *> find(IndexKey key, const QString &value) const;
+
+    /**
+     * @brief ordered:对候选设备去重并按加入顺序排列
+     * @param lst:候选设备
+     * @return 排序后的设备列表
+     */
+    QList<DeviceBaseInfo *> ordered(const QList<DeviceBaseInfo *> &lst) const;
+
+    /**
+     * @brief size:索引中的设备数量
+     * @return 设备数量
+     */
+    int size() const;
+
+    static QString uniqueIDKey(const QString &uniqueID);
+    static QString modaliasKey(const QString &modalias);
+    static QString vidpidKey(const QString &vid, const QString &pid);
+    static QString vendorNameKey(const QString &vendor, const QString &name);
+
+private:
+    /**
+     * @brief deviceKeys:计算设备的所有索引键,同一类型可以有多个键
+     * @param device:设备指针
+     * @return 索引键类型与键值的列表
+     */
+    static QList<QPair<int, QString> > deviceKeys(DeviceBaseInfo *device);
+
+    QHash<QString, QList<DeviceBaseInfo *> >   m_Index[IK_Count];    //<! 各类索引键到设备的映射
+    QHash<DeviceBaseInfo *, QList<QPair<int, QString> > > m_Keys;    //<! 设备已登记的索引键
+    QHash<DeviceBaseInfo *, quint64>           m_Order;              //<! 设备加入顺序
+    QHash<DeviceBaseInfo *, int>               m_Revision;           //<! 设备登记时的属性修改序号
+    int                                        m_SyncedRevision;     //<! 上次同步时所有设备的最近修改序号
+    quint64                                    m_Serial;             //<! 顺序计数
+};
+
+#endif // DEVICEINDEX_H
@@ -7,6 +7,7 @@
 #include "commonfunction.h"
 #include "commondefine.h"
 #include"DeviceManager.h"
+#include "SourceTextTranslator.h"
 #include "DDLog.h"
 
 #include <DApplication>
@@ -15,10 +16,14 @@
 #include <QProcess>
 #include <QMap>
 #include <QRegularExpression>
+#include <QAtomicInt>
 using namespace DDLog;
 
 DWIDGET_USE_NAMESPACE
 
+// 设备属性修改序号,设备在加载线程和界面线程中都会被修改
+static QAtomicInt deviceRevision(0);
+
 DeviceBaseInfo::DeviceBaseInfo(QObject *parent)
     : QObject(parent)
     , m_Name("")
@@ -37,6 +42,13 @@ DeviceBaseInfo::DeviceBaseInfo(QObject *parent)
     , m_Index(0)
     , m_forcedDisplay(false)
     , m_Driver("")
+    , m_BaseInfoLoaded(false)
+    , m_OtherInfoLoaded(false)
+    , m_TableDataLoaded(false)
+    , m_DriverVersionLoaded(false)
+    , m_Revision(0)
+    , m_ContentHash(Q_UINT64_C(14695981039346656037))
+    , m_GeneratedHash(0)
 {
 }
 
@@ -47,17 +59,23 @@ DeviceBaseInfo::~DeviceBaseInfo()
 
 const QList<QPair<QString, QString>> &DeviceBaseInfo::getOtherAttribs()
 {
-    // 获取其他设备信息列表
-    m_LstOtherInfo.clear();
-    loadOtherDeviceInfo();
+    // 获取其他设备信息列表,首次获取时生成,属性变化前直接返回缓存
+    if (!m_OtherInfoLoaded) {
+        m_LstOtherInfo.clear();
+        loadOtherDeviceInfo();
+        m_OtherInfoLoaded = true;
+    }
     return m_LstOtherInfo;
 }
 
 const QList<QPair<QString, QString> > &DeviceBaseInfo::getBaseAttribs()
 {
-    // 获取基本信息列表
-    m_LstBaseInfo.clear();
-    loadBaseDeviceInfo();
+    // 获取基本信息列表,首次获取时生成,属性变化前直接返回缓存
+    if (!m_BaseInfoLoaded) {
+        m_LstBaseInfo.clear();
+        loadBaseDeviceInfo();
+        m_BaseInfoLoaded = true;
+    }
     return m_LstBaseInfo;
 }
 
@@ -75,11 +93,128 @@ const QStringList &DeviceBaseInfo::getTableHeader()
 const QStringList &DeviceBaseInfo::getTableData()
 {
     // 获取表格数据
-    m_TableData.clear();
-    loadTableData();
+    if (!m_TableDataLoaded) {
+        m_TableData.clear();
+        loadTableData();
+        m_TableDataLoaded = true;
+    }
     return m_TableData;
 }
 
+void DeviceBaseInfo::invalidateAttribs()
+{
+    m_BaseInfoLoaded = false;
+    m_OtherInfoLoaded = false;
+    m_TableDataLoaded = false;
+    m_DriverVersionLoaded = false;
+    m_TableHeader.clear();
+    m_Revision = deviceRevision.fetchAndAddRelaxed(1) + 1;
+}
+
+void DeviceBaseInfo::copyAttribs(QList<QPair<QString, QString>> &base, QList<QPair<QString, QString>> &other,
+                                 QStringList &header, QStringList &data)
+{
+    // 用户没有打开过的设备不保留生成的显示信息,生成后交换出缓存
+    base.clear();
+    other.clear();
+    header.clear();
+    data.clear();
+
+    if (m_BaseInfoLoaded) {
+        base = m_LstBaseInfo;
+    } else {
+        m_LstBaseInfo.clear();
+        loadBaseDeviceInfo();
+        base.swap(m_LstBaseInfo);
+    }
+
+    if (m_OtherInfoLoaded) {
+        other = m_LstOtherInfo;
+    } else {
+        m_LstOtherInfo.clear();
+        loadOtherDeviceInfo();
+        other.swap(m_LstOtherInfo);
+    }
+
+    // 缓存的表头末尾是 getTableHeader 追加的是否可禁用
+    if (!m_TableHeader.isEmpty()) {
+        header = m_TableHeader;
+        header.removeLast();
+    } else {
+        loadTableHeader();
+        header.swap(m_TableHeader);
+    }
+
+    if (m_TableDataLoaded) {
+        data = m_TableData;
+    } else {
+        m_TableData.clear();
+        loadTableData();
+        data.swap(m_TableData);
+    }
+}
+
+void DeviceBaseInfo::copySourceAttribs(QList<QPair<QString, QString>> &base, QList<QPair<QString, QString>> &other)
+{
+    // 属性名在生成时翻译,在当前线程以原文重新生成,生成前先换出缓存
+    SourceTextTranslator::Scope scope;
+    base.clear();
+    other.clear();
+
+    base.swap(m_LstBaseInfo);
+    loadBaseDeviceInfo();
+    base.swap(m_LstBaseInfo);
+
+    other.swap(m_LstOtherInfo);
+    loadOtherDeviceInfo();
+    other.swap(m_LstOtherInfo);
+}
+
+int DeviceBaseInfo::revision() const
+{
+    return m_Revision;
+}
+
+int DeviceBaseInfo::lastRevision()
+{
+    return deviceRevision.loadAcquire();
+}
+
+void DeviceBaseInfo::invalidateDriverVersion()
+{
+    m_DriverVersionLoaded = false;
+}
+
+quint64 DeviceBaseInfo::contentHash() const
+{
+    return m_ContentHash;
+}
+
+void DeviceBaseInfo::markGenerated()
+{
+    m_GeneratedHash = m_ContentHash;
+}
+
+quint64 DeviceBaseInfo::generatedHash() const
+{
+    return m_GeneratedHash;
+}
+
+void DeviceBaseInfo::addContentHash(const QString &key, const QString &value)
+{
+    // FNV-1a,键值之间以不会出现在属性中的字符分隔
+    auto fold = [this](const QString &str) {
+        for (const QChar &ch : str) {
+            m_ContentHash ^= ch.unicode();
+            m_ContentHash *= Q_UINT64_C(1099511628211);
+        }
+        m_ContentHash ^= 0xffff;
+        m_ContentHash *= Q_UINT64_C(1099511628211);
+    };
+    fold(key);
+    fold(value);
+}
+
 QString DeviceBaseInfo::subTitle()
 {
     return QString("");
@@ -139,73 +274,49 @@ bool DeviceBaseInfo::isValueValid(QString &value)
 void DeviceBaseInfo::setForcedDisplay(const bool &flag)
 {
     m_forcedDisplay = flag;
+    addContentHash("ForcedDisplay", flag ? "1" : "0");
+    invalidateAttribs();
 }
 
-void DeviceBaseInfo::toHtmlString(QDomDocument &doc)
+void DeviceBaseInfo::toHtmlString(QIODevice &html)
 {
     // 设备信息转为Html
-    baseInfoToHTML(doc, m_LstBaseInfo);
-    baseInfoToHTML(doc, m_LstOtherInfo);
+    baseInfoToHTML(html, m_LstBaseInfo);
+    baseInfoToHTML(html, m_LstOtherInfo);
 }
 
-void DeviceBaseInfo::baseInfoToHTML(QDomDocument &doc, QList<QPair<QString, QString> > &infoLst)
+void DeviceBaseInfo::baseInfoToHTML(QIODevice &html, QList<QPair<QString, QString> > &infoLst)
 {
-    // 设备信息转为HTML
-    QDomElement table = doc.createElement("table");
-    table.setAttribute("border", "0");
-    table.setAttribute("width", "100%");
-    table.setAttribute("cellpadding", "3");
+    if (infoLst.isEmpty())
+        return;
 
-    // 添加HTML表格内容
+    // 设备信息转为HTML表格,逐行写出
+    html.write("<table border=\"0\" width=\"100%\" cellpadding=\"3\">");
     foreach (auto info, infoLst) {
         if (isValueValid(info.second)) {
-            QDomElement tr = doc.createElement("tr");
-
-            // 第一列
-            QDomElement td = doc.createElement("td");
-            td.setAttribute("width", "15%");
-            td.setAttribute("style", "text-align:left;");
-
-            QDomText nameText = doc.createTextNode(info.first + ": ");
-            td.appendChild(nameText);
-            tr.appendChild(td);
-
-            // 第二列
-            QDomElement td2 = doc.createElement("td");
-            td2.setAttribute("width", "85%");
-
-            QDomText valueText;
-            valueText = doc.createTextNode(info.second);
-            td2.appendChild(valueText);
-
-            tr.appendChild(td2);
-
-            table.appendChild(tr);
+            QString tr = "<tr><td width=\"15%\" style=\"text-align:left;\">" + (info.first + ": ").toHtmlEscaped() + "</td>"
+                         + "<td width=\"85%\">" + info.second.toHtmlEscaped() + "</td></tr>";
+            html.write(tr.toUtf8());
         }
-
-        doc.appendChild(table);
     }
+    html.write("</table>\n");
 }
 
-void DeviceBaseInfo::subTitleToHTML(QDomDocument &doc)
+void DeviceBaseInfo::subTitleToHTML(QIODevice &html)
 {
     // 子标题转为HTML格式
-    if (false == this->subTitle().isEmpty()) {
-        QDomElement h3 = doc.createElement("h3");
-        QDomText valueText = doc.createTextNode(this->subTitle());
-        h3.appendChild(valueText);
-        doc.appendChild(h3);
-    }
+    if (false == this->subTitle().isEmpty())
+        html.write(("<h3>" + this->subTitle().toHtmlEscaped() + "</h3>\n").toUtf8());
 }
 
-void DeviceBaseInfo::toDocString(Docx::Document &doc)
+void DeviceBaseInfo::toDocString(DocxStreamWriter &doc)
 {
     // 设备信息转为doc
     baseInfoToDoc(doc, m_LstBaseInfo);
     baseInfoToDoc(doc, m_LstOtherInfo);
 }
 
-void DeviceBaseInfo::baseInfoToDoc(Docx::Document &doc, QList<QPair<QString, QString> > &infoLst)
+void DeviceBaseInfo::baseInfoToDoc(DocxStreamWriter &doc, QList<QPair<QString, QString> > &infoLst)
 {
     // 设备信息保存为Doc
     foreach (auto item, infoLst) {
@@ -221,19 +332,16 @@ void DeviceBaseInfo::baseInfoToDoc(Docx::Document &doc, QList<QPair<QString, QSt
     }
 }
 
-void DeviceBaseInfo::toXlsxString(QXlsx::Document &xlsx, QXlsx::Format &boldFont)
+void DeviceBaseInfo::toXlsxString(XlsxStreamWriter &xlsx)
 {
     // 设备信息转为xlxs表格
-    baseInfoToXlsx(xlsx, boldFont, m_LstBaseInfo);
-    baseInfoToXlsx(xlsx, boldFont, m_LstOtherInfo);
+    baseInfoToXlsx(xlsx, m_LstBaseInfo);
+    baseInfoToXlsx(xlsx, m_LstOtherInfo);
 }
 
-void DeviceBaseInfo::baseInfoToXlsx(QXlsx::Document &xlsx, QXlsx::Format &boldFont, QList<QPair<QString, QString> > &infoLst)
+void DeviceBaseInfo::baseInfoToXlsx(XlsxStreamWriter &xlsx, QList<QPair<QString, QString> > &infoLst)
 {
-    // 设置表格内容字体不加粗,字号10
-    boldFont.setFontBold(false);
-    boldFont.setFontSize(10);
-
+    // 表格内容字体不加粗,字号10
     foreach (auto item, infoLst) {
         QString value = item.second;
 
@@ -242,9 +350,9 @@ void DeviceBaseInfo::baseInfoToXlsx(QXlsx::Document &xlsx, QXlsx::Format &boldFo
             continue;
 
         // 获取行数
-        int _row = DeviceManager::instance()->currentXlsRow();
-        xlsx.write(_row, 1, item.first, boldFont);
-        xlsx.write(_row, 2, item.second, boldFont);
+        int _row = xlsx.nextRow();
+        xlsx.write(_row, 1, item.first, XlsxStreamWriter::CS_Small);
+        xlsx.write(_row, 2, item.second, XlsxStreamWriter::CS_Small);
     }
 }
 
@@ -320,7 +428,7 @@ void DeviceBaseInfo::tableHeaderToTxt(QTextStream &out)
     out << "\n";
 }
 
-void DeviceBaseInfo::tableInfoToHtml(QFile &html)
+void DeviceBaseInfo::tableInfoToHtml(QIODevice &html)
 {
     // 获取表格内容
     getTableData();
@@ -330,14 +438,14 @@ void DeviceBaseInfo::tableInfoToHtml(QFile &html)
         return;
 
     // 写表格内容
-    foreach (auto item, m_TableData) {
-        html.write(QString("<td style=\"width:200px;text-align:left;\">" + item + "</td>").toUtf8().data());
-    }
-
-    html.write("</tr>\n");
+    QString tr = "<tr>";
+    foreach (auto item, m_TableData)
+        tr += "<td style=\"width:200px;text-align:left;\">" + item.toHtmlEscaped() + "</td>";
+    tr += "</tr>\n";
+    html.write(tr.toUtf8());
 }
 
-void DeviceBaseInfo::tableHeaderToHtml(QFile &html)
+void DeviceBaseInfo::tableHeaderToHtml(QIODevice &html)
 {
     // 获取表头信息
     getTableHeader();
@@ -350,31 +458,24 @@ void DeviceBaseInfo::tableHeaderToHtml(QFile &html)
 
     // 写表头内容
     for (int col = 0; col < m_TableHeader.size() - 1; ++col)
-        html.write(QString("<th style=\"width:200px;text-align:left; white-space:pre;\">" + m_TableHeader[col] + "</th>").toUtf8().data());
+        html.write(QString("<th style=\"width:200px;text-align:left; white-space:pre;\">" + m_TableHeader[col].toHtmlEscaped() + "</th>").toUtf8());
 
     html.write("</tr></thead>\n");
 }
 
-void DeviceBaseInfo::tableInfoToDoc(Docx::Table *tab, int &row)
+void DeviceBaseInfo::tableInfoToDoc(DocxStreamWriter &doc)
 {
-    // 表格信息保存为Doc
-    if (nullptr == tab)
-        return;
-
     // 获取表格数据
     getTableData();
 
     if (m_TableData.size() < 1)
         return;
 
-    // 添加doc表格
-    for (int col = 0; col < m_TableData.size(); ++col) {
-        auto cel = tab->cell(row, col);
-        cel->addText(m_TableData[col]);
-    }
+    // 添加doc表格行
+    doc.addTableRow(m_TableData);
 }
 
-void DeviceBaseInfo::tableHeaderToDoc(Docx::Table *tab)
+void DeviceBaseInfo::tableHeaderToDoc(DocxStreamWriter &doc)
 {
     // 表头保存为doc
     getTableHeader();
@@ -382,15 +483,11 @@ void DeviceBaseInfo::tableHeaderToDoc(Docx::Table *tab)
     if (m_TableHeader.size() < 1)
         return;
 
-    // 添加表头信息
-    for (int col = 0; col < m_TableHeader.size() - 1; ++col)  {
-        tab->addColumn();
-        auto cel = tab->cell(0, col);
-        cel->addText(m_TableHeader[col]);
-    }
+    // 最后一列不导出,表格列数由表头决定
+    doc.beginTable(m_TableHeader.mid(0, m_TableHeader.size() - 1));
 }
 
-void DeviceBaseInfo::tableInfoToXlsx(QXlsx::Document &xlsx)
+void DeviceBaseInfo::tableInfoToXlsx(XlsxStreamWriter &xlsx)
 {
     // 获取表格信息
     getTableData();
@@ -399,12 +496,12 @@ void DeviceBaseInfo::tableInfoToXlsx(QXlsx::Document &xlsx)
         return;
 
     // 添加表格信息
-    int curRow = DeviceManager::instance()->currentXlsRow();
+    int curRow = xlsx.nextRow();
     for (int col = 0; col < m_TableData.size(); ++col)
         xlsx.write(curRow, col + 1, m_TableData[col]);
 }
 
-void DeviceBaseInfo::tableHeaderToXlsx(QXlsx::Document &xlsx)
+void DeviceBaseInfo::tableHeaderToXlsx(XlsxStreamWriter &xlsx)
 {
     // 获取表头
     getTableHeader();
@@ -413,18 +510,16 @@ void DeviceBaseInfo::tableHeaderToXlsx(QXlsx::Document &xlsx)
         return;
 
     // 添加表头信息
-    int curRow = DeviceManager::instance()->currentXlsRow();
-    for (int col = 0; col < m_TableHeader.size() - 1; ++col) {
-        QXlsx::Format boldFont;
-        boldFont.setFontSize(10);
-        boldFont.setFontBold(true);
-        xlsx.write(curRow, col + 1, m_TableHeader[col], boldFont);
-    }
+    int curRow = xlsx.nextRow();
+    for (int col = 0; col < m_TableHeader.size() - 1; ++col)
+        xlsx.write(curRow, col + 1, m_TableHeader[col], XlsxStreamWriter::CS_SmallBold);
 }
 
 void DeviceBaseInfo::setOtherDeviceInfo(const QString &key, const QString &value)
 {
     m_MapOtherInfo[key] = value;
+    addContentHash(key, value);
+    invalidateAttribs();
 }
 
 TomlFixMethod DeviceBaseInfo::setInfoFromTomlBase(const QMap<QString, QString> &mapInfo)
@@ -501,6 +596,8 @@ bool DeviceBaseInfo::driverIsKernelIn(const QString &driver)
 void DeviceBaseInfo::setCanEnale(bool can)
 {
     m_CanEnable = can;
+    addContentHash("CanEnable", can ? "1" : "0");
+    invalidateAttribs();
 }
 
 bool DeviceBaseInfo::canEnable()
@@ -511,6 +608,8 @@ bool DeviceBaseInfo::canEnable()
 void DeviceBaseInfo::setEnableValue(bool e)
 {
     m_Enable = e;
+    addContentHash("Enable", e ? "1" : "0");
+    invalidateAttribs();
 }
 
 bool DeviceBaseInfo::canUninstall()
@@ -521,11 +620,15 @@ bool DeviceBaseInfo::canUninstall()
 void DeviceBaseInfo::setCanUninstall(bool can)
 {
     m_CanUninstall = can;
+    addContentHash("CanUninstall", can ? "1" : "0");
+    invalidateAttribs();
 }
 
 void DeviceBaseInfo::setHardwareClass(const QString &hclass)
 {
     m_HardwareClass = hclass;
+    addContentHash("HardwareClass", hclass);
+    invalidateAttribs();
 }
 
 const QString &DeviceBaseInfo::hardwareClass() const
@@ -576,9 +679,15 @@ const QString DeviceBaseInfo::getVendorOrModelId(const QString &sysPath, bool fl
 
 const QString DeviceBaseInfo::getDriverVersion()
 {
+    // modinfo 需要启动进程,结果缓存到设备属性变化为止
+    if (m_DriverVersionLoaded)
+        return m_DriverVersion;
+
+    m_DriverVersion = QString("");
+    m_DriverVersionLoaded = true;
     QString outInfo = Common::executeClientCmd("modinfo", QStringList() << driver(), QString(), -1);
     if(outInfo.isEmpty())
-        return  QString("");
+        return  m_DriverVersion;
 
     foreach (QString out, outInfo.split("\n")) {
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
@@ -587,11 +696,12 @@ const QString DeviceBaseInfo::getDriverVersion()
         QStringList item = out.split(":", Qt::SkipEmptyParts);
 #endif
         if (!item.isEmpty() && "version" == item[0].trimmed()) {
-            return item[1].trimmed();
+            m_DriverVersion = item[1].trimmed();
+            break;
         }
     }
 
-    return QString("");
+    return m_DriverVersion;
 }
 
 const QString DeviceBaseInfo::getOverviewInfo()
@@ -636,16 +746,21 @@ void DeviceBaseInfo::addFilterKey(const QString &key)
 void DeviceBaseInfo::getOtherMapInfo(const QMap<QString, QString> &mapInfo)
 {
     // 获取其他设备信息
+    invalidateAttribs();
     QMap<QString, QString>::const_iterator it = mapInfo.begin();
     for (; it != mapInfo.end(); ++it) {
+        // 各 setInfoFrom 中直接取自 mapInfo 的属性也由此计入摘要
+        addContentHash(it.key(), it.value());
         QString k = DApplication::translate("QObject", it.key().trimmed().toStdString().data());
 
         // 可显示设备属性中存在该属性
         if (m_FilterKey.find(k) != m_FilterKey.end()) {
-            if (it.value().toLower().contains("nouse"))
+            if (it.value().toLower().contains("nouse")) {
                 m_MapOtherInfo.remove(k);
-            else
+            } else {
                 m_MapOtherInfo.insert(k, it.value().trimmed());
+                m_MapOtherSourceKey.insert(k, it.key().trimmed());
+            }
         }
     }
 }
@@ -674,6 +789,7 @@ void DeviceBaseInfo::setAttribute(const QMap<QString, QString> &mapInfo, const Q
     if (mapInfo[key] == "")
         return;
 
+    invalidateAttribs();
     // overwrite 为true直接覆盖
     if (overwrite) {
         variable = mapInfo[key].trimmed();
@@ -686,6 +802,7 @@ void DeviceBaseInfo::setAttribute(const QMap<QString, QString> &mapInfo, const Q
         if (variable.contains("Unknown", Qt::CaseInsensitive))
             variable = mapInfo[key].trimmed();
     }
+    addContentHash(key, variable);
 }
 
 TomlFixMethod DeviceBaseInfo::setTomlAttribute(const QMap<QString, QString> &mapInfo, const QString &key, QString &variable, bool overwrite)
@@ -700,6 +817,8 @@ TomlFixMethod DeviceBaseInfo::setTomlAttribute(const QMap<QString, QString> &map
     //如果有 关键字nouse 为直接接去掉清除
     if (mapInfo[key].toLower().contains("nouse")) {
         variable.clear();
+        addContentHash(key, variable);
+        invalidateAttribs();
         return TOML_nouse;
     }
 
@@ -717,11 +836,15 @@ void DeviceBaseInfo::mapInfoToList()
 {
     // m_MapOtherInfo --> m_LstOtherInfo
     // QMap内容转为QList存储
+    // 以原文生成时属性名换回翻译前的原文
+    const bool source = SourceTextTranslator::isActive();
     auto iter = m_MapOtherInfo.begin();
 
     for (; iter != m_MapOtherInfo.end(); ++iter) {
-        if (isValueValid(iter.value()))
-            m_LstOtherInfo.append(QPair<QString, QString>(iter.key(), iter.value()));
+        if (!isValueValid(iter.value()))
+            continue;
+        const QString key = source ? m_MapOtherSourceKey.value(iter.key(), iter.key()) : iter.key();
+        m_LstOtherInfo.append(QPair<QString, QString>(key, iter.value()));
     }
 }
 
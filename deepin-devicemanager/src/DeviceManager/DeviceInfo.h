@@ -6,9 +6,8 @@
 #ifndef DEVICEINFO_H
 #define DEVICEINFO_H
 
-#include "document.h"
-#include "xlsxdocument.h"
-#include "table.h"
+#include "DocxStreamWriter.h"
+#include "XlsxStreamWriter.h"
 #include "DeviceManager.h"
 
 #include <QString>
@@ -17,8 +16,7 @@
 #include <QObject>
 #include <QList>
 #include <QPair>
-#include <QDomDocument>
-#include <QFile>
+#include <QIODevice>
 
 /**
  * @brief The EnableDeviceStatus enum
@@ -68,6 +66,62 @@ public:
      */
     const QStringList &getTableData();
 
+    /**
+     * @brief invalidateAttribs:设备属性变化后使缓存的显示信息失效,下次获取时重新生成
+     */
+    void invalidateAttribs();
+
+    /**
+     * @brief copyAttribs:获取所有显示信息,已生成的直接使用缓存,未生成的临时生成且不写入缓存
+     * @param base:基本信息
+     * @param other:其它信息
+     * @param header:表头,不包含末尾的是否可禁用
+     * @param data:表格数据
+     */
+    void copyAttribs(QList<QPair<QString, QString>> &base, QList<QPair<QString, QString>> &other,
+                     QStringList &header, QStringList &data);
+
+    /**
+     * @brief copySourceAttribs:以未翻译的属性名重新生成基本信息和其它信息,不改动缓存
+     * @param base:基本信息
+     * @param other:其它信息
+     */
+    void copySourceAttribs(QList<QPair<QString, QString>> &base, QList<QPair<QString, QString>> &other);
+
+    /**
+     * @brief revision:设备属性的修改序号,属性变化时更新,用于索引判断设备是否需要重新登记
+     * @return 修改序号
+     */
+    int revision() const;
+
+    /**
+     * @brief lastRevision:所有设备中最近一次属性变化的修改序号
+     * @return 修改序号
+     */
+    static int lastRevision();
+
+    /**
+     * @brief invalidateDriverVersion:驱动安装卸载后使缓存的驱动版本失效
+     */
+    void invalidateDriverVersion();
+
+    /**
+     * @brief contentHash:设备内容摘要,由所有写入设备的属性依次累加而成
+     * @return 内容摘要
+     */
+    quint64 contentHash() const;
+
+    /**
+     * @brief markGenerated:记录设备生成完成时的内容摘要
+     */
+    void markGenerated();
+
+    /**
+     * @brief generatedHash:设备生成完成时的内容摘要,用于与下一次生成的设备比较
+     * @return 内容摘要
+     */
+    quint64 generatedHash() const;
+
     /**
      * @brief subTitle:获取子标题
      * @return 子标题
@@ -236,50 +290,48 @@ public:
 
     /**
      * @brief toHtmlString:导出信息为html格式
-     * @param doc xml格式文本
+     * @param html:html输出设备
      */
-    void toHtmlString(QDomDocument &doc);
+    void toHtmlString(QIODevice &html);
 
     /**
      * @brief baseInfoToHTML:基本信息导出html
-     * @param doc:xml格式文本
+     * @param html:html输出设备
      * @param infoLst:信息列表
      */
-    void baseInfoToHTML(QDomDocument &doc, QList<QPair<QString, QString>> &infoLst);
+    void baseInfoToHTML(QIODevice &html, QList<QPair<QString, QString>> &infoLst);
 
     /**
      * @brief subTitleToHTML:子标题导出
-     * @param doc:xml格式文本
+     * @param html:html输出设备
      */
-    void subTitleToHTML(QDomDocument &doc);
+    void subTitleToHTML(QIODevice &html);
 
     /**
-     * @brief toDocString:导出信息为html格式
+     * @brief toDocString:导出信息为doc格式
      * @param doc:doc文档
      */
-    void toDocString(Docx::Document &doc);
+    void toDocString(DocxStreamWriter &doc);
 
     /**
      * @brief baseInfoToDoc:基本信息导出doc
      * @param doc:doc文档
      * @param infoLst:信息列表
      */
-    void baseInfoToDoc(Docx::Document &doc, QList<QPair<QString, QString>> &infoLst);
+    void baseInfoToDoc(DocxStreamWriter &doc, QList<QPair<QString, QString>> &infoLst);
 
     /**
      * @brief toXlsxString:导出信息为xlsx格式
      * @param xlsx:xlsx文档
-     * @param boldFontc:字体格式
      */
-    void toXlsxString(QXlsx::Document &xlsx, QXlsx::Format &boldFont);
+    void toXlsxString(XlsxStreamWriter &xlsx);
 
     /**
      * @brief baseInfoToXlsx:基本信息导出xlsx
      * @param xlsx:xlsx文档
-     * @param boldFont:字体格式
      * @param infoLst:信息列表
      */
-    void baseInfoToXlsx(QXlsx::Document &xlsx, QXlsx::Format &boldFont, QList<QPair<QString, QString>> &infoLst);
+    void baseInfoToXlsx(XlsxStreamWriter &xlsx, QList<QPair<QString, QString>> &infoLst);
 
     /**
      * @brief toTxtString:导出信息为txt格式
@@ -308,40 +360,39 @@ public:
 
     /**
      * @brief tableInfoToHtml:表格内容写到html
-     * @param html:html文档
+     * @param html:html输出设备
      */
-    void tableInfoToHtml(QFile &html);
+    void tableInfoToHtml(QIODevice &html);
 
     /**
      * @brief tableHeaderToHtml:表头信息写到html
-     * @param html:html文档
+     * @param html:html输出设备
      */
-    void tableHeaderToHtml(QFile &html);
+    void tableHeaderToHtml(QIODevice &html);
 
     /**
      * @brief tableInfoToDoc:表格信息写到doc
-     * @param tab:doc文档表格
-     * @param row:表格行数，第row行
+     * @param doc:doc文档
      */
-    void tableInfoToDoc(Docx::Table *tab, int &row);
+    void tableInfoToDoc(DocxStreamWriter &doc);
 
     /**
      * @brief tableHeaderToDoc:表头信息写到doc
-     * @param tab doc文档的表格
+     * @param doc:doc文档
      */
-    void tableHeaderToDoc(Docx::Table *tab);
+    void tableHeaderToDoc(DocxStreamWriter &doc);
 
     /**
      * @brief tableInfoToXlsx:表格信息写到xlsx
      * @param xlsx xlsx文件
      */
-    void tableInfoToXlsx(QXlsx::Document &xlsx);
+    void tableInfoToXlsx(XlsxStreamWriter &xlsx);
 
     /**
      * @brief tableHeaderToXlsx:表头信息写到xlsx
      * @param xlsx xlsx文件
      */
-    void tableHeaderToXlsx(QXlsx::Document &xlsx);
+    void tableHeaderToXlsx(XlsxStreamWriter &xlsx);
 
     /**
      * @brief setOtherDeviceInfo:设置其他信息信息
@@ -462,6 +513,13 @@ protected:
      */
     bool PhysIDMapInfo(const QMap<QString, QString> &mapInfo);
 
+    /**
+     * @brief addContentHash:将写入的属性计入内容摘要
+     * @param key:属性名
+     * @param value:属性值
+     */
+    void addContentHash(const QString &key, const QString &value);
+
 protected:
     QString            m_Name;         //<! 【名称】
     QString            m_Vendor;       //<! 【制造商
@@ -492,7 +550,17 @@ protected:
     QString                        m_PhysIDMap;         //<! 匹配 XXX和XXX的key
     QString            m_Driver;                  //<! 【驱动】
 
+    bool                           m_BaseInfoLoaded;    //<! m_LstBaseInfo 是否为最新
+    bool                           m_OtherInfoLoaded;   //<! m_LstOtherInfo 是否为最新
+    bool                           m_TableDataLoaded;   //<! m_TableData 是否为最新
+    bool                           m_DriverVersionLoaded; //<! m_DriverVersion 是否为最新
+    QString                        m_DriverVersion;     //<! 驱动版本缓存
+    int                            m_Revision;          //<! 属性修改序号
+    quint64                        m_ContentHash;       //<! 内容摘要
+    quint64                        m_GeneratedHash;     //<! 生成完成时的内容摘要
+
 private:
     QMap<QString, QString>  m_MapOtherInfo;         //<! 其它信息
+    QMap<QString, QString>  m_MapOtherSourceKey;    //<! 其它信息翻译后的属性名对应的原文
 };
 #endif // DEVICEINFO_H
@@ -190,6 +190,7 @@ void DeviceInput::setKLUInfoFromHwinfo(const QMap<QString, QString> &mapInfo)
 
 void DeviceInput::setInfoFromBluetoothctl()
 {
+    invalidateAttribs();
     // 判断该设备信息是否存在于Bluetoothctl中
     if (isValueValid(m_keysToPairedDevice)) {
         bool isExist = DeviceManager::instance()->isDeviceExistInPairedDevice(m_keysToPairedDevice.toUpper());
@@ -197,6 +198,7 @@ void DeviceInput::setInfoFromBluetoothctl()
         if (isExist)
             m_Interface = "Bluetooth";
     }
+    addContentHash("Interface", m_Interface);
 }
 
 bool DeviceInput::getPS2Syspath(const QString &dfs)
@@ -261,6 +263,9 @@ bool DeviceInput::getPS2Syspath(const QString &dfs)
         }
     }
 
+    // sysfs 路径是设备索引键
+    addContentHash("SysFS ID", m_SysPath);
+    invalidateAttribs();
     return true;
 }
 
@@ -395,6 +400,7 @@ const QString DeviceInput::getOverviewInfo()
 
 EnableDeviceStatus DeviceInput::setEnable(bool e)
 {
+    invalidateAttribs();
     if (m_Name.contains("Touchpad", Qt::CaseInsensitive)) {
         DBusTouchPad::instance()->setEnable(e);
         m_Enable = e;
@@ -10,6 +10,10 @@
 #include <QLoggingCategory>
 #include <QFile>
 #include <QMutexLocker>
+#include <QBuffer>
+#include <QThread>
+#include <QThreadPool>
+#include <QSemaphore>
 
 // 其它头文件
 #include "DeviceCpu.h"
@@ -29,19 +33,61 @@
 #include "DeviceComputer.h"
 #include "DeviceCdrom.h"
 #include "DeviceInput.h"
+#include "DeviceSnapshotInfo.h"
 #include "MacroDefinition.h"
+#include "DeviceDumper.h"
+#include "DeviceRecordWriter.h"
 #include <QRegularExpression>   
 #include <algorithm> // for std::sort
 
 using namespace DDLog;
 
 DeviceManager    *DeviceManager::sInstance = nullptr;
-int DeviceManager::m_CurrentXlsRow = 1;
 
 QMutex addCmdMutex;
 
+/**
+ * @brief The ExportTask class
+ * 导出时渲染一类设备的任务,完成后由导出线程按顺序取走片段
+ */
+class ExportTask : public QRunnable
+{
+public:
+    ExportTask(DeviceManager::ExportFormat format, const DeviceManager::ExportCategory &category)
+        : m_Format(format)
+        , m_Category(category)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override
+    {
+        m_Fragment = DeviceManager::renderCategory(m_Format, m_Category);
+        m_Done.release();
+    }
+
+    /**
+     * @brief takeFragment:等待渲染完成并取走片段
+     */
+    QByteArray takeFragment()
+    {
+        m_Done.acquire();
+        QByteArray fragment = m_Fragment;
+        m_Fragment.clear();
+        return fragment;
+    }
+
+private:
+    DeviceManager::ExportFormat     m_Format;      //<! 导出格式
+    DeviceManager::ExportCategory   m_Category;    //<! 设备类别
+    QByteArray                      m_Fragment;    //<! 渲染结果
+    QSemaphore                      m_Done;        //<! 渲染完成信号
+};
+
 DeviceManager::DeviceManager()
-    : m_CpuNum(1)
+    : m_ShownCpuNum(1)
+    , m_CpuNum(1)
+    , m_ExportThreadCount(QThread::idealThreadCount())
 {
 
 }
@@ -49,6 +95,7 @@ DeviceManager::DeviceManager()
 DeviceManager::~DeviceManager()
 {
     clear();
+    clearLastGeneration();
 }
 
 void DeviceManager::clear()
@@ -56,60 +103,21 @@ void DeviceManager::clear()
     // 清除所有命令
     m_cmdInfo.clear();
 
-    // 清除内存中的所有设备指针
-    foreach (auto device, m_ListDeviceMouse)
-        delete device;
-
-    foreach (auto device, m_ListDeviceStorage)
-        delete device;
-
-    foreach (auto device, m_ListDeviceMonitor)
-        delete device;
-
-    foreach (auto device, m_ListDeviceBluetooth)
-        delete device;
-
-    foreach (auto device, m_ListDeviceAudio)
-        delete device;
-
-    foreach (auto device, m_ListDeviceImage)
-        delete device;
-
-    foreach (auto device, m_ListDeviceKeyboard)
-        delete device;
-
-    foreach (auto device, m_ListDeviceOthers)
-        delete device;
-
-    foreach (auto device, m_ListDevicePower)
-        delete device;
-
-    foreach (auto device, m_ListDevicePrint)
-        delete device;
-
-    foreach (auto device, m_ListDeviceOtherPCI)
-        delete device;
-
-    foreach (auto device, m_ListDeviceCdrom)
-        delete device;
-
-    foreach (auto device, m_ListDeviceComputer)
-        delete device;
-
-    foreach (auto device, m_ListDeviceNetwork)
-        delete device;
-
-    foreach (auto device, m_ListDeviceBios)
-        delete device;
-
-    foreach (auto device, m_ListDeviceGPU)
-        delete device;
-
-    foreach (auto device, m_ListDeviceMemory)
-        delete device;
+    // 设备指针暂存到上一次刷新的列表中,生成结束后比对,内容未变化的设备继续使用
+    // 连续清空而未合并时,暂存的仍是界面显示的设备,中间生成的设备未被界面使用,直接释放
+    for (int type = DT_Audio; type <= DT_Others; ++type) {
+        QList<DeviceBaseInfo *> *lst = convertDeviceListAddr(DeviceType(type));
+        QList<DeviceBaseInfo *> &last = m_LastGeneration[type];
+        if (last.isEmpty()) {
+            last = *lst;
+            continue;
+        }
 
-    foreach (auto device, m_ListDeviceCPU)
-        delete device;
+        foreach (DeviceBaseInfo *device, *lst) {
+            if (!last.contains(device))
+                delete device;
+        }
+    }
 
     // 清空存储设备指针的列表
     m_ListDeviceMouse.clear();
@@ -130,12 +138,23 @@ void DeviceManager::clear()
     m_ListDeviceGPU.clear();
     m_ListDeviceMemory.clear();
     m_ListDeviceCPU.clear();
-    m_DeviceClassMap.clear();
+
+    // 清空设备索引
+    m_IndexMouse.clear();
+    m_IndexBluetooth.clear();
+    m_IndexAudio.clear();
+    m_IndexNetwork.clear();
+    m_IndexImage.clear();
+    m_IndexOthers.clear();
 }
 
 const QList<QPair<QString, QString>> &DeviceManager::getDeviceTypes()
 {
-    // 获取设备类型
+    // 获取设备类型,只读取界面线程中更新的设备类型映射,加载线程可以同时生成设备
+    auto hasDevice = [this](const QString &type) {
+        return !m_DeviceClassMap.value(type).isEmpty();
+    };
+
     // 清空设备类型列表
     m_ListDeviceType.clear();
     bool addSeperator = false;
@@ -146,12 +165,12 @@ const QList<QPair<QString, QString>> &DeviceManager::getDeviceTypes()
     }
 
     // 添加cpu信息
-    if (m_ListDeviceCPU.size() > 0) {
+    if (hasDevice(tr("CPU"))) {
         m_ListDeviceType.append(QPair<QString, QString>(tr("CPU"), "cpu##CPU"));
         addSeperator = true;
     }
 
-    if (m_CpuNum > 1) {
+    if (m_ShownCpuNum > 1) {
         m_ListDeviceType.append(QPair<QString, QString>(tr("CPU quantity"), ""));
         addSeperator = true;
     }
@@ -162,37 +181,37 @@ const QList<QPair<QString, QString>> &DeviceManager::getDeviceTypes()
     }
 
     // 板载接口设备
-    if (m_ListDeviceBios.size() > 0) {
+    if (hasDevice(tr("Motherboard"))) {
         m_ListDeviceType.append(QPair<QString, QString>(tr("Motherboard"), "motherboard##Bios"));
         addSeperator = true;
     }
 
-    if (m_ListDeviceMemory.size() > 0) {
+    if (hasDevice(tr("Memory"))) {
         m_ListDeviceType.append(QPair<QString, QString>(tr("Memory"), "memory##Memory"));
         addSeperator = true;
     }
 
-    if (m_ListDeviceGPU.size() > 0) {
+    if (hasDevice(tr("Display Adapter"))) {
         m_ListDeviceType.append(QPair<QString, QString>(tr("Display Adapter"), "displayadapter##GPU"));
         addSeperator = true;
     }
 
-    if (m_ListDeviceAudio.size() > 0) {
+    if (hasDevice(tr("Sound Adapter"))) {
         m_ListDeviceType.append(QPair<QString, QString>(tr("Sound Adapter"), "audiodevice##Audio"));
         addSeperator = true;
     }
 
-    if (m_ListDeviceStorage.size() > 0) {
+    if (hasDevice(tr("Storage"))) {
         m_ListDeviceType.append(QPair<QString, QString>(tr("Storage"), "storage##Storage"));
         addSeperator = true;
     }
 
-    if (m_ListDeviceOtherPCI.size() > 0) {
+    if (hasDevice(tr("Other PCI Devices"))) {
         m_ListDeviceType.append(QPair<QString, QString>(tr("Other PCI Devices"), "otherpcidevices##OtherPCI"));
         addSeperator = true;
     }
 
-    if (m_ListDevicePower.size() > 0) {
+    if (hasDevice(tr("Battery"))) {
         m_ListDeviceType.append(QPair<QString, QString>(tr("Battery"), "battery##Power"));
         addSeperator = true;
     }
@@ -203,12 +222,12 @@ const QList<QPair<QString, QString>> &DeviceManager::getDeviceTypes()
     }
 
     // 网络设备
-    if (m_ListDeviceBluetooth.size() > 0) {
+    if (hasDevice(tr("Bluetooth"))) {
         m_ListDeviceType.append(QPair<QString, QString>(tr("Bluetooth"), "bluetooth##Bluetooth"));
         addSeperator = true;
     }
 
-    if (m_ListDeviceNetwork.size() > 0) {
+    if (hasDevice(tr("Network Adapter"))) {
         m_ListDeviceType.append(QPair<QString, QString>(tr("Network Adapter"), "networkadapter##Network"));
         addSeperator = true;
     }
@@ -219,12 +238,12 @@ const QList<QPair<QString, QString>> &DeviceManager::getDeviceTypes()
     }
 
     // 输入设备
-    if (m_ListDeviceMouse.size() > 0) {
+    if (hasDevice(tr("Mouse"))) {
         m_ListDeviceType.append(QPair<QString, QString>(tr("Mouse"), "mouse##Mouse"));
         addSeperator = true;
     }
 
-    if (m_ListDeviceKeyboard.size() > 0) {
+    if (hasDevice(tr("Keyboard"))) {
         m_ListDeviceType.append(QPair<QString, QString>(tr("Keyboard"), "keyboard##Keyboard"));
         addSeperator = true;
     }
@@ -234,23 +253,23 @@ const QList<QPair<QString, QString>> &DeviceManager::getDeviceTypes()
     }
 
     // 外设设备
-    if (m_ListDeviceMonitor.size() > 0) {
+    if (hasDevice(tr("Monitor"))) {
         m_ListDeviceType.append(QPair<QString, QString>(tr("Monitor"), "monitor##Monitor"));
     }
 
-    if (m_ListDeviceCdrom.size() > 0) {
+    if (hasDevice(tr("CD-ROM"))) {
         m_ListDeviceType.append(QPair<QString, QString>(tr("CD-ROM"), "cdrom##Cdrom"));
     }
 
-    if (m_ListDevicePrint.size() > 0) {
+    if (hasDevice(tr("Printer"))) {
         m_ListDeviceType.append(QPair<QString, QString>(tr("Printer"), "printer##Print"));
     }
 
-    if (m_ListDeviceImage.size() > 0) {
+    if (hasDevice(tr("Camera"))) {
         m_ListDeviceType.append(QPair<QString, QString>(tr("Camera"), "camera##Image"));
     }
 
-    if (m_ListDeviceOthers.size() > 0) {
+    if (hasDevice(tr("Other Devices", "Other Input Devices"))) {
         m_ListDeviceType.append(QPair<QString, QString>(tr("Other Devices", "Other Input Devices"), "otherdevices##Others"));
     }
 
@@ -259,6 +278,9 @@ const QList<QPair<QString, QString>> &DeviceManager::getDeviceTypes()
 
 void DeviceManager::setDeviceListClass()
 {
+    // 复用上一次刷新中未变化的设备
+    mergeLastGeneration();
+
     // 添加设备类型与设备指针列表的映射关系
     m_DeviceClassMap[tr("CPU")] = m_ListDeviceCPU;
     m_DeviceClassMap[tr("Motherboard")] =  m_ListDeviceBios;
@@ -277,6 +299,108 @@ void DeviceManager::setDeviceListClass()
     m_DeviceClassMap[tr("Printer")] =  m_ListDevicePrint;
     m_DeviceClassMap[tr("Camera")] =  m_ListDeviceImage;
     m_DeviceClassMap[tr("Other Devices", "Other Input Devices")] =  m_ListDeviceOthers;
+    m_ShownComputer = m_ListDeviceComputer;
+    m_ShownCpuNum = m_CpuNum;
+
+    // 复用的设备指针不变,列表完全一致说明该类设备没有变化
+    m_ChangedClasses.clear();
+    for (auto it = m_DeviceClassMap.begin(); it != m_DeviceClassMap.end(); ++it) {
+        if (m_LastClassMap.value(it.key()) != it.value())
+            m_ChangedClasses.insert(it.key());
+    }
+    m_LastClassMap = m_DeviceClassMap;
+}
+
+void DeviceManager::mergeLastGeneration()
+{
+    int reused = 0, added = 0, removed = 0;
+    for (int type = DT_Audio; type <= DT_Others; ++type) {
+        QList<DeviceBaseInfo *> *lst = convertDeviceListAddr(DeviceType(type));
+        const QList<DeviceBaseInfo *> last = m_LastGeneration.take(type);
+        if (last.isEmpty()) {
+            added += lst->size();
+            foreach (DeviceBaseInfo *device, *lst)
+                device->markGenerated();
+            continue;
+        }
+
+        // 同类设备比对键相同时按出现顺序区分
+        QHash<QString, DeviceBaseInfo *> lastDevices;
+        QHash<QString, int> lastCount;
+        foreach (DeviceBaseInfo *device, last) {
+            QString key = generationKey(device);
+            lastDevices.insert(key + "#" + QString::number(lastCount[key]++), device);
+        }
+
+        QHash<QString, int> curCount;
+        for (int i = 0; i < lst->size(); ++i) {
+            DeviceBaseInfo *device = (*lst)[i];
+            QString key = generationKey(device);
+            key += "#" + QString::number(curCount[key]++);
+
+            auto it = lastDevices.find(key);
+            if (it != lastDevices.end() && it.value() != device && sameContent(it.value(), device)) {
+                (*lst)[i] = it.value();
+                delete device;
+                // 驱动可能已被安装或卸载,版本需要重新读取
+                it.value()->invalidateDriverVersion();
+                lastDevices.erase(it);
+                ++reused;
+            } else {
+                device->markGenerated();
+                ++added;
+            }
+        }
+
+        // 本次刷新中不存在或内容变化的旧设备,地址可能被新设备复用,先移出搜索索引
+        foreach (DeviceBaseInfo *device, lastDevices) {
+            if (!lst->contains(device)) {
+                m_SearchIndex.remove(device);
+                delete device;
+                ++removed;
+            }
+        }
+
+        DeviceIndex *index = convertDeviceIndex(DeviceType(type));
+        if (index)
+            index->rebuild(*lst);
+    }
+
+    if (reused || added || removed)
+        qCInfo(appLog) << "device refresh, reused:" << reused << "added or changed:" << added << "removed:" << removed;
+}
+
+bool DeviceManager::deviceClassChanged(const QString &name)
+{
+    if (name == tr("Overview"))
+        return !m_ChangedClasses.isEmpty();
+    return m_ChangedClasses.contains(name);
+}
+
+QString DeviceManager::generationKey(DeviceBaseInfo *device)
+{
+    return QString(device->metaObject()->className()) + "\n" + device->uniqueID() + "\n" + device->sysPath() + "\n" + device->name();
+}
+
+bool DeviceManager::sameContent(DeviceBaseInfo *device, DeviceBaseInfo *other)
+{
+    // 只比较内容摘要,不生成显示信息,避免提前填充延迟加载的缓存
+    return device->enable() == other->enable()
+           && device->available() == other->available()
+           && device->canEnable() == other->canEnable()
+           && device->canUninstall() == other->canUninstall()
+           && device->generatedHash() == other->contentHash();
+}
+
+void DeviceManager::clearLastGeneration()
+{
+    foreach (const QList<DeviceBaseInfo *> &lst, m_LastGeneration) {
+        foreach (DeviceBaseInfo *device, lst) {
+            m_SearchIndex.remove(device);
+            delete device;
+        }
+    }
+    m_LastGeneration.clear();
 }
 
 bool DeviceManager::getDeviceList(const QString &name, QList<DeviceBaseInfo *> &lst)
@@ -292,6 +416,38 @@ bool DeviceManager::getDeviceList(const QString &name, QList<DeviceBaseInfo *> &
     return true;
 }
 
+QMap<QString, QList<DeviceBaseInfo *>> DeviceManager::searchDevices(const QString &text)
+{
+    QMap<QString, QList<DeviceBaseInfo *>> result;
+    if (DeviceSearchIndex::tokenize(text).isEmpty())
+        return result;
+
+    // 索引在搜索时才建立,只登记新设备和显示期间属性变化(显示信息、网络状态、电池与处理器频率等)的设备
+    QList<DeviceBaseInfo *> shown;
+    for (auto it = m_DeviceClassMap.constBegin(); it != m_DeviceClassMap.constEnd(); ++it) {
+        foreach (DeviceBaseInfo *device, it.value()) {
+            m_SearchIndex.update(device);
+            shown.append(device);
+        }
+    }
+    m_SearchIndex.retain(shown);
+
+    const QSet<DeviceBaseInfo *> matched = m_SearchIndex.find(text);
+    if (matched.isEmpty())
+        return result;
+
+    for (auto it = m_DeviceClassMap.constBegin(); it != m_DeviceClassMap.constEnd(); ++it) {
+        QList<DeviceBaseInfo *> lst;
+        foreach (DeviceBaseInfo *device, it.value()) {
+            if (matched.contains(device))
+                lst.append(device);
+        }
+        if (!lst.isEmpty())
+            result.insert(it.key(), lst);
+    }
+    return result;
+}
+
 QString DeviceManager::convertDeviceTomlClassName(DeviceType deviceType)
 {
     //与oeminfoxxx.toml文件中的[hardclassname.submember] 保持一致，即 “toml+hardclassname”
@@ -340,6 +496,18 @@ QList<DeviceBaseInfo *> *DeviceManager::convertDeviceListAddr(DeviceType deviceT
     if (deviceType == DT_Others)    {return &m_ListDeviceOthers;}
     return &m_ListDeviceOthers;
 }
+
+DeviceIndex *DeviceManager::convertDeviceIndex(DeviceType deviceType)
+{
+    if (deviceType == DT_Mouse)     {return &m_IndexMouse;}
+    if (deviceType == DT_Bluetoorh) {return &m_IndexBluetooth;}
+    if (deviceType == DT_Audio)     {return &m_IndexAudio;}
+    if (deviceType == DT_Network)   {return &m_IndexNetwork;}
+    if (deviceType == DT_Image)     {return &m_IndexImage;}
+    if (deviceType == DT_Others)    {return &m_IndexOthers;}
+    return nullptr;
+}
+
 QList<DeviceBaseInfo *> DeviceManager::convertDeviceList(DeviceType deviceType)
 {
 //    if (deviceType == DT_Null)      {return m_ListDeviceOthers;}
@@ -479,31 +647,26 @@ void DeviceManager::tomlDeviceSet(DeviceType deviceType)
 
     QString deviceTypeName = convertDeviceTomlClassName(deviceType);
     const QList<QMap<QString, QString>> &tomlMapLst = cmdInfo(deviceTypeName);
+    if (tomlMapLst.isEmpty())
+        return;
+
+    // toml 合并前设备信息已加载完毕,按当前属性建立一次索引,合并过程中随设备变化更新
+    // toml 规则预先规范化,每条规则只做常数次索引查找,整体与设备数加规则数成线性关系
+    const QList<TomlRule> rules = compileTomlRules(tomlMapLst);
+    DeviceIndex index;
+    index.rebuild(convertDeviceList(deviceType));
     for (int j = 0; j < tomlMapLst.size(); j++) { // 加载从toml中获取的信息
         bool fixSameOne = false;                  //初始值设为该项信息没有用过
-        bool isSameOne = false;
-        QList<DeviceBaseInfo *> lst = convertDeviceList(deviceType);
-        for (int i = 0; i < lst.size(); i++) {   // toml中获取的信息 与 原设备信息遍历，相比较作处理
-            DeviceBaseInfo *device = lst[i];
-            QString modalias = PhysID(tomlMapLst[j], "Modalias");
-            QString vid = PhysID(tomlMapLst[j], "Vendor_ID");
-            QString pid = PhysID(tomlMapLst[j], "Product_ID");
-            QString vendor = PhysID(tomlMapLst[j], "Vendor");
-            QString name = PhysID(tomlMapLst[j], "Name");
-            //取出toml中获取的关键字信息设备唯一标识硬件IDS "Modalias"， "Vendor_ID"， "Vendor"，"Name"；作比较处理
-            isSameOne = findByModalias(deviceType, device, modalias);
-            if (!isSameOne) {
-                isSameOne = findByVIDPID(deviceType, device, vid, pid);
-            }
-            if (!isSameOne) {
-                isSameOne = findByVendorName(deviceType, device, vendor, name);
-            }
-            if (isSameOne) {   //存在 就合并信息 setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo);
-                fixSameOne = true;   //标记为该项信息有用过 ，
-                if (TOML_Del == tomlDeviceSet(deviceType, device, tomlMapLst[j])) {
-                    tomlDeviceDel(deviceType, device); //toml 去掉该设备
-                    delete (device);
-                }
+        //取出toml中获取的关键字信息设备唯一标识硬件IDS "Modalias"， "Vendor_ID"， "Vendor"，"Name"；作比较处理
+        QList<DeviceBaseInfo *> lst = findTomlDevices(deviceType, index, rules[j]);
+        foreach (DeviceBaseInfo *device, lst) {   //存在 就合并信息 setInfoFromTomlOneByOne(const QMap<QString, QString> &mapInfo);
+            fixSameOne = true;   //标记为该项信息有用过 ，
+            if (TOML_Del == tomlDeviceSet(deviceType, device, tomlMapLst[j])) {
+                index.remove(device);
+                tomlDeviceDel(deviceType, device); //toml 去掉该设备
+                delete (device);
+            } else {
+                index.update(device);
             }
         }  //与原设备信息遍历相比完再作添加设备
         if ((deviceType != DT_Bios) && (deviceType != DT_Computer) && !fixSameOne) {
@@ -511,9 +674,77 @@ void DeviceManager::tomlDeviceSet(DeviceType deviceType)
                 DeviceBaseInfo *device = createDevice(deviceType);
                 tomlDeviceSet(deviceType, device, tomlMapLst[j]);
                 tomlDeviceAdd(deviceType, device); //不存在 就加
+                index.insert(device);
         }
     } //end of for (int j = 0;...
 }
+
+QList<TomlRule> DeviceManager::compileTomlRules(const QList<QMap<QString, QString>> &tomlMapLst)
+{
+    QList<TomlRule> rules;
+    rules.reserve(tomlMapLst.size());
+    foreach (const auto &mapInfo, tomlMapLst) {
+        TomlRule rule;
+        rule.modalias = PhysID(mapInfo, "Modalias");
+        rule.vid = PhysID(mapInfo, "Vendor_ID");
+        rule.pid = PhysID(mapInfo, "Product_ID");
+        rule.vendor = PhysID(mapInfo, "Vendor");
+        rule.name = PhysID(mapInfo, "Name");
+
+        // 自己构建的modalias,包含设备的vid和pid即认为是同一设备,预先取出所有可能的4位vid
+        if (!rule.modalias.isEmpty() && !rule.modalias.startsWith("pci") && !rule.modalias.startsWith("usb")) {
+            for (int i = 0; i + 4 <= rule.modalias.size(); ++i) {
+                QString window = rule.modalias.mid(i, 4);
+                if (!rule.vidWindows.contains(window))
+                    rule.vidWindows.append(window);
+            }
+        }
+        rules.append(rule);
+    }
+    return rules;
+}
+
+QList<DeviceBaseInfo *> DeviceManager::findTomlDevices(DeviceType deviceType, const DeviceIndex &index, const TomlRule &rule)
+{
+    QList<DeviceBaseInfo *> candidates;
+
+    // 索引只用于缩小范围,候选设备仍按原有规则校验
+    if (!rule.modalias.isEmpty())
+        candidates += index.find(DeviceIndex::IK_Modalias, DeviceIndex::modaliasKey(rule.modalias));
+    foreach (const QString &window, rule.vidWindows)
+        candidates += index.find(DeviceIndex::IK_VID, window);
+    if (!rule.vidWindows.isEmpty())
+        candidates += index.find(DeviceIndex::IK_VID, DeviceIndex::ShortKey);
+
+    if (!rule.vid.isEmpty() && !rule.pid.isEmpty()) {
+        candidates += index.find(DeviceIndex::IK_VIDPID, DeviceIndex::vidpidKey(rule.vid, rule.pid));
+        // 只有 VIDAndPID 的设备须同时包含 vid 与 pid,按其中一个的 4 位子串查找即可
+        const QString vid = QString(rule.vid).remove("0x");
+        const QString pid = QString(rule.pid).remove("0x");
+        if (vid.size() == 4)
+            candidates += index.find(DeviceIndex::IK_VIDPIDWindow, vid);
+        else if (pid.size() == 4)
+            candidates += index.find(DeviceIndex::IK_VIDPIDWindow, pid);
+        else
+            candidates += index.find(DeviceIndex::IK_VIDPIDWindow, DeviceIndex::ShortKey);
+    }
+
+    if (deviceType == DT_Bios || deviceType == DT_Computer) {
+        // bios与computer设备只有几条,按名称逐一比较
+        candidates += convertDeviceList(deviceType);
+    } else if (!rule.name.isEmpty() && !rule.vendor.isEmpty()) {
+        candidates += index.find(DeviceIndex::IK_VendorName, DeviceIndex::vendorNameKey(rule.vendor, rule.name));
+    }
+
+    QList<DeviceBaseInfo *> lst;
+    foreach (DeviceBaseInfo *device, index.ordered(candidates)) {
+        if (findByModalias(deviceType, device, rule.modalias)
+                || findByVIDPID(deviceType, device, rule.vid, rule.pid)
+                || findByVendorName(deviceType, device, rule.vendor, rule.name))
+            lst.append(device);
+    }
+    return lst;
+}
 QString DeviceManager::PhysID(const QMap<QString, QString> &mapInfo, const QString &key)
 {
     if (mapInfo.contains(key)) {  //toml key
@@ -533,6 +764,9 @@ void DeviceManager::tomlDeviceDel(DeviceType deviceType, DeviceBaseInfo *const d
     }
     QList<DeviceBaseInfo *> *lst = convertDeviceListAddr(deviceType);
     lst->removeOne(device);
+    DeviceIndex *index = convertDeviceIndex(deviceType);
+    if (index)
+        index->remove(device);
 }
 
 void DeviceManager::tomlDeviceAdd(DeviceType deviceType, DeviceBaseInfo *const device)
@@ -542,6 +776,9 @@ void DeviceManager::tomlDeviceAdd(DeviceType deviceType, DeviceBaseInfo *const d
     }
     QList<DeviceBaseInfo *> *lst = convertDeviceListAddr(deviceType);
     lst->append(device);
+    DeviceIndex *index = convertDeviceIndex(deviceType);
+    if (index)
+        index->insert(device);
 }
 
 bool DeviceManager::findByModalias(DeviceType deviceType, DeviceBaseInfo *device, const QString &modalias)
@@ -651,6 +888,7 @@ void DeviceManager::addMouseDevice(DeviceInput *const device)
 {
     // 如果不是重复设备则添加到设备列表
     m_ListDeviceMouse.append(device);
+    m_IndexMouse.insert(device);
 }
 
 DeviceBaseInfo *DeviceManager::getMouseDevice(const QString &unique_id)
@@ -658,10 +896,10 @@ DeviceBaseInfo *DeviceManager::getMouseDevice(const QString &unique_id)
     if (unique_id.isEmpty()) {
         return nullptr;
     }
-    for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceMouse.begin(); it != m_ListDeviceMouse.end(); ++it) {
-        DeviceInput *mouse = dynamic_cast<DeviceInput *>(*it);
-        if (mouse && mouse->uniqueID() == unique_id) {
-            return *it;
+    m_IndexMouse.sync(m_ListDeviceMouse);
+    foreach (DeviceBaseInfo *mouse, m_IndexMouse.find(DeviceIndex::IK_UniqueID, DeviceIndex::uniqueIDKey(unique_id))) {
+        if (mouse->uniqueID() == unique_id) {
+            return mouse;
         }
     }
     return nullptr;
@@ -933,6 +1171,7 @@ void DeviceManager::setLanguageInfo(const QMap<QString, QString> &mapInfo)
 void DeviceManager::addBluetoothDevice(DeviceBluetooth *const device)
 {
     m_ListDeviceBluetooth.append(device);
+    m_IndexBluetooth.insert(device);
 }
 
 void DeviceManager::setBluetoothInfoFromLshw(const QMap<QString, QString> &mapInfo)
@@ -978,10 +1217,10 @@ bool DeviceManager::setBluetoothInfoFromWifiInfo(const QMap<QString, QString> &m
 
 DeviceBaseInfo *DeviceManager::getBluetoothDevice(const QString &unique_id)
 {
-    for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceBluetooth.begin(); it != m_ListDeviceBluetooth.end(); ++it) {
-        DeviceBluetooth *bt = dynamic_cast<DeviceBluetooth *>(*it);
-        if (bt && bt->uniqueID() == unique_id) {
-            return *it;
+    m_IndexBluetooth.sync(m_ListDeviceBluetooth);
+    foreach (DeviceBaseInfo *bt, m_IndexBluetooth.find(DeviceIndex::IK_UniqueID, DeviceIndex::uniqueIDKey(unique_id))) {
+        if (bt->uniqueID() == unique_id) {
+            return bt;
         }
     }
     return nullptr;
@@ -990,11 +1229,13 @@ DeviceBaseInfo *DeviceManager::getBluetoothDevice(const QString &unique_id)
 void DeviceManager::addAudioDevice(DeviceAudio *const device)
 {
     m_ListDeviceAudio.append(device);
+    m_IndexAudio.insert(device);
 }
 
 void DeviceManager::delAudioDevice(DeviceAudio *const device)
 {
     m_ListDeviceAudio.removeOne(device);
+    m_IndexAudio.remove(device);
 }
 
 void DeviceManager::deleteDisableDuplicate_AudioDevice(void)
@@ -1008,8 +1249,10 @@ void DeviceManager::deleteDisableDuplicate_AudioDevice(void)
                 for (QList<DeviceBaseInfo *>::iterator it2 = m_ListDeviceAudio.begin(); it2 != m_ListDeviceAudio.end(); ++it2) {
                     DeviceAudio *audio_2 = dynamic_cast<DeviceAudio *>(*it2);
                     if (audio_2->name() == audio_1->name())
-                        if (audio_2->enable())
+                        if (audio_2->enable()) {
                             m_ListDeviceAudio.removeOne(audio_2);
+                            m_IndexAudio.remove(audio_2);
+                        }
                 }
             }
         }
@@ -1019,29 +1262,22 @@ void DeviceManager::deleteDisableDuplicate_AudioDevice(void)
 
 DeviceBaseInfo *DeviceManager::getAudioDevice(const QString &path)
 {
-    for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceAudio.begin(); it != m_ListDeviceAudio.end(); ++it) {
-        DeviceAudio *audio = dynamic_cast<DeviceAudio *>(*it);
-        QString tpath = audio->uniqueID();
+    m_IndexAudio.sync(m_ListDeviceAudio);
+
+    // 唯一值、sysfs路径、toml Modalias、VIDAndPID 任一相同即为重复设备,取列表中最靠前的一个
+    QList<DeviceBaseInfo *> candidates;
+    candidates += m_IndexAudio.find(DeviceIndex::IK_UniqueID, path);
+    candidates += m_IndexAudio.find(DeviceIndex::IK_SysPath, path);
+    candidates += m_IndexAudio.find(DeviceIndex::IK_Modalias, DeviceIndex::modaliasKey(path));
+    candidates += m_IndexAudio.find(DeviceIndex::IK_VIDAndPID, path);
+
+    foreach (DeviceBaseInfo *audio, m_IndexAudio.ordered(candidates)) {
         // 判断该设备是否已经存在，1.1:1.1 -> 1.1:1.0
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-        if (audio && path == tpath.replace(QRegExp("[1-9]$"), "0")) {
-#else
-        if (audio && path == tpath.replace(QRegularExpression("[1-9]$"), "0")) {
-#endif
-            return *it;
-        }
-        QString syspath = audio->sysPath();   //remove dumplicate syspath
-        if (audio && path == syspath) {
-            return *it;
-        }
-        //remove dumplicate by toml Modalias
-        QString Modalias =  audio->getModalias();
-        if (audio && path == Modalias) {
-            return *it;
-        }
-        QString vidpid =  audio->getVIDAndPID();
-        if (audio && path == vidpid) {
-            return *it;
+        if (path == DeviceIndex::uniqueIDKey(audio->uniqueID())
+                || path == audio->sysPath()
+                || path == audio->getModalias()
+                || path == audio->getVIDAndPID()) {
+            return audio;
         }
     }
     return nullptr;
@@ -1078,6 +1314,7 @@ void DeviceManager::addNetworkDevice(DeviceNetwork *const device)
 {
     // 添加网络适配器
     m_ListDeviceNetwork.append(device);
+    m_IndexNetwork.insert(device);
 }
 
 bool DeviceManager::setNetworkInfoFromWifiInfo(const QMap<QString, QString> &mapInfo)
@@ -1098,10 +1335,13 @@ bool DeviceManager::setNetworkInfoFromWifiInfo(const QMap<QString, QString> &map
 
 DeviceBaseInfo *DeviceManager::getNetworkDevice(const QString &unique_id)
 {
-    for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceNetwork.begin(); it != m_ListDeviceNetwork.end(); ++it) {
-        DeviceNetwork *net = dynamic_cast<DeviceNetwork *>(*it);
-        if (!unique_id.isEmpty() && net && net->uniqueID() == unique_id) {
-            return *it;
+    if (unique_id.isEmpty()) {
+        return nullptr;
+    }
+    m_IndexNetwork.sync(m_ListDeviceNetwork);
+    foreach (DeviceBaseInfo *net, m_IndexNetwork.find(DeviceIndex::IK_UniqueID, DeviceIndex::uniqueIDKey(unique_id))) {
+        if (net->uniqueID() == unique_id) {
+            return net;
         }
     }
     return nullptr;
@@ -1121,6 +1361,15 @@ void DeviceManager::correctNetworkLinkStatus(QString linkStatus, QString network
     }
 }
 
+void DeviceManager::correctNetworkSpeed(const QString &speed, const QString &networkDriver)
+{
+    foreach (DeviceBaseInfo *info, m_ListDeviceNetwork) {
+        DeviceNetwork *device = dynamic_cast<DeviceNetwork *>(info);
+        if (device && networkDriver == device->logicalName())
+            device->correctCurrentSpeed(speed);
+    }
+}
+
 QStringList DeviceManager::networkDriver()
 {
     m_networkDriver.clear();
@@ -1155,14 +1404,15 @@ void DeviceManager::addImageDevice(DeviceImage *const device)
 {
     // 添加图像设备
     m_ListDeviceImage.append(device);
+    m_IndexImage.insert(device);
 }
 
 DeviceBaseInfo *DeviceManager::getImageDevice(const QString &unique_id)
 {
-    for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceImage.begin(); it != m_ListDeviceImage.end(); ++it) {
-        DeviceImage *image = dynamic_cast<DeviceImage *>(*it);
-        if (image && image->uniqueID() == unique_id) {
-            return *it;
+    m_IndexImage.sync(m_ListDeviceImage);
+    foreach (DeviceBaseInfo *image, m_IndexImage.find(DeviceIndex::IK_UniqueID, DeviceIndex::uniqueIDKey(unique_id))) {
+        if (image->uniqueID() == unique_id) {
+            return image;
         }
     }
     return nullptr;
@@ -1218,8 +1468,10 @@ void DeviceManager::addOthersDevice(DeviceOthers *const device)
     }
 
     // 添加其他设备
-    if (isOtherDevice)
+    if (isOtherDevice) {
         m_ListDeviceOthers.append(device);
+        m_IndexOthers.insert(device);
+    }
 }
 
 DeviceBaseInfo *DeviceManager::getOthersDevice(const QString &unique_id)
@@ -1227,10 +1479,10 @@ DeviceBaseInfo *DeviceManager::getOthersDevice(const QString &unique_id)
     if (unique_id.isEmpty()) {
         return nullptr;
     }
-    for (QList<DeviceBaseInfo *>::iterator it = m_ListDeviceOthers.begin(); it != m_ListDeviceOthers.end(); ++it) {
-        DeviceOthers *other = dynamic_cast<DeviceOthers *>(*it);
-        if (other && other->uniqueID() == unique_id) {
-            return *it;
+    m_IndexOthers.sync(m_ListDeviceOthers);
+    foreach (DeviceBaseInfo *other, m_IndexOthers.find(DeviceIndex::IK_UniqueID, DeviceIndex::uniqueIDKey(unique_id))) {
+        if (other->uniqueID() == unique_id) {
+            return other;
         }
     }
     return nullptr;
@@ -1248,6 +1500,7 @@ void DeviceManager::addOthersDeviceFromHwinfo(DeviceOthers *const device)
             return;
     }
     m_ListDeviceOthers.append(device);
+    m_IndexOthers.insert(device);
 }
 
 void DeviceManager::setOthersDeviceInfoFromLshw(const QMap<QString, QString> &mapInfo)
@@ -1356,83 +1609,37 @@ bool DeviceManager::exportToTxt(const QString &filePath)
 
     QTextStream out(&txtFile);
     overviewToTxt(out);
-    EXPORT_TO_TXT(out, m_ListDeviceCPU, QObject::tr("CPU"), QObject::tr("No CPU found"));
-    EXPORT_TO_TXT(out, m_ListDeviceBios, QObject::tr("Motherboard"), QObject::tr("No motherboard found"));
-    EXPORT_TO_TXT(out, m_ListDeviceMemory, QObject::tr("Memory"), QObject::tr("No memory found"));
-    EXPORT_TO_TXT(out, m_ListDeviceStorage, QObject::tr("Storage"), QObject::tr("No disk found"));
-    EXPORT_TO_TXT(out, m_ListDeviceGPU, QObject::tr("Display Adapter"), QObject::tr("No GPU found"));
-    EXPORT_TO_TXT(out, m_ListDeviceMonitor, QObject::tr("Monitor"), QObject::tr("No monitor found"));
-    EXPORT_TO_TXT(out, m_ListDeviceNetwork, QObject::tr("Network Adapter"), QObject::tr("No network adapter found"));
-    EXPORT_TO_TXT(out, m_ListDeviceAudio, QObject::tr("Sound Adapter"), QObject::tr("No audio device found"));
-    EXPORT_TO_TXT(out, m_ListDeviceBluetooth, QObject::tr("Bluetooth"), QObject::tr("No Bluetooth device found"));
-    EXPORT_TO_TXT(out, m_ListDeviceOtherPCI, QObject::tr("Other PCI Devices"), QObject::tr("No other PCI devices found"));
-    EXPORT_TO_TXT(out, m_ListDevicePower, QObject::tr("Power"), QObject::tr("No battery found"));
-    EXPORT_TO_TXT(out, m_ListDeviceKeyboard, QObject::tr("Keyboard"), QObject::tr("No keyboard found"));
-    EXPORT_TO_TXT(out, m_ListDeviceMouse, QObject::tr("Mouse"), QObject::tr("No mouse found"));
-    EXPORT_TO_TXT(out, m_ListDevicePrint, QObject::tr("Printer"), QObject::tr("No printer found"));
-    EXPORT_TO_TXT(out, m_ListDeviceImage, QObject::tr("Camera"), QObject::tr("No camera found"));
-    EXPORT_TO_TXT(out, m_ListDeviceCdrom, QObject::tr("CD-ROM"), QObject::tr("No CD-ROM found"));
-    EXPORT_TO_TXT(out, m_ListDeviceOthers, QObject::tr("Other Devices"), QObject::tr("No other devices found"));
+    bool finished = renderCategories(EF_Txt, [&out](const QByteArray & fragment) {
+        out << QString::fromUtf8(fragment);
+    });
+    out.flush();
     txtFile.close();
 
-    return true;
+    return finished;
 }
 
 bool DeviceManager::exportToXlsx(const QString &filePath)
 {
-    // 导出设备信息到xlsx表格
-    QXlsx::Document xlsx;
-    QXlsx::Format boldFont;
-    overviewToXlsx(xlsx, boldFont);
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceCPU, QObject::tr("CPU"), QObject::tr("No CPU found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceBios, QObject::tr("Motherboard"), QObject::tr("No motherboard found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceMemory, QObject::tr("Memory"), QObject::tr("No memory found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceStorage, QObject::tr("Storage"), QObject::tr("No disk found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceGPU, QObject::tr("Display Adapter"), QObject::tr("No GPU found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceMonitor, QObject::tr("Monitor"), QObject::tr("No monitor found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceNetwork, QObject::tr("Network Adapter"), QObject::tr("No network adapter found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceAudio, QObject::tr("Sound Adapter"), QObject::tr("No audio device found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceBluetooth, QObject::tr("Bluetooth"), QObject::tr("No Bluetooth device found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceOtherPCI, QObject::tr("Other PCI Devices"), QObject::tr("No other PCI devices found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDevicePower, QObject::tr("Power"), QObject::tr("No battery found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceKeyboard, QObject::tr("Keyboard"), QObject::tr("No keyboard found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceMouse, QObject::tr("Mouse"), QObject::tr("No mouse found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDevicePrint, QObject::tr("Printer"), QObject::tr("No printer found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceImage, QObject::tr("Camera"), QObject::tr("No camera found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceCdrom, QObject::tr("CD-ROM"), QObject::tr("No CD-ROM found"));
-    EXPORT_TO_XLSX(xlsx, boldFont, m_ListDeviceOthers, QObject::tr("Other Devices"), QObject::tr("No other devices found"));
-    m_CurrentXlsRow = 1;
-    xlsx.saveAs(filePath);
+    // 导出设备信息到xlsx表格,按行流式写出
+    XlsxStreamWriter xlsx(filePath);
+    overviewToXlsx(xlsx);
+    bool finished = renderCategories(EF_Xlsx, [&xlsx](const QByteArray & fragment) {
+        xlsx.appendFragment(fragment);
+    });
 
-    return true;
+    return finished && xlsx.save();
 }
 
 bool DeviceManager::exportToDoc(const QString &filePath)
 {
-    // 导出设备信息到doc文件
-    Docx::Document doc(":/template.docx");
+    // 导出设备信息到doc文件,正文直接流式写入 document.xml
+    DocxStreamWriter doc(filePath);
     overviewToDoc(doc);
-    EXPORT_TO_DOC(doc, m_ListDeviceCPU, QObject::tr("CPU"), QObject::tr("No CPU found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceBios, QObject::tr("Motherboard"), QObject::tr("No motherboard found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceMemory, QObject::tr("Memory"), QObject::tr("No memory found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceStorage, QObject::tr("Storage"), QObject::tr("No disk found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceGPU, QObject::tr("Display Adapter"), QObject::tr("No GPU found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceMonitor, QObject::tr("Monitor"), QObject::tr("No monitor found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceNetwork, QObject::tr("Network Adapter"), QObject::tr("No network adapter found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceAudio, QObject::tr("Sound Adapter"), QObject::tr("No audio device found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceBluetooth, QObject::tr("Bluetooth"), QObject::tr("No Bluetooth device found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceOtherPCI, QObject::tr("Other PCI Devices"), QObject::tr("No other PCI devices found"));
-    EXPORT_TO_DOC(doc, m_ListDevicePower, QObject::tr("Power"), QObject::tr("No battery found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceKeyboard, QObject::tr("Keyboard"), QObject::tr("No keyboard found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceMouse, QObject::tr("Mouse"), QObject::tr("No mouse found"));
-    EXPORT_TO_DOC(doc, m_ListDevicePrint, QObject::tr("Printer"), QObject::tr("No printer found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceImage, QObject::tr("Camera"), QObject::tr("No camera found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceCdrom, QObject::tr("CD-ROM"), QObject::tr("No CD-ROM found"));
-    EXPORT_TO_DOC(doc, m_ListDeviceOthers, QObject::tr("Other Devices"), QObject::tr("No other devices found"));
-
-    doc.save(filePath);
+    bool finished = renderCategories(EF_Doc, [&doc](const QByteArray & fragment) {
+        doc.addFragment(fragment);
+    });
 
-    return true;
+    return finished && doc.save();
 }
 
 bool DeviceManager::exportToHtml(const QString &filePath)
@@ -1447,36 +1654,223 @@ bool DeviceManager::exportToHtml(const QString &filePath)
     html.write("<body>\n");
 
     overviewToHtml(html);
+    bool finished = renderCategories(EF_Html, [&html](const QByteArray & fragment) {
+        html.write(fragment);
+    });
 
-    EXPORT_TO_HTML(html, m_ListDeviceCPU, QObject::tr("CPU"), QObject::tr("No CPU found"));
-    EXPORT_TO_HTML(html, m_ListDeviceBios, QObject::tr("Motherboard"), QObject::tr("No motherboard found"));
-    EXPORT_TO_HTML(html, m_ListDeviceMemory, QObject::tr("Memory"), QObject::tr("No memory found"));
-    EXPORT_TO_HTML(html, m_ListDeviceStorage, QObject::tr("Storage"), QObject::tr("No disk found"));
-    EXPORT_TO_HTML(html, m_ListDeviceGPU, QObject::tr("Display Adapter"), QObject::tr("No GPU found"));
-    EXPORT_TO_HTML(html, m_ListDeviceMonitor, QObject::tr("Monitor"), QObject::tr("No monitor found"));
-    EXPORT_TO_HTML(html, m_ListDeviceNetwork, QObject::tr("Network Adapter"), QObject::tr("No network adapter found"));
-    EXPORT_TO_HTML(html, m_ListDeviceAudio, QObject::tr("Sound Adapter"), QObject::tr("No audio device found"));
-    EXPORT_TO_HTML(html, m_ListDeviceBluetooth, QObject::tr("Bluetooth"), QObject::tr("No Bluetooth device found"));
-    EXPORT_TO_HTML(html, m_ListDeviceOtherPCI, QObject::tr("Other PCI Devices"), QObject::tr("No other PCI devices found"));
-    EXPORT_TO_HTML(html, m_ListDevicePower, QObject::tr("Power"), QObject::tr("No battery found"));
-    EXPORT_TO_HTML(html, m_ListDeviceKeyboard, QObject::tr("Keyboard"), QObject::tr("No keyboard found"));
-    EXPORT_TO_HTML(html, m_ListDeviceMouse, QObject::tr("Mouse"), QObject::tr("No mouse found"));
-    EXPORT_TO_HTML(html, m_ListDevicePrint, QObject::tr("Printer"), QObject::tr("No printer found"));
-    EXPORT_TO_HTML(html, m_ListDeviceImage, QObject::tr("Camera"), QObject::tr("No camera found"));
-    EXPORT_TO_HTML(html, m_ListDeviceCdrom, QObject::tr("CD-ROM"), QObject::tr("No CD-ROM found"));
-    EXPORT_TO_HTML(html, m_ListDeviceOthers, QObject::tr("Other Devices"), QObject::tr("No other devices found"));
-
-    html.write("</body>\n");                                                \
+    html.write("</body>\n");
     html.write("</html>\n");
 
     html.close();
 
-    return true;
+    return finished && html.error() == QFileDevice::NoError;
+}
+
+bool DeviceManager::exportToJson(const QString &filePath)
+{
+    return exportToRecords(filePath, DeviceRecordWriter::RF_Json);
+}
+
+bool DeviceManager::exportToCbor(const QString &filePath)
+{
+    return exportToRecords(filePath, DeviceRecordWriter::RF_Cbor);
+}
+
+bool DeviceManager::exportToRecords(const QString &filePath, DeviceRecordWriter::RecordFormat format)
+{
+    QFile file(filePath);
+    if (false == file.open(QIODevice::WriteOnly))
+        return false;
+
+    // 类别名与命令行 --dump --type 一致
+    QStringList unknown;
+    QList<DeviceDumper::DumpCategory> categories = DeviceDumper::categories(QStringList(), unknown);
+
+    int total = 0;
+    foreach (const DeviceDumper::DumpCategory &category, categories) {
+        QList<DeviceBaseInfo *> *lst = convertDeviceListAddr(category.type);
+        if (lst)
+            total += lst->size();
+    }
+
+    int written = 0;
+    if (m_ExportObserver && !m_ExportObserver(written, total))
+        return false;
+
+    // 逐个设备写出,不在内存中生成整个文档
+    DeviceRecordWriter writer(&file, format);
+    foreach (const DeviceDumper::DumpCategory &category, categories) {
+        QList<DeviceBaseInfo *> *lst = convertDeviceListAddr(category.type);
+        if (!lst)
+            continue;
+        foreach (DeviceBaseInfo *device, *lst)
+            writer.writeDevice(category.id, device);
+
+        written += lst->size();
+        if (m_ExportObserver && !m_ExportObserver(written, total))
+            return false;
+    }
+
+    bool ok = writer.finish();
+    file.close();
+    return ok && file.error() == QFileDevice::NoError;
+}
+
+void DeviceManager::setExportThreadCount(int count)
+{
+    m_ExportThreadCount = qMax(1, count);
+}
+
+void DeviceManager::setExportObserver(const std::function<bool(int, int)> &observer)
+{
+    m_ExportObserver = observer;
+}
+
+QList<DeviceManager::ExportCategory> DeviceManager::exportCategories()
+{
+    // 导出顺序与界面中的设备类型顺序一致
+    QList<ExportCategory> categories;
+    categories.append(ExportCategory(m_ListDeviceCPU, QObject::tr("CPU"), QObject::tr("No CPU found")));
+    categories.append(ExportCategory(m_ListDeviceBios, QObject::tr("Motherboard"), QObject::tr("No motherboard found")));
+    categories.append(ExportCategory(m_ListDeviceMemory, QObject::tr("Memory"), QObject::tr("No memory found")));
+    categories.append(ExportCategory(m_ListDeviceStorage, QObject::tr("Storage"), QObject::tr("No disk found")));
+    categories.append(ExportCategory(m_ListDeviceGPU, QObject::tr("Display Adapter"), QObject::tr("No GPU found")));
+    categories.append(ExportCategory(m_ListDeviceMonitor, QObject::tr("Monitor"), QObject::tr("No monitor found")));
+    categories.append(ExportCategory(m_ListDeviceNetwork, QObject::tr("Network Adapter"), QObject::tr("No network adapter found")));
+    categories.append(ExportCategory(m_ListDeviceAudio, QObject::tr("Sound Adapter"), QObject::tr("No audio device found")));
+    categories.append(ExportCategory(m_ListDeviceBluetooth, QObject::tr("Bluetooth"), QObject::tr("No Bluetooth device found")));
+    categories.append(ExportCategory(m_ListDeviceOtherPCI, QObject::tr("Other PCI Devices"), QObject::tr("No other PCI devices found")));
+    categories.append(ExportCategory(m_ListDevicePower, QObject::tr("Power"), QObject::tr("No battery found")));
+    categories.append(ExportCategory(m_ListDeviceKeyboard, QObject::tr("Keyboard"), QObject::tr("No keyboard found")));
+    categories.append(ExportCategory(m_ListDeviceMouse, QObject::tr("Mouse"), QObject::tr("No mouse found")));
+    categories.append(ExportCategory(m_ListDevicePrint, QObject::tr("Printer"), QObject::tr("No printer found")));
+    categories.append(ExportCategory(m_ListDeviceImage, QObject::tr("Camera"), QObject::tr("No camera found")));
+    categories.append(ExportCategory(m_ListDeviceCdrom, QObject::tr("CD-ROM"), QObject::tr("No CD-ROM found")));
+    categories.append(ExportCategory(m_ListDeviceOthers, QObject::tr("Other Devices"), QObject::tr("No other devices found")));
+    return categories;
+}
+
+QByteArray DeviceManager::renderCategory(ExportFormat format, const ExportCategory &category)
+{
+    // 每类设备渲染为独立的片段,只访问本类设备,可以在工作线程中执行
+    const QList<DeviceBaseInfo *> &deviceLst = category.devices;
+    QByteArray fragment;
+
+    switch (format) {
+    case EF_Txt: {
+        QString text;
+        QTextStream out(&text);
+        EXPORT_TO_TXT(out, deviceLst, category.title, category.msg);
+        out.flush();
+        fragment = text.toUtf8();
+        break;
+    }
+    case EF_Html: {
+        QBuffer html(&fragment);
+        html.open(QIODevice::WriteOnly);
+        EXPORT_TO_HTML(html, deviceLst, category.title, category.msg);
+        break;
+    }
+    case EF_Doc: {
+        QBuffer buffer(&fragment);
+        buffer.open(QIODevice::WriteOnly);
+        DocxStreamWriter doc(&buffer);
+        EXPORT_TO_DOC(doc, deviceLst, category.title, category.msg);
+        doc.save();
+        break;
+    }
+    case EF_Xlsx: {
+        XlsxStreamWriter xlsx;
+        EXPORT_TO_XLSX(xlsx, deviceLst, category.title, category.msg);
+        fragment = xlsx.takeFragment();
+        break;
+    }
+    case EF_Json:
+    case EF_Cbor:
+        // 结构化格式由 exportToRecords 按设备流式写出,不分片渲染
+        break;
+    }
+
+    return fragment;
+}
+
+bool DeviceManager::renderCategories(ExportFormat format, const std::function<void(const QByteArray &)> &writer)
+{
+    QList<ExportCategory> categories = exportCategories();
+
+    int total = 0;
+    foreach (const ExportCategory &category, categories)
+        total += category.devices.size();
+
+    int written = 0;
+    if (m_ExportObserver && !m_ExportObserver(written, total))
+        return false;
+
+    // 单线程时按顺序渲染并写出
+    if (m_ExportThreadCount <= 1) {
+        foreach (const ExportCategory &category, categories) {
+            writer(renderCategory(format, category));
+            written += category.devices.size();
+            if (m_ExportObserver && !m_ExportObserver(written, total))
+                return false;
+        }
+        return true;
+    }
+
+    // 属性缓存在首次获取时生成,先在当前线程中生成,渲染任务只读取缓存,不会同时写同一个设备
+    // 由界面导出时缓存已由 prepareExport 生成,这里不再修改设备
+    foreach (const ExportCategory &category, categories)
+        loadExportAttribs(category.devices);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(m_ExportThreadCount);
+
+    QList<ExportTask *> tasks;
+    foreach (const ExportCategory &category, categories)
+        tasks.append(new ExportTask(format, category));
+
+    // 最多领先写出进度 m_ExportThreadCount 个类别,已渲染未写出的片段数不超过线程数
+    int started = 0;
+    for (; started < tasks.size() && started < m_ExportThreadCount; ++started)
+        pool.start(tasks[started]);
+
+    // 按导出顺序取片段,取走一个再开始下一个类别的渲染,写出后即释放
+    bool finished = true;
+    for (int i = 0; i < tasks.size(); ++i) {
+        QByteArray fragment = tasks[i]->takeFragment();
+        if (started < tasks.size())
+            pool.start(tasks[started++]);
+        writer(fragment);
+        fragment.clear();
+        written += categories[i].devices.size();
+        if (m_ExportObserver && !m_ExportObserver(written, total)) {
+            // 取消导出,未开始的任务不再执行
+            pool.clear();
+            finished = false;
+            break;
+        }
+    }
+
+    pool.waitForDone();
+    qDeleteAll(tasks);
+    return finished;
 }
 
-int DeviceManager::currentXlsRow()
+void DeviceManager::prepareExport()
 {
-    return m_CurrentXlsRow++;
+    // 界面显示设备时也会生成属性缓存,导出前统一生成,导出期间两边都只读取
+    for (int type = DT_Audio; type <= DT_Others; ++type)
+        loadExportAttribs(*convertDeviceListAddr(DeviceType(type)));
+}
+
+void DeviceManager::loadExportAttribs(const QList<DeviceBaseInfo *> &deviceLst)
+{
+    foreach (DeviceBaseInfo *device, deviceLst) {
+        device->getBaseAttribs();
+        device->getOtherAttribs();
+        device->getTableHeader();
+        device->getTableData();
+    }
 }
 
 void DeviceManager::overviewToTxt(QTextStream &out)
@@ -1520,17 +1914,16 @@ void DeviceManager::overviewToTxt(QTextStream &out)
 
 
 
-void DeviceManager::overviewToHtml(QFile &html)
+void DeviceManager::overviewToHtml(QIODevice &html)
 {
     // 导出概况信息到html
-    html.write((QString("<h2>") + "[" + tr("Overview") + "]" + "</h2>").toUtf8());
-    QDomDocument doc;
+    html.write((QString("<h2>") + "[" + tr("Overview").toHtmlEscaped() + "]" + "</h2>").toUtf8());
 
     // 导出设备信息到html
-    infoToHtml(doc, "Device", m_OveriewMap["Overview"]);
+    infoToHtml(html, "Device", m_OveriewMap["Overview"]);
 
     // 导出操作系统信息到html
-    infoToHtml(doc, "OS", m_OveriewMap["OS"]);
+    infoToHtml(html, "OS", m_OveriewMap["OS"]);
 
     // 导出设备概况信息到html
     foreach (auto iter, m_ListDeviceType) {
@@ -1538,14 +1931,13 @@ void DeviceManager::overviewToHtml(QFile &html)
             continue;
 
         if (m_OveriewMap.find(iter.first) != m_OveriewMap.end())
-            infoToHtml(doc, iter.first, m_OveriewMap[iter.first]);
+            infoToHtml(html, iter.first, m_OveriewMap[iter.first]);
     }
 
-    doc.appendChild(doc.createElement("br"));
-    html.write(doc.toString().toStdString().data());
+    html.write("<br/>\n");
 }
 
-void DeviceManager::overviewToDoc(Docx::Document &doc)
+void DeviceManager::overviewToDoc(DocxStreamWriter &doc)
 {
     // 导出概况信息到doc文件
     doc.addHeading("[" + tr("Overview") + "]");
@@ -1572,23 +1964,20 @@ void DeviceManager::overviewToDoc(Docx::Document &doc)
     doc.addParagraph("\n");
 }
 
-void DeviceManager::overviewToXlsx(QXlsx::Document &xlsx, QXlsx::Format &boldFont)
+void DeviceManager::overviewToXlsx(XlsxStreamWriter &xlsx)
 {
     // 导出概况信息到xlsx文件
-    boldFont.setFontBold(true);
-    xlsx.write(m_CurrentXlsRow++, 1, "[" + tr("Overview") + "]", boldFont);
-
-    // 设置字体格式
-    boldFont.setFontBold(false);
-    boldFont.setFontSize(10);
+    xlsx.write(xlsx.nextRow(), 1, "[" + tr("Overview") + "]", XlsxStreamWriter::CS_Bold);
 
     // 导出设备信息到xlsx文件
-    xlsx.write(m_CurrentXlsRow, 1, tr("Device"), boldFont);
-    xlsx.write(m_CurrentXlsRow++, 2, m_OveriewMap["Overview"], boldFont);
+    int row = xlsx.nextRow();
+    xlsx.write(row, 1, tr("Device"), XlsxStreamWriter::CS_Small);
+    xlsx.write(row, 2, m_OveriewMap["Overview"], XlsxStreamWriter::CS_Small);
 
     // 导出操作系统信息到xlsx文件
-    xlsx.write(m_CurrentXlsRow, 1, tr("OS"), boldFont);
-    xlsx.write(m_CurrentXlsRow++, 2, m_OveriewMap["OS"], boldFont);
+    row = xlsx.nextRow();
+    xlsx.write(row, 1, tr("OS"), XlsxStreamWriter::CS_Small);
+    xlsx.write(row, 2, m_OveriewMap["OS"], XlsxStreamWriter::CS_Small);
 
     // 导出设备概况信息到xlsx文件
     foreach (auto iter, m_ListDeviceType) {
@@ -1596,50 +1985,22 @@ void DeviceManager::overviewToXlsx(QXlsx::Document &xlsx, QXlsx::Format &boldFon
             continue;
 
         if (m_OveriewMap.find(iter.first) != m_OveriewMap.end()) {
-
-            xlsx.write(m_CurrentXlsRow, 1, iter.first, boldFont);
-            xlsx.write(m_CurrentXlsRow++, 2, m_OveriewMap[iter.first], boldFont);
+            row = xlsx.nextRow();
+            xlsx.write(row, 1, iter.first, XlsxStreamWriter::CS_Small);
+            xlsx.write(row, 2, m_OveriewMap[iter.first], XlsxStreamWriter::CS_Small);
         }
     }
-    m_CurrentXlsRow++;
+    xlsx.nextRow();
 }
 
-void DeviceManager::infoToHtml(QDomDocument &doc, const QString &key, const QString &value)
+void DeviceManager::infoToHtml(QIODevice &html, const QString &key, const QString &value)
 {
-    // 导出设备信息到html
-    // 创建表格,设置表格属性
-    QDomElement table = doc.createElement("table");
-    table.setAttribute("border", "0");
-    table.setAttribute("width", "100%");
-    table.setAttribute("cellpadding", "3");
-
-    QDomElement tr = doc.createElement("tr");
-
-    // 创建单元格,设置单元格属性
-    QDomElement td = doc.createElement("td");
-    td.setAttribute("width", "15%");
-    td.setAttribute("style", "text-align:left;");
-
-    // 设置单元格内容
-    QDomText nameText = doc.createTextNode(QObject::tr(key.toStdString().c_str()) + ": ");
-    td.appendChild(nameText);
-    tr.appendChild(td);
-
-    // 创建单元格,设置单元格属性
-    QDomElement td2 = doc.createElement("td");
-    td2.setAttribute("width", "85%");
-
-    // 设置单元格内容
-    QDomText valueText;
-    valueText = doc.createTextNode(value);
-    td2.appendChild(valueText);
-
-    tr.appendChild(td2);
-
-    // 插入表格
-    table.appendChild(tr);
-
-    doc.appendChild(table);
+    // 导出设备信息到html,每条信息为一个单行表格
+    QString table = "<table border=\"0\" width=\"100%\" cellpadding=\"3\"><tr>"
+                    "<td width=\"15%\" style=\"text-align:left;\">" + (QObject::tr(key.toStdString().c_str()) + ": ").toHtmlEscaped() + "</td>"
+                    "<td width=\"85%\">" + value.toHtmlEscaped() + "</td>"
+                    "</tr></table>\n";
+    html.write(table.toUtf8());
 }
 
 const QMap<QString, QString>  &DeviceManager::getDeviceOverview()
@@ -1670,18 +2031,25 @@ const QMap<QString, QString>  &DeviceManager::getDeviceOverview()
     }
 
     // 设备名称 and 操作系统
-    if (m_ListDeviceComputer.size() > 0) {
-        m_OveriewMap["Overview"] = m_ListDeviceComputer[0]->getOverviewInfo();
-        m_OveriewMap["OS"] = dynamic_cast<DeviceComputer *>(m_ListDeviceComputer[0])->getOSInfo();
+    if (m_ShownComputer.size() > 0) {
+        m_OveriewMap["Overview"] = m_ShownComputer[0]->getOverviewInfo();
+        // 由快照恢复的计算机设备不是 DeviceComputer
+        DeviceComputer *computer = dynamic_cast<DeviceComputer *>(m_ShownComputer[0]);
+        DeviceSnapshotInfo *snapshot = qobject_cast<DeviceSnapshotInfo *>(m_ShownComputer[0]);
+        if (computer)
+            m_OveriewMap["OS"] = computer->getOSInfo();
+        else if (snapshot)
+            m_OveriewMap["OS"] = snapshot->osInfo();
     }
 
 
     // CPU 概况显示 样式"Intel(R) Core(TM) i3-9100F CPU @ 3.60GHz (四核 / 四逻辑处理器)"
-    if (!m_ListDeviceCPU.isEmpty())
-        m_OveriewMap[tr("CPU")] = m_ListDeviceCPU[0] ->getOverviewInfo();
+    const QList<DeviceBaseInfo *> lstCpu = m_DeviceClassMap.value(tr("CPU"));
+    if (!lstCpu.isEmpty())
+        m_OveriewMap[tr("CPU")] = lstCpu[0]->getOverviewInfo();
 
-    if (m_CpuNum > 1)
-        m_OveriewMap[tr("CPU quantity")] = QString::number(m_CpuNum);
+    if (m_ShownCpuNum > 1)
+        m_OveriewMap[tr("CPU quantity")] = QString::number(m_ShownCpuNum);
 
     return m_OveriewMap;
 }
@@ -1739,6 +2107,11 @@ void DeviceManager::setCpuNum(int num)
     m_CpuNum = num;
 }
 
+int DeviceManager::cpuNum() const
+{
+    return m_CpuNum;
+}
+
 void DeviceManager::setCpuFrequencyIsCur(const bool &flag)
 {
     QList<DeviceBaseInfo *>::iterator it = m_ListDeviceCPU.begin();
@@ -1750,3 +2123,16 @@ void DeviceManager::setCpuFrequencyIsCur(const bool &flag)
         device->setFrequencyIsCur(flag);
     }
 }
+
+void DeviceManager::setCpuSampledFreq(const QMap<QString, QPair<QString, QString>> &mapFreq)
+{
+    foreach (DeviceBaseInfo *info, m_ListDeviceCPU) {
+        DeviceCpu *device = dynamic_cast<DeviceCpu *>(info);
+        if (!device)
+            continue;
+
+        auto it = mapFreq.find(device->physicalID());
+        if (it != mapFreq.end())
+            device->setSampledFreq(it.value().first, it.value().second);
+    }
+}
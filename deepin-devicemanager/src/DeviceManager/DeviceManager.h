@@ -6,17 +6,22 @@
 #ifndef DEVICEMANAGER_H
 #define DEVICEMANAGER_H
 
-#include "document.h"
-#include "xlsxdocument.h"
+#include "DocxStreamWriter.h"
+#include "XlsxStreamWriter.h"
+#include "DeviceRecordWriter.h"
 #include "GenerateDevicePool.h"
+#include "DeviceIndex.h"
+#include "DeviceSearchIndex.h"
 
 #include <QList>
 #include <QMap>
+#include <QSet>
 #include <QMutex>
-#include <QDomDocument>
 #include <QObject>
 #include <QFile>
 
+#include <functional>
+
 //class DeviceMouse;
 class DeviceCpu;
 class DeviceStorage;
@@ -49,6 +54,19 @@ enum TomlFixMethod {
     TOML_Del   //去掉该设备
 };
 
+/**
+ * @brief The TomlRule struct
+ * 预处理后的toml匹配规则,硬件标识在加载时规范化一次
+ */
+struct TomlRule {
+    QString modalias;          //<! 小写 modalias
+    QString vid;               //<! 小写 Vendor_ID
+    QString pid;               //<! 小写 Product_ID
+    QString vendor;            //<! 小写 Vendor
+    QString name;              //<! 小写 Name
+    QStringList vidWindows;    //<! 自定义 modalias 中所有 4 位子串,用于按 vid 查找设备
+};
+
 /**
  * @brief The DeviceManager class
  * 设备的管理类(包括设备的获取、增加、修改)
@@ -58,6 +76,30 @@ class DeviceManager : public QObject
 {
     Q_OBJECT
 public:
+    /**
+     * @brief The ExportFormat enum 导出格式
+     */
+    enum ExportFormat {
+        EF_Txt  = 0,
+        EF_Html = 1,
+        EF_Doc  = 2,
+        EF_Xlsx = 3,
+        EF_Json = 4,
+        EF_Cbor = 5
+    };
+
+    /**
+     * @brief The ExportCategory struct 导出的一类设备
+     */
+    struct ExportCategory {
+        ExportCategory(const QList<DeviceBaseInfo *> &lst, const QString &type, const QString &noneMsg)
+            : devices(lst), title(type), msg(noneMsg) {}
+
+        QList<DeviceBaseInfo *>  devices;    //<! 设备列表
+        QString                  title;      //<! 设备类型
+        QString                  msg;        //<! 没有设备时的提示信息
+    };
+
     static DeviceManager *instance()
     {
         if (!sInstance) {
@@ -78,10 +120,22 @@ public:
     const QList<QPair<QString, QString>> &getDeviceTypes();
 
     /**
-     * @brief setDeviceListClass:设置设备信息List的分类
+     * @brief setDeviceListClass:设置设备信息List的分类,设置前先与上一次刷新的设备比对
      */
     void setDeviceListClass();
 
+    /**
+     * @brief mergeLastGeneration:与上一次刷新生成的设备比对,内容未变化的设备复用原对象,其余旧设备释放
+     */
+    void mergeLastGeneration();
+
+    /**
+     * @brief deviceClassChanged:最近一次 setDeviceListClass 后该类设备列表是否变化
+     * @param name:设备类型,与 setDeviceListClass 中的名称一致,概况界面任意一类变化即返回true
+     * @return 是否变化
+     */
+    bool deviceClassChanged(const QString &name);
+
     /**
      * @brief getDeviceList : 获取设备列表
      * @param name : 该设备的类型
@@ -89,6 +143,13 @@ public:
      */
     bool getDeviceList(const QString &name, QList<DeviceBaseInfo *> &lst);
 
+    /**
+     * @brief searchDevices : 按关键字搜索设备,第一次搜索时建立索引,之后只重新登记新增及属性变化的设备
+     * @param text : 搜索内容,多个关键字需全部匹配
+     * @return ：设备类型与匹配的设备,设备顺序与设备列表一致,没有匹配的类型不包含在内
+     */
+    QMap<QString, QList<DeviceBaseInfo *>> searchDevices(const QString &text);
+
    /**
     * @brief convertDeviceListAddr : 获取设备列表地址
     * @param name : 该设备的类型地址
@@ -96,6 +157,13 @@ public:
     */
    QList<DeviceBaseInfo *> *convertDeviceListAddr(DeviceType deviceType);
 
+    /**
+     * @brief convertDeviceIndex : 获取设备索引地址
+     * @param deviceType : 该设备的类型
+     * @return ：返回设备索引地址,该类型没有索引时返回nullptr
+     */
+    DeviceIndex *convertDeviceIndex(DeviceType deviceType);
+
     /**
      * @brief convertDeviceList : 获取设备列表
      * @param name : 该设备的类型
@@ -137,6 +205,22 @@ public:
     bool findByVIDPID(DeviceType deviceType, DeviceBaseInfo *device, const QString &vid, const QString &pid);
     bool findByVendorName(DeviceType deviceType, DeviceBaseInfo *device, const QString &vendor, const QString &name);
 
+    /**
+     * @brief compileTomlRules 将toml信息预处理为匹配规则
+     * @param tomlMapLst 从toml中获取的信息
+     * @return 与tomlMapLst一一对应的匹配规则
+     */
+    QList<TomlRule> compileTomlRules(const QList<QMap<QString, QString>> &tomlMapLst);
+
+    /**
+     * @brief findTomlDevices 通过索引查找与toml规则匹配的设备
+     * @param deviceType 设备类型
+     * @param index 该类型设备的索引
+     * @param rule toml匹配规则
+     * @return 按设备顺序排列的匹配设备
+     */
+    QList<DeviceBaseInfo *> findTomlDevices(DeviceType deviceType, const DeviceIndex &index, const TomlRule &rule);
+
     /**
      * @brief getBluetoothAtIndex 根据索引获取device
      * @param index
@@ -403,6 +487,13 @@ public:
      */
     void correctNetworkLinkStatus(QString linkStatus, QString networkDriver);
 
+    /**
+     * @brief correctNetworkSpeed:校正网卡协商速率
+     * @param speed:速率
+     * @param networkDriver:网卡逻辑名称
+     */
+    void correctNetworkSpeed(const QString &speed, const QString &networkDriver);
+
     /**
      * @brief networkDriver:获取所有网络驱动
      * @return
@@ -572,10 +663,43 @@ public:
     bool exportToHtml(const QString &filePath);
 
     /**
-     * @brief currentXlsRow:获取xlsx当前行
-     * @return xlsx当前行
+     * @brief exportToJson:导出到json,每个设备包含类别、唯一ID、基本信息、其它信息、驱动与启用状态
+     * @param filePath:文件路径
+     * @return true:导出成功，false:导出失败
+     */
+    bool exportToJson(const QString &filePath);
+
+    /**
+     * @brief exportToCbor:导出到cbor,内容与json相同
+     * @param filePath:文件路径
+     * @return true:导出成功，false:导出失败
      */
-    static int currentXlsRow();
+    bool exportToCbor(const QString &filePath);
+
+    /**
+     * @brief setExportThreadCount:设置导出时并行渲染的线程数
+     * @param count:线程数,1表示在导出线程中串行渲染
+     */
+    void setExportThreadCount(int count);
+
+    /**
+     * @brief setExportObserver:设置导出进度回调,在导出线程中调用
+     * @param observer:参数为已写出的设备数和设备总数,返回false时取消导出
+     */
+    void setExportObserver(const std::function<bool(int, int)> &observer);
+
+    /**
+     * @brief prepareExport:在界面线程中生成所有设备的属性缓存,导出线程只读取缓存
+     */
+    void prepareExport();
+
+    /**
+     * @brief renderCategory:将一类设备渲染为导出片段,只访问该类设备,可在工作线程中调用
+     * @param format:导出格式
+     * @param category:设备类别
+     * @return 片段内容,xlsx为序列化的单元格
+     */
+    static QByteArray renderCategory(ExportFormat format, const ExportCategory &category);
 
     /**
      * @brief overviewToTxt:概况信息写到txt
@@ -585,30 +709,29 @@ public:
 
     /**
      * @brief overviewToHtml:概况信息写到html
-     * @param html:html文件
+     * @param html:html输出设备
      */
-    void overviewToHtml(QFile &html);
+    void overviewToHtml(QIODevice &html);
 
     /**
      * @brief overviewToDoc:概况信息写到doc
      * @param doc:doc文件
      */
-    void overviewToDoc(Docx::Document &doc);
+    void overviewToDoc(DocxStreamWriter &doc);
 
     /**
      * @brief overviewToXlsx:概况信息写到表格
      * @param xlsx:xlsx文件
-     * @param boldFont:字体格式
      */
-    void overviewToXlsx(QXlsx::Document &xlsx, QXlsx::Format &boldFont);
+    void overviewToXlsx(XlsxStreamWriter &xlsx);
 
     /**
      * @brief infoToHtml:将信息写到html中
-     * @param doc:文本
+     * @param html:html输出设备
      * @param key:关键字
      * @param value:值
      */
-    void infoToHtml(QDomDocument &doc, const QString &key, const QString &value);
+    void infoToHtml(QIODevice &html, const QString &key, const QString &value);
 
     /**
      * @brief getDeviceOverview:获取所有设备设备概况信息
@@ -639,16 +762,74 @@ public:
      */
     void setCpuNum(int num);
 
+    /**
+     * @brief cpuNum:物理cpu个数
+     * @return 物理cpu个数
+     */
+    int cpuNum() const;
+
     /**
      * @brief setCpuFrequencyIsCur:设置频率显示是当前还是最大值
      * @param flag:频率显示是当前还是最大值
      */
     void setCpuFrequencyIsCur(const bool &flag);
 
+    /**
+     * @brief setCpuSampledFreq:设置采样得到的处理器频率
+     * @param mapFreq:processor 到(当前频率,最小/平均/最大频率)的映射
+     */
+    void setCpuSampledFreq(const QMap<QString, QPair<QString, QString>> &mapFreq);
+
 protected:
     DeviceManager();
     ~DeviceManager();
 
+    /**
+     * @brief generationKey:设备在两次刷新之间的比对键,由设备类型、唯一值、sysfs路径和名称组成
+     * @param device:设备指针
+     * @return 比对键
+     */
+    static QString generationKey(DeviceBaseInfo *device);
+
+    /**
+     * @brief sameContent:上一次生成的设备与本次生成的设备内容是否一致
+     * @return 是否一致
+     */
+    static bool sameContent(DeviceBaseInfo *device, DeviceBaseInfo *other);
+
+    /**
+     * @brief clearLastGeneration:释放上一次刷新中尚未比对的设备
+     */
+    void clearLastGeneration();
+
+    /**
+     * @brief exportCategories:按导出顺序列出所有设备类别
+     */
+    QList<ExportCategory> exportCategories();
+
+    /**
+     * @brief renderCategories:在线程池中并行渲染各设备类别,按导出顺序交给 writer 写出
+     * 渲染最多领先写出线程数个类别,同时保存的片段不超过线程数加一个,单个类别的片段仍需整体保存
+     * @param format:导出格式
+     * @param writer:片段写出函数
+     * @return true:全部写出;false:导出被取消
+     */
+    bool renderCategories(ExportFormat format, const std::function<void(const QByteArray &)> &writer);
+
+    /**
+     * @brief loadExportAttribs:生成导出时用到的属性缓存,之后导出只读取缓存
+     * @param deviceLst:设备列表
+     */
+    static void loadExportAttribs(const QList<DeviceBaseInfo *> &deviceLst);
+
+    /**
+     * @brief exportToRecords:按设备逐个写出机器可读的设备记录
+     * @param filePath:文件路径
+     * @param format:记录格式
+     * @return true:导出成功，false:导出失败或被取消
+     */
+    bool exportToRecords(const QString &filePath, DeviceRecordWriter::RecordFormat format);
+
 private:
     static DeviceManager    *sInstance;
 
@@ -671,17 +852,31 @@ private:
     QList<DeviceBaseInfo *>              m_ListDeviceComputer;             //<! 计算机基本信息
     QList<DeviceBaseInfo *>              m_ListDeviceCdrom;                //<! cdrom设备
 
+    DeviceIndex                          m_IndexMouse;                     //<! 鼠标设备索引
+    DeviceIndex                          m_IndexBluetooth;                 //<! 蓝牙设备索引
+    DeviceIndex                          m_IndexAudio;                     //<! 音频设备索引
+    DeviceIndex                          m_IndexNetwork;                   //<! 网络设备索引
+    DeviceIndex                          m_IndexImage;                     //<! 图像设备索引
+    DeviceIndex                          m_IndexOthers;                    //<! 其它设备索引
+    DeviceSearchIndex                    m_SearchIndex;                    //<! 所有设备的搜索索引
+
     QList<QPair<QString, QString>>       m_ListDeviceType;                 //<! 所有的设备类型及其对应的图标
     QStringList                                    m_BusIdList;            //<! 所有的设备总线ID
     QMap<QString, QList<QMap<QString, QString> > > m_cmdInfo;              //<! 所有设备信息获取命令
     QMap<QString, QString>                         m_OveriewMap;           //<! 所有的设备与其对应概况信息
     QMap<QString, QList<DeviceBaseInfo *>>         m_DeviceClassMap;       //<! 所有的设备类型与其对应设备列表
+    QList<DeviceBaseInfo *>                        m_ShownComputer;        //<! 界面显示的计算机设备,与 m_DeviceClassMap 一起在界面线程更新
+    int                                            m_ShownCpuNum;          //<! 界面显示的物理cpu个数
+    QMap<QString, QList<DeviceBaseInfo *>>         m_LastClassMap;         //<! 上一次的设备类型与设备列表,只用于比对,不访问指针
+    QSet<QString>                                  m_ChangedClasses;       //<! 最近一次刷新有变化的设备类型
+    QMap<int, QList<DeviceBaseInfo *>>             m_LastGeneration;       //<! 上一次刷新生成的设备,等待与本次比对
     QMap<QString, QMap<QString, QStringList>>      m_DeviceDriverPool;     //<! 所有的设备驱动与与其对应的设备类型，设备名称列表
     QMap<QString, QMap<QString, QString> >         m_InputDeviceInfo;
 
     int                                            m_CpuNum;               //<! 物理cpu个数
 
-    static int m_CurrentXlsRow;       //<! xlsx表格当前行
+    int                                            m_ExportThreadCount;    //<! 导出时并行渲染的线程数
+    std::function<bool(int, int)>                  m_ExportObserver;       //<! 导出进度回调
     QStringList m_networkDriver; //网络驱动
 };
 
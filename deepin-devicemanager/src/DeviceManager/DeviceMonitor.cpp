@@ -221,6 +221,8 @@ QString DeviceMonitor::transWeekToDate(const QString &year, const QString &week)
 
 bool DeviceMonitor::setInfoFromXradr(const QString &main, const QString &edid, const QString &rate)
 {
+    invalidateAttribs();
+    addContentHash("Xrandr", main + "\n" + edid + "\n" + rate);
     if(m_IsTomlSet)
         return false;
     // 判断该显示器设备是否已经设置过从xrandr获取的消息
@@ -341,6 +343,8 @@ void DeviceMonitor::loadTableData()
 
 bool DeviceMonitor::setMainInfoFromXrandr(const QString &info, const QString &rate)
 {
+    invalidateAttribs();
+    addContentHash("XrandrMain", info + "\n" + rate);
     //  bug89456：显示设备接口类型DP，VGA，HDMI，eDP，DisplayPort
     //  还可能会有其它接口类型，为了避免每一次遇到新的接口类型就要修改代码
     //  使用正则表达式获取接口类型进行显示
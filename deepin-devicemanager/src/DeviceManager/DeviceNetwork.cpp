@@ -201,11 +201,13 @@ bool DeviceNetwork::setInfoFromWifiInfo(const QMap<QString, QString> &mapInfo)
 
 void DeviceNetwork::setIsWireless(const QString &sysfs)
 {
+    invalidateAttribs();
     // 路径下包含 phy80211 或 wireless 是无线网卡
     QFileInfo fileInfo(QString("/sys") + sysfs);
     if (fileInfo.exists("phy80211") || fileInfo.exists("wireless")) {
         m_IsWireless = true;
     }
+    addContentHash("IsWireless", m_IsWireless ? "1" : "0");
 }
 
 const QString &DeviceNetwork::name()const
@@ -238,6 +240,7 @@ const QString DeviceNetwork::getOverviewInfo()
 
 EnableDeviceStatus DeviceNetwork::setEnable(bool e)
 {
+    invalidateAttribs();
     m_HardwareClass = "network interface";
     // 设置设备状态
     if (m_SysPath.isEmpty()) {
@@ -262,8 +265,19 @@ bool DeviceNetwork::enable()
 
 void DeviceNetwork::correctCurrentLinkStatus(QString linkStatus)
 {
+    invalidateAttribs();
     if (m_Link != linkStatus)
         m_Link = linkStatus;
+    addContentHash("Link", linkStatus);
+}
+
+void DeviceNetwork::correctCurrentSpeed(const QString &speed)
+{
+    if (m_Speed == speed)
+        return;
+    invalidateAttribs();
+    m_Speed = speed;
+    addContentHash("Speed", speed);
 }
 
 QString DeviceNetwork::logicalName()
@@ -101,6 +101,12 @@ public:
      */
     void correctCurrentLinkStatus(QString linkStatus);
 
+    /**
+     * @brief correctCurrentSpeed:校正协商速率
+     * @param speed:速率,如 1Gbit/s
+     */
+    void correctCurrentSpeed(const QString &speed);
+
     /**
      * @brief logicalName: 获取网卡逻辑名称
      * @return
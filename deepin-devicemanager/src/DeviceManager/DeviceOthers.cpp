@@ -114,6 +114,7 @@ void DeviceOthers::setInfoFromHwinfo(const QMap<QString, QString> &mapInfo)
 
 EnableDeviceStatus DeviceOthers::setEnable(bool e)
 {
+    invalidateAttribs();
     if (m_SerialID.isEmpty()) {
         return EDS_NoSerial;
     }
@@ -109,6 +109,7 @@ const QString DevicePrint::getOverviewInfo()
 
 EnableDeviceStatus DevicePrint::setEnable(bool e)
 {
+    invalidateAttribs();
     bool res  = DBusEnableInterface::getInstance()->enablePrinter("printer", m_Name, m_URI, e);
     if (res) {
         m_Enable = e;
@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "DeviceSearchIndex.h"
+#include "DeviceInfo.h"
+
+DeviceSearchIndex::DeviceSearchIndex()
+{
+
+}
+
+void DeviceSearchIndex::insert(DeviceBaseInfo *device)
+{
+    if (!device)
+        return;
+
+    // 地址已登记(旧设备释放后地址被复用)时重新登记
+    if (m_Tokens.contains(device))
+        remove(device);
+
+    QStringList tokens = deviceTokens(device);
+    foreach (const QString &token, tokens)
+        m_Postings[token].insert(device);
+    m_Tokens.insert(device, tokens);
+    m_Revisions.insert(device, device->revision());
+}
+
+bool DeviceSearchIndex::update(DeviceBaseInfo *device)
+{
+    // 属性变化时设备会更新版本号,版本号未变的设备不重新切分
+    if (!device || (m_Tokens.contains(device) && m_Revisions.value(device) == device->revision()))
+        return false;
+
+    insert(device);
+    return true;
+}
+
+void DeviceSearchIndex::remove(DeviceBaseInfo *device)
+{
+    if (!m_Tokens.contains(device))
+        return;
+
+    const QStringList tokens = m_Tokens.take(device);
+    m_Revisions.remove(device);
+    foreach (const QString &token, tokens) {
+        QHash<QString, QSet<DeviceBaseInfo *> >::iterator it = m_Postings.find(token);
+        if (it == m_Postings.end())
+            continue;
+        it->remove(device);
+        if (it->isEmpty())
+            m_Postings.erase(it);
+    }
+}
+
+void DeviceSearchIndex::retain(const QList<DeviceBaseInfo *> &lst)
+{
+    QSet<DeviceBaseInfo *> current;
+    foreach (DeviceBaseInfo *device, lst)
+        current.insert(device);
+    foreach (DeviceBaseInfo *device, m_Tokens.keys()) {
+        if (!current.contains(device))
+            remove(device);
+    }
+}
+
+void DeviceSearchIndex::clear()
+{
+    m_Postings.clear();
+    m_Tokens.clear();
+    m_Revisions.clear();
+}
+
+QSet<DeviceBaseInfo *> DeviceSearchIndex::find(const QString &text) const
+{
+    QSet<DeviceBaseInfo *> result;
+    const QStringList terms = tokenize(text);
+    if (terms.isEmpty())
+        return result;
+
+    for (int i = 0; i < terms.size(); ++i) {
+        // 关键字是词元的子串即匹配,词元数量远少于设备数量×属性数量
+        QSet<DeviceBaseInfo *> matched;
+        for (auto it = m_Postings.constBegin(); it != m_Postings.constEnd(); ++it) {
+            if (it.key().contains(terms[i]))
+                matched.unite(it.value());
+        }
+
+        if (i == 0)
+            result = matched;
+        else
+            result.intersect(matched);
+        if (result.isEmpty())
+            break;
+    }
+    return result;
+}
+
+bool DeviceSearchIndex::contains(DeviceBaseInfo *device) const
+{
+    return m_Tokens.contains(device);
+}
+
+int DeviceSearchIndex::size() const
+{
+    return m_Tokens.size();
+}
+
+QStringList DeviceSearchIndex::tokenize(const QString &text)
+{
+    QStringList tokens;
+    QSet<QString> seen;
+    QString token;
+    const QString lower = text.toLower();
+    for (int i = 0; i <= lower.size(); ++i) {
+        if (i < lower.size() && lower[i].isLetterOrNumber()) {
+            token.append(lower[i]);
+            continue;
+        }
+        if (!token.isEmpty() && !seen.contains(token)) {
+            seen.insert(token);
+            tokens.append(token);
+        }
+        token.clear();
+    }
+    return tokens;
+}
+
+QStringList DeviceSearchIndex::deviceTokens(DeviceBaseInfo *device)
+{
+    QStringList values;
+    values << device->name() << device->vendor() << device->driver() << device->getModalias();
+
+    typedef QPair<QString, QString> Attrib;
+    foreach (const Attrib &attrib, device->getBaseAttribs())
+        values.append(attrib.second);
+    foreach (const Attrib &attrib, device->getOtherAttribs())
+        values.append(attrib.second);
+
+    return tokenize(values.join("\n"));
+}
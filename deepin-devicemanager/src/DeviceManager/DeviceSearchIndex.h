@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DEVICESEARCHINDEX_H
+#define DEVICESEARCHINDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QHash>
+#include <QSet>
+
+class DeviceBaseInfo;
+
+/**
+ * @brief The DeviceSearchIndex class
+ * 设备搜索的倒排索引,将设备名称、厂商、驱动、modalias 及所有基本信息和其它信息的值切分为小写词元
+ * 查询时每个关键字匹配包含该子串的词元,多个关键字的结果取交集
+ */
+class DeviceSearchIndex
+{
+public:
+    DeviceSearchIndex();
+
+    /**
+     * @brief insert:将设备加入索引,已登记的设备重新切分
+     * @param device:设备指针
+     */
+    void insert(DeviceBaseInfo *device);
+
+    /**
+     * @brief update:设备未登记或登记后属性发生过变化时重新登记
+     * @param device:设备指针
+     * @return true:重新登记;false:索引已是最新
+     */
+    bool update(DeviceBaseInfo *device);
+
+    /**
+     * @brief remove:将设备从索引中移除,不访问设备对象
+     * @param device:设备指针
+     */
+    void remove(DeviceBaseInfo *device);
+
+    /**
+     * @brief retain:只保留列表中的设备,其余设备从索引中移除
+     * @param lst:当前所有设备
+     */
+    void retain(const QList<DeviceBaseInfo *> &lst);
+
+    /**
+     * @brief clear:清空索引
+     */
+    void clear();
+
+    /**
+     * @brief find:查找匹配所有关键字的设备
+     * @param text:搜索内容,以空白及标点分隔为关键字
+     * @return 匹配的设备,没有关键字时为空
+     */
+    QSet<DeviceBaseInfo *> find(const QString &text) const;
+
+    /**
+     * @brief contains:设备是否已登记
+     */
+    bool contains(DeviceBaseInfo *device) const;
+
+    /**
+     * @brief size:索引中的设备数量
+     */
+    int size() const;
+
+    /**
+     * @brief tokenize:将文本切分为去重的小写词元,字母和数字以外的字符作为分隔符
+     * @param text:文本
+     * @return 词元列表
+     */
+    static QStringList tokenize(const QString &text);
+
+private:
+    /**
+     * @brief deviceTokens:计算设备的所有词元
+     * @param device:设备指针
+     * @return 词元列表
+     */
+    static QStringList deviceTokens(DeviceBaseInfo *device);
+
+    QHash<QString, QSet<DeviceBaseInfo *> >    m_Postings;    //<! 词元到设备的映射
+    QHash<DeviceBaseInfo *, QStringList>       m_Tokens;      //<! 设备已登记的词元
+    QHash<DeviceBaseInfo *, int>               m_Revisions;   //<! 设备登记时的属性版本
+};
+
+#endif // DEVICESEARCHINDEX_H
@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "DeviceSnapshotInfo.h"
+#include "DeviceComputer.h"
+
+// Qt库文件
+#include <QFile>
+#include <QDataStream>
+
+DeviceSnapshotInfo::DeviceSnapshotInfo(const QSharedPointer<QFile> &file, const uchar *detail, int detailSize)
+    : DeviceBaseInfo()
+    , m_File(file)
+    , mp_Detail(detail)
+    , m_DetailSize(detailSize)
+    , m_SubTitle("")
+    , m_Overview("")
+    , m_OSInfo("")
+{
+}
+
+void DeviceSnapshotInfo::writeSummary(QDataStream &out, DeviceBaseInfo *device)
+{
+    // 计算机设备的操作系统信息只能由子类获取
+    DeviceComputer *computer = dynamic_cast<DeviceComputer *>(device);
+    out << device->name() << device->vendor() << device->driver()
+        << device->subTitle() << device->getOverviewInfo()
+        << device->uniqueID() << device->sysPath()
+        << device->enable() << device->available()
+        << (computer ? computer->getOSInfo() : QString());
+}
+
+void DeviceSnapshotInfo::writeDetail(QDataStream &out, DeviceBaseInfo *device)
+{
+    // 快照中的设备不可禁用,表头不包含是否可禁用;用户没有打开过的设备不生成缓存
+    QList<QPair<QString, QString>> base, other;
+    QStringList header, data;
+    device->copyAttribs(base, other, header, data);
+    out << base << other << header << data;
+}
+
+bool DeviceSnapshotInfo::setInfoFromSnapshot(QDataStream &in)
+{
+    in >> m_Name >> m_Vendor >> m_Driver
+       >> m_SubTitle >> m_Overview
+       >> m_UniqueID >> m_SysPath
+       >> m_Enable >> m_Available
+       >> m_OSInfo;
+    return in.status() == QDataStream::Ok;
+}
+
+const QString &DeviceSnapshotInfo::name()const
+{
+    return m_Name;
+}
+
+const QString &DeviceSnapshotInfo::vendor()const
+{
+    return m_Vendor;
+}
+
+const QString &DeviceSnapshotInfo::driver()const
+{
+    return m_Driver;
+}
+
+QString DeviceSnapshotInfo::subTitle()
+{
+    return m_SubTitle;
+}
+
+const QString DeviceSnapshotInfo::getOverviewInfo()
+{
+    return m_Overview;
+}
+
+EnableDeviceStatus DeviceSnapshotInfo::setEnable(bool)
+{
+    return EDS_Faild;
+}
+
+const QString &DeviceSnapshotInfo::osInfo() const
+{
+    return m_OSInfo;
+}
+
+void DeviceSnapshotInfo::initFilterKey()
+{
+
+}
+
+void DeviceSnapshotInfo::loadBaseDeviceInfo()
+{
+    readDetail(&m_LstBaseInfo, nullptr, nullptr, nullptr);
+}
+
+void DeviceSnapshotInfo::loadOtherDeviceInfo()
+{
+    readDetail(nullptr, &m_LstOtherInfo, nullptr, nullptr);
+}
+
+void DeviceSnapshotInfo::loadTableHeader()
+{
+    readDetail(nullptr, nullptr, &m_TableHeader, nullptr);
+}
+
+void DeviceSnapshotInfo::loadTableData()
+{
+    readDetail(nullptr, nullptr, nullptr, &m_TableData);
+}
+
+void DeviceSnapshotInfo::readDetail(QList<QPair<QString, QString>> *base, QList<QPair<QString, QString>> *other,
+                                    QStringList *header, QStringList *data)
+{
+    if (!mp_Detail)
+        return;
+
+    // 直接在映射的内存上读取,不拷贝文件内容
+    QByteArray bytes = QByteArray::fromRawData(reinterpret_cast<const char *>(mp_Detail), m_DetailSize);
+    QDataStream in(bytes);
+    in.setVersion(QDataStream::Qt_5_11);
+
+    QList<QPair<QString, QString>> lstBase, lstOther;
+    QStringList lstHeader, lstData;
+    in >> lstBase >> lstOther >> lstHeader >> lstData;
+    if (in.status() != QDataStream::Ok)
+        return;
+
+    if (base)
+        *base = lstBase;
+    if (other)
+        *other = lstOther;
+    if (header)
+        *header = lstHeader;
+    if (data)
+        *data = lstData;
+}
@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DEVICESNAPSHOTINFO_H
+#define DEVICESNAPSHOTINFO_H
+#include "DeviceInfo.h"
+
+#include <QSharedPointer>
+
+class QFile;
+class QDataStream;
+
+/**
+ * @brief The DeviceSnapshotInfo class
+ * 用来描述由设备快照恢复的设备,只读
+ * 概要信息在加载时读取,详细属性在界面首次使用时直接从映射的快照文件中读取
+ */
+class DeviceSnapshotInfo : public DeviceBaseInfo
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(DeviceSnapshotInfo)
+public:
+    /**
+     * @brief DeviceSnapshotInfo
+     * @param file:已映射的快照文件,所有设备释放后解除映射
+     * @param detail:本设备详细属性在映射内存中的位置
+     * @param detailSize:详细属性的长度
+     */
+    DeviceSnapshotInfo(const QSharedPointer<QFile> &file, const uchar *detail, int detailSize);
+
+    /**
+     * @brief writeSummary:写入设备的概要信息
+     * @param out:快照数据流
+     * @param device:设备
+     */
+    static void writeSummary(QDataStream &out, DeviceBaseInfo *device);
+
+    /**
+     * @brief writeDetail:写入设备的详细属性
+     * @param out:快照数据流
+     * @param device:设备
+     */
+    static void writeDetail(QDataStream &out, DeviceBaseInfo *device);
+
+    /**
+     * @brief setInfoFromSnapshot:读取 writeSummary 写入的概要信息
+     * @param in:快照数据流
+     * @return 布尔值，true:信息设置成功；false:数据不完整
+     */
+    bool setInfoFromSnapshot(QDataStream &in);
+
+    /**
+       * @brief name:获取名称属性值
+       * @return QString:名称属性值
+       */
+    const QString &name()const override;
+
+    /**
+     * @brief name:获取制造商属性值
+     * @return QString 制造商属性值
+     */
+    const QString &vendor()const override;
+
+    /**
+       * @brief driver:获取驱动属性值
+       * @return QString:驱动属性值
+       */
+    const QString &driver()const override;
+
+    /**
+     * @brief subTitle:获取子标题
+     * @return 子标题
+     */
+    QString subTitle() override;
+
+    /**
+     * @brief getOverviewInfo:获取概况信息
+     * @return 概况信息
+     */
+    const QString getOverviewInfo() override;
+
+    /**
+     * @brief setEnable:快照中的设备不能启用禁用
+     */
+    EnableDeviceStatus setEnable(bool enable) override;
+
+    /**
+     * @brief osInfo:计算机设备的操作系统信息
+     * @return 操作系统信息
+     */
+    const QString &osInfo() const;
+
+protected:
+
+    /**
+       * @brief initFilterKey:初始化可现实的可显示的属性,m_FilterKey
+       */
+    void initFilterKey() override;
+
+    /**
+     * @brief loadBaseDeviceInfo:加载基本信息
+     */
+    void loadBaseDeviceInfo() override;
+
+    /**
+     * @brief loadOtherDeviceInfo:加载其他信息
+     */
+    void loadOtherDeviceInfo() override;
+
+    /**
+     * @brief loadTableHeader:加载表头
+     */
+    void loadTableHeader() override;
+
+    /**
+     * @brief loadTableData:加载表格数据
+     */
+    void loadTableData() override;
+
+private:
+    /**
+     * @brief readDetail:从映射内存中读取详细属性,不需要的部分传空指针
+     */
+    void readDetail(QList<QPair<QString, QString>> *base, QList<QPair<QString, QString>> *other,
+                    QStringList *header, QStringList *data);
+
+    QSharedPointer<QFile> m_File;           //<! 映射的快照文件
+    const uchar          *mp_Detail;        //<! 详细属性位置
+    int                   m_DetailSize;     //<! 详细属性长度
+    QString               m_SubTitle;       //<! 子标题
+    QString               m_Overview;       //<! 概况信息
+    QString               m_OSInfo;         //<! 操作系统信息
+};
+
+#endif // DEVICESNAPSHOTINFO_H
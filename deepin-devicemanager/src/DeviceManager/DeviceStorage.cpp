@@ -400,20 +400,26 @@ bool DeviceStorage::addNVMEInfoFromlshw(const QMap<QString, QString> &mapInfo)
 
 bool DeviceStorage::addInfoFromSmartctl(const QString &name, const QMap<QString, QString> &mapInfo)
 {
+    invalidateAttribs();
     // 查看传入的设备信息与当前的设备信息是不是同一个设备信息
     if (!m_DeviceFile.contains(name, Qt::CaseInsensitive))
         return false;
 
     // 获取基本信息
+    for (auto it = mapInfo.begin(); it != mapInfo.end(); ++it)
+        addContentHash(it.key(), it.value());
     getInfoFromsmartctl(mapInfo);
     return true;
 }
 
 bool DeviceStorage::setMediaType(const QString &name, const QString &value)
 {
+    invalidateAttribs();
     if (!m_DeviceFile.contains(name))
         return false;
 
+    addContentHash("MediaType", value);
+
     if (QString("0") == value)
         m_MediaType = QObject::tr("SSD");
     else if (QString("1") == value)
@@ -426,9 +432,12 @@ bool DeviceStorage::setMediaType(const QString &name, const QString &value)
 
 bool DeviceStorage::setKLUMediaType(const QString &name, const QString &value)
 {
+    invalidateAttribs();
     if (!m_DeviceFile.contains(name))
         return false;
 
+    addContentHash("MediaType", value);
+
     if (m_MediaType == "USB")
         return true;
 
@@ -453,6 +462,8 @@ bool DeviceStorage::isValid()
 
 void DeviceStorage::setDiskSerialID(const QString &deviceFiles)
 {
+    invalidateAttribs();
+    addContentHash("DeviceFiles", deviceFiles);
     // Serial ID 与 device Files 中信息一致
     if (!m_SerialNumber.isEmpty() && deviceFiles.contains(m_SerialNumber))
         return;
@@ -504,11 +515,11 @@ void DeviceStorage::appendDisk(DeviceStorage *device)
             allAttribMaps.insert(allOtherAttribs[i].first, allOtherAttribs[i].second);
         }
 
-        loadOtherDeviceInfo();
         //合并
+        const QList<QPair<QString, QString> > &curAllOtherAttribs = getOtherAttribs();
         QMap<QString, QString> curAllOtherAttribMaps;
-        for (int i = 0; i < m_LstOtherInfo.size(); ++i) {
-            curAllOtherAttribMaps.insert(m_LstOtherInfo[i].first, m_LstOtherInfo[i].second);
+        for (int i = 0; i < curAllOtherAttribs.size(); ++i) {
+            curAllOtherAttribMaps.insert(curAllOtherAttribs[i].first, curAllOtherAttribs[i].second);
         }
 
         QStringList keyList;
@@ -524,12 +535,12 @@ void DeviceStorage::appendDisk(DeviceStorage *device)
                 setOtherDeviceInfo(keyStr, curBusInfo + "," + busInfo);
             }
         }
-        loadOtherDeviceInfo();
     }
 }
 
 void DeviceStorage::checkDiskSize()
 {
+    invalidateAttribs();
     QRegularExpression reg("[0-9]*.?[0-9]*");
     int index = reg.match(m_Size).capturedStart();
     // index>0时，对于"32GB"（数字开头的字符串,index=0）无法获取正确的数据32
@@ -19,6 +19,8 @@ const QString ENABLE_SERVICE_INTER = "org.deepin.DeviceControl";
 
 DBusEnableInterface::DBusEnableInterface()
     : mp_Iface(nullptr)
+    , m_CacheValid(false)
+    , m_CacheRevision(0)
 {
     // 初始化dbus
     init();
@@ -48,6 +50,37 @@ bool DBusEnableInterface::getAuthorizedInfo(QString &info)
     }
 }
 
+bool DBusEnableInterface::getDisabledRecords(EnableDeviceRecordList &removed, EnableDeviceRecordList &authorized)
+{
+    std::lock_guard<std::mutex> lock(m_CacheMutex);
+
+    QDBusReply<qulonglong> revision = mp_Iface->call("getEnableRevision");
+    if (!revision.isValid()) {
+        // 旧版本服务没有结构化接口
+        m_CacheValid = false;
+        return false;
+    }
+
+    // 修改计数变化后才重新获取记录
+    if (!m_CacheValid || revision.value() != m_CacheRevision) {
+        QDBusReply<EnableDeviceRecordList> removeReply = mp_Iface->call("getRemoveRecords");
+        QDBusReply<EnableDeviceRecordList> authorizedReply = mp_Iface->call("getAuthorizedRecords");
+        if (!removeReply.isValid() || !authorizedReply.isValid()) {
+            m_CacheValid = false;
+            return false;
+        }
+
+        m_CacheRemoved = removeReply.value();
+        m_CacheAuthorized = authorizedReply.value();
+        m_CacheRevision = revision.value();
+        m_CacheValid = true;
+    }
+
+    removed = m_CacheRemoved;
+    authorized = m_CacheAuthorized;
+    return true;
+}
+
 bool DBusEnableInterface::isDeviceEnabled(const QString &unique_id)
 {
     QDBusReply<bool> reply = mp_Iface->call("isDeviceEnabled", unique_id);
@@ -84,6 +117,9 @@ void DBusEnableInterface::init()
                 "/teval `dbus-launch --auto-syntax`/n");
     }
 
-    // 2. create interface
+    // 2. 注册禁用设备记录的dbus类型
+    registerEnableDeviceRecordMetaType();
+
+    // 3. create interface
     mp_Iface = new QDBusInterface(SERVICE_NAME, ENABLE_SERVICE_PATH, ENABLE_SERVICE_INTER, QDBusConnection::systemBus());
 }
@@ -6,6 +6,8 @@
 #ifndef DBUSENABLEINTERFACE_H
 #define DBUSENABLEINTERFACE_H
 
+#include "EnableDeviceRecord.h"
+
 #include <QObject>
 
 #include <mutex>
@@ -47,6 +49,14 @@ public:
      */
     bool getAuthorizedInfo(QString& lst);
 
+    /**
+     * @brief getDisabledRecords 获取被禁用设备的记录,服务端修改计数未变化时直接使用缓存
+     * @param removed 通过remove文件禁用的设备
+     * @param authorized 通过authorized文件禁用的设备
+     * @return 服务端不支持结构化接口时返回false,调用方应回退到 getRemoveInfo/getAuthorizedInfo
+     */
+    bool getDisabledRecords(EnableDeviceRecordList &removed, EnableDeviceRecordList &authorized);
+
     /**
      * @brief isDeviceEnabled 判断设备是否被禁用 通过后台查询
      * @param unique_id 设备的唯一标识
@@ -86,6 +96,12 @@ private:
     static std::mutex m_mutex;
 
     QDBusInterface       *mp_Iface;
+
+    std::mutex               m_CacheMutex;          //<! 禁用设备记录缓存锁,多个加载线程会同时访问
+    bool                     m_CacheValid;          //<! 缓存是否有效
+    qulonglong               m_CacheRevision;       //<! 缓存对应的服务端修改计数
+    EnableDeviceRecordList   m_CacheRemoved;        //<! 缓存的remove禁用记录
+    EnableDeviceRecordList   m_CacheAuthorized;     //<! 缓存的authorized禁用记录
 };
 
 #endif // DBUSENABLEINTERFACE_H
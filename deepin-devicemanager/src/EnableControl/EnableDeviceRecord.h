@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ENABLEDEVICERECORD_H
+#define ENABLEDEVICERECORD_H
+
+#include <QString>
+#include <QList>
+#include <QMetaType>
+#include <QDBusArgument>
+#include <QDBusMetaType>
+
+/**
+ * @brief The EnableDeviceRecord struct
+ * 被禁用设备的数据库记录,通过 dbus 以 (sssss) 结构传递
+ * 客户端与服务端 deepin-devicecontrol 共用此文件,保证两端的结构一致
+ */
+struct EnableDeviceRecord {
+    QString hclass;      //<! 设备类型
+    QString name;        //<! 设备名称
+    QString path;        //<! 设备节点路径
+    QString uniqueId;    //<! 设备唯一标识
+    QString driver;      //<! 驱动名称
+};
+
+typedef QList<EnableDeviceRecord> EnableDeviceRecordList;
+
+Q_DECLARE_METATYPE(EnableDeviceRecord)
+Q_DECLARE_METATYPE(EnableDeviceRecordList)
+
+inline QDBusArgument &operator<<(QDBusArgument &argument, const EnableDeviceRecord &record)
+{
+    argument.beginStructure();
+    argument << record.hclass << record.name << record.path << record.uniqueId << record.driver;
+    argument.endStructure();
+    return argument;
+}
+
+inline const QDBusArgument &operator>>(const QDBusArgument &argument, EnableDeviceRecord &record)
+{
+    argument.beginStructure();
+    argument >> record.hclass >> record.name >> record.path >> record.uniqueId >> record.driver;
+    argument.endStructure();
+    return argument;
+}
+
+/**
+ * @brief registerEnableDeviceRecordMetaType 注册 dbus 类型,客户端须在调用 dbus 接口之前、服务端须在导出对象之前调用
+ */
+inline void registerEnableDeviceRecordMetaType()
+{
+    qRegisterMetaType<EnableDeviceRecord>("EnableDeviceRecord");
+    qRegisterMetaType<EnableDeviceRecordList>("EnableDeviceRecordList");
+    qDBusRegisterMetaType<EnableDeviceRecord>();
+    qDBusRegisterMetaType<EnableDeviceRecordList>();
+}
+
+#endif // ENABLEDEVICERECORD_H
@@ -22,6 +22,7 @@
 #include "DBusInterface.h"
 #include "DBusEnableInterface.h"
 #include "MacroDefinition.h"
+#include "GpuProbe.h"
 using namespace DDLog;
 
 CmdTool::CmdTool()
@@ -143,10 +144,34 @@ void CmdTool::loadCmdInfo(const QString &key, const QString &debugFile)
         loadCatConfigInfo(key, debugFile);
     else if ("nvidia" == key)
         loadNvidiaSettingInfo(key, debugFile);
+    else if ("nvidia_width" == key)
+        loadNvidiaWidthInfo(key, debugFile);
     else
         loadCatInfo(key, debugFile);
 }
 
+QByteArray CmdTool::rawInfoHash(const QString &key, const QString &debugFile)
+{
+    // 只有解析结果完全由原始输出决定的命令才能按摘要复用
+    // printer/hciconfig/hwinfo/nvidia 等还依赖 cups、进程、启用记录,lscpu/lsblk/ls_sg/dmidecode1/dmidecode2 会读取额外的文件
+    static const QStringList hashableKeys = { "lshw", "dmesg", "upower", "dr_config", "bootdevice",
+                                              "dmidecode0", "dmidecode3", "dmidecode4", "dmidecode13", "dmidecode16", "dmidecode17",
+                                              "xrandr", "xrandr_verbose", "bt_device",
+                                              "cat_boardinfo", "cat_os_release", "cat_version", "cat_audio", "cat_gpuinfo"
+                                            };
+    if (!hashableKeys.contains(key))
+        return QByteArray();
+
+    // 与 loadCmdInfo 中对应解析函数的读取方式保持一致
+    QString deviceInfo;
+    bool isCat = key.startsWith("cat_") || key.startsWith("xrandr") || "bt_device" == key;
+    if (!(isCat ? getCatDeviceInfo(deviceInfo, debugFile) : getDeviceInfo(deviceInfo, debugFile)))
+        return QByteArray();
+
+    m_RawInfo.insert(debugFile, deviceInfo);
+    return QCryptographicHash::hash(deviceInfo.toUtf8(), QCryptographicHash::Md5);
+}
+
 QMap<QString, QList<QMap<QString, QString> > > &CmdTool::cmdInfo()
 {
     return m_cmdInfo;
@@ -546,75 +571,107 @@ void CmdTool::loadHwinfoInfo(const QString &key, const QString &debugfile)
 
 void CmdTool::getMulHwinfoInfo(const QString &info)
 {
-//    // 获取已经禁用的设备的信息
-    QString sAinfo, sRinfo;
-    DBusEnableInterface::getInstance()->getRemoveInfo(sRinfo);
-    DBusEnableInterface::getInstance()->getAuthorizedInfo(sAinfo);
-
     // 获取信息
-    QStringList items = info.split("\n\n");
+    QStringList resItems = info.split("\n\n");
+
+    // 获取已经禁用的设备的信息,服务端支持时直接使用结构化记录,无需拼接再解析文本
+    QList<QMap<QString, QString> > disabledMaps;
+    EnableDeviceRecordList removed, authorized;
+    if (DBusEnableInterface::getInstance()->getDisabledRecords(removed, authorized)) {
+        foreach (const EnableDeviceRecord &record, authorized + removed) {
+            QMap<QString, QString> mapInfo;
+            getMapInfoFromEnableRecord(record, mapInfo);
+            disabledMaps.append(mapInfo);
+        }
+    } else {
+        QString sAinfo, sRinfo;
+        DBusEnableInterface::getInstance()->getRemoveInfo(sRinfo);
+        DBusEnableInterface::getInstance()->getAuthorizedInfo(sAinfo);
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-    QStringList auths = sAinfo.split("\n\n", QString::SkipEmptyParts);
-    QStringList remos = sRinfo.split("\n\n", QString::SkipEmptyParts);
+        resItems += sAinfo.split("\n\n", QString::SkipEmptyParts);
+        resItems += sRinfo.split("\n\n", QString::SkipEmptyParts);
 #else
-    QStringList auths = sAinfo.split("\n\n", Qt::SkipEmptyParts);
-    QStringList remos = sRinfo.split("\n\n", Qt::SkipEmptyParts);
+        resItems += sAinfo.split("\n\n", Qt::SkipEmptyParts);
+        resItems += sRinfo.split("\n\n", Qt::SkipEmptyParts);
 #endif
-    QStringList resItems = items + auths + remos;
+    }
 
     foreach (const QString &item, resItems) {
         if (item.isEmpty())
             continue;
         QMap<QString, QString> mapInfo;
         getMapInfoFromHwinfo(item, mapInfo);
-        if (mapInfo["Hardware Class"] == "sound" || mapInfo["Device"].contains("USB Audio")) {
-            // mapInfo["Device"].contains("USB Audio") 是为了处理未识别的USB声卡 Bug-118773
-            addMapInfo("hwinfo_sound", mapInfo);
-        } else if (mapInfo["Hardware Class"].contains("network")) {
-            //if (mapInfo.find("SysFS Device Link") != mapInfo.end() && mapInfo["SysFS Device Link"].contains("/devices/platform"))
-            bool hasAddress = mapInfo.find("HW Address") != mapInfo.end() || mapInfo.find("Permanent HW Address") != mapInfo.end();
-            bool hasPath = mapInfo.find("path") != mapInfo.end();
-            if (hasPath || hasAddress) {
-                addMapInfo("hwinfo_network", mapInfo);
-            }
-        } else if ("keyboard" == mapInfo["Hardware Class"]) {
-            addMouseKeyboardInfoMapInfo("hwinfo_keyboard", mapInfo);
-        } else if ("mouse" == mapInfo["Hardware Class"]) {
-            addMouseKeyboardInfoMapInfo("hwinfo_mouse", mapInfo);
-        } else if ("cdrom" == mapInfo["Hardware Class"]) {
-            addMapInfo("hwinfo_cdrom", mapInfo);
-        } else if ("disk" == mapInfo["Hardware Class"]) {
-            addMapInfo("hwinfo_disk", mapInfo);
-        } else if ("graphics card" == mapInfo["Hardware Class"]) {
-            if (mapInfo["Device"].contains("Graphics Processing Unit"))
-                continue;
-            addWidthToMap(mapInfo);
-            addMapInfo("hwinfo_display", mapInfo);
-        } else {
-            addUsbMapInfo("hwinfo_usb", mapInfo);
+        addMulHwinfoMapInfo(mapInfo);
+    }
+    for (int i = 0; i < disabledMaps.size(); ++i)
+        addMulHwinfoMapInfo(disabledMaps[i]);
+}
+
+void CmdTool::getMapInfoFromEnableRecord(const EnableDeviceRecord &record, QMap<QString, QString> &mapInfo)
+{
+    // 与服务端拼接的文本 "Hardware Class : xxx" 等解析结果保持一致
+    QList<QPair<QString, QString> > items;
+    items << qMakePair(QString("Hardware Class"), record.hclass)
+          << qMakePair(QString("name"), record.name)
+          << qMakePair(QString("path"), record.path)
+          << qMakePair(QString("unique_id"), record.uniqueId)
+          << qMakePair(QString("driver"), record.driver);
+    for (int i = 0; i < items.size(); ++i) {
+        QString value = items[i].second.trimmed();
+        if (!value.contains("unknown"))
+            mapInfo.insert(items[i].first, value);
+    }
+}
+
+void CmdTool::addMulHwinfoMapInfo(QMap<QString, QString> &mapInfo)
+{
+    if (mapInfo["Hardware Class"] == "sound" || mapInfo["Device"].contains("USB Audio")) {
+        // mapInfo["Device"].contains("USB Audio") 是为了处理未识别的USB声卡 Bug-118773
+        addMapInfo("hwinfo_sound", mapInfo);
+    } else if (mapInfo["Hardware Class"].contains("network")) {
+        //if (mapInfo.find("SysFS Device Link") != mapInfo.end() && mapInfo["SysFS Device Link"].contains("/devices/platform"))
+        bool hasAddress = mapInfo.find("HW Address") != mapInfo.end() || mapInfo.find("Permanent HW Address") != mapInfo.end();
+        bool hasPath = mapInfo.find("path") != mapInfo.end();
+        if (hasPath || hasAddress) {
+            addMapInfo("hwinfo_network", mapInfo);
         }
+    } else if ("keyboard" == mapInfo["Hardware Class"]) {
+        addMouseKeyboardInfoMapInfo("hwinfo_keyboard", mapInfo);
+    } else if ("mouse" == mapInfo["Hardware Class"]) {
+        addMouseKeyboardInfoMapInfo("hwinfo_mouse", mapInfo);
+    } else if ("cdrom" == mapInfo["Hardware Class"]) {
+        addMapInfo("hwinfo_cdrom", mapInfo);
+    } else if ("disk" == mapInfo["Hardware Class"]) {
+        addMapInfo("hwinfo_disk", mapInfo);
+    } else if ("graphics card" == mapInfo["Hardware Class"]) {
+        if (mapInfo["Device"].contains("Graphics Processing Unit"))
+            return;
+        addMapInfo("hwinfo_display", mapInfo);
+    } else {
+        addUsbMapInfo("hwinfo_usb", mapInfo);
     }
 }
 
-void CmdTool::addWidthToMap(QMap<QString, QString> &mapInfo)
+void CmdTool::loadNvidiaWidthInfo(const QString &key, const QString &debugfile)
 {
-    QString vendor = mapInfo["Vendor"];
-    if (!vendor.contains("NVIDIA Corporation")) {
+    Q_UNUSED(debugfile);
+    // 显存位宽与hwinfo解析分开采集,生成显卡设备时再合并到NVIDIA显卡上
+    if (!GpuProbe::nvidiaDriverLoaded())
         return;
-    }
 
-    QString cmd = QString("nvidia-settings -q GPUMemoryInterface");
-    QString sInfo;
-    QProcess process;
-    process.start(cmd);
-    process.waitForFinished(-1);
-    sInfo = process.readAllStandardOutput();
-    QStringList lines = sInfo.split("\n");
+    static const QRegularExpression reg("\\s\\sAttribute\\s'GPUMemoryInterface' \\(.*\\):\\s([0-9]+).*");
+    QString width;
+    const QStringList lines = GpuProbe::instance()->output("nvidia-settings", QStringList() << "-q" << "GPUMemoryInterface").split("\n");
     foreach (const QString &line, lines) {
-        QRegularExpression reg("\\s\\sAttribute\\s'GPUMemoryInterface' \\(.*\\):\\s([0-9]{2}).*");
-        if (reg.match(line).hasMatch()) {
-            mapInfo.insert("Width", reg.match(line).captured(1) + " bits");
-        }
+        QRegularExpressionMatch match = reg.match(line);
+        if (match.hasMatch())
+            width = match.captured(1) + " bits";
+    }
+
+    if (!width.isEmpty()) {
+        QMap<QString, QString> mapInfo;
+        mapInfo.insert("Width", width);
+        addMapInfo(key, mapInfo);
     }
 }
 
@@ -875,8 +932,13 @@ void CmdTool::loadNvidiaSettingInfo(const QString &key, const QString &debugfile
     Q_UNUSED(debugfile);
     // 加载nvidia-settings  -q  VideoRam 信息
     // 命令与xrandr命令一样无法在后台运行,该从前台命令直接获取信息
-    QString deviceInfo;
-    if (getDeviceInfoFromCmd(deviceInfo, "nvidia-smi -L")) {
+    if (!GpuProbe::nvidiaDriverLoaded())
+        return;
+
+    // VideoRam 与显卡个数无关,只查询一次
+    QString videoRamInfo = GpuProbe::instance()->output("nvidia-settings", QStringList() << "-q" << "VideoRam");
+    QString deviceInfo = GpuProbe::instance()->output("nvidia-smi", QStringList() << "-L");
+    if (!deviceInfo.isEmpty()) {
         QStringList gpuList = deviceInfo.split("\n");
         for (QString item : gpuList) {
             int index = item.indexOf(":");
@@ -899,8 +961,8 @@ void CmdTool::loadNvidiaSettingInfo(const QString &key, const QString &debugfile
                 deviceStr = lastStr.left(devIndex).trimmed();
             }
 
-            QString memoryInfo;
-            if (!getDeviceInfoFromCmd(memoryInfo, QString("nvidia-smi -i %1 -q -d MEMORY").arg(gpuNumList[1])))
+            QString memoryInfo = GpuProbe::instance()->output("nvidia-smi", QStringList() << "-i" << gpuNumList[1] << "-q" << "-d" << "MEMORY");
+            if (memoryInfo.isEmpty())
                 continue;
 
             // 读取Bus Id
@@ -962,14 +1024,15 @@ void CmdTool::loadNvidiaSettingInfo(const QString &key, const QString &debugfile
 
 
             QMap<QString, QString> mapInfo;
-            if (getDeviceInfoFromCmd(deviceInfo, "nvidia-settings  -q  VideoRam")) {
-                QRegularExpression reg("[\\s\\S]*VideoRam[\\s\\S]*([0-9]{4,})[\\s\\S]*");
-                QStringList list = deviceInfo.split("\n");
+            if (!videoRamInfo.isEmpty()) {
+                static const QRegularExpression reg("[\\s\\S]*VideoRam[\\s\\S]*([0-9]{4,})[\\s\\S]*");
+                QStringList list = videoRamInfo.split("\n");
 
                 foreach (QString item, list) {
                     // Attribute 'VideoRam' (jixiaomei-PC:0.0): 2097152.  正则表达式获取2097152
-                    if (reg.match(item).hasMatch()) {
-                        QString gpuSize = reg.match(item).captured(1);
+                    QRegularExpressionMatch match = reg.match(item);
+                    if (match.hasMatch()) {
+                        QString gpuSize = match.captured(1);
                         int numSize = gpuSize.toInt();
                         numSize /= 1024;
                         if (numSize >= 1024) {   // Bug109782 1024MB -> 1G
@@ -1490,6 +1553,12 @@ void CmdTool::getMapInfoFromBluetoothCtl(QMap<QString, QString> &mapInfo, const
 
 bool CmdTool::getDeviceInfo(QString &deviceInfo, const QString &debugFile)
 {
+    // rawInfoHash 已读取过的原始输出直接使用
+    if (m_RawInfo.contains(debugFile)) {
+        deviceInfo = m_RawInfo.take(debugFile);
+        return true;
+    }
+
     QString key = debugFile;
     key.replace(".txt", "");
     if (DBusInterface::getInstance()->getInfo(key, deviceInfo))
@@ -1521,6 +1590,12 @@ bool CmdTool::getDeviceInfoFromCmd(QString &deviceInfo, const QString &cmd)
 
 bool CmdTool::getCatDeviceInfo(QString &deviceInfo, const QString &debugFile)
 {
+    // rawInfoHash 已读取过的原始输出直接使用
+    if (m_RawInfo.contains(debugFile)) {
+        deviceInfo = m_RawInfo.take(debugFile);
+        return true;
+    }
+
     // deviceInfo 不为空时信息已读取
     if (!deviceInfo.isEmpty())
         return true;
@@ -18,6 +18,8 @@
 DWIDGET_USE_NAMESPACE
 DCORE_USE_NAMESPACE
 
+struct EnableDeviceRecord;
+
 /**
  * @brief The CmdTool class
  * 用于获取设备信息的类，主要执行命令获取信息，然后解析生成对应的map
@@ -34,6 +36,14 @@ public:
      */
     void loadCmdInfo(const QString &key, const QString &debugFile);
 
+    /**
+     * @brief rawInfoHash:计算命令原始输出的摘要,原始输出会暂存供随后的 loadCmdInfo 使用,避免重复读取
+     * @param key:与命令对应的关键字
+     * @param debugFile:调试时所需文件名
+     * @return 原始输出的md5摘要,解析结果还依赖其它数据源或读取失败时返回空
+     */
+    QByteArray rawInfoHash(const QString &key, const QString &debugFile);
+
     /**
      * @brief getCurNetworkLinkStatus:lshw -C network获取当前连接状态
      * @return
@@ -128,10 +138,17 @@ private:
     void getMulHwinfoInfo(const QString &info);
 
     /**
-     * @brief addWidthToMap
-     * @param mapInfo
+     * @brief getMapInfoFromEnableRecord : 将被禁用设备的记录转化为map形式
+     * @param record : 被禁用设备的记录
+     * @param mapInfo : 解析后的map
      */
-    void addWidthToMap(QMap<QString, QString> &mapInfo);
+    void getMapInfoFromEnableRecord(const EnableDeviceRecord &record, QMap<QString, QString> &mapInfo);
+
+    /**
+     * @brief addMulHwinfoMapInfo : 根据hwinfo中的设备类型添加设备信息
+     * @param mapInfo : 设备信息
+     */
+    void addMulHwinfoMapInfo(QMap<QString, QString> &mapInfo);
 
     /**
      * @brief getRemoveInfo
@@ -241,6 +258,13 @@ private:
          */
     void loadNvidiaSettingInfo(const QString &key, const QString &debugfile);
 
+    /**
+     * @brief loadNvidiaWidthInfo : 加载nvidia-settings -q GPUMemoryInterface 显存位宽信息
+     * @param key   nvidia_width
+     * @param debugfile  nvidia_width.txt
+     */
+    void loadNvidiaWidthInfo(const QString &key, const QString &debugfile);
+
     /**
      * @brief getMapInfoFromCmd:将通过命令获取的信息字符串，转化为map形式
      * @param info:命令获取的信息字符串
@@ -365,6 +389,7 @@ private:
 
 private:
     QMap<QString, QList<QMap<QString, QString> > > m_cmdInfo;
+    QMap<QString, QString>                         m_RawInfo;    //<! rawInfoHash 暂存的原始输出
 };
 
 #endif // CMDTOOL_H
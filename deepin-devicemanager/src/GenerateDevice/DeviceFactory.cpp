@@ -18,40 +18,53 @@
 // Qt库文件
 #include <QProcess>
 #include <QFile>
+#include <QMap>
 
 DeviceFactory::DeviceFactory()
 {
 
 }
 
+typedef DeviceGenerator *(*GeneratorCreator)();
+
+template<typename T>
+static DeviceGenerator *createGenerator()
+{
+    return new T();
+}
+
+// 生成器查找表,键为系统架构或 aarch64 下的主板厂商类型
+static const QMap<QString, GeneratorCreator> &generatorTable()
+{
+    static const QMap<QString, GeneratorCreator> table = {
+        {"x86_64", &createGenerator<X86Generator>},
+        {"mips64", &createGenerator<MipsGenerator>},
+        {"arm", &createGenerator<ArmGenerator>},
+        {"hw", &createGenerator<HWGenerator>},
+        {"KLVV", &createGenerator<KLVGenerator>},
+        {"KLVU", &createGenerator<KLUGenerator>},
+        {"PGUV", &createGenerator<PanguVGenerator>},
+        {"PGUW", &createGenerator<PanguVGenerator>},
+        {"PGUX", &createGenerator<PanguXGenerator>}
+    };
+    return table;
+}
+
+QString DeviceFactory::generatorKey(const PlatformProfile &profile)
+{
+    if (profile.arch != "aarch64")
+        return profile.arch;
+
+    // aarch64 下按主板厂商类型区分,未知厂商类型使用 hw 生成器
+    if (profile.boardVendorKey.isEmpty())
+        return "arm";
+    return generatorTable().contains(profile.boardVendorKey) ? profile.boardVendorKey : "hw";
+}
+
 DeviceGenerator *DeviceFactory::getDeviceGenerator()
 {
-    // 获取系统架构
-    QString arch = Common::getArch();
-
-    // 根据架构创建设备信息生成器
-    DeviceGenerator *generator = nullptr;
-    if (arch == "x86_64")
-        generator = new X86Generator();
-    else if (arch == "mips64")
-        generator = new MipsGenerator();
-    else if (arch == "aarch64") {
-        QString type = Common::boardVendorType();
-        if (!type.isEmpty()) {
-            if (type == "KLVV")
-                generator = new KLVGenerator();
-            else if (type == "PGUV" || type == "PGUW")
-                generator = new PanguVGenerator();
-            else if (type == "KLVU")
-                generator = new KLUGenerator();
-            else if (type == "PGUX")
-                generator = new PanguXGenerator();
-            else
-                generator = new HWGenerator();
-        } else
-            generator = new ArmGenerator();
-    } else
-        generator = new X86Generator();
-
-    return generator;
+    // 平台特征信息在进程内不变,生成器类型只计算一次
+    static const GeneratorCreator creator = generatorTable().value(generatorKey(Common::platformProfile()),
+                                                                   &createGenerator<X86Generator>);
+    return creator();
 }
@@ -8,6 +8,7 @@
 
 #include<QString>
 class DeviceGenerator;
+struct PlatformProfile;
 
 /**
  * @brief The DeviceFactory class
@@ -23,6 +24,13 @@ public:
      */
     static DeviceGenerator *getDeviceGenerator();
 
+    /**
+     * @brief generatorKey:根据平台特征信息获取生成器查找表的键
+     * @param profile:平台特征信息
+     * @return 生成器键,未知架构返回架构名,由调用方回退到 x86 生成器
+     */
+    static QString generatorKey(const PlatformProfile &profile);
+
 protected:
     DeviceFactory();
 };
@@ -7,6 +7,7 @@
 
 // 其它头文件
 #include "CmdTool.h"
+#include "DrmEdidCollector.h"
 #include "DeviceManager/DeviceManager.h"
 #include "DeviceManager/DeviceCpu.h"
 #include "DeviceManager/DeviceGpu.h"
@@ -238,8 +239,10 @@ void DeviceGenerator::generatorGpuDevice()
 
 void DeviceGenerator::generatorMonitorDevice()
 {
-    // 生成显示设备
+    // 生成显示设备,hwinfo 未探测到显示器时(如 Wayland 下无 DDC 权限)直接读取 drm sysfs
     getMonitorInfoFromHwinfo();
+    if (DeviceManager::instance()->cmdInfo("hwinfo_monitor").isEmpty())
+        getMonitorInfoFromDrm();
 }
 
 void DeviceGenerator::generatorNetworkDevice()
@@ -585,6 +588,9 @@ void DeviceGenerator::getGpuInfoFromHwinfo()
 {
     // 加载从hwinfo获取的显示适配器信息
     const QList<QMap<QString, QString>> &lstMap = DeviceManager::instance()->cmdInfo("hwinfo_display");
+    // 显存位宽由独立的探测任务采集,这里合并到NVIDIA显卡信息中
+    const QList<QMap<QString, QString>> &widthMap = DeviceManager::instance()->cmdInfo("nvidia_width");
+    QString nvidiaWidth = widthMap.isEmpty() ? QString() : widthMap[0].value("Width");
     QList<QMap<QString, QString> >::const_iterator it = lstMap.begin();
     for (; it != lstMap.end(); ++it) {
         if ((*it).size() < 5)
@@ -592,7 +598,13 @@ void DeviceGenerator::getGpuInfoFromHwinfo()
 
         DeviceGpu *device = new DeviceGpu();
         device->setForcedDisplay(true);
-        device->setHwinfoInfo(*it);
+        if (!nvidiaWidth.isEmpty() && (*it)["Vendor"].contains("NVIDIA Corporation")) {
+            QMap<QString, QString> mapInfo = *it;
+            mapInfo.insert("Width", nvidiaWidth);
+            device->setHwinfoInfo(mapInfo);
+        } else {
+            device->setHwinfoInfo(*it);
+        }
         DeviceManager::instance()->addGpuDevice(device);
         addBusIDFromHwinfo((*it)["SysFS BusID"]);
     }
@@ -657,6 +669,21 @@ void DeviceGenerator::getMonitorInfoFromHwinfo()
     }
 }
 
+void DeviceGenerator::getMonitorInfoFromDrm()
+{
+    // 加载从 drm sysfs 中读取的显示设备信息
+    DrmEdidCollector collector;
+    foreach (const DrmEdidCollector::Connector &connector, collector.connectedMonitors()) {
+        QMap<QString, QString> mapInfo;
+        if (!DrmEdidCollector::monitorInfo(connector, mapInfo))
+            continue;
+
+        DeviceMonitor *device = new DeviceMonitor();
+        device->setInfoFromEdid(mapInfo);
+        DeviceManager::instance()->addMonitor(device);
+    }
+}
+
 void DeviceGenerator::getMonitorInfoFromXrandrVerbose()
 {
     // 加载从xrandr --verbose中获取的显示设备信息
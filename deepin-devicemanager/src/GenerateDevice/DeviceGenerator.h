@@ -220,6 +220,11 @@ protected:
      */
     virtual void getMonitorInfoFromHwinfo();
 
+    /**
+     * @brief getMonitorInfoFromDrm:从drm sysfs的edid获取显示设备信息
+     */
+    virtual void getMonitorInfoFromDrm();
+
     /**
      * @brief getMonitorInfoFromXrandrVerbose:从xrandr --verbose获取显示设备信息
      */
@@ -0,0 +1,198 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "DeviceSnapshot.h"
+#include "DeviceManager.h"
+#include "DeviceSnapshotInfo.h"
+#include "GenerateDevicePool.h"
+#include "DDLog.h"
+
+// Qt库文件
+#include <QFile>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QLocale>
+#include <QSharedPointer>
+#include <QStandardPaths>
+#include <QLoggingCategory>
+
+using namespace DDLog;
+
+// 快照文件标识 "DMSN"
+#define SNAPSHOT_MAGIC 0x444D534E
+// 快照格式版本,写入内容或设备显示信息变化时需要递增
+#define SNAPSHOT_VERSION 2
+// 索引中每个设备占用的字节数: 类型、位置、概要长度、详细属性长度
+#define SNAPSHOT_ENTRY_SIZE 16
+
+/*
+ * 快照文件布局:
+ *   文件头   magic version bootId locale cpuNum count
+ *   索引     count 个定长项,每项为设备类型、记录位置、概要长度、详细属性长度
+ *   设备记录 概要信息后紧跟详细属性
+ */
+
+bool DeviceSnapshot::save(const QString &path)
+{
+    const QString file = path.isEmpty() ? snapshotPath() : path;
+    const QByteArray id = bootId();
+    if (id.isEmpty())
+        return false;
+
+    // 先生成每个设备的记录,再根据记录长度生成索引
+    QList<quint32> types;
+    QList<QByteArray> summaries;
+    QList<QByteArray> details;
+    for (int type = DT_Audio; type <= DT_Others; ++type) {
+        foreach (DeviceBaseInfo *device, *DeviceManager::instance()->convertDeviceListAddr(DeviceType(type))) {
+            QByteArray summary;
+            QDataStream summaryOut(&summary, QIODevice::WriteOnly);
+            summaryOut.setVersion(QDataStream::Qt_5_11);
+            DeviceSnapshotInfo::writeSummary(summaryOut, device);
+
+            QByteArray detail;
+            QDataStream detailOut(&detail, QIODevice::WriteOnly);
+            detailOut.setVersion(QDataStream::Qt_5_11);
+            DeviceSnapshotInfo::writeDetail(detailOut, device);
+
+            types.append(quint32(type));
+            summaries.append(summary);
+            details.append(detail);
+        }
+    }
+
+    QByteArray head;
+    QDataStream headOut(&head, QIODevice::WriteOnly);
+    headOut.setVersion(QDataStream::Qt_5_11);
+    headOut << quint32(SNAPSHOT_MAGIC) << quint32(SNAPSHOT_VERSION) << id << QLocale::system().name()
+            << qint32(DeviceManager::instance()->cpuNum()) << quint32(types.size());
+
+    QByteArray index;
+    QDataStream indexOut(&index, QIODevice::WriteOnly);
+    quint32 offset = quint32(head.size() + types.size() * SNAPSHOT_ENTRY_SIZE);
+    for (int i = 0; i < types.size(); ++i) {
+        indexOut << types[i] << offset << quint32(summaries[i].size()) << quint32(details[i].size());
+        offset += quint32(summaries[i].size() + details[i].size());
+    }
+
+    QDir().mkpath(QFileInfo(file).absolutePath());
+
+    // 先写临时文件再替换,避免读到写了一半的快照
+    QSaveFile saveFile(file);
+    if (!saveFile.open(QIODevice::WriteOnly))
+        return false;
+
+    // 快照中包含只有 root 可读的设备信息(序列号等),不能让其他用户读取
+    if (!saveFile.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner)) {
+        saveFile.cancelWriting();
+        return false;
+    }
+
+    bool ok = saveFile.write(head) == head.size() && saveFile.write(index) == index.size();
+    for (int i = 0; ok && i < types.size(); ++i)
+        ok = saveFile.write(summaries[i]) == summaries[i].size() && saveFile.write(details[i]) == details[i].size();
+
+    if (!ok) {
+        saveFile.cancelWriting();
+        return false;
+    }
+    return saveFile.commit();
+}
+
+bool DeviceSnapshot::load(const QString &path)
+{
+    const QString fileName = path.isEmpty() ? snapshotPath() : path;
+
+    // 映射在所有恢复的设备释放后解除
+    QSharedPointer<QFile> file(new QFile(fileName));
+    if (!file->open(QIODevice::ReadOnly) || file->size() <= 0)
+        return false;
+
+    const qint64 size = file->size();
+    const uchar *addr = file->map(0, size);
+    if (!addr)
+        return false;
+
+    QByteArray bytes = QByteArray::fromRawData(reinterpret_cast<const char *>(addr), int(size));
+    QDataStream in(bytes);
+    in.setVersion(QDataStream::Qt_5_11);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QByteArray id;
+    QString locale;
+    qint32 cpuNum = 0;
+    quint32 count = 0;
+    in >> magic >> version;
+    bool valid = in.status() == QDataStream::Ok && SNAPSHOT_MAGIC == magic && SNAPSHOT_VERSION == version;
+    if (valid) {
+        in >> id >> locale >> cpuNum >> count;
+        valid = in.status() == QDataStream::Ok
+                && !id.isEmpty() && id == bootId()
+                && locale == QLocale::system().name()
+                && in.device()->pos() + qint64(count) * SNAPSHOT_ENTRY_SIZE <= size;
+    }
+
+    // 读取索引,只解析每个设备的概要信息
+    QList<QPair<DeviceType, DeviceSnapshotInfo *> > devices;
+    for (quint32 i = 0; valid && i < count; ++i) {
+        quint32 type = 0, offset = 0, summarySize = 0, detailSize = 0;
+        in >> type >> offset >> summarySize >> detailSize;
+        valid = in.status() == QDataStream::Ok
+                && type >= DT_Audio && type <= DT_Others
+                && qint64(offset) + summarySize + detailSize <= size;
+        if (!valid)
+            break;
+
+        DeviceSnapshotInfo *device = new DeviceSnapshotInfo(file, addr + offset + summarySize, int(detailSize));
+        devices.append(qMakePair(DeviceType(type), device));
+
+        QByteArray summary = QByteArray::fromRawData(reinterpret_cast<const char *>(addr + offset), int(summarySize));
+        QDataStream summaryIn(summary);
+        summaryIn.setVersion(QDataStream::Qt_5_11);
+        valid = device->setInfoFromSnapshot(summaryIn);
+    }
+
+    // 重启、语言或格式变化后快照不再可用,删除以免下次重复校验
+    if (!valid) {
+        for (int i = 0; i < devices.size(); ++i)
+            delete devices[i].second;
+        file.clear();
+        qCInfo(appLog) << "Device snapshot is invalid:" << fileName;
+        QFile::remove(fileName);
+        return false;
+    }
+
+    DeviceManager::instance()->clear();
+    for (int i = 0; i < devices.size(); ++i)
+        DeviceManager::instance()->convertDeviceListAddr(devices[i].first)->append(devices[i].second);
+    DeviceManager::instance()->setCpuNum(cpuNum);
+
+    qCInfo(appLog) << "Device snapshot loaded, device count:" << devices.size();
+    return true;
+}
+
+void DeviceSnapshot::remove(const QString &path)
+{
+    QFile::remove(path.isEmpty() ? snapshotPath() : path);
+}
+
+QString DeviceSnapshot::snapshotPath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+           + "/deepin/deepin-devicemanager/device_snapshot.bin";
+}
+
+QByteArray DeviceSnapshot::bootId()
+{
+    QFile file("/proc/sys/kernel/random/boot_id");
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    QByteArray id = file.readAll().trimmed();
+    file.close();
+    return id;
+}
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DEVICESNAPSHOT_H
+#define DEVICESNAPSHOT_H
+
+#include <QString>
+#include <QByteArray>
+
+/**
+ * @brief The DeviceSnapshot class
+ * 上一次生成的设备信息的二进制快照,保存在用户缓存目录,只有当前用户可读写
+ * 启动时先由快照恢复设备并显示,实时数据加载完成后再替换
+ * 快照以 mmap 方式读取,加载时只读取索引和概要信息,设备的详细属性在界面使用时才从映射内存中读取
+ * 系统重启(boot id 变化)、语言或格式版本变化时失效
+ */
+class DeviceSnapshot
+{
+public:
+    /**
+     * @brief save:将 DeviceManager 中当前生成的设备写入快照
+     * 在界面线程中写入显示信息、电池和网卡状态之后调用,没有缓存的显示信息临时生成,不保留在设备中
+     * @param path:快照文件路径,为空时使用默认路径
+     * @return true:保存成功;false:保存失败
+     */
+    static bool save(const QString &path = QString());
+
+    /**
+     * @brief load:读取快照并将恢复的设备写入 DeviceManager,调用前会清空 DeviceManager 中的设备
+     * @param path:快照文件路径,为空时使用默认路径
+     * @return true:快照有效且已加载;false:快照不存在或已失效
+     */
+    static bool load(const QString &path = QString());
+
+    /**
+     * @brief remove:删除快照
+     * @param path:快照文件路径,为空时使用默认路径
+     */
+    static void remove(const QString &path = QString());
+
+    /**
+     * @brief snapshotPath:默认快照文件路径
+     */
+    static QString snapshotPath();
+
+    /**
+     * @brief bootId:本次开机的唯一标识
+     */
+    static QByteArray bootId();
+};
+
+#endif // DEVICESNAPSHOT_H
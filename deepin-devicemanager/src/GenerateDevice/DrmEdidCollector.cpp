@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "DrmEdidCollector.h"
+#include "EdidDecoder.h"
+#include "DDLog.h"
+
+// Qt库文件
+#include <QDir>
+#include <QFile>
+#include <QRegularExpression>
+
+using namespace DDLog;
+
+#define EDID_BLOCK_SIZE     128
+
+DrmEdidCollector::DrmEdidCollector(const QString &sysfsPath)
+    : m_SysfsPath(sysfsPath)
+{
+
+}
+
+QList<DrmEdidCollector::Connector> DrmEdidCollector::connectors() const
+{
+    QList<Connector> lstConnector;
+
+    QDir dir(m_SysfsPath);
+    if (!dir.exists())
+        return lstConnector;
+
+    // 接口目录为 cardN-接口名,cardN 本身及 renderD* 等不是接口
+    static const QRegularExpression reConnector("^(card\\d+)-(.+)$");
+    const QStringList entries = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+    foreach (const QString &entry, entries) {
+        QRegularExpressionMatch match = reConnector.match(entry);
+        if (!match.hasMatch())
+            continue;
+
+        const QString dirPath = dir.filePath(entry);
+        Connector connector;
+        connector.card = match.captured(1);
+        connector.name = match.captured(2);
+        connector.status = QString::fromLatin1(readAttribute(dirPath, "status")).trimmed();
+        connector.enabled = readAttribute(dirPath, "enabled").trimmed() == "enabled";
+        connector.edid = readAttribute(dirPath, "edid");
+        lstConnector.append(connector);
+    }
+
+    return lstConnector;
+}
+
+QList<DrmEdidCollector::Connector> DrmEdidCollector::connectedMonitors(const QStringList &names) const
+{
+    QList<Connector> lstMonitor;
+    foreach (const Connector &connector, connectors()) {
+        if (!names.isEmpty() && !names.contains(connector.name))
+            continue;
+
+        // 部分虚拟显卡不上报连接状态,有edid即认为已连接
+        if (connector.status == "disconnected" || connector.edid.size() < EDID_BLOCK_SIZE)
+            continue;
+
+        lstMonitor.append(connector);
+    }
+    return lstMonitor;
+}
+
+bool DrmEdidCollector::monitorInfo(const Connector &connector, QMap<QString, QString> &mapInfo)
+{
+    if (connector.edid.size() < EDID_BLOCK_SIZE)
+        return false;
+
+    // sysfs 中的edid为原始字节,直接解码
+    EdidDecoder edidDecoder;
+    QString errorMsg;
+    if (!edidDecoder.decode(connector.edid, errorMsg)) {
+        qCWarning(appLog) << "Invalid edid of" << connector.card + "-" + connector.name << errorMsg;
+        return false;
+    }
+
+    mapInfo.insert("Vendor", edidDecoder.vendor());
+    mapInfo.insert("Model", edidDecoder.model());
+    mapInfo.insert("Date", edidDecoder.releaseDate());
+    mapInfo.insert("Size", edidDecoder.screenSize());
+    mapInfo.insert("Display Input", connector.name);
+    return true;
+}
+
+QByteArray DrmEdidCollector::readAttribute(const QString &dirPath, const QString &name)
+{
+    // sysfs 属性文件的大小不可信,直接读到文件结束
+    QFile file(dirPath + "/" + name);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
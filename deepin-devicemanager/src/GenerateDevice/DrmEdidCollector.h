@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DRMEDIDCOLLECTOR_H
+#define DRMEDIDCOLLECTOR_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QList>
+#include <QMap>
+
+/**
+ * @brief The DrmEdidCollector class
+ * 直接从 DRM sysfs(/sys/class/drm/cardN-XXX)读取显示接口的状态与edid
+ * 不依赖 xrandr、hexdump 等外部命令,Wayland 及无显示服务的环境下同样可用
+ */
+class DrmEdidCollector
+{
+public:
+    struct Connector {
+        QString       card;         //<! 显卡,如 card0
+        QString       name;         //<! 接口名,如 HDMI-A-1
+        QString       status;       //<! 连接状态 connected/disconnected/unknown
+        bool          enabled;      //<! 接口是否启用
+        QByteArray    edid;         //<! edid原始数据
+    };
+
+    /**
+     * @brief DrmEdidCollector:构造函数
+     * @param sysfsPath:drm类目录,测试时可指向构造的目录树
+     */
+    explicit DrmEdidCollector(const QString &sysfsPath = "/sys/class/drm");
+
+    /**
+     * @brief connectors:读取所有显示接口
+     * @return 按目录名排序的接口列表
+     */
+    QList<Connector> connectors() const;
+
+    /**
+     * @brief connectedMonitors:读取已连接且有edid的显示接口
+     * @param names:只保留这些接口,为空时不过滤
+     * @return 接口列表
+     */
+    QList<Connector> connectedMonitors(const QStringList &names = QStringList()) const;
+
+    /**
+     * @brief monitorInfo:解析接口的edid,生成显示设备信息
+     * @param connector:显示接口
+     * @param mapInfo:显示设备信息(Vendor、Model、Date、Size、Display Input)
+     * @return true:解析成功;false:edid无效
+     */
+    static bool monitorInfo(const Connector &connector, QMap<QString, QString> &mapInfo);
+
+private:
+    /**
+     * @brief readAttribute:读取接口目录下的属性文件
+     */
+    static QByteArray readAttribute(const QString &dirPath, const QString &name);
+
+private:
+    QString       m_SysfsPath;      //<! drm类目录
+};
+
+#endif // DRMEDIDCOLLECTOR_H
@@ -9,6 +9,9 @@
 
 #include "CmdTool.h"
 #include "DeviceManager.h"
+#include "DDLog.h"
+
+using namespace DDLog;
 
 static QMutex mutex;
 
@@ -29,14 +32,25 @@ CmdTask::~CmdTask()
 void CmdTask::run()
 {
     CmdTool tool;
+
+    // 原始输出与上次相同则直接复用上次的解析结果
+    QByteArray hash = tool.rawInfoHash(m_Key, m_File);
+    QMap<QString, QList<QMap<QString, QString> > > cachedInfo;
+    if (mp_Parent->cachedCmdInfo(m_Key, hash, cachedInfo)) {
+        mp_Parent->finishedCmd(m_Info, cachedInfo);
+        return;
+    }
+
     tool.loadCmdInfo(m_Key, m_File);
     const QMap<QString, QList<QMap<QString, QString> > > &cmdInfo = tool.cmdInfo();
+    mp_Parent->saveCmdInfo(m_Key, hash, cmdInfo);
     mp_Parent->finishedCmd(m_Info, cmdInfo);
 }
 
 GetInfoPool::GetInfoPool()
     : m_Arch("")
     , m_FinishedNum(0)
+    , m_ParsedNum(0)
 {
     initCmd();
 }
@@ -59,11 +73,64 @@ void GetInfoPool::finishedCmd(const QString &info, const QMap<QString, QList<QMa
     QMutexLocker m_lock(&mutex);
     m_FinishedNum++;
     if (m_FinishedNum == m_CmdList.size()) {
+        // 记录本次刷新节省的解析工作量
+        {
+            QMutexLocker locker(&m_CacheMutex);
+            m_SkippedKeys = m_CurSkippedKeys;
+            m_CurSkippedKeys.clear();
+        }
+        m_ParsedNum = m_FinishedNum - m_SkippedKeys.size();
+        qCInfo(appLog) << "Cmd info parsed:" << m_ParsedNum << "skipped:" << m_SkippedKeys.size() << m_SkippedKeys;
+
         emit finishedAll(info);
         m_FinishedNum = 0;
     }
 }
 
+bool GetInfoPool::cachedCmdInfo(const QString &key, const QByteArray &hash, QMap<QString, QList<QMap<QString, QString> > > &cmdInfo)
+{
+    if (hash.isEmpty())
+        return false;
+
+    QMutexLocker locker(&m_CacheMutex);
+    QMap<QString, ParsedCmdInfo>::const_iterator it = m_ParsedCache.constFind(key);
+    if (it == m_ParsedCache.constEnd() || it->hash != hash)
+        return false;
+
+    cmdInfo = it->cmdInfo;
+    m_CurSkippedKeys.append(key);
+    return true;
+}
+
+void GetInfoPool::saveCmdInfo(const QString &key, const QByteArray &hash, const QMap<QString, QList<QMap<QString, QString> > > &cmdInfo)
+{
+    QMutexLocker locker(&m_CacheMutex);
+    if (hash.isEmpty()) {
+        m_ParsedCache.remove(key);
+        return;
+    }
+
+    ParsedCmdInfo parsed;
+    parsed.hash = hash;
+    parsed.cmdInfo = cmdInfo;
+    m_ParsedCache.insert(key, parsed);
+}
+
+int GetInfoPool::parsedNum() const
+{
+    return m_ParsedNum;
+}
+
+int GetInfoPool::skippedNum() const
+{
+    return m_SkippedKeys.size();
+}
+
+QStringList GetInfoPool::skippedKeys() const
+{
+    return m_SkippedKeys;
+}
+
 void GetInfoPool::setFramework(const QString &arch)
 {
     // 设置架构
@@ -98,6 +165,7 @@ void GetInfoPool::initCmd()
     m_CmdList.append({ "dmesg",                "dmesg.txt",              tr("Loading Power Info...")});
     m_CmdList.append({ "hciconfig",            "hciconfig.txt",          tr("Loading Printer Info...")});
     m_CmdList.append({ "nvidia",               "nvidia.txt",             ""});
+    m_CmdList.append({ "nvidia_width",         "nvidia_width.txt",       ""});
 
     m_CmdList.append({ "cat_boardinfo",        "/proc/boardinfo",        tr("Loading Mouse Info...")});
     m_CmdList.append({ "cat_os_release",       "/etc/os-release",        tr("Loading Network Adapter Info...")});
@@ -8,6 +8,9 @@
 
 #include <QObject>
 #include <QThreadPool>
+#include <QMap>
+#include <QMutex>
+#include <QStringList>
 
 class GetInfoPool;
 
@@ -49,6 +52,39 @@ public:
      * @param cmdInfo
      */
     void finishedCmd(const QString &info, const QMap<QString, QList<QMap<QString, QString> > > &cmdInfo);
+
+    /**
+     * @brief cachedCmdInfo:原始输出摘要未变化时获取上次的解析结果
+     * @param key:命令关键字
+     * @param hash:本次原始输出的摘要
+     * @param cmdInfo:上次的解析结果
+     * @return 摘要相同时返回true
+     */
+    bool cachedCmdInfo(const QString &key, const QByteArray &hash, QMap<QString, QList<QMap<QString, QString> > > &cmdInfo);
+
+    /**
+     * @brief saveCmdInfo:保存解析结果及其原始输出的摘要,摘要为空时不保存
+     * @param key:命令关键字
+     * @param hash:原始输出的摘要
+     * @param cmdInfo:解析结果
+     */
+    void saveCmdInfo(const QString &key, const QByteArray &hash, const QMap<QString, QList<QMap<QString, QString> > > &cmdInfo);
+
+    /**
+     * @brief parsedNum:上一次刷新实际解析的命令个数
+     */
+    int parsedNum() const;
+
+    /**
+     * @brief skippedNum:上一次刷新因原始输出未变化而跳过解析的命令个数
+     */
+    int skippedNum() const;
+
+    /**
+     * @brief skippedKeys:上一次刷新跳过解析的命令关键字
+     */
+    QStringList skippedKeys() const;
+
     /**
      * @brief setFramework：设置架构
      * @param arch:架构
@@ -65,9 +101,19 @@ private:
     void initCmd();
 
 private:
+    struct ParsedCmdInfo {
+        QByteArray                                         hash;       //<! 原始输出的摘要
+        QMap<QString, QList<QMap<QString, QString> > >     cmdInfo;    //<! 解析结果
+    };
+
     QString                      m_Arch;
     QList<QStringList>           m_CmdList;
     int                          m_FinishedNum;
+    QMutex                       m_CacheMutex;       //<! 保护解析结果缓存
+    QMap<QString, ParsedCmdInfo> m_ParsedCache;      //<! 命令关键字到上次解析结果的缓存
+    QStringList                  m_CurSkippedKeys;   //<! 本次刷新跳过解析的命令
+    int                          m_ParsedNum;        //<! 上一次刷新解析的命令个数
+    QStringList                  m_SkippedKeys;      //<! 上一次刷新跳过解析的命令
 };
 
 #endif // READFILEPOOL_H
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "GpuProbe.h"
+
+// Qt库文件
+#include <QProcess>
+#include <QFile>
+#include <QDateTime>
+#include <QMutexLocker>
+
+// 显卡配置在运行期间基本不变,刷新时一分钟内复用上次的探测结果
+#define GPU_PROBE_TTL 60000
+
+GpuProbe *GpuProbe::instance()
+{
+    static GpuProbe probe;
+    return &probe;
+}
+
+GpuProbe::GpuProbe()
+    : m_Ttl(GPU_PROBE_TTL)
+{
+
+}
+
+QString GpuProbe::output(const QString &program, const QStringList &args)
+{
+    const QString cmd = (QStringList() << program << args).join(" ");
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    {
+        QMutexLocker locker(&m_Mutex);
+        QMap<QString, ProbeResult>::const_iterator it = m_Results.constFind(cmd);
+        if (it != m_Results.constEnd() && now - it->timestamp < m_Ttl)
+            return it->output;
+    }
+
+    // 执行命令时不持锁,不同的探测命令可以并行执行
+    ProbeResult result;
+    result.output = runCmd(program, args);
+    result.timestamp = now;
+
+    QMutexLocker locker(&m_Mutex);
+    m_Results.insert(cmd, result);
+    return result.output;
+}
+
+void GpuProbe::setTtl(qint64 msec)
+{
+    QMutexLocker locker(&m_Mutex);
+    m_Ttl = msec;
+}
+
+void GpuProbe::clear()
+{
+    QMutexLocker locker(&m_Mutex);
+    m_Results.clear();
+}
+
+bool GpuProbe::nvidiaDriverLoaded()
+{
+    return QFile::exists("/proc/driver/nvidia/version");
+}
+
+QString GpuProbe::runCmd(const QString &program, const QStringList &args)
+{
+    QProcess process;
+    process.start(program, args);
+    process.waitForFinished(-1);
+    return process.readAllStandardOutput();
+}
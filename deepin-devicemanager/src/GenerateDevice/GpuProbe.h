@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef GPUPROBE_H
+#define GPUPROBE_H
+
+#include <QString>
+#include <QStringList>
+#include <QMap>
+#include <QMutex>
+
+/**
+ * @brief The GpuProbe class
+ * 厂商显卡探测命令(nvidia-smi、nvidia-settings)的结果缓存
+ * 探测作为独立的采集任务在线程池中与其它命令并行执行,有效期内重复刷新不再启动进程
+ */
+class GpuProbe
+{
+public:
+    static GpuProbe *instance();
+
+    /**
+     * @brief output:获取命令输出,有效期内直接返回缓存
+     * @param program:探测程序
+     * @param args:命令参数
+     * @return 命令的标准输出
+     */
+    QString output(const QString &program, const QStringList &args);
+
+    /**
+     * @brief setTtl:设置缓存有效期
+     * @param msec:有效期,单位毫秒,小于等于0时不缓存
+     */
+    void setTtl(qint64 msec);
+
+    /**
+     * @brief clear:清空缓存
+     */
+    void clear();
+
+    /**
+     * @brief nvidiaDriverLoaded:是否加载了nvidia闭源驱动,未加载时nvidia-smi/nvidia-settings均无输出
+     * @return 是否加载
+     */
+    static bool nvidiaDriverLoaded();
+
+private:
+    GpuProbe();
+
+    /**
+     * @brief runCmd:执行命令
+     * @param program:程序
+     * @param args:命令参数
+     * @return 命令的标准输出
+     */
+    QString runCmd(const QString &program, const QStringList &args);
+
+    struct ProbeResult {
+        QString    output;       //<! 命令输出
+        qint64     timestamp;    //<! 采集时间
+    };
+
+    QMutex                        m_Mutex;      //<! 保护缓存
+    QMap<QString, ProbeResult>    m_Results;    //<! 命令行到结果的缓存
+    qint64                        m_Ttl;        //<! 缓存有效期
+};
+
+#endif // GPUPROBE_H
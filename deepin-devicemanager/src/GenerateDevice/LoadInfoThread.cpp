@@ -7,6 +7,7 @@
 #include "GenerateDevicePool.h"
 #include "DBusInterface.h"
 #include "DeviceManager.h"
+#include "DeviceSnapshot.h"
 
 #include <DApplication>
 
@@ -26,6 +27,8 @@ LoadInfoThread::LoadInfoThread()
     , m_Running(false)
     , m_FinishedReadFilePool(false)
     , m_Start(true)
+    , m_SnapshotChecked(false)
+    , m_Generated(false)
 {
     connect(&mp_ReadFilePool, &GetInfoPool::finishedAll, this, &LoadInfoThread::slotFinishedReadFilePool);
 }
@@ -47,11 +50,23 @@ LoadInfoThread::~LoadInfoThread()
 
 void LoadInfoThread::run()
 {
+    m_Running = true;
+    m_Generated = false;
+
+    // 首次加载时先显示上次保存的设备,界面显示后再加载实时信息
+    if (!m_SnapshotChecked) {
+        m_SnapshotChecked = true;
+        if (DeviceSnapshot::load()) {
+            m_Running = false;
+            emit finished("snapshot");
+            return;
+        }
+    }
+
     // 判断后台是否正处理update状态
     QString info;
     DBusInterface::getInstance()->getInfo("is_server_running", info);
     // 请求后台更新信息
-    m_Running = true;
     if (!info.toInt()) {
         m_Start = false;
         mp_ReadFilePool.getAllInfo();
@@ -96,6 +111,7 @@ void LoadInfoThread::run()
         m_FinishedReadFilePool = false;
         mp_GenerateDevicePool.generateDevice();
         mp_GenerateDevicePool.waitForDone(-1);
+        m_Generated = true;
     }
 
     emit finished("finish");
@@ -118,3 +134,12 @@ void LoadInfoThread::setFramework(const QString &arch)
     mp_ReadFilePool.setFramework(arch);
 }
 
+void LoadInfoThread::setSnapshotEnabled(bool enable)
+{
+    m_SnapshotChecked = !enable;
+}
+
+bool LoadInfoThread::generated() const
+{
+    return m_Generated;
+}
@@ -24,6 +24,18 @@ public:
      */
     void setFramework(const QString &arch);
 
+    /**
+     * @brief setSnapshotEnabled：设置首次加载时是否先由快照生成设备
+     * @param enable:是否使用快照
+     */
+    void setSnapshotEnabled(bool enable);
+
+    /**
+     * @brief generated：最近一次加载是否重新生成了设备,由快照恢复或后台正在更新时为false
+     * @return 是否生成了设备
+     */
+    bool generated() const;
+
 signals:
     void finished(const QString &message);
     void finishedReadFilePool();
@@ -44,6 +56,8 @@ private:
     bool            m_Running;                      //<!  标识是否正在运行
     bool            m_FinishedReadFilePool;         //<!  标识生成读文件的线程池是否结束
     bool            m_Start;                        //<!  是否为启动
+    bool            m_SnapshotChecked;              //<!  是否已尝试由快照生成设备
+    bool            m_Generated;                    //<!  最近一次加载是否生成了设备
 
 };
 
@@ -8,7 +8,7 @@
 // 其它头文件
 #include "../DeviceManager/DeviceManager.h"
 #include "../DeviceManager/DeviceMonitor.h"
-#include "EDIDParser.h"
+#include "DrmEdidCollector.h"
 #include "DeviceManager/DeviceNetwork.h"
 #include <QProcess>
 
@@ -17,62 +17,22 @@ PanguVGenerator::PanguVGenerator()
 
 }
 
-void parseEDID(QStringList allEDIDS,QString input)
+void PanguVGenerator::generatorMonitorDevice()
 {
-    for (auto edid:allEDIDS) {
-        QProcess process;
-        process.start(QString("hexdump %1").arg(edid));
-        process.waitForFinished(-1);
-
-        QString deviceInfo = process.readAllStandardOutput();
-        if(deviceInfo.isEmpty())
+    // panguV 只读取 HDMI-A-1 与 VGA-1 两个接口,不显示型号
+    DrmEdidCollector collector;
+    foreach (const DrmEdidCollector::Connector &connector, collector.connectedMonitors(QStringList() << "HDMI-A-1" << "VGA-1")) {
+        QMap<QString, QString> mapInfo;
+        if (!DrmEdidCollector::monitorInfo(connector, mapInfo))
             continue;
+        mapInfo.remove("Model");
 
-        QString edidStr;
-        QStringList lines = deviceInfo.split("\n");
-        for (auto line:lines) {
-            QStringList words = line.trimmed().split(" ");
-            if(words.size() != 9)
-                continue;
-
-            words.removeAt(0);
-            QString l = words.join("");
-            l.append("\n");
-            edidStr.append(l);
-        }
-
-        lines = edidStr.split("\n");
-        if(lines.size() > 3){
-            EDIDParser edidParser;
-            QString errorMsg;
-            edidParser.setEdid(edidStr,errorMsg,"\n", false);
-
-            QMap<QString, QString> mapInfo;
-            mapInfo.insert("Vendor",edidParser.vendor());
-            mapInfo.insert("Date",edidParser.releaseDate());
-            mapInfo.insert("Size",edidParser.screenSize());
-            mapInfo.insert("Display Input",input);
-
-            DeviceMonitor *device = new DeviceMonitor();
-            device->setInfoFromEdid(mapInfo);
-            DeviceManager::instance()->addMonitor(device);
-        }
+        DeviceMonitor *device = new DeviceMonitor();
+        device->setInfoFromEdid(mapInfo);
+        DeviceManager::instance()->addMonitor(device);
     }
 }
 
-void PanguVGenerator::generatorMonitorDevice()
-{
-    QStringList allEDIDS1;
-    allEDIDS1.append("/sys/devices/platform/hisi-drm/drm/card0/card0-HDMI-A-1/edid");
-    allEDIDS1.append("/sys/devices/platform/hldrm/drm/card0/card0-HDMI-A-1/edid");
-    parseEDID(allEDIDS1,"HDMI-A-1");
-
-    QStringList allEDIDS2;
-    allEDIDS2.append("/sys/devices/platform/hisi-drm/drm/card0/card0-VGA-1/edid");
-    allEDIDS2.append("/sys/devices/platform/hldrm/drm/card0/card0-VGA-1/edid");
-    parseEDID(allEDIDS2,"VGA-1");
-}
-
 void PanguVGenerator::generatorNetworkDevice()
 {
     QStringList ifconfigCardName =  getNetworkInfoFromifconfig();
@@ -60,20 +60,18 @@
 
 /**
  * @brief EXPORT_TO_XLSX:导出设备信息到xlsx
- * @param boldFont:字体格式
- * @param htmlFile:xlsx文件
+ * @param xlsx:流式写出的xlsx文件
  * @param deviceLst:设备列表
  * @param type:设备类型
  * @param msg:没有设备时的提示信息
  */
-#define EXPORT_TO_XLSX(xlsx, boldFont, deviceLst, type, msg)                        \
+#define EXPORT_TO_XLSX(xlsx, deviceLst, type, msg)                                  \
     /**添加设备类型**/                                                                \
-    boldFont.setFontBold(true);                                                     \
-    xlsx.write(m_CurrentXlsRow++, 1, "[" + type + "]", boldFont);                   \
+    xlsx.write(xlsx.nextRow(), 1, "[" + type + "]", XlsxStreamWriter::CS_Bold);     \
     \
     /**无设备添加提示信息**/                                                           \
     if (deviceLst.size() < 1) {                                                     \
-        xlsx.write(m_CurrentXlsRow++, 1, msg, boldFont);                            \
+        xlsx.write(xlsx.nextRow(), 1, msg, XlsxStreamWriter::CS_Bold);              \
     }                                                                               \
     \
     /**添加Table信息**/                                                              \
@@ -91,21 +89,18 @@
         \
         /**设备数目大于1，添加子标题**/                                                 \
         if (deviceLst.size() > 1) {                                                 \
-            boldFont.setFontSize(10);                                               \
-            boldFont.setFontBold(true);                                             \
-            \
-            xlsx.write(m_CurrentXlsRow++, 1, device->subTitle(), boldFont);         \
+            xlsx.write(xlsx.nextRow(), 1, device->subTitle(), XlsxStreamWriter::CS_SmallBold); \
         }                                                                           \
         \
         /**添加设备的详细信息**/                                                       \
-        device->toXlsxString(xlsx, boldFont);                                       \
-        m_CurrentXlsRow++;\
+        device->toXlsxString(xlsx);                                                 \
+        xlsx.nextRow();                                                             \
     }                                                                               \
     \
 
 /**
  * @brief EXPORT_TO_DOC:导出设备信息到doc
- * @param htmlFile:doc文件
+ * @param doc:流式写出的doc文件
  * @param deviceLst:设备列表
  * @param type:设备类型
  * @param msg:没有设备时的提示信息
@@ -120,15 +115,14 @@
         doc.addParagraph(msg);                                                      \
     }                                                                               \
     \
-    /**添加表格信息**/\
-    if (deviceLst.size() > 1) {\
-        Docx::Table *tab = doc.addTable(1,0);\
-        deviceLst[0]->tableHeaderToDoc(tab);\
-        for (int row = 1; row <= deviceLst.size(); ++row) {\
-            tab->addRow();\
-            deviceLst[row - 1]->tableInfoToDoc(tab, row);\
-        }\
-    }\
+    /**添加表格信息**/                                                              \
+    if (deviceLst.size() > 1) {                                                     \
+        deviceLst[0]->tableHeaderToDoc(doc);                                        \
+        foreach (auto device, deviceLst) {                                          \
+            device->tableInfoToDoc(doc);                                            \
+        }                                                                           \
+        doc.endTable();                                                             \
+    }                                                                               \
     /**添加每个设备的信息**/                                                           \
     foreach (auto device, deviceLst) {                                              \
         \
@@ -148,7 +142,7 @@
 
 /**
  * @brief EXPORT_TO_HTML:导出设备信息到html
- * @param htmlFile:html文件
+ * @param htmlFile:html输出设备
  * @param deviceLst:设备列表
  * @param type:设备类型
  * @param msg:没有设备时的提示信息
@@ -156,40 +150,35 @@
 #define EXPORT_TO_HTML(htmlFile, deviceLst, type, msg)                              \
     \
     /**添加设备类型**/                                                                \
-    htmlFile.write((QString("<h2>") + "[" + type + "]" + "</h2>").toUtf8());        \
+    htmlFile.write((QString("<h2>") + "[" + (type).toHtmlEscaped() + "]" + "</h2>").toUtf8()); \
     \
     /**无设备添加提示信息**/                                                           \
     if (deviceLst.size() < 1) {                                                     \
-        htmlFile.write((QString("<h2>") + msg + "</h2>").toUtf8());                 \
+        htmlFile.write((QString("<h2>") + (msg).toHtmlEscaped() + "</h2>").toUtf8()); \
     }                                                                               \
     \
-    /**添加表格信息**/\
-    if(deviceLst.size() > 1) {\
-        html.write("<table border=\"0\" white-space:pre>\n");\
-        deviceLst[0]->tableHeaderToHtml(html);\
-        foreach(auto device, deviceLst) {\
-            device->tableInfoToHtml(html);\
-        }\
-        html.write("</table>\n");\
-    }\
+    /**添加表格信息**/                                                              \
+    if (deviceLst.size() > 1) {                                                     \
+        htmlFile.write("<table border=\"0\" white-space:pre>\n");                   \
+        deviceLst[0]->tableHeaderToHtml(htmlFile);                                  \
+        foreach (auto device, deviceLst) {                                          \
+            device->tableInfoToHtml(htmlFile);                                      \
+        }                                                                           \
+        htmlFile.write("</table>\n");                                               \
+    }                                                                               \
     \
-    /**添加每个设备的信息**/                                                           \
+    /**添加每个设备的信息,逐个设备直接写出**/                                            \
     foreach (auto device, deviceLst) {                                              \
-        QDomDocument doc;                                                           \
-        \
         device->getBaseAttribs();                                                   \
         device->getOtherAttribs();                                                  \
         /**设备数目大于1，添加子标题**/                                                 \
-        if (deviceLst.size() > 1) {                                                     \
-            device->subTitleToHTML(doc);                                            \
+        if (deviceLst.size() > 1) {                                                 \
+            device->subTitleToHTML(htmlFile);                                       \
         }                                                                           \
         \
         /**添加设备的详细信息**/                                                       \
-        device->toHtmlString(doc);\
-        doc.appendChild(doc.createElement("br"));                                   \
-        \
-        htmlFile.write(doc.toString().toStdString().data());                        \
-        \
+        device->toHtmlString(htmlFile);                                             \
+        htmlFile.write("<br/>\n");                                                  \
     }                                                                               \
     \
 
@@ -34,6 +34,7 @@ DeviceWidget::DeviceWidget(QWidget *parent)
 
     connect(mp_ListView, &PageListView::refreshActionTrigger, this, &DeviceWidget::refreshInfo);
     connect(mp_ListView, &PageListView::exportActionTrigger, this, &DeviceWidget::exportInfo);
+    connect(mp_ListView, &PageListView::searchTextChanged, this, &DeviceWidget::slotSearchTextChanged);
 }
 
 DeviceWidget::~DeviceWidget()
@@ -54,7 +55,8 @@ DeviceWidget::~DeviceWidget()
 
 void DeviceWidget::updateListView(const QList<QPair<QString, QString> > &lst)
 {
-    // 更新左边的列表
+    // 设备已重新生成,先更新搜索结果再更新左边的列表
+    updateSearchResult();
     if (mp_ListView)
         mp_ListView->updateListItems(lst);
 }
@@ -66,7 +68,7 @@ void DeviceWidget::updateDevice(const QString &itemStr, const QList<DeviceBaseIn
 
     // 更新右边的详细内容
     if (mp_PageInfo)
-        mp_PageInfo->updateTable(itemStr, lst);
+        mp_PageInfo->updateTable(itemStr, filteredDevices(itemStr, lst));
 }
 
 void DeviceWidget::updateOverview(const QMap<QString, QString> &map)
@@ -79,6 +81,12 @@ void DeviceWidget::updateOverview(const QMap<QString, QString> &map)
         mp_PageInfo->updateTable(map);
 }
 
+void DeviceWidget::updateDeviceData()
+{
+    if (mp_PageInfo)
+        mp_PageInfo->updateDeviceData();
+}
+
 QString DeviceWidget::currentIndex() const
 {
     // 当前设备类型
@@ -93,6 +101,7 @@ void DeviceWidget::setFontChangeFlag()
 
 void DeviceWidget::clear()
 {
+    m_SearchResult.clear();
     mp_ListView->clear();
     mp_PageInfo->clear();
 }
@@ -110,6 +119,48 @@ void DeviceWidget::slotUpdateUI()
     emit itemClicked(m_CurItemStr);
 }
 
+void DeviceWidget::slotSearchTextChanged(const QString &text)
+{
+    m_SearchText = text.trimmed();
+    updateSearchResult();
+
+    // 当前类型没有匹配的设备时切换到第一个匹配的类型,都没有匹配时显示概况
+    QString curType = mp_ListView->currentType();
+    if (!m_SearchText.isEmpty() && !m_SearchResult.contains(curType)) {
+        curType = DeviceManager::tr("Overview");
+        foreach (auto iter, DeviceManager::instance()->getDeviceTypes()) {
+            if (m_SearchResult.contains(iter.first)) {
+                curType = iter.first;
+                break;
+            }
+        }
+        mp_ListView->setCurType(curType);
+    }
+
+    m_CurItemStr = curType;
+    emit itemClicked(curType);
+}
+
+void DeviceWidget::updateSearchResult()
+{
+    if (m_SearchText.isEmpty()) {
+        m_SearchResult.clear();
+        mp_ListView->setItemFilter(QStringList());
+        return;
+    }
+
+    // 概况始终显示
+    m_SearchResult = DeviceManager::instance()->searchDevices(m_SearchText);
+    mp_ListView->setItemFilter(QStringList() << DeviceManager::tr("Overview") << m_SearchResult.keys());
+}
+
+QList<DeviceBaseInfo *> DeviceWidget::filteredDevices(const QString &itemStr, const QList<DeviceBaseInfo *> &lst) const
+{
+    if (m_SearchText.isEmpty() || !m_SearchResult.contains(itemStr))
+        return lst;
+    return m_SearchResult.value(itemStr);
+}
+
 void DeviceWidget::resizeEvent(QResizeEvent *event)
 {
     DWidget::resizeEvent(event);
@@ -130,6 +181,7 @@ void DeviceWidget::resizeEvent(QResizeEvent *event)
     // 根据设备类别获取设备指针
     QList<DeviceBaseInfo *> lst;
     bool ret = DeviceManager::instance()->getDeviceList(deviceType, lst);
+    lst = filteredDevices(deviceType, lst);
     if (! ret) {
         // 更新Overview界面
         QMap<QString, QString> overviewMap = DeviceManager::instance()->getDeviceOverview();
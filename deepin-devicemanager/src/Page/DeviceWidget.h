@@ -10,6 +10,7 @@
 #include <QHBoxLayout>
 #include <DWidget>
 #include <DSplitter>
+#include <QMap>
 
 class PageListView;
 class PageInfoWidget;
@@ -47,6 +48,11 @@ public:
      */
     void updateOverview(const QMap<QString, QString> &map);
 
+    /**
+     * @brief updateDeviceData:当前显示的设备属性变化,设备列表未变化时就地更新
+     */
+    void updateDeviceData();
+
     /**
      * @brief currentIndex:当前设备类型
      * @return 设备类型
@@ -94,6 +100,12 @@ private slots:
      */
     void slotUpdateUI();
 
+    /**
+     * @brief slotSearchTextChanged:搜索内容变化,过滤左侧列表并刷新当前界面
+     * @param text:搜索内容
+     */
+    void slotSearchTextChanged(const QString &text);
+
 protected:
     /**
      * @brief: 事件的重写
@@ -104,11 +116,26 @@ private:
     /**@brief:初始化界面布局*/
     void initWidgets();
 
+    /**
+     * @brief updateSearchResult:按当前搜索内容重新搜索,设备刷新后原有结果中的设备可能已释放
+     */
+    void updateSearchResult();
+
+    /**
+     * @brief filteredDevices:搜索时只保留该类型中匹配的设备
+     * @param itemStr:设备类型
+     * @param lst:该类型的所有设备
+     * @return 显示的设备
+     */
+    QList<DeviceBaseInfo *> filteredDevices(const QString &itemStr, const QList<DeviceBaseInfo *> &lst) const;
+
 private:
     PageListView              *mp_ListView;          //<! 左边的list
     PageInfoWidget            *mp_PageInfo;          //<! 右边的详细内容
     QString                   m_CurItemStr;          //<! 当前Item内容
     QHBoxLayout               *m_Layout;             //<! layout
+    QString                   m_SearchText;          //<! 搜索内容
+    QMap<QString, QList<DeviceBaseInfo *> > m_SearchResult;  //<! 搜索结果,设备类型与匹配的设备
 };
 
 #endif // DETAILWIDGET_H
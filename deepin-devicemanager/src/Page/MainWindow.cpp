@@ -12,12 +12,17 @@
 #include "DebugTimeManager.h"
 #include "commondefine.h"
 #include "LoadInfoThread.h"
+#include "DeviceSnapshot.h"
 #include "DeviceFactory.h"
-#include "ThreadExecXrandr.h"
+#include "XrandrCache.h"
+#include "UPowerMonitor.h"
+#include "NetLinkMonitor.h"
 #include "LoadCpuInfoThread.h"
+#include "CpuFreqSampler.h"
 #include "CmdTool.h"
 #include "commonfunction.h"
 #include "DriverScanWidget.h"
+#include "ExportInfoThread.h"
 #include "DDLog.h"
 
 // Dtk头文件
@@ -27,6 +32,7 @@
 #include <DButtonBox>
 #include <DTitlebar>
 #include <DDialog>
+#include <DMessageManager>
 #include <QShortcut>
 #ifdef DTKCORE_CLASS_DConfigFile
 #include <DConfig>
@@ -54,7 +60,6 @@ using namespace DDLog;
 #define MIN_HEIGHT 300      // 窗口的最小高度
 
 static bool startScanningFlag = false;
-static int monitorNumber = 1;
 static bool checkWaylandMode()
 {
     auto e = QProcessEnvironment::systemEnvironment();
@@ -72,23 +77,91 @@ MainWindow::MainWindow(QWidget *parent)
     , mp_MainStackWidget(new DStackedWidget(this))
     , mp_WaitingWidget(new WaitingWidget(this))
     , mp_DeviceWidget(new DeviceWidget(this))
-    , mp_DriverScanWidget(new DriverScanWidget(this))
-    , mp_DriverManager(new PageDriverManager(this))
+    , mp_DriverScanWidget(nullptr)
+    , mp_DriverManager(nullptr)
     , mp_WorkingThread(new LoadInfoThread)
+    , mp_ExportThread(nullptr)
+    , mp_ExportDialog(nullptr)
+    , mp_ExportProgress(nullptr)
     , mp_ButtonBox(new DButtonBox(this))
 {
+    // 驱动管理界面、导出线程及各信息监听在首次绘制后或首次使用时才创建,不占用首屏时间
+    STARTUP_TRACE("MainWindow construct");
+
     // 初始化窗口相关的内容，比如界面布局，控件大小
     initWindow();
+    STARTUP_TRACE("MainWindow initWindow");
 
     // 加载设备信息
     refreshDataBase();
+    STARTUP_TRACE("load thread started");
 
     // 关联信号槽
     connect(mp_WorkingThread, &LoadInfoThread::finished, this, &MainWindow::slotLoadingFinish);
+    // 快照显示后,加载线程结束时再开始加载实时信息;加载期间切换的界面在设备替换后重新加载
+    connect(static_cast<QThread *>(mp_WorkingThread), &QThread::finished, this, [ = ]() {
+        if (m_LoadAfterSnapshot) {
+            m_LoadAfterSnapshot = false;
+            refreshDataBase();
+        } else if (m_ItemClickDeferred && !m_refreshing) {
+            m_ItemClickDeferred = false;
+            slotListItemClicked(mp_DeviceWidget->currentIndex());
+        }
+    });
     connect(mp_DeviceWidget, &DeviceWidget::itemClicked, this, &MainWindow::slotListItemClicked);
     connect(mp_DeviceWidget, &DeviceWidget::refreshInfo, this, &MainWindow::slotRefreshInfo);
     connect(mp_DeviceWidget, &DeviceWidget::exportInfo, this, &MainWindow::slotExportInfo);
     connect(this, &MainWindow::fontChange, this, &MainWindow::slotChangeUI);
+
+    // 处理器界面显示时定时采样频率
+    connect(CpuFreqSampler::instance(), &CpuFreqSampler::sampled, this, &MainWindow::slotCpuFreqSampled);
+
+    connect(mp_WorkingThread, &LoadInfoThread::finishedReadFilePool, this, [ = ]() {
+        refreshDataBaseLater();
+    });
+}
+
+void MainWindow::initDeferred()
+{
+    if (m_DeferredInit)
+        return;
+    m_DeferredInit = true;
+
+    // 显示信息在后台获取并缓存,显示配置变化时才重新获取
+    connect(XrandrCache::instance(), &XrandrCache::updated, this, &MainWindow::slotXrandrUpdated);
+    connect(XrandrCache::instance(), &XrandrCache::monitorNumberChanged, this, [ = ]() {
+        QString info;
+        DBusInterface::getInstance()->getInfo("is_server_running", info);
+        //请求后台更新信息
+        if (!info.toInt())
+            refreshDataBaseLater();
+        qCDebug(appLog) << "Monitor refreshInfo" << QDateTime::currentDateTime().toString("hh:mm:ss") << info;
+    });
+    XrandrCache::instance()->start(!checkWaylandMode());
+
+    // 电池信息由 UPower 信号驱动更新
+    connect(UPowerMonitor::instance(), &UPowerMonitor::updated, this, &MainWindow::slotBatteryUpdated);
+    UPowerMonitor::instance()->start();
+
+    // 网卡连接状态由 rtnetlink 链路消息驱动更新
+    connect(NetLinkMonitor::instance(), &NetLinkMonitor::updated, this, &MainWindow::slotNetworkUpdated);
+    NetLinkMonitor::instance()->start();
+
+    STARTUP_TRACE("deferred init");
+}
+
+void MainWindow::initDriverPages()
+{
+    if (mp_DriverManager)
+        return;
+
+    mp_DriverScanWidget = new DriverScanWidget(this);
+    mp_DriverManager = new PageDriverManager(this);
+
+    // 驱动扫描界面和驱动管理主界面分别位于 2、3
+    mp_MainStackWidget->addWidget(mp_DriverScanWidget);
+    mp_MainStackWidget->addWidget(mp_DriverManager);
+
     connect(mp_DriverManager, &PageDriverManager::startScanning, this, [ = ]() {
         // 正在刷新,避免重复操作
         if (m_refreshing || mp_WorkingThread->isRunning()) {
@@ -119,15 +192,18 @@ MainWindow::MainWindow(QWidget *parent)
         mp_DriverScanWidget->refreshProgress(info, progress);
     });
     connect(mp_DriverScanWidget, &DriverScanWidget::redetected, mp_DriverManager, &PageDriverManager::startScanning);
-    //get monitorNumber
-    ThreadExecXrandr txgpu(true, !checkWaylandMode());
-    txgpu.start();
-    txgpu.wait();
-    monitorNumber = txgpu.getMonitorNumber();
-    connect(mp_WorkingThread, &LoadInfoThread::finishedReadFilePool, this, [ = ]() {
-        refreshDataBaseLater();
-    });
 }
+
+void MainWindow::initExportThread()
+{
+    if (mp_ExportThread)
+        return;
+
+    mp_ExportThread = new ExportInfoThread(this);
+    connect(mp_ExportThread, &ExportInfoThread::progressChanged, this, &MainWindow::slotExportProgress);
+    connect(mp_ExportThread, &ExportInfoThread::exportFinished, this, &MainWindow::slotExportFinished);
+}
+
 void MainWindow::refreshDataBaseLater()
 {
     DBusInterface::getInstance()->refreshInfo();
@@ -139,6 +215,12 @@ void MainWindow::refreshDataBaseLater()
 
 MainWindow::~MainWindow()
 {
+    // 导出线程访问设备信息,需先结束
+    if (mp_ExportThread && mp_ExportThread->isRunning()) {
+        mp_ExportThread->cancel();
+        mp_ExportThread->wait();
+    }
+
     // 释放指针
     if (mp_WorkingThread && mp_WorkingThread->isRunning())
         mp_WorkingThread->terminate();
@@ -168,9 +250,15 @@ void MainWindow::refresh()
     refreshBatteryStatus();
 
     // 正在刷新,避免重复操作
-    if (m_refreshing || startScanningFlag || mp_DriverManager->isScanning() || mp_WorkingThread->isRunning())
+    if (m_refreshing || startScanningFlag || (mp_DriverManager && mp_DriverManager->isScanning()) || mp_WorkingThread->isRunning())
         return;
 
+    // 正在导出,结束后再刷新
+    if (isExporting()) {
+        m_RefreshAfterExport = true;
+        return;
+    }
+
     if (mp_ButtonBox->checkedId() == 1) {
         startScanningFlag = true;
     }
@@ -182,6 +270,7 @@ void MainWindow::refresh()
     mp_MainStackWidget->setCurrentIndex(0);
     mp_ButtonBox->buttonList().at(0)->click();
     mp_DeviceWidget->clear();
+    m_PageCleared = true;
 
     // 加载设备信息
     refreshDataBase();
@@ -189,40 +278,16 @@ void MainWindow::refresh()
 
 void MainWindow::refreshBatteryStatus()
 {
-    QDBusConnection bus = QDBusConnection::systemBus();
-
-    //创建Dbus接口
-    QDBusInterface interfaceService("org.freedesktop.UPower", "/org/freedesktop/UPower", "org.freedesktop.UPower", bus);
-    if (interfaceService.isValid()) {
-         QProcess process;
-         QString command = "gdbus call --system --dest org.freedesktop.UPower --object-path /org/freedesktop/UPower --method org.freedesktop.UPower.EnumerateDevices";
-         process.start(command);
-         process.waitForFinished();
-
-         QByteArray output = process.readAllStandardOutput();
-         QString outputStr = QString::fromLocal8Bit(output);
-         QStringList outputList = outputStr.split(",");
-
-         foreach (const QString& str, outputList) {
-             if (str.contains("BAT")) {
-                 QStringList pathStr = str.split("'");
-                 if (pathStr.size() >= 2) {
-                     QDBusInterface interfaceBattery("org.freedesktop.UPower", pathStr.at(1), "org.freedesktop.UPower.Device", bus);
-                     if (interfaceBattery.isValid()) {
-                         QDBusMessage reply = interfaceBattery.call("Refresh");
-                         if (reply.type() != QDBusMessage::ReplyMessage)
-                             qWarning() << "call Refresh failure:" << reply.errorMessage();
-                     }
-                 }
-             }
-         }
-    } else {
-       qDebug() << "interface UPower invalid";
-    }
+    // 异步请求 UPower 重新读取电池,变化的属性通过 PropertiesChanged 返回
+    UPowerMonitor::instance()->refresh();
 }
 
 bool MainWindow::exportTo()
 {
+    // 正在导出或正在加载设备信息时不能导出
+    if (isExporting() || mp_WorkingThread->isRunning())
+        return false;
+
     QString selectFilter;
 
     // 导出信息文件保存路径
@@ -240,30 +305,71 @@ bool MainWindow::exportTo()
                        this,
                        "Export", saveDir + tr("Device Info", "export file's name") + \
                        QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss").remove(QRegularExpression("\\s")) + ".txt", \
-                       "Text (*.txt);; Doc (*.docx);; Xls (*.xls);; Html (*.html)", &selectFilter);  //
+                       "Text (*.txt);; Doc (*.docx);; Xls (*.xls);; Html (*.html);; Json (*.json);; Cbor (*.cbor)", &selectFilter);  //
 
     if (file.isEmpty())
         return true;
 
-    QFileInfo fileInfo(file);
-
-    // 文件类型txt
-    if (selectFilter == "Text (*.txt)")
-        return DeviceManager::instance()->exportToTxt(file);
+    DeviceManager::ExportFormat format;
+    if (selectFilter == "Text (*.txt)") {
+        // 文件类型txt
+        format = DeviceManager::EF_Txt;
+    } else if (selectFilter == "Html (*.html)") {
+        // 文件类型html
+        format = DeviceManager::EF_Html;
+    } else if (selectFilter == "Doc (*.docx)") {
+        // 文件类型docx
+        format = DeviceManager::EF_Doc;
+    } else if (selectFilter == "Xls (*.xls)") {
+        // 文件类型xls
+        format = DeviceManager::EF_Xlsx;
+    } else if (selectFilter == "Json (*.json)") {
+        // 文件类型json
+        format = DeviceManager::EF_Json;
+    } else if (selectFilter == "Cbor (*.cbor)") {
+        // 文件类型cbor
+        format = DeviceManager::EF_Cbor;
+    } else {
+        return false;
+    }
 
-    // 文件类型html
-    if (selectFilter == "Html (*.html)")
-        return DeviceManager::instance()->exportToHtml(file);
+    // 在后台线程中导出,界面只显示进度
+    // 设备属性缓存先在界面线程中生成,导出线程与界面只读取
+    DeviceManager::instance()->prepareExport();
+    initExportThread();
+    mp_ExportThread->setExportInfo(file, format);
+    showExportDialog();
+    mp_ExportThread->start();
+    return true;
+}
 
-    // 文件类型docx
-    if (selectFilter == "Doc (*.docx)")
-        return DeviceManager::instance()->exportToDoc(file);
+bool MainWindow::isExporting() const
+{
+    return mp_ExportThread && mp_ExportThread->isRunning();
+}
 
-    // 文件类型xls
-    if (selectFilter == "Xls (*.xls)")
-        return DeviceManager::instance()->exportToXlsx(file);
+void MainWindow::showExportDialog()
+{
+    if (!mp_ExportDialog) {
+        mp_ExportDialog = new DDialog(tr("Exporting device info..."), QString(), this);
+        mp_ExportDialog->setIcon(QIcon::fromTheme("deepin-devicemanager"));
+        mp_ExportProgress = new DProgressBar(mp_ExportDialog);
+        mp_ExportProgress->setRange(0, 100);
+        mp_ExportProgress->setTextVisible(false);
+        mp_ExportDialog->addContent(mp_ExportProgress);
+        mp_ExportDialog->addButton(QObject::tr("Cancel", "button"));
+
+        // 点击取消或关闭对话框均取消导出
+        connect(mp_ExportDialog, &DDialog::finished, this, [this]() {
+            if (isExporting())
+                mp_ExportThread->cancel();
+        });
+    }
 
-    return false;
+    // 模态显示,导出期间不能操作设备界面
+    mp_ExportProgress->setValue(0);
+    mp_ExportDialog->setModal(true);
+    mp_ExportDialog->show();
 }
 
 
@@ -408,7 +514,12 @@ void MainWindow::initWindowTitle()
                 return ;
             else
                 mp_MainStackWidget->setCurrentIndex(1);
+            // 回到处理器界面时继续采样频率
+            if (tr("CPU") == mp_DeviceWidget->currentIndex())
+                CpuFreqSampler::instance()->start();
         } else {
+            CpuFreqSampler::instance()->stop();
+            initDriverPages();
             if (mp_DriverManager->isFirstScan()) {
                 mp_ButtonBox->setEnabled(false);
                 mp_DriverManager->scanDriverInfo();
@@ -428,7 +539,12 @@ void MainWindow::initWindowTitle()
         Common::specialComType = dconfig->value("specialComType").toInt();
     }
     qCInfo(appLog) << "Common::specialComType value is:" << Common::specialComType;
+    // 处理器频率采样间隔,毫秒
+    if (dconfig && dconfig->isValid() && dconfig->keyList().contains("cpuFreqSampleInterval"))
+        CpuFreqSampler::instance()->setInterval(dconfig->value("cpuFreqSampleInterval").toInt());
 #endif
+    // 平台特征信息依赖 specialComType,在此一次性初始化,后续生成设备时直接使用
+    Common::initPlatformProfile();
     // 特殊处理
     if (!Common::boardVendorType().isEmpty())
         mp_ButtonBox->hide();
@@ -446,18 +562,23 @@ void MainWindow::initWidgets()
     // 添加加载等待界面
     mp_MainStackWidget->addWidget(mp_WaitingWidget);
     mp_WaitingWidget->start();
+    // 加载界面是首屏,首次绘制后再做其余初始化
+    mp_WaitingWidget->installEventFilter(this);
 
     // 添加信息显示界面
     mp_MainStackWidget->addWidget(mp_DeviceWidget);
 
-    mp_MainStackWidget->addWidget(mp_DriverScanWidget);
-
-    // 初始化驱动相关界面
-    mp_MainStackWidget->addWidget(mp_DriverManager);
+    // 驱动相关界面在第一次使用时添加,见 initDriverPages
 }
 
 void MainWindow::refreshDataBase()
 {
+    // 导出线程正在读取设备信息,导出结束后再加载
+    if (isExporting()) {
+        m_RefreshAfterExport = true;
+        return;
+    }
+
     if (mp_WorkingThread) {
         /* 一定要与 restoreOverrideCursor 成对使用*/
         if(!m_statusCursorIsWait) {
@@ -486,6 +607,13 @@ void MainWindow::slotLoadingFinish(const QString &message)
     if (begin)
         begin = false;
 
+    // snapshot 表示设备由上次保存的快照恢复,先显示出来,加载线程结束后再加载实时信息
+    if (message == "snapshot") {
+        showDeviceInfo();
+        m_LoadAfterSnapshot = true;
+        return;
+    }
+
     // finish 表示所有设备信息加载完成
     if (message == "finish") {
         begin = true;
@@ -496,29 +624,23 @@ void MainWindow::slotLoadingFinish(const QString &message)
         DApplication::restoreOverrideCursor();
     }
 
-        // 信息显示界面
-        // 获取设备类型列表
-        DeviceManager::instance()->setDeviceListClass();
-        const QList<QPair<QString, QString>> types = DeviceManager::instance()->getDeviceTypes();
-
-        // 获取设备驱动列表
-        DeviceManager::instance()->getDeviceDriverPool();
-
-        // 更新左侧ListView
-        mp_DeviceWidget->updateListView(types);
+        // 首次绘制前已加载完成时在此完成延迟的初始化
+        initDeferred();
 
-        // 设置当前页面设备信息页
-        if (mp_ButtonBox->checkedId() != 1)
-            mp_MainStackWidget->setCurrentWidget(mp_DeviceWidget);
+        // 新加载的设备使用缓存的显示信息、电池信息和网卡连接状态
+        XrandrCache::instance()->apply();
+        UPowerMonitor::instance()->apply();
+        m_BatteryDeferred = false;
+        NetLinkMonitor::instance()->apply();
+        m_NetworkDeferred = false;
 
-        QList<DeviceBaseInfo *> lst;
-        bool ret = DeviceManager::instance()->getDeviceList(mp_DeviceWidget->currentIndex(), lst);
+        // 信息显示界面
+        showDeviceInfo();
 
-        if (ret && lst.size() > 0) {//当设备大小为0时，显示概况信息
-            mp_DeviceWidget->updateDevice(mp_DeviceWidget->currentIndex(), lst);
-        } else {
-            QMap<QString, QString> overviewMap = DeviceManager::instance()->getDeviceOverview();
-            mp_DeviceWidget->updateOverview(overviewMap);
+        // 显示信息、电池和网卡状态写入后再保存快照,界面空闲时保存
+        if (mp_WorkingThread->generated()) {
+            m_SnapshotPending = true;
+            QTimer::singleShot(0, this, &MainWindow::saveSnapshot);
         }
 
         if (!startScanningFlag) {
@@ -527,8 +649,11 @@ void MainWindow::slotLoadingFinish(const QString &message)
         // 刷新结束
         m_refreshing = false;
 
-        if (m_IsFirstRefresh)
+        if (m_IsFirstRefresh) {
             m_IsFirstRefresh = false;
+            STARTUP_TRACE("devices shown");
+            STARTUP_FINISH();
+        }
 
         // 是否切换到驱动界面
         if (m_ShowDriverPage) {
@@ -537,6 +662,7 @@ void MainWindow::slotLoadingFinish(const QString &message)
         }
     }
     if (startScanningFlag) {
+        initDriverPages();
         mp_MainStackWidget->setCurrentIndex(2);
         mp_DriverManager->scanDriverInfo();
         mp_DriverScanWidget->setScanningUI("", 0);
@@ -544,49 +670,99 @@ void MainWindow::slotLoadingFinish(const QString &message)
     }
 }
 
+void MainWindow::saveSnapshot()
+{
+    // 加载或导出期间不访问设备,加载结束后重新保存,导出结束后再保存
+    if (!m_SnapshotPending || m_refreshing || mp_WorkingThread->isRunning() || isExporting())
+        return;
+
+    m_SnapshotPending = false;
+    if (!DeviceSnapshot::save())
+        qCWarning(appLog) << "Failed to save device snapshot";
+}
+
+void MainWindow::showDeviceInfo()
+{
+    // 获取设备类型列表
+    DeviceManager::instance()->setDeviceListClass();
+    const QList<QPair<QString, QString>> types = DeviceManager::instance()->getDeviceTypes();
+
+    // 获取设备驱动列表
+    DeviceManager::instance()->getDeviceDriverPool();
+
+    // 更新左侧ListView
+    mp_DeviceWidget->updateListView(types);
+
+    // 设置当前页面设备信息页
+    if (mp_ButtonBox->checkedId() != 1)
+        mp_MainStackWidget->setCurrentWidget(mp_DeviceWidget);
+
+    // 界面未被清空且当前类别的设备没有变化时保留当前界面
+    QString curIndex = mp_DeviceWidget->currentIndex();
+    if (m_PageCleared || DeviceManager::instance()->deviceClassChanged(curIndex)) {
+        QList<DeviceBaseInfo *> lst;
+        bool ret = DeviceManager::instance()->getDeviceList(curIndex, lst);
+
+        if (ret && lst.size() > 0) {//当设备大小为0时，显示概况信息
+            mp_DeviceWidget->updateDevice(curIndex, lst);
+        } else {
+            QMap<QString, QString> overviewMap = DeviceManager::instance()->getDeviceOverview();
+            mp_DeviceWidget->updateOverview(overviewMap);
+        }
+        m_PageCleared = false;
+    }
+}
+
 void MainWindow::slotListItemClicked(const QString &itemStr)
 {
-    // xrandr would be execed later
-    if (tr("Monitor") == itemStr || tr("Overview") == itemStr) { //点击显示设备，执行线程加载信息
-        ThreadExecXrandr tx(false, !checkWaylandMode());
-        tx.start();
-        tx.wait();
-    } else if (tr("Display Adapter") == itemStr) { //点击显示适配器，执行线程加载信息
-        ThreadExecXrandr tx(true, !checkWaylandMode());
-        tx.start();
-        tx.wait();
-    } else if (tr("CPU") == itemStr) { //点击处理器，执行加载处理器信息线程
-        LoadCpuInfoThread lct;
-        lct.start();
-        lct.wait();
-    } else if (tr("Network Adapter") == itemStr) { //点击网络适配器，更新网络连接的信息
-        CmdTool tool;
-        QStringList networkDriver = DeviceManager::instance()->networkDriver();
-        //判断所有网卡的连接情况
-        for (int i = 0; i < networkDriver.size(); i++)
-            DeviceManager::instance()->correctNetworkLinkStatus(tool.getCurNetworkLinkStatus(networkDriver.at(i)), networkDriver.at(i));
-    } else if (tr("Battery") == itemStr) { //点击电池，重新加载电池显示信息
-        CmdTool tool;
-        DeviceManager::instance()->correctPowerInfo(tool.getCurPowerInfo());
+    // 显示信息由 XrandrCache 在后台获取,缓存有效时不做任何处理
+    XrandrCache::instance()->probe();
+
+    // 处理器频率只在处理器界面显示时采样
+    if (tr("CPU") != itemStr)
+        CpuFreqSampler::instance()->stop();
+
+    // 加载线程正在替换设备列表(包括显示快照期间),不修改设备也不读取设备列表,加载结束后再处理
+    if (m_refreshing || mp_WorkingThread->isRunning()) {
+        m_ItemClickDeferred = true;
+        return;
     }
 
-        ThreadExecXrandr txgpu(true, !checkWaylandMode());
-        txgpu.start();
-        txgpu.wait();
-        if(monitorNumber != txgpu.getMonitorNumber()) {
+    // 导出线程正在读取设备属性(取消后会先写完当前类别),不修改设备,导出结束后再处理
+    if (isExporting()) {
+        m_ItemClickDeferred = true;
+        return;
+    }
 
-            QString info;
-            DBusInterface::getInstance()->getInfo("is_server_running", info);
-            //请求后台更新信息
-            if (!info.toInt()) {
-                refreshDataBaseLater();
-            }
-            qCDebug(appLog)<< "Monitor refreshInfo" << __LINE__  << QDateTime::currentDateTime().toString("hh:mm:ss") << info << monitorNumber;
-            monitorNumber = txgpu.getMonitorNumber();
+    if (tr("CPU") == itemStr) { //点击处理器，开始采样频率
+        // 不支持 cpufreq 时执行加载处理器信息线程
+        if (CpuFreqSampler::instance()->start()) {
+            CpuFreqSampler::instance()->apply();
+        } else {
+            LoadCpuInfoThread lct;
+            lct.start();
+            lct.wait();
         }
-
-    // 数据刷新时不处理界面刷新
-    if (m_refreshing || mp_WorkingThread->isRunning()) return;
+    } else if (tr("Network Adapter") == itemStr) { //点击网络适配器，更新网络连接的信息
+        // rtnetlink 不可用时才执行 ifconfig
+        if (NetLinkMonitor::instance()->isValid()) {
+            NetLinkMonitor::instance()->apply();
+        } else {
+            CmdTool tool;
+            QStringList networkDriver = DeviceManager::instance()->networkDriver();
+            //判断所有网卡的连接情况
+            for (int i = 0; i < networkDriver.size(); i++)
+                DeviceManager::instance()->correctNetworkLinkStatus(tool.getCurNetworkLinkStatus(networkDriver.at(i)), networkDriver.at(i));
+        }
+    } else if (tr("Battery") == itemStr) { //点击电池，重新加载电池显示信息
+        // UPower 不可用时才执行 upower --dump
+        if (UPowerMonitor::instance()->isValid()) {
+            UPowerMonitor::instance()->apply();
+        } else {
+            CmdTool tool;
+            DeviceManager::instance()->correctPowerInfo(tool.getCurPowerInfo());
+        }
+    }
 
     QList<DeviceBaseInfo *> lst;
     bool ret = DeviceManager::instance()->getDeviceList(itemStr, lst);
@@ -599,6 +775,72 @@ void MainWindow::slotListItemClicked(const QString &itemStr)
     }
 }
 
+void MainWindow::slotXrandrUpdated()
+{
+    // 设备正在加载或导出时不修改设备,加载结束后会重新写入
+    if (m_refreshing || mp_WorkingThread->isRunning() || isExporting())
+        return;
+
+    XrandrCache::instance()->apply();
+
+    // 当前界面显示的是显示相关的设备时更新界面
+    QString curIndex = mp_DeviceWidget->currentIndex();
+    if (tr("Monitor") == curIndex || tr("Display Adapter") == curIndex || tr("Overview") == curIndex)
+        slotListItemClicked(curIndex);
+}
+
+void MainWindow::slotBatteryUpdated()
+{
+    // 设备正在加载或导出时不修改设备,加载结束后会重新写入,导出结束后再写入
+    if (isExporting())
+        m_BatteryDeferred = true;
+    if (m_refreshing || mp_WorkingThread->isRunning() || isExporting())
+        return;
+    m_BatteryDeferred = false;
+
+    UPowerMonitor::instance()->apply();
+
+    // 当前界面显示的是电池或概况时更新界面
+    QString curIndex = mp_DeviceWidget->currentIndex();
+    if (tr("Battery") == curIndex || tr("Overview") == curIndex)
+        slotListItemClicked(curIndex);
+}
+
+void MainWindow::slotNetworkUpdated()
+{
+    // 设备正在加载或导出时不修改设备,加载结束后会重新写入,导出结束后再写入
+    if (isExporting())
+        m_NetworkDeferred = true;
+    if (m_refreshing || mp_WorkingThread->isRunning() || isExporting())
+        return;
+    m_NetworkDeferred = false;
+
+    NetLinkMonitor::instance()->apply();
+
+    // 当前界面显示的是网卡时更新界面
+    QString curIndex = mp_DeviceWidget->currentIndex();
+    if (tr("Network Adapter") == curIndex)
+        slotListItemClicked(curIndex);
+}
+
+void MainWindow::slotCpuFreqSampled()
+{
+    // 设备正在加载或导出时不修改设备
+    if (m_refreshing || mp_WorkingThread->isRunning() || isExporting())
+        return;
+
+    // 处理器界面不可见时停止采样
+    QString curIndex = mp_DeviceWidget->currentIndex();
+    if (tr("CPU") != curIndex || 1 != mp_MainStackWidget->currentIndex()) {
+        CpuFreqSampler::instance()->stop();
+        return;
+    }
+
+    // 只有频率变化,就地更新表格中已显示的行和可见的详细信息,不重建页面
+    CpuFreqSampler::instance()->apply();
+    mp_DeviceWidget->updateDeviceData();
+}
+
 void MainWindow::slotRefreshInfo()
 {
     refreshDataBaseLater();
@@ -612,6 +854,45 @@ void MainWindow::slotExportInfo()
     exportTo();
 }
 
+void MainWindow::slotExportProgress(int written, int total)
+{
+    if (mp_ExportProgress && total > 0)
+        mp_ExportProgress->setValue(int(qint64(written) * 100 / total));
+}
+
+void MainWindow::slotExportFinished(bool success, bool canceled)
+{
+    if (mp_ExportDialog && mp_ExportDialog->isVisible())
+        mp_ExportDialog->hide();
+
+    QString fileName = QFileInfo(mp_ExportThread->filePath()).fileName();
+    if (success) {
+        DMessageManager::instance()->sendMessage(this, QIcon::fromTheme("deepin-devicemanager"), tr("Exported to %1").arg(fileName));
+    } else if (canceled) {
+        DMessageManager::instance()->sendMessage(this, QIcon::fromTheme("warning"), tr("Export canceled"));
+    } else {
+        DMessageManager::instance()->sendMessage(this, QIcon::fromTheme("warning"), tr("Failed to export %1").arg(fileName));
+    }
+
+    // 执行导出期间被推迟的刷新
+    mp_ExportThread->wait();
+    if (m_RefreshAfterExport) {
+        m_RefreshAfterExport = false;
+        refreshDataBase();
+    } else {
+        slotXrandrUpdated();
+        if (m_BatteryDeferred)
+            slotBatteryUpdated();
+        if (m_NetworkDeferred)
+            slotNetworkUpdated();
+        saveSnapshot();
+        if (m_ItemClickDeferred) {
+            m_ItemClickDeferred = false;
+            slotListItemClicked(mp_DeviceWidget->currentIndex());
+        }
+    }
+}
+
 void MainWindow::slotChangeUI()
 {
     // 设置字体变化标志
@@ -670,9 +951,20 @@ bool MainWindow::event(QEvent *event)
     return DMainWindow::event(event);
 }
 
+bool MainWindow::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == mp_WaitingWidget && QEvent::Paint == event->type()) {
+        mp_WaitingWidget->removeEventFilter(this);
+        STARTUP_TRACE("first paint");
+        // 等本次绘制结束后再初始化
+        QTimer::singleShot(0, this, &MainWindow::initDeferred);
+    }
+    return DMainWindow::eventFilter(watched, event);
+}
+
 void MainWindow::closeEvent(QCloseEvent *event)
 {
-    if (mp_DriverManager->isInstalling()) {
+    if (mp_DriverManager && mp_DriverManager->isInstalling()) {
         // 当前界面正在驱动安装，弹窗提示
         // bug134487
         DDialog dialog(QObject::tr("You are installing a driver, which will be interrupted if you exit.")
@@ -687,7 +979,7 @@ void MainWindow::closeEvent(QCloseEvent *event)
         } else {
             event->ignore();
         }
-    } else if (mp_DriverManager->isBackingup()) {
+    } else if (mp_DriverManager && mp_DriverManager->isBackingup()) {
         DDialog dialog(QObject::tr("You are backing up drivers, which will be interrupted if you exit.")
                        , QObject::tr("Are you sure you want to exit?"));
 
@@ -700,7 +992,7 @@ void MainWindow::closeEvent(QCloseEvent *event)
         } else {
             event->ignore();
         }
-    } else if (mp_DriverManager->isRestoring()) {
+    } else if (mp_DriverManager && mp_DriverManager->isRestoring()) {
         DDialog dialog(QObject::tr("You are restoring drivers, which will be interrupted if you exit.")
                        , QObject::tr("Are you sure you want to exit?"));
 
@@ -12,6 +12,8 @@
 #include <DMainWindow>
 #include <DStackedWidget>
 #include <DButtonBox>
+#include <DDialog>
+#include <DProgressBar>
 #include <qdbusconnection.h>
 #include <QDBusInterface>
 #include <QDBusReply>
@@ -23,6 +25,7 @@ class DeviceWidget;
 class LoadInfoThread;
 class PageDriverManager;
 class DriverScanWidget;
+class ExportInfoThread;
 
 using namespace Dtk::Widget;
 
@@ -49,8 +52,8 @@ public:
     void refreshBatteryStatus();
 
     /**
-     * @brief exportTo:导出设备信息
-     * @return true:导出成功，false:导出失败
+     * @brief exportTo:选择导出文件并在后台线程中导出设备信息
+     * @return true:已开始导出或取消选择，false:无法开始导出
      */
     bool exportTo();
 
@@ -102,6 +105,11 @@ protected:
      */
     bool event(QEvent *event) override;
 
+    /**
+     * @brief eventFilter:加载界面首次绘制后开始延迟的初始化
+     */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
     /**
      * @brief closeEvent 重写关闭事件
      * @param event
@@ -121,6 +129,15 @@ private:
     /** @brief initWidgets:初始化界面相关的内容*/
     void initWidgets();
 
+    /** @brief initDeferred:首次绘制后初始化显示、电池、网卡信息的监听,只执行一次*/
+    void initDeferred();
+
+    /** @brief initDriverPages:第一次使用时创建驱动扫描和驱动管理界面*/
+    void initDriverPages();
+
+    /** @brief initExportThread:第一次导出时创建导出线程*/
+    void initExportThread();
+
     /**
      * @brief refreshDataBase:刷新设备信息
      */
@@ -129,6 +146,26 @@ private:
      * @brief refreshDataBaseLater:刷新设备信息
      */
     void refreshDataBaseLater();
+
+    /**
+     * @brief showDeviceInfo:按 DeviceManager 中的设备更新左侧列表和当前设备界面
+     */
+    void showDeviceInfo();
+
+    /**
+     * @brief saveSnapshot:保存实时加载的设备快照,加载或导出期间推迟
+     */
+    void saveSnapshot();
+
+    /**
+     * @brief isExporting:是否正在导出,导出期间不能刷新设备信息
+     */
+    bool isExporting() const;
+
+    /**
+     * @brief showExportDialog:显示导出进度对话框
+     */
+    void showExportDialog();
 private slots:
     /**
      * @brief slotSetPage
@@ -148,6 +185,26 @@ private slots:
      */
     void slotListItemClicked(const QString &itemStr);
 
+    /**
+     * @brief slotXrandrUpdated:获取到新的显示信息,写入设备并更新显示相关的界面
+     */
+    void slotXrandrUpdated();
+
+    /**
+     * @brief slotBatteryUpdated:电池信息变化,写入设备并更新电池相关的界面
+     */
+    void slotBatteryUpdated();
+
+    /**
+     * @brief slotNetworkUpdated:网卡连接状态变化,写入设备并更新网卡界面
+     */
+    void slotNetworkUpdated();
+
+    /**
+     * @brief slotCpuFreqSampled:采样到处理器频率,更新处理器界面
+     */
+    void slotCpuFreqSampled();
+
     /**
      * @brief slotRefreshInfo:刷新信息槽函数
      */
@@ -158,6 +215,20 @@ private slots:
      */
     void slotExportInfo();
 
+    /**
+     * @brief slotExportProgress:导出进度变化槽函数
+     * @param written:已写出的设备数
+     * @param total:设备总数
+     */
+    void slotExportProgress(int written, int total);
+
+    /**
+     * @brief slotExportFinished:导出结束槽函数,关闭进度对话框并提示结果
+     * @param success:是否导出成功
+     * @param canceled:是否被取消
+     */
+    void slotExportFinished(bool success, bool canceled);
+
     /**
      * @brief changeUI:UI界面变化,BIOS界面行高
      */
@@ -177,11 +248,22 @@ private:
     DriverScanWidget      *mp_DriverScanWidget;        //驱动管理扫描界面
     PageDriverManager     *mp_DriverManager;           //驱动管理主界面
     LoadInfoThread        *mp_WorkingThread;           //信息加载线程
+    ExportInfoThread      *mp_ExportThread;            //信息导出线程
+    DDialog               *mp_ExportDialog;            //导出进度对话框
+    DProgressBar          *mp_ExportProgress;          //导出进度条
     DButtonBox            *mp_ButtonBox;               // titlebar上添加Buttonbox
     bool                  m_refreshing = false;        // 判断界面是否正在刷新
     bool                  m_IsFirstRefresh = true;
+    bool                  m_PageCleared = true;        // 设备界面已清空,刷新结束后必须重新加载
     bool                  m_ShowDriverPage = false;
     bool                  m_statusCursorIsWait = false;
+    bool                  m_RefreshAfterExport = false; // 导出期间收到的刷新请求,导出结束后执行
+    bool                  m_DeferredInit = false;      // 是否已执行首次绘制后的初始化
+    bool                  m_LoadAfterSnapshot = false; // 快照已显示,加载线程结束后加载实时信息
+    bool                  m_ItemClickDeferred = false; // 加载期间切换了界面,加载结束后重新加载当前界面
+    bool                  m_SnapshotPending = false;   // 实时加载的设备还未保存快照
+    bool                  m_BatteryDeferred = false;   // 导出期间电池信息变化,导出结束后写入
+    bool                  m_NetworkDeferred = false;   // 导出期间网卡连接状态变化,导出结束后写入
 };
 
 #endif // MAINWINDOW_H
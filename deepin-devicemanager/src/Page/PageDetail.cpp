@@ -183,6 +183,9 @@ PageDetail::PageDetail(QWidget *parent)
     hLayout->addWidget(mp_ScrollArea);
     setLayout(hLayout);
 
+    // 属性变化时不可见的详细信息在滚动到可见时再重新生成
+    connect(mp_ScrollArea->verticalScrollBar(), &QScrollBar::valueChanged, this, &PageDetail::slotUpdateStaleInfo);
+
     clearWidget();
 }
 
@@ -229,6 +232,29 @@ void PageDetail::showInfoOfNum(int index)
     mp_ScrollArea->verticalScrollBar()->setValue(value);
 }
 
+void PageDetail::updateVisibleInfo()
+{
+    // 滚动区域外的详细信息先标记,滚动到可见或界面重新显示时再重新生成
+    foreach (TextBrowser *browser, m_ListTextBrowser) {
+        if (browser)
+            m_StaleTextBrowser.insert(browser);
+    }
+    slotUpdateStaleInfo();
+}
+
+void PageDetail::slotUpdateStaleInfo()
+{
+    if (m_StaleTextBrowser.isEmpty())
+        return;
+
+    foreach (TextBrowser *browser, m_StaleTextBrowser) {
+        if (!browser->visibleRegion().isEmpty()) {
+            m_StaleTextBrowser.remove(browser);
+            browser->updateInfo();
+        }
+    }
+}
+
 EnableDeviceStatus PageDetail::enableDevice(int row, bool enable)
 {
     if (m_ListTextBrowser.size() <= row)
@@ -292,6 +318,17 @@ void PageDetail::paintEvent(QPaintEvent *e)
 void PageDetail::resizeEvent(QResizeEvent *event)
 {
     DWidget::resizeEvent(event);
+
+    // 变大后显示出的详细信息可能已过时
+    slotUpdateStaleInfo();
+}
+
+void PageDetail::showEvent(QShowEvent *event)
+{
+    DWidget::showEvent(event);
+
+    // 界面隐藏期间设备属性变化过
+    slotUpdateStaleInfo();
 }
 
 void PageDetail::addWidgets(TextBrowser *widget, bool enable)
@@ -329,6 +366,7 @@ void PageDetail::addWidgets(TextBrowser *widget, bool enable)
 
 void PageDetail::clearWidget()
 {
+    m_StaleTextBrowser.clear();
     QList<TextBrowser *> listTextBrowser = m_ListTextBrowser;
     m_ListTextBrowser.clear();
     //  清空TextBrowser
@@ -10,6 +10,7 @@
 #include <DWidget>
 #include <QScrollArea>
 #include <QHBoxLayout>
+#include <QSet>
 #include <DCommandLinkButton>
 #include <DHorizontalLine>
 
@@ -92,6 +93,12 @@ public:
      */
     void showInfoOfNum(int index);
 
+    /**
+     * @brief updateVisibleInfo : 设备属性变化后只重新生成可见的详细信息,不重建控件
+     * 其余详细信息在滚动到可见、界面变大或重新显示时再生成
+     */
+    void updateVisibleInfo();
+
     /**
      * @brief enableDevice
      * @param row
@@ -117,6 +124,8 @@ protected:
 
     void resizeEvent(QResizeEvent *event) override;
 
+    void showEvent(QShowEvent *event) override;
+
 private:
     /**
      * @brief addWidgets 添加widget到布局
@@ -144,6 +153,11 @@ private slots:
 
     void slotCopyAllInfo();
 
+    /**
+     * @brief slotUpdateStaleInfo:重新生成已过时且当前可见的详细信息
+     */
+    void slotUpdateStaleInfo();
+
 private:
     QVBoxLayout      *mp_ScrollAreaLayout;
     QScrollArea      *mp_ScrollArea;
@@ -153,6 +167,7 @@ private:
     QList<QHBoxLayout *>           m_ListHlayout;
     QList<DetailButton *>          m_ListDetailButton;
     QList<DetailSeperator *>       m_ListDetailSeperator;
+    QSet<TextBrowser *>            m_StaleTextBrowser;    //<! 属性变化后还未重新生成的详细信息
 };
 
 #endif // DEVICEDETAILPAGE_H
@@ -42,6 +42,11 @@ void PageInfo::clearContent()
 
 }
 
+void PageInfo::updateDeviceData()
+{
+
+}
+
 void PageInfo::setDeviceInfoNum(int num)
 {
     // 设置设备信息数目
@@ -59,6 +59,11 @@ public:
      */
     virtual void clearContent();
 
+    /**
+     * @brief updateDeviceData:当前设备的属性变化后就地更新显示的内容,不重建页面
+     */
+    virtual void updateDeviceData();
+
     /**
      * @brief isOverview:是否是概况界面
      * @return false : 不是概况界面
@@ -98,6 +98,12 @@ void PageInfoWidget::updateTable(const QMap<QString, QString> &map)
     }
 }
 
+void PageInfoWidget::updateDeviceData()
+{
+    if (mp_PageInfo)
+        mp_PageInfo->updateDeviceData();
+}
+
 void PageInfoWidget::setFontChangeFlag()
 {
     mp_PageBoardInfo->setFontChangeFlag();
@@ -48,6 +48,11 @@ public:
      */
     void setFontChangeFlag();
 
+    /**
+     * @brief updateDeviceData: 当前设备属性变化后就地更新页面
+     */
+    void updateDeviceData();
+
     /**
      * @brief clear:清除数据
      */
@@ -9,24 +9,35 @@
 
 // Dtk头文件
 #include <DGuiApplicationHelper>
+#include <DSearchEdit>
 
 // Qt库文件
 #include <QHBoxLayout>
+#include <QVBoxLayout>
 #include <QLoggingCategory>
 
 PageListView::PageListView(DWidget *parent)
     : DWidget(parent)
     , mp_ListView(new DeviceListView(this))
+    , mp_SearchEdit(new DSearchEdit(this))
     , mp_Refresh(new QAction(tr("Refresh"), this))
     , mp_Export(new QAction(tr("Export"), this))
     , mp_Menu(new QMenu(this))
     , m_CurType(tr("Overview"))
 {
     //初始化界面
-    QHBoxLayout *hLayout = new QHBoxLayout();
-    hLayout->addWidget(mp_ListView);
-    hLayout->setContentsMargins(0, 0, 0, 0);
-    setLayout(hLayout);
+    QVBoxLayout *vLayout = new QVBoxLayout();
+    QHBoxLayout *searchLayout = new QHBoxLayout();
+    searchLayout->setContentsMargins(10, 10, 10, 0);
+    searchLayout->addWidget(mp_SearchEdit);
+    vLayout->addLayout(searchLayout);
+    vLayout->addWidget(mp_ListView);
+    vLayout->setContentsMargins(0, 0, 0, 0);
+    setLayout(vLayout);
+
+    // 输入时立即过滤
+    mp_SearchEdit->setPlaceHolder(tr("Search"));
+    connect(mp_SearchEdit, &DSearchEdit::textChanged, this, &PageListView::searchTextChanged);
 
     this->setFixedWidth(152);
     // 初始化右键菜单
@@ -51,12 +62,17 @@ void PageListView::updateListItems(const QList<QPair<QString, QString> > &lst)
         return;
     }
 
-    // 更新之前先清理
-    mp_ListView->clearItem();
-
-    // 更新 list
-    foreach (auto it, lst) {
-        mp_ListView->addItem(it.first, it.second);
+    // 设备类型没有变化时复用已有的item
+    if (m_ListItems.isEmpty() || m_ListItems != lst) {
+        // 更新之前先清理
+        mp_ListView->clearItem();
+
+        // 更新 list
+        foreach (auto it, lst) {
+            mp_ListView->addItem(it.first, it.second);
+        }
+        m_ListItems = lst;
+        mp_ListView->setItemFilter(m_Filter);
     }
 
     // 更新之后恢复之前显示的设备
@@ -84,6 +100,7 @@ void PageListView::clear()
 
     // 更新之前先清理
     mp_ListView->clearItem();
+    m_ListItems.clear();
 }
 
 void PageListView::setCurType(QString type)
@@ -92,6 +109,12 @@ void PageListView::setCurType(QString type)
     mp_ListView->setCurItem(m_CurType);
 }
 
+void PageListView::setItemFilter(const QStringList &names)
+{
+    m_Filter = names;
+    mp_ListView->setItemFilter(m_Filter);
+}
+
 void PageListView::paintEvent(QPaintEvent *event)
 {
     // 让背景色适合主题颜色
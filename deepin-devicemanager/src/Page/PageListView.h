@@ -13,6 +13,12 @@
 
 class DeviceListView;
 
+namespace Dtk {
+namespace Widget {
+class DSearchEdit;
+}
+}
+
 using namespace Dtk::Widget;
 
 /**
@@ -48,6 +54,12 @@ public:
 
     void setCurType(QString type);
 
+    /**
+     * @brief setItemFilter:只显示搜索命中的设备类型,列表重建后保持过滤
+     * @param names:显示的设备类型,为空时显示全部
+     */
+    void setItemFilter(const QStringList &names);
+
 protected:
     /**@brief:事件重写*/
     void paintEvent(QPaintEvent *event) override;
@@ -63,6 +75,12 @@ signals:
 
     void exportActionTrigger();
 
+    /**
+     * @brief searchTextChanged:搜索内容变化
+     * @param text:搜索内容
+     */
+    void searchTextChanged(const QString &text);
+
 private slots:
     /**
      * @brief slotShowMenu:鼠标右键菜单槽函数
@@ -78,10 +96,13 @@ private slots:
 
 private:
     DeviceListView            *mp_ListView;
+    DSearchEdit               *mp_SearchEdit;   // 设备搜索框
     QAction                   *mp_Refresh;
     QAction                   *mp_Export;
     QMenu                     *mp_Menu;
     QString                   m_CurType;        // 当前显示的设备类型
+    QList<QPair<QString, QString> > m_ListItems;  // 当前列表项,刷新后内容不变时不重建
+    QStringList               m_Filter;         // 搜索命中的设备类型,为空时不过滤
 };
 
 #endif // LISTVIEWWIDGET_H
@@ -10,8 +10,6 @@
 #include "DeviceInfo.h"
 #include "PageDriverControl.h"
 #include "DevicePrint.h"
-#include "DeviceInput.h"
-#include "DeviceNetwork.h"
 #include "DDLog.h"
 
 // Dtk头文件
@@ -39,8 +37,6 @@ PageMultiInfo::PageMultiInfo(QWidget *parent)
     , mp_Table(new PageTableHeader(this))
     , mp_Detail(new PageDetail(this))
 {
-    m_deviceList.clear();
-    m_menuControlList.clear();
     // 初始化界面布局
     initWidgets();
 
@@ -69,8 +65,6 @@ PageMultiInfo::~PageMultiInfo()
         delete mp_Detail;
         mp_Detail = nullptr;
     }
-    m_deviceList.clear();
-    m_menuControlList.clear();
 }
 
 void PageMultiInfo::updateInfo(const QList<DeviceBaseInfo *> &lst)
@@ -80,14 +74,9 @@ void PageMultiInfo::updateInfo(const QList<DeviceBaseInfo *> &lst)
 
     if (lst.size() < 1)
         return;
-    m_deviceList.clear();
-    m_menuControlList.clear();
 
-    //  获取多个设备界面表格信息
-    getTableListInfo(lst, m_deviceList, m_menuControlList);
-
-    // 更新表格
-    mp_Table->updateTable(m_deviceList, m_menuControlList);
+    // 更新表格,表格直接读取设备对象
+    mp_Table->updateTable(lst);
 
     // 更新详细信息
     mp_Detail->showDeviceInfo(lst);
@@ -113,10 +102,22 @@ void PageMultiInfo::setLabel(const QString &itemstr)
 
 void PageMultiInfo::clearWidgets()
 {
+    // 刷新时设备对象会被释放,表格保留已显示的内容直到新的设备列表到来
+    mp_Table->releaseDevices();
     m_lstDevice.clear();
     mp_Detail->clearWidget();
 }
 
+void PageMultiInfo::updateDeviceData()
+{
+    if (m_lstDevice.size() < 1)
+        return;
+
+    // 设备列表未变化,表格与详细信息保持当前的选中和滚动位置
+    mp_Table->updateLoadedRows();
+    mp_Detail->updateVisibleInfo();
+}
+
 void PageMultiInfo::resizeEvent(QResizeEvent *e)
 {
     if (m_lstDevice.size() < 1)
@@ -125,11 +126,11 @@ void PageMultiInfo::resizeEvent(QResizeEvent *e)
     // 先获取当前窗口大小
     int curHeight = this->height();
     if (curHeight < LEAST_PAGE_HEIGHT) {
-        //  获取多个设备界面表格信息
-        mp_Table->updateTable(m_deviceList, m_menuControlList, true, (LEAST_PAGE_HEIGHT - curHeight) / TREE_ROW_HEIGHT + 1);
+        // 设备未变化,只调整表格行数
+        mp_Table->updateTable(m_lstDevice, true, (LEAST_PAGE_HEIGHT - curHeight) / TREE_ROW_HEIGHT + 1);
     } else {
-        //  获取多个设备界面表格信息
-        mp_Table->updateTable(m_deviceList, m_menuControlList, true, 0);
+        // 设备未变化,只调整表格行数
+        mp_Table->updateTable(m_lstDevice, true, 0);
     }
 
     return PageInfo::resizeEvent(e);
@@ -246,31 +247,3 @@ void PageMultiInfo::initWidgets()
 
     setLayout(hLayout);
 }
-
-void PageMultiInfo::getTableListInfo(const QList<DeviceBaseInfo *> &lst, QList<QStringList> &deviceList, QList<QStringList> &menuControlList)
-{
-    //  获取多个设备界面表格信息
-     if(lst[0] == nullptr) return;
-    deviceList.append(lst[0]->getTableHeader());
-    foreach (DeviceBaseInfo *info, lst) {
-        if(info == nullptr) continue;
-        QStringList lstDeviceInfo = info->getTableData();
-        deviceList.append(lstDeviceInfo);
-
-        QStringList menuControl;
-        menuControl.append(info->canUninstall() ? "true" : "false");
-        menuControl.append(info->canEnable() ? "true" : "false");
-        DeviceInput *input = dynamic_cast<DeviceInput *>(info);
-        if (input) {
-            menuControl.append(input->canWakeupMachine() ? "true" : "false");
-            menuControl.append(input->wakeupPath());
-        }
-
-        DeviceNetwork *network = dynamic_cast<DeviceNetwork *>(info);
-        if (network) {
-            menuControl.append(network->logicalName());
-        }
-
-        menuControlList.append(menuControl);
-    }
-}
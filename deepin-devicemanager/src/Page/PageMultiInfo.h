@@ -47,6 +47,11 @@ public:
      */
     void clearWidgets() override;
 
+    /**
+     * @brief updateDeviceData:只更新表格中已显示的行和可见的详细信息
+     */
+    void updateDeviceData() override;
+
 signals:
     /**
      * @brief refreshInfo:刷新信息信号
@@ -115,20 +120,11 @@ private:
      */
     void initWidgets();
 
-    /**
-     * @brief getTableListInfo 获取需要在表格中显示的数据
-     * @param deviceList 显示在表格中的数据
-     * @param menuList 显示的右键菜单数据
-     */
-    void getTableListInfo(const QList<DeviceBaseInfo *> &lst, QList<QStringList>& deviceList, QList<QStringList>& menuList);
-
 private:
     DLabel                    *mp_Label;
     PageTableHeader           *mp_Table;       //<! 上面的表格
     PageDetail                *mp_Detail;      //<! 下面的详细内容
     QList<DeviceBaseInfo *>   m_lstDevice;     //<! 保存设备列表
-    QList<QStringList>        m_deviceList;    //<! 设备界面表格信息
-    QList<QStringList>        m_menuControlList; //<! 设备界面菜单信息
 };
 
 #endif // DEVICEPAGE_H
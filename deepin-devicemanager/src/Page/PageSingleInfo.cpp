@@ -119,6 +119,34 @@ void PageSingleInfo::updateInfo(const QList<DeviceBaseInfo *> &lst)
     }
 }
 
+void PageSingleInfo::updateDeviceData()
+{
+    if (!mp_Device)
+        return;
+
+    QList<QPair<QString, QString>> baseInfoMap = mp_Device->getBaseAttribs();
+    baseInfoMap = baseInfoMap + mp_Device->getOtherAttribs();
+
+    // 属性项或多行显示方式变化时重新加载整个表格
+    bool sameRows = mp_Content->rowCount() == baseInfoMap.size() + 1;
+    for (int i = 0; sameRows && i < baseInfoMap.size(); ++i) {
+        QTableWidgetItem *itemFirst = mp_Content->item(i, 0);
+        QTableWidgetItem *itemSecond = mp_Content->item(i, 1);
+        sameRows = itemFirst && itemSecond && itemFirst->text() == baseInfoMap[i].first
+                   && itemSecond->text().contains("\n") == baseInfoMap[i].second.contains("\n");
+    }
+    if (!sameRows) {
+        updateInfo(QList<DeviceBaseInfo *>() << mp_Device);
+        return;
+    }
+
+    for (int i = 0; i < baseInfoMap.size(); ++i) {
+        QTableWidgetItem *itemSecond = mp_Content->item(i, 1);
+        if (itemSecond->text() != baseInfoMap[i].second)
+            itemSecond->setText(baseInfoMap[i].second);
+    }
+}
+
 void PageSingleInfo::clearWidgets()
 {
     mp_Device = nullptr;
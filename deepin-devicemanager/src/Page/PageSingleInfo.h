@@ -38,6 +38,11 @@ public:
      */
     virtual void updateInfo(const QList<DeviceBaseInfo *> &lst)override;
 
+    /**
+     * @brief updateDeviceData:属性项不变时只更新变化的单元格
+     */
+    virtual void updateDeviceData() override;
+
     /**
      * @brief clearWidgets clear widgets
      */
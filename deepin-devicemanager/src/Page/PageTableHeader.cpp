@@ -9,7 +9,6 @@
 
 // Dtk头文件
 #include <DFontSizeManager>
-#include <DStandardItem>
 #include <DApplication>
 #include <DGuiApplicationHelper>
 
@@ -54,54 +53,48 @@ void PageTableHeader::initWidgets()
     setLayout(hLayout);
 }
 
-void PageTableHeader::updateTable(const QList<QStringList> &lst, const QList<QStringList>& lstMenuControl, bool resizeTable, int step)
+void PageTableHeader::updateTable(const QList<DeviceBaseInfo *> &lst, bool resizeTable, int step)
 {
     int configRowNum = ROW_NUM;
     if(resizeTable)
         configRowNum = ROW_NUM - step;
 
-    // 如果lst.size() == 1 则说明改设备只有一个
-    if (lst.size() <= 1)
+    // 没有设备时不更新表格
+    if (lst.isEmpty())
         return;
 
-    // 提前清楚内容
-    mp_Table->clear();
-
-    // 设置表头
-    mp_Table->setHeaderLabels(lst[0]);
-
-    // 设置表格的内容
-    int row = lst.size();
-    int column = lst[0].size() - 1;
+    // 设置表格内容,表格只读取可见的行
+    mp_Table->setDevices(lst);
 
     // 设置表格行数以及背景Widget高度
     //(+1)表示包含表头高度,(*2)表示上下边距,
-    if (row - 1 < configRowNum) {
+    int row = lst.size();
+    if (row < configRowNum) {
         // 表格内容行数小于4,表格高度与行数一致，为保证treewidget横向滚动条与item不重叠，添加滚动条高度
-        mp_Table->setRowNum(row - 1);
-        this->setFixedHeight(TREE_ROW_HEIGHT * row + HORSCROLL_WIDTH + WIDGET_MARGIN * 2 + BOTTOM_MARGIN);
+        mp_Table->setRowNum(row);
+        this->setFixedHeight(TREE_ROW_HEIGHT * (row + 1) + HORSCROLL_WIDTH + WIDGET_MARGIN * 2 + BOTTOM_MARGIN);
     } else {
         // 表格内容行数大于等于4,表格行数固定为4，为保证treewidget横向滚动条与item不重叠，添加滚动条高度
         mp_Table->setRowNum(configRowNum);
         this->setFixedHeight(TREE_ROW_HEIGHT * (configRowNum + 1) + HORSCROLL_WIDTH + WIDGET_MARGIN * 2  + BOTTOM_MARGIN);
     }
 
-    for (int i = 0; i < row - 1; i++) {
-        for (int j = 0; j < column; j++) {
-            DStandardItem *item = new DStandardItem(lst[i + 1][j]);
-            if(0 == j){
-                for(int index = 0; index < lstMenuControl[i].size(); index++){
-                    item->setData(lstMenuControl[i][index],Qt::UserRole+index);
-                }
-            }
-            mp_Table->setItem(i, j, item);
-        }
-    }
-
     // 列宽平均分配
     mp_Table->setColumnAverage();
 }
 
+void PageTableHeader::releaseDevices()
+{
+    if (mp_Table)
+        mp_Table->releaseDevices();
+}
+
+void PageTableHeader::updateLoadedRows()
+{
+    if (mp_Table)
+        mp_Table->updateLoadedRows();
+}
+
 void PageTableHeader::setColumnAverage()
 {
     // 列宽平均分配
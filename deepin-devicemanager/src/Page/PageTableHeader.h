@@ -10,6 +10,7 @@
 #include <DWidget>
 
 class TableWidget;
+class DeviceBaseInfo;
 
 using namespace Dtk::Widget;
 
@@ -25,10 +26,22 @@ public:
     ~PageTableHeader();
 
     /**
-     * @brief updateTable:更新表格
-     * @param lst : 表格内容
+     * @brief updateTable:更新表格,同类设备只更新变化的行
+     * @param lst : 设备列表
+     * @param resizeTable : 是否根据窗口高度减少显示的行数
+     * @param step : 减少的行数
      */
-    void updateTable(const QList<QStringList> &lst, const QList<QStringList>& lstMenuControl, bool resizeTable = false, int step = 0);
+    void updateTable(const QList<DeviceBaseInfo *> &lst, bool resizeTable = false, int step = 0);
+
+    /**
+     * @brief releaseDevices:设备对象释放前调用,表格保留已显示的内容
+     */
+    void releaseDevices();
+
+    /**
+     * @brief updateLoadedRows:设备属性变化后只更新已显示的行,不重置表格
+     */
+    void updateLoadedRows();
 
     /**
      * @brief setColumnAverage:设置每列等宽
@@ -46,6 +46,16 @@ void PageTableWidget::setItem(int row, int column, QTableWidgetItem *item)
     mp_Table->setItem(row, column, item);
 }
 
+QTableWidgetItem *PageTableWidget::item(int row, int column) const
+{
+    return mp_Table->item(row, column);
+}
+
+int PageTableWidget::rowCount() const
+{
+    return mp_Table->rowCount();
+}
+
 QString PageTableWidget::toString()
 {
     // table 内容转为QString
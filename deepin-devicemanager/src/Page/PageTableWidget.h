@@ -48,6 +48,20 @@ public:
      */
     void setItem(int row, int column, QTableWidgetItem *item);
 
+    /**
+     * @brief item 获取item
+     * @param row　行
+     * @param column　列
+     * @return 表格项,不存在时为空
+     */
+    QTableWidgetItem *item(int row, int column) const;
+
+    /**
+     * @brief rowCount 表格行数
+     * @return 行数
+     */
+    int rowCount() const;
+
     /**
      * @brief toString 以字符串的方式获取信息
      * @return 单元格内容以字符串显示
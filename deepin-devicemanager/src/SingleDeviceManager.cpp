@@ -5,6 +5,7 @@
 #include "SingleDeviceManager.h"
 #include "MainWindow.h"
 #include "eventlogutils.h"
+#include "DebugTimeManager.h"
 #include "DDLog.h"
 
 #include <DWidgetUtil>
@@ -23,9 +24,11 @@ void SingleDeviceManager::activateWindow()
 {
     qCInfo(appLog) << "SingleDeviceManager::activateWindow()";
     if (nullptr == m_qspMainWnd.get()) {
+        STARTUP_TRACE("create main window");
         m_qspMainWnd.reset(new MainWindow());
         Dtk::Widget::moveToCenter(m_qspMainWnd.get());
         m_qspMainWnd->show();
+        STARTUP_TRACE("main window shown");
         QJsonObject obj{
             {"tid", EventLogUtils::Start},
             {"version", QCoreApplication::applicationVersion()},
@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "CpuFreqReadThread.h"
+#include "CpuFreqSampler.h"
+
+CpuFreqReadThread::CpuFreqReadThread(QObject *parent)
+    : QThread(parent)
+    , m_Generation(0)
+{
+
+}
+
+void CpuFreqReadThread::setFds(const QVector<int> &fds, int generation)
+{
+    m_Fds = fds;
+    m_Generation = generation;
+}
+
+void CpuFreqReadThread::run()
+{
+    m_Results = CpuFreqSampler::readFrequencies(m_Fds);
+}
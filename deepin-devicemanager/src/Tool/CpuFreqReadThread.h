@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CPUFREQREADTHREAD_H
+#define CPUFREQREADTHREAD_H
+
+#include <QThread>
+#include <QVector>
+
+/**
+ * @brief The CpuFreqReadThread class
+ * 在后台读取所有处理器的 scaling_cur_freq,x86 上每次读取都可能等待内核刷新频率,不能在界面线程中读取
+ */
+class CpuFreqReadThread : public QThread
+{
+    Q_OBJECT
+public:
+    explicit CpuFreqReadThread(QObject *parent = nullptr);
+
+    /**
+     * @brief setFds:设置要读取的文件,只能在线程未运行时调用,线程结束前文件不能关闭
+     * @param fds:文件描述符
+     * @param generation:采样器的启动序号,结束后用于判断结果是否过时
+     */
+    void setFds(const QVector<int> &fds, int generation);
+
+    /**
+     * @brief fds:正在或最近一次读取的文件
+     */
+    const QVector<int> &fds() const { return m_Fds; }
+
+    /**
+     * @brief generation:设置文件时的启动序号
+     */
+    int generation() const { return m_Generation; }
+
+    /**
+     * @brief results:最近一次读取的频率,与 fds 一一对应,读取失败为 -1
+     */
+    const QVector<qint64> &results() const { return m_Results; }
+
+protected:
+    void run() override;
+
+private:
+    QVector<int>        m_Fds;          //<! 要读取的文件
+    QVector<qint64>     m_Results;      //<! 读取结果,kHz
+    int                 m_Generation;   //<! 采样器的启动序号
+};
+
+#endif // CPUFREQREADTHREAD_H
@@ -0,0 +1,248 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "CpuFreqSampler.h"
+#include "CpuFreqReadThread.h"
+#include "DeviceManager.h"
+#include "DDLog.h"
+
+// Qt库文件
+#include <QDir>
+#include <QLoggingCategory>
+
+// 其它头文件
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <algorithm>
+
+#define CPU_ROOT                "/sys/devices/system/cpu"
+#define DEFAULT_INTERVAL        1000
+#define MIN_INTERVAL            100
+
+using namespace DDLog;
+
+CpuFreqSampler *CpuFreqSampler::sInstance = nullptr;
+
+CpuFreqSampler::Core::Core()
+    : cpu(-1)
+    , fd(-1)
+    , cur(0)
+    , min(0)
+    , max(0)
+    , sum(0)
+    , count(0)
+{
+
+}
+
+CpuFreqSampler::CpuFreqSampler()
+    : m_Root(CPU_ROOT)
+    , mp_Thread(new CpuFreqReadThread(this))
+    , m_Generation(0)
+    , m_Reading(false)
+{
+    m_Timer.setInterval(DEFAULT_INTERVAL);
+    connect(&m_Timer, &QTimer::timeout, this, &CpuFreqSampler::requestSample);
+    connect(mp_Thread, &QThread::finished, this, &CpuFreqSampler::slotReadFinished);
+}
+
+CpuFreqSampler::~CpuFreqSampler()
+{
+    mp_Thread->wait();
+    m_Reading = false;
+    closeCores();
+    foreach (int fd, m_StaleFds)
+        close(fd);
+}
+
+void CpuFreqSampler::setInterval(int msec)
+{
+    m_Timer.setInterval(qMax(msec, MIN_INTERVAL));
+}
+
+void CpuFreqSampler::setRoot(const QString &root)
+{
+    stop();
+    m_Cores.clear();
+    m_Root = root;
+}
+
+bool CpuFreqSampler::start()
+{
+    if (m_Timer.isActive())
+        return true;
+
+    // 每次进入界面重新打开文件并重新统计,期间上线的处理器也能采样
+    closeCores();
+    m_Cores.clear();
+    ++m_Generation;
+    openCores();
+    if (m_Cores.isEmpty())
+        return false;
+
+    requestSample();
+    m_Timer.start();
+    return true;
+}
+
+void CpuFreqSampler::stop()
+{
+    m_Timer.stop();
+    ++m_Generation;
+    closeCores();
+}
+
+void CpuFreqSampler::sample()
+{
+    merge(readFrequencies(coreFds()));
+}
+
+void CpuFreqSampler::requestSample()
+{
+    // 处理器很多时一次读取可能超过采样间隔,上一次读取未结束时跳过本次
+    if (m_Reading || m_Cores.isEmpty())
+        return;
+
+    m_Reading = true;
+    mp_Thread->setFds(coreFds(), m_Generation);
+    mp_Thread->start();
+}
+
+void CpuFreqSampler::slotReadFinished()
+{
+    mp_Thread->wait();
+    m_Reading = false;
+
+    // 读取期间停止或重新启动时关闭的文件
+    foreach (int fd, m_StaleFds)
+        close(fd);
+    m_StaleFds.clear();
+
+    // 读取期间停止或重新启动过,结果已过时;重新启动后立即开始第一次采样
+    if (mp_Thread->generation() != m_Generation) {
+        if (m_Timer.isActive())
+            requestSample();
+        return;
+    }
+
+    merge(mp_Thread->results());
+}
+
+void CpuFreqSampler::merge(const QVector<qint64> &freqs)
+{
+    for (int i = 0; i < m_Cores.size() && i < freqs.size(); ++i) {
+        Core &core = m_Cores[i];
+        qint64 freq = freqs[i];
+        if (freq <= 0)
+            continue;
+
+        core.cur = freq;
+        if (core.count == 0 || freq < core.min)
+            core.min = freq;
+        if (freq > core.max)
+            core.max = freq;
+        core.sum += freq;
+        ++core.count;
+    }
+    emit sampled();
+}
+
+void CpuFreqSampler::apply()
+{
+    // 处理器序号对应 DeviceCpu 的 processor
+    QMap<QString, QPair<QString, QString>> mapFreq;
+    for (const Core &core : m_Cores) {
+        if (core.count == 0)
+            continue;
+        QString cur = QString("%1 MHz").arg(core.cur / 1000);
+        QString statistics = QString("%1 / %2 / %3 MHz").arg(core.min / 1000).arg(core.avg() / 1000).arg(core.max / 1000);
+        mapFreq.insert(QString::number(core.cpu), qMakePair(cur, statistics));
+    }
+
+    if (!mapFreq.isEmpty())
+        DeviceManager::instance()->setCpuSampledFreq(mapFreq);
+}
+
+qint64 CpuFreqSampler::readFrequency(int fd)
+{
+    char buf[32];
+    ssize_t len;
+    do {
+        len = pread(fd, buf, sizeof(buf), 0);
+    } while (len < 0 && errno == EINTR);
+
+    // 内容为十进制 kHz 加换行
+    qint64 value = 0;
+    ssize_t i = 0;
+    for (; i < len && buf[i] >= '0' && buf[i] <= '9'; ++i)
+        value = value * 10 + (buf[i] - '0');
+    return i > 0 ? value : -1;
+}
+
+QVector<qint64> CpuFreqSampler::readFrequencies(const QVector<int> &fds)
+{
+    // 每个处理器一次 pread,不重新打开文件
+    QVector<qint64> freqs(fds.size(), -1);
+    for (int i = 0; i < fds.size(); ++i) {
+        if (fds[i] >= 0)
+            freqs[i] = readFrequency(fds[i]);
+    }
+    return freqs;
+}
+
+QVector<int> CpuFreqSampler::coreFds() const
+{
+    QVector<int> fds;
+    fds.reserve(m_Cores.size());
+    for (const Core &core : m_Cores)
+        fds.append(core.fd);
+    return fds;
+}
+
+void CpuFreqSampler::openCores()
+{
+    QDir dir(m_Root);
+    const QStringList names = dir.entryList(QStringList() << "cpu*", QDir::Dirs | QDir::NoDotAndDotDot);
+    m_Cores.reserve(names.size());
+    foreach (const QString &name, names) {
+        bool ok = false;
+        int cpu = name.mid(3).toInt(&ok);
+        if (!ok)
+            continue;
+
+        // 离线或不支持调频的处理器没有该文件
+        QByteArray path = QString("%1/%2/cpufreq/scaling_cur_freq").arg(m_Root).arg(name).toLocal8Bit();
+        int fd = open(path.constData(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            continue;
+
+        Core core;
+        core.cpu = cpu;
+        core.fd = fd;
+        m_Cores.append(core);
+    }
+
+    std::sort(m_Cores.begin(), m_Cores.end(), [](const Core & left, const Core & right) {
+        return left.cpu < right.cpu;
+    });
+
+    if (m_Cores.isEmpty())
+        qCWarning(appLog) << "no scaling_cur_freq found under" << m_Root;
+}
+
+void CpuFreqSampler::closeCores()
+{
+    // 后台线程可能正在读取这些文件,读取结束后再关闭
+    for (Core &core : m_Cores) {
+        if (core.fd >= 0) {
+            if (m_Reading)
+                m_StaleFds.append(core.fd);
+            else
+                close(core.fd);
+        }
+        core.fd = -1;
+    }
+}
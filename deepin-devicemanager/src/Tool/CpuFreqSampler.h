@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CPUFREQSAMPLER_H
+#define CPUFREQSAMPLER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+#include <QString>
+
+class CpuFreqReadThread;
+
+/**
+ * @brief The CpuFreqSampler class
+ * 逻辑处理器当前频率的采样器,只在界面线程中使用
+ * 启动时打开每个处理器的 cpufreq/scaling_cur_freq,之后按间隔在 CpuFreqReadThread 中用 pread 读取,统计每个处理器的最小、平均、最大频率
+ * 上一次读取还未结束时跳过本次采样;处理器界面显示时启动,离开时停止并关闭文件
+ */
+class CpuFreqSampler : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief The Core struct
+     * 一个逻辑处理器的采样统计,频率单位 kHz
+     */
+    struct Core {
+        Core();
+
+        /**
+         * @brief avg:平均频率,没有样本时为 0
+         */
+        qint64 avg() const { return count > 0 ? qint64(sum / count) : 0; }
+
+        int         cpu;        //<! 逻辑处理器序号
+        int         fd;         //<! scaling_cur_freq 的文件描述符
+        qint64      cur;        //<! 最近一次采样
+        qint64      min;        //<! 最小值
+        qint64      max;        //<! 最大值
+        double      sum;        //<! 样本总和
+        quint32     count;      //<! 样本数量
+    };
+
+    static CpuFreqSampler *instance()
+    {
+        if (!sInstance) {
+            sInstance = new CpuFreqSampler;
+        }
+        return sInstance;
+    }
+
+    ~CpuFreqSampler() override;
+
+    /**
+     * @brief setInterval:设置采样间隔
+     * @param msec:毫秒,小于 100 时按 100 处理
+     */
+    void setInterval(int msec);
+
+    /**
+     * @brief interval:采样间隔,毫秒
+     */
+    int interval() const { return m_Timer.interval(); }
+
+    /**
+     * @brief setRoot:设置 sysfs 中处理器目录,用于测试
+     * @param root:默认为 /sys/devices/system/cpu
+     */
+    void setRoot(const QString &root);
+
+    /**
+     * @brief start:打开所有处理器的频率文件,立即在后台采样一次并开始定时采样,已启动时不做处理
+     * @return 是否有可采样的处理器
+     */
+    bool start();
+
+    /**
+     * @brief stop:停止采样并关闭文件,统计结果保留到下次启动
+     */
+    void stop();
+
+    /**
+     * @brief isRunning:是否正在采样
+     */
+    bool isRunning() const { return m_Timer.isActive(); }
+
+    /**
+     * @brief sample:在调用线程中读取所有处理器的当前频率
+     */
+    void sample();
+
+    /**
+     * @brief requestSample:在后台读取所有处理器的当前频率,结束后统计并发出 sampled,上一次读取未结束时不做处理
+     */
+    void requestSample();
+
+    /**
+     * @brief apply:将采样结果写入 DeviceManager 中的处理器
+     */
+    void apply();
+
+    /**
+     * @brief cores:所有处理器的统计,按处理器序号排序
+     */
+    const QVector<Core> &cores() const { return m_Cores; }
+
+    /**
+     * @brief readFrequency:从文件开头读取频率
+     * @param fd:文件描述符
+     * @return 频率 kHz,失败时为 -1
+     */
+    static qint64 readFrequency(int fd);
+
+    /**
+     * @brief readFrequencies:依次读取所有文件的频率
+     * @param fds:文件描述符,小于 0 的跳过
+     * @return 频率 kHz,与 fds 一一对应,失败时为 -1
+     */
+    static QVector<qint64> readFrequencies(const QVector<int> &fds);
+
+signals:
+    /**
+     * @brief sampled:完成一次采样
+     */
+    void sampled();
+
+protected:
+    CpuFreqSampler();
+
+private slots:
+    /**
+     * @brief slotReadFinished:后台读取结束,结果未过时则写入统计
+     */
+    void slotReadFinished();
+
+private:
+    /**
+     * @brief merge:将一次读取的结果写入统计并发出 sampled
+     * @param freqs:与 m_Cores 一一对应的频率
+     */
+    void merge(const QVector<qint64> &freqs);
+
+    /**
+     * @brief coreFds:所有处理器的文件描述符
+     */
+    QVector<int> coreFds() const;
+
+    /**
+     * @brief openCores:打开所有在线处理器的频率文件
+     */
+    void openCores();
+
+    /**
+     * @brief closeCores:关闭所有文件
+     */
+    void closeCores();
+
+private:
+    static CpuFreqSampler     *sInstance;
+
+    QVector<Core>             m_Cores;        //<! 按处理器序号排序的统计
+    QString                   m_Root;         //<! 处理器目录
+    QTimer                    m_Timer;        //<! 采样定时器
+    CpuFreqReadThread        *mp_Thread;      //<! 读取频率的线程
+    QVector<int>              m_StaleFds;     //<! 读取期间被关闭的文件,读取结束后再关闭
+    int                       m_Generation;   //<! 启动与停止的序号,用于丢弃过时的读取结果
+    bool                      m_Reading;      //<! 后台读取的结果是否还未处理
+};
+
+#endif // CPUFREQSAMPLER_H
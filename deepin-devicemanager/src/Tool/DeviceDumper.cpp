@@ -0,0 +1,265 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "DeviceDumper.h"
+#include "LoadInfoThread.h"
+#include "ThreadExecXrandr.h"
+#include "NetLinkMonitor.h"
+#include "UPowerMonitor.h"
+#include "DeviceManager.h"
+#include "DeviceInfo.h"
+#include "DeviceRecordWriter.h"
+#include "MacroDefinition.h"
+#include "commonfunction.h"
+#include "DDLog.h"
+
+// Dtk头文件
+#ifdef DTKCORE_CLASS_DConfigFile
+#include <DConfig>
+#endif
+
+// Qt库文件
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTextStream>
+#include <QTimer>
+#include <QLoggingCategory>
+
+#include <stdio.h>
+
+#define UPOWER_WAIT_TIMEOUT 2000    // 设备加载后等待电池信息的最长时间 ms
+
+DCORE_USE_NAMESPACE
+using namespace DDLog;
+
+DeviceDumper::DeviceDumper(const QString &format, const QList<DumpCategory> &categories, QObject *parent)
+    : QObject(parent)
+    , m_Format(format)
+    , m_Categories(categories)
+    , mp_LoadThread(new LoadInfoThread)
+    , mp_XrandrThread(new ThreadExecXrandr(false))
+    , mp_WaitTimer(new QTimer(this))
+    , m_Loaded(false)
+    , m_XrandrFinished(false)
+    , m_Dumped(false)
+{
+    // 命令行模式输出实时信息,不使用快照
+    mp_LoadThread->setSnapshotEnabled(false);
+    connect(mp_LoadThread, &LoadInfoThread::finished, this, &DeviceDumper::slotLoadingFinish);
+
+    // 显示信息和电池信息在设备加载期间获取,加载结束后还未返回时再等待
+    connect(mp_XrandrThread, &QThread::finished, this, [this]() {
+        m_XrandrFinished = true;
+        slotTryDump();
+    });
+    connect(UPowerMonitor::instance(), &UPowerMonitor::fetched, this, &DeviceDumper::slotTryDump);
+    mp_WaitTimer->setSingleShot(true);
+    mp_WaitTimer->setInterval(UPOWER_WAIT_TIMEOUT);
+    connect(mp_WaitTimer, &QTimer::timeout, this, &DeviceDumper::slotTryDump);
+}
+
+DeviceDumper::~DeviceDumper()
+{
+    mp_LoadThread->wait();
+    delete mp_LoadThread;
+    mp_LoadThread = nullptr;
+
+    mp_XrandrThread->wait();
+    delete mp_XrandrThread;
+    mp_XrandrThread = nullptr;
+}
+
+bool DeviceDumper::isDumpCmd(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        QString arg(argv[i]);
+        if ("--dump" == arg || arg.startsWith("--dump="))
+            return true;
+    }
+    return false;
+}
+
+int DeviceDumper::exec(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setOrganizationName("deepin");
+    app.setApplicationName("deepin-devicemanager");
+
+    QCommandLineParser parser;
+    QCommandLineOption dumpOption("dump", "Print device information without starting the GUI.", "json|txt");
+    QCommandLineOption typeOption("type", "Comma separated device categories, e.g. cpu,disk.", "types");
+    parser.addHelpOption();
+    parser.addOption(dumpOption);
+    parser.addOption(typeOption);
+    parser.process(app);
+
+    QString format = parser.value(dumpOption).toLower();
+    if ("json" != format && "txt" != format) {
+        fprintf(stderr, "Unsupported dump format: %s, use json or txt\n", qPrintable(format));
+        return 1;
+    }
+
+    QStringList unknown;
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    QStringList ids = parser.value(typeOption).split(",", QString::SkipEmptyParts);
+#else
+    QStringList ids = parser.value(typeOption).split(",", Qt::SkipEmptyParts);
+#endif
+    QList<DumpCategory> lst = categories(ids, unknown);
+    if (!unknown.isEmpty()) {
+        fprintf(stderr, "Unknown device type: %s\n", qPrintable(unknown.join(",")));
+        return 1;
+    }
+
+#ifdef DTKCORE_CLASS_DConfigFile
+    // 与界面保持一致,特殊机型配置影响设备生成
+    DConfig *dconfig = DConfig::create("org.deepin.devicemanager", "org.deepin.devicemanager");
+    if (dconfig && dconfig->isValid() && dconfig->keyList().contains("specialComType"))
+        Common::specialComType = dconfig->value("specialComType").toInt();
+#endif
+    Common::initPlatformProfile();
+
+    DeviceDumper dumper(format, lst);
+    QObject::connect(&dumper, &DeviceDumper::finished, &app, &QCoreApplication::exit);
+    dumper.start();
+    return app.exec();
+}
+
+QList<DeviceDumper::DumpCategory> DeviceDumper::categories(const QStringList &ids, QStringList &unknown)
+{
+    // 与界面导出的顺序保持一致
+    static const QList<DumpCategory> allCategories = {
+        {"computer",  DT_Computer,  QObject::tr("Computer"),          QObject::tr("No computer found")},
+        {"cpu",       DT_Cpu,       QObject::tr("CPU"),               QObject::tr("No CPU found")},
+        {"board",     DT_Bios,      QObject::tr("Motherboard"),       QObject::tr("No motherboard found")},
+        {"memory",    DT_Memory,    QObject::tr("Memory"),            QObject::tr("No memory found")},
+        {"disk",      DT_Storage,   QObject::tr("Storage"),           QObject::tr("No disk found")},
+        {"gpu",       DT_Gpu,       QObject::tr("Display Adapter"),   QObject::tr("No GPU found")},
+        {"monitor",   DT_Monitor,   QObject::tr("Monitor"),           QObject::tr("No monitor found")},
+        {"network",   DT_Network,   QObject::tr("Network Adapter"),   QObject::tr("No network adapter found")},
+        {"audio",     DT_Audio,     QObject::tr("Sound Adapter"),     QObject::tr("No audio device found")},
+        {"bluetooth", DT_Bluetoorh, QObject::tr("Bluetooth"),         QObject::tr("No Bluetooth device found")},
+        {"otherpci",  DT_OtherPCI,  QObject::tr("Other PCI Devices"), QObject::tr("No other PCI devices found")},
+        {"power",     DT_Power,     QObject::tr("Power"),             QObject::tr("No battery found")},
+        {"keyboard",  DT_Keyboard,  QObject::tr("Keyboard"),          QObject::tr("No keyboard found")},
+        {"mouse",     DT_Mouse,     QObject::tr("Mouse"),             QObject::tr("No mouse found")},
+        {"printer",   DT_Print,     QObject::tr("Printer"),           QObject::tr("No printer found")},
+        {"camera",    DT_Image,     QObject::tr("Camera"),            QObject::tr("No camera found")},
+        {"cdrom",     DT_Cdrom,     QObject::tr("CD-ROM"),            QObject::tr("No CD-ROM found")},
+        {"others",    DT_Others,    QObject::tr("Other Devices"),     QObject::tr("No other devices found")}
+    };
+    // 常用的别名
+    static const QMap<QString, QString> aliases = {
+        {"bios", "board"}, {"storage", "disk"}, {"display", "gpu"}, {"sound", "audio"},
+        {"battery", "power"}, {"image", "camera"}, {"print", "printer"}, {"other", "others"}
+    };
+
+    if (ids.isEmpty())
+        return allCategories;
+
+    QStringList wanted;
+    foreach (const QString &item, ids) {
+        QString id = item.trimmed().toLower();
+        wanted.append(aliases.value(id, id));
+    }
+
+    QList<DumpCategory> lst;
+    foreach (const DumpCategory &category, allCategories) {
+        if (wanted.removeAll(category.id) > 0)
+            lst.append(category);
+    }
+    unknown = wanted;
+    return lst;
+}
+
+void DeviceDumper::start()
+{
+    // 网卡连接状态启动时同步获取,显示和电池信息与设备加载同时获取
+    NetLinkMonitor::instance()->start();
+    UPowerMonitor::instance()->start();
+    mp_XrandrThread->start();
+    mp_LoadThread->start();
+}
+
+bool DeviceDumper::dump(QIODevice &out)
+{
+    if (!out.isWritable())
+        return false;
+
+    if ("json" == m_Format)
+        return dumpJson(out);
+
+    dumpTxt(out);
+    return true;
+}
+
+void DeviceDumper::slotLoadingFinish(const QString &message)
+{
+    if ("finish" != message)
+        return;
+
+    m_Loaded = true;
+    mp_WaitTimer->start();
+    slotTryDump();
+}
+
+void DeviceDumper::slotTryDump()
+{
+    if (!m_Loaded || m_Dumped)
+        return;
+    // 显示信息读取不会一直阻塞,电池信息的 D-Bus 请求最多等待 UPOWER_WAIT_TIMEOUT
+    if (!m_XrandrFinished)
+        return;
+    if (UPowerMonitor::instance()->isFetching() && mp_WaitTimer->isActive())
+        return;
+
+    m_Dumped = true;
+    mp_WaitTimer->stop();
+    applyMonitors();
+    DeviceManager::instance()->setDeviceListClass();
+
+    QFile out;
+    if (!out.open(stdout, QIODevice::WriteOnly) || !dump(out)) {
+        emit finished(1);
+        return;
+    }
+    out.close();
+    emit finished(0);
+}
+
+void DeviceDumper::applyMonitors()
+{
+    // 与界面加载结束时相同,新加载的设备写入显示信息、电池信息和网卡连接状态
+    mp_XrandrThread->applyToDeviceManager();
+    UPowerMonitor::instance()->apply();
+    NetLinkMonitor::instance()->apply();
+}
+
+bool DeviceDumper::dumpJson(QIODevice &out)
+{
+    // 与界面导出的 json 使用相同的记录格式,逐个设备写出
+    DeviceRecordWriter writer(&out, DeviceRecordWriter::RF_Json);
+    foreach (const DumpCategory &category, m_Categories) {
+        QList<DeviceBaseInfo *> *lst = DeviceManager::instance()->convertDeviceListAddr(category.type);
+        if (!lst)
+            continue;
+        foreach (DeviceBaseInfo *device, *lst)
+            writer.writeDevice(category.id, device);
+    }
+    return writer.finish();
+}
+
+void DeviceDumper::dumpTxt(QIODevice &out)
+{
+    QTextStream stream(&out);
+    foreach (const DumpCategory &category, m_Categories) {
+        QList<DeviceBaseInfo *> *lst = DeviceManager::instance()->convertDeviceListAddr(category.type);
+        if (!lst)
+            continue;
+        EXPORT_TO_TXT(stream, (*lst), category.title, category.empty);
+    }
+    stream.flush();
+}
@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DEVICEDUMPER_H
+#define DEVICEDUMPER_H
+
+#include "GenerateDevicePool.h"
+
+#include <QObject>
+#include <QStringList>
+#include <QList>
+
+class QIODevice;
+class QTimer;
+class LoadInfoThread;
+class ThreadExecXrandr;
+
+/**
+ * @brief The DeviceDumper class
+ * 命令行模式: deepin-devicemanager --dump json|txt [--type cpu,disk]
+ * 不启动界面,在 QCoreApplication 下执行与界面相同的采集、解析和生成流程,结果输出到标准输出
+ * json 输出与界面导出的 json 相同,由 DeviceRecordWriter 写出
+ * 与界面相同,设备写入 RandR 显示信息、网卡连接状态和 UPower 电池信息后再输出
+ */
+class DeviceDumper : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief The DumpCategory struct 可导出的设备类别
+     */
+    struct DumpCategory {
+        QString     id;      //<! 命令行中使用的类别名
+        DeviceType  type;    //<! 设备类型
+        QString     title;   //<! 类别标题
+        QString     empty;   //<! 没有设备时的提示
+    };
+
+    DeviceDumper(const QString &format, const QList<DumpCategory> &categories, QObject *parent = nullptr);
+    ~DeviceDumper();
+
+    /**
+     * @brief isDumpCmd:命令行参数中是否包含 --dump
+     */
+    static bool isDumpCmd(int argc, char *argv[]);
+
+    /**
+     * @brief exec:运行命令行模式
+     * @return 进程退出码
+     */
+    static int exec(int argc, char *argv[]);
+
+    /**
+     * @brief categories:根据类别名获取要导出的设备类别
+     * @param ids:类别名,为空时返回全部类别
+     * @param unknown:无法识别的类别名
+     * @return 按导出顺序排列的设备类别
+     */
+    static QList<DumpCategory> categories(const QStringList &ids, QStringList &unknown);
+
+    /**
+     * @brief start:开始加载设备信息,同时获取显示、网卡和电池信息,都结束后输出并发出 finished 信号
+     */
+    void start();
+
+    /**
+     * @brief dump:将 DeviceManager 中的设备输出
+     * @param out:输出设备
+     * @return true:输出成功;false:输出失败
+     */
+    bool dump(QIODevice &out);
+
+signals:
+    void finished(int code);
+
+private slots:
+    /**
+     * @brief slotLoadingFinish:设备加载结束
+     * @param message:加载结果
+     */
+    void slotLoadingFinish(const QString &message);
+
+    /**
+     * @brief slotTryDump:设备、显示和电池信息都已获取或等待超时后输出
+     */
+    void slotTryDump();
+
+private:
+    /**
+     * @brief applyMonitors:将显示信息、网卡连接状态和电池信息写入加载的设备
+     */
+    void applyMonitors();
+
+    bool dumpJson(QIODevice &out);
+    void dumpTxt(QIODevice &out);
+
+private:
+    QString               m_Format;        //<! 输出格式 json/txt
+    QList<DumpCategory>   m_Categories;    //<! 要输出的设备类别
+    LoadInfoThread        *mp_LoadThread;  //<! 加载设备信息的线程
+    ThreadExecXrandr      *mp_XrandrThread;//<! 获取显示信息的线程
+    QTimer                *mp_WaitTimer;   //<! 设备加载后等待电池信息的超时
+    bool                  m_Loaded;        //<! 设备是否已加载
+    bool                  m_XrandrFinished;//<! 显示信息是否已获取
+    bool                  m_Dumped;        //<! 是否已输出
+};
+
+#endif // DEVICEDUMPER_H
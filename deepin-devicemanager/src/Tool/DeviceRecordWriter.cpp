@@ -0,0 +1,207 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "DeviceRecordWriter.h"
+#include "DeviceInfo.h"
+
+// Qt库文件
+#include <QSet>
+
+#define RECORD_VERSION  1
+
+DeviceRecordWriter::DeviceRecordWriter(QIODevice *device, RecordFormat format)
+    : mp_Device(device)
+    , m_Format(format)
+    , mp_Cbor(nullptr)
+    , m_Count(0)
+    , m_Finished(false)
+    , m_Error(!device || !device->isWritable())
+{
+    if (m_Error)
+        return;
+
+    if (RF_Cbor == m_Format) {
+        // 以自描述标签开头,设备数组使用不定长编码,无需预先知道设备数
+        mp_Cbor = new QCborStreamWriter(mp_Device);
+        mp_Cbor->append(QCborKnownTags::Signature);
+        mp_Cbor->startMap(2);
+        mp_Cbor->append(QLatin1String("version"));
+        mp_Cbor->append(qint64(RECORD_VERSION));
+        mp_Cbor->append(QLatin1String("devices"));
+        mp_Cbor->startArray();
+    } else {
+        writeRaw("{\"version\":" + QByteArray::number(RECORD_VERSION) + ",\"devices\":[");
+    }
+}
+
+DeviceRecordWriter::~DeviceRecordWriter()
+{
+    delete mp_Cbor;
+    mp_Cbor = nullptr;
+}
+
+void DeviceRecordWriter::writeDevice(const QString &type, DeviceBaseInfo *device)
+{
+    if (m_Error || m_Finished || !device)
+        return;
+
+    // 属性名使用未翻译的原文,不随界面语言变化
+    QList<QPair<QString, QString>> base;
+    QList<QPair<QString, QString>> other;
+    device->copySourceAttribs(base, other);
+    makeKeysUnique(base);
+    makeKeysUnique(other);
+
+    if (RF_Cbor == m_Format)
+        writeCborDevice(type, device, base, other);
+    else
+        writeJsonDevice(type, device, base, other);
+    ++m_Count;
+}
+
+bool DeviceRecordWriter::finish()
+{
+    if (m_Error)
+        return false;
+    if (m_Finished)
+        return true;
+    m_Finished = true;
+
+    if (mp_Cbor) {
+        mp_Cbor->endArray();
+        mp_Cbor->endMap();
+    } else {
+        writeRaw(m_Count > 0 ? "\n]}\n" : "]}\n");
+    }
+    return !m_Error;
+}
+
+void DeviceRecordWriter::writeJsonDevice(const QString &type, DeviceBaseInfo *device,
+                                         const QList<QPair<QString, QString>> &base,
+                                         const QList<QPair<QString, QString>> &other)
+{
+    // 一个设备一行,拼好后一次写出
+    QByteArray buf;
+    buf += m_Count > 0 ? ",\n{" : "\n{";
+    buf += "\"type\":";
+    appendJsonString(buf, type);
+    buf += ",\"name\":";
+    appendJsonString(buf, device->name());
+    buf += ",\"uniqueId\":";
+    appendJsonString(buf, device->uniqueID());
+    buf += ",\"driver\":";
+    appendJsonString(buf, device->driver());
+    buf += ",\"enable\":";
+    buf += device->enable() ? "true" : "false";
+    buf += ",\"available\":";
+    buf += device->available() ? "true" : "false";
+
+    buf += ",\"base\":{";
+    for (int i = 0; i < base.size(); ++i) {
+        if (i > 0)
+            buf += ',';
+        appendJsonString(buf, base[i].first);
+        buf += ':';
+        appendJsonString(buf, base[i].second);
+    }
+
+    buf += "},\"other\":{";
+    for (int i = 0; i < other.size(); ++i) {
+        if (i > 0)
+            buf += ',';
+        appendJsonString(buf, other[i].first);
+        buf += ':';
+        appendJsonString(buf, other[i].second);
+    }
+    buf += "}}";
+
+    writeRaw(buf);
+}
+
+void DeviceRecordWriter::writeCborDevice(const QString &type, DeviceBaseInfo *device,
+                                         const QList<QPair<QString, QString>> &base,
+                                         const QList<QPair<QString, QString>> &other)
+{
+    mp_Cbor->startMap(8);
+    mp_Cbor->append(QLatin1String("type"));
+    mp_Cbor->append(type);
+    mp_Cbor->append(QLatin1String("name"));
+    mp_Cbor->append(device->name());
+    mp_Cbor->append(QLatin1String("uniqueId"));
+    mp_Cbor->append(device->uniqueID());
+    mp_Cbor->append(QLatin1String("driver"));
+    mp_Cbor->append(device->driver());
+    mp_Cbor->append(QLatin1String("enable"));
+    mp_Cbor->append(device->enable());
+    mp_Cbor->append(QLatin1String("available"));
+    mp_Cbor->append(device->available());
+
+    mp_Cbor->append(QLatin1String("base"));
+    mp_Cbor->startMap(quint64(base.size()));
+    foreach (auto item, base) {
+        mp_Cbor->append(item.first);
+        mp_Cbor->append(item.second);
+    }
+    mp_Cbor->endMap();
+
+    mp_Cbor->append(QLatin1String("other"));
+    mp_Cbor->startMap(quint64(other.size()));
+    foreach (auto item, other) {
+        mp_Cbor->append(item.first);
+        mp_Cbor->append(item.second);
+    }
+    mp_Cbor->endMap();
+
+    mp_Cbor->endMap();
+}
+
+void DeviceRecordWriter::makeKeysUnique(QList<QPair<QString, QString>> &attribs)
+{
+    // 同一设备可能有重名的属性,重名的依次加上序号,避免记录中键重复
+    QSet<QString> keys;
+    for (int i = 0; i < attribs.size(); ++i) {
+        QString key = attribs[i].first;
+        for (int n = 2; keys.contains(key); ++n)
+            key = QString("%1 (%2)").arg(attribs[i].first).arg(n);
+        keys.insert(key);
+        attribs[i].first = key;
+    }
+}
+
+void DeviceRecordWriter::writeRaw(const QByteArray &data)
+{
+    if (mp_Device->write(data) != data.size())
+        m_Error = true;
+}
+
+void DeviceRecordWriter::appendJsonString(QByteArray &buf, const QString &str)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    const QByteArray utf8 = str.toUtf8();
+    buf += '"';
+    foreach (char ch, utf8) {
+        const uchar c = uchar(ch);
+        switch (c) {
+        case '"':  buf += "\\\""; break;
+        case '\\': buf += "\\\\"; break;
+        case '\b': buf += "\\b"; break;
+        case '\f': buf += "\\f"; break;
+        case '\n': buf += "\\n"; break;
+        case '\r': buf += "\\r"; break;
+        case '\t': buf += "\\t"; break;
+        default:
+            if (c < 0x20) {
+                buf += "\\u00";
+                buf += hex[c >> 4];
+                buf += hex[c & 0xF];
+            } else {
+                buf += ch;
+            }
+            break;
+        }
+    }
+    buf += '"';
+}
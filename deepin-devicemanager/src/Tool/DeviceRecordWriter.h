@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DEVICERECORDWRITER_H
+#define DEVICERECORDWRITER_H
+
+#include <QString>
+#include <QList>
+#include <QPair>
+#include <QByteArray>
+#include <QIODevice>
+#include <QCborStreamWriter>
+
+class DeviceBaseInfo;
+
+/**
+ * @brief The DeviceRecordWriter class
+ * 以JSON或CBOR格式逐个写出设备记录,供其它程序读取
+ * 每个设备写完即输出到设备,内存占用与设备总数无关
+ * 输出结构: {"version": 1, "devices": [{"type", "name", "uniqueId", "driver", "enable", "available", "base", "other"}, ...]}
+ * base 和 other 的属性名为未翻译的原文,不随界面语言变化,重名的属性名加上序号
+ */
+class DeviceRecordWriter
+{
+public:
+    enum RecordFormat {
+        RF_Json = 0,
+        RF_Cbor = 1
+    };
+
+    /**
+     * @brief DeviceRecordWriter:构造函数,写出记录头
+     * @param device:已打开的输出设备
+     * @param format:输出格式
+     */
+    DeviceRecordWriter(QIODevice *device, RecordFormat format);
+    ~DeviceRecordWriter();
+
+    /**
+     * @brief writeDevice:写出一个设备
+     * @param type:设备类别名,与 --dump --type 使用的类别名一致
+     * @param device:设备
+     */
+    void writeDevice(const QString &type, DeviceBaseInfo *device);
+
+    /**
+     * @brief finish:写出记录尾
+     * @return true:写出成功;false:写出失败
+     */
+    bool finish();
+
+    /**
+     * @brief deviceCount:已写出的设备数
+     */
+    int deviceCount() const { return m_Count; }
+
+private:
+    void writeJsonDevice(const QString &type, DeviceBaseInfo *device,
+                         const QList<QPair<QString, QString>> &base, const QList<QPair<QString, QString>> &other);
+    void writeCborDevice(const QString &type, DeviceBaseInfo *device,
+                         const QList<QPair<QString, QString>> &base, const QList<QPair<QString, QString>> &other);
+    void writeRaw(const QByteArray &data);
+
+    /**
+     * @brief makeKeysUnique:重名的属性名依次加上序号 "名称 (2)"
+     */
+    static void makeKeysUnique(QList<QPair<QString, QString>> &attribs);
+
+    /**
+     * @brief appendJsonString:将字符串转义后以JSON字符串形式追加到 buf
+     */
+    static void appendJsonString(QByteArray &buf, const QString &str);
+
+private:
+    QIODevice            *mp_Device;     //<! 输出设备
+    RecordFormat         m_Format;       //<! 输出格式
+    QCborStreamWriter    *mp_Cbor;       //<! CBOR格式的流式写出器
+    int                  m_Count;        //<! 已写出的设备数
+    bool                 m_Finished;     //<! 是否已写出记录尾
+    bool                 m_Error;        //<! 是否写出失败
+};
+
+#endif // DEVICERECORDWRITER_H
@@ -0,0 +1,227 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "DocxStreamWriter.h"
+
+// Qt库文件
+#include <QFile>
+#include <private/qzipreader_p.h>
+
+#define DOCUMENT_PART   "word/document.xml"
+#define TABLE_COL_WIDTH "1600"
+
+static const char *contentTypesXml =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+    "<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+    "<Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+    "<Default Extension=\"xml\" ContentType=\"application/xml\"/>"
+    "<Override PartName=\"/word/document.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.wordprocessingml.document.main+xml\"/>"
+    "</Types>";
+
+static const char *rootRelsXml =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+    "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+    "<Relationship Id=\"rId1\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument\" Target=\"word/document.xml\"/>"
+    "</Relationships>";
+
+static const char *documentHeadXml =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+    "<w:document xmlns:r=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships\" "
+    "xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\"><w:body>";
+
+static const char *documentTailXml = "<w:sectPr/></w:body></w:document>";
+
+// 表格边框与 Docx::Table 默认生成的一致
+static const char *tablePrXml =
+    "<w:tblPr><w:tblBorders>"
+    "<w:top w:val=\"single\" w:color=\"auto\" w:sz=\"4\" w:space=\"0\"/>"
+    "<w:left w:val=\"single\" w:color=\"auto\" w:sz=\"4\" w:space=\"0\"/>"
+    "<w:bottom w:val=\"single\" w:color=\"auto\" w:sz=\"4\" w:space=\"0\"/>"
+    "<w:right w:val=\"single\" w:color=\"auto\" w:sz=\"4\" w:space=\"0\"/>"
+    "<w:insideH w:val=\"single\" w:color=\"auto\" w:sz=\"4\" w:space=\"0\"/>"
+    "<w:insideV w:val=\"single\" w:color=\"auto\" w:sz=\"4\" w:space=\"0\"/>"
+    "</w:tblBorders></w:tblPr>";
+
+DocxStreamWriter::DocxStreamWriter(const QString &filePath, const QString &templatePath)
+    : m_Zip(filePath)
+    , mp_Fragment(nullptr)
+    , m_Opened(false)
+    , m_TableCols(0)
+{
+    if (!m_Zip.isOpen())
+        return;
+
+    if (!copyTemplate(templatePath))
+        writeDefaultParts();
+
+    // document.xml 放在最后,正文边生成边写入该条目
+    m_Opened = m_Zip.beginEntry(DOCUMENT_PART) && m_Zip.write(m_DocHead);
+}
+
+DocxStreamWriter::DocxStreamWriter(QIODevice *fragment)
+    : m_Zip(QString())
+    , mp_Fragment(fragment)
+    , m_Opened(fragment && fragment->isWritable())
+    , m_TableCols(0)
+{
+
+}
+
+DocxStreamWriter::~DocxStreamWriter()
+{
+
+}
+
+void DocxStreamWriter::addHeading(const QString &text, int level)
+{
+    // 与 Docx::Document::addHeading 一致,0级为 Title,其余以级别作为样式
+    writeParagraph(text, level == 0 ? QString("Title") : QString::number(level));
+}
+
+void DocxStreamWriter::addParagraph(const QString &text)
+{
+    writeParagraph(text, QString());
+}
+
+void DocxStreamWriter::beginTable(const QStringList &header)
+{
+    if (!m_Opened || header.isEmpty())
+        return;
+
+    endTable();
+
+    QByteArray xml = "<w:tbl>";
+    xml += tablePrXml;
+    xml += "<w:tblGrid>";
+    for (int col = 0; col < header.size(); ++col)
+        xml += "<w:gridCol w:w=\"" TABLE_COL_WIDTH "\"/>";
+    xml += "</w:tblGrid>";
+    writeXml(xml);
+
+    m_TableCols = header.size();
+    addTableRow(header);
+}
+
+void DocxStreamWriter::addTableRow(const QStringList &cells)
+{
+    if (!m_Opened || m_TableCols < 1)
+        return;
+
+    QByteArray xml = "<w:tr>";
+    for (int col = 0; col < m_TableCols; ++col) {
+        xml += "<w:tc><w:tcPr><w:tcW w:w=\"" TABLE_COL_WIDTH "\" w:type=\"dxa\"/></w:tcPr><w:p>";
+        if (col < cells.size())
+            xml += runXml(cells[col]);
+        xml += "</w:p></w:tc>";
+    }
+    xml += "</w:tr>";
+    writeXml(xml);
+}
+
+void DocxStreamWriter::endTable()
+{
+    if (!m_Opened || m_TableCols < 1)
+        return;
+
+    writeXml("</w:tbl>");
+    m_TableCols = 0;
+}
+
+void DocxStreamWriter::addFragment(const QByteArray &xml)
+{
+    if (!m_Opened)
+        return;
+
+    endTable();
+    writeXml(xml);
+}
+
+bool DocxStreamWriter::save()
+{
+    if (!m_Opened)
+        return false;
+
+    endTable();
+    if (mp_Fragment)
+        return true;
+    m_Opened = false;
+
+    bool ok = m_Zip.write(m_DocTail) && m_Zip.endEntry();
+    return m_Zip.close() && ok;
+}
+
+bool DocxStreamWriter::copyTemplate(const QString &templatePath)
+{
+    QFile file(templatePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QZipReader reader(&file);
+    if (reader.status() != QZipReader::NoError)
+        return false;
+
+    // 从模板的 document.xml 中取出命名空间声明与页面设置
+    QByteArray document = reader.fileData(DOCUMENT_PART);
+    int bodyIndex = document.indexOf("<w:body>");
+    int sectIndex = document.lastIndexOf("<w:sectPr");
+    if (bodyIndex < 0 || sectIndex < bodyIndex)
+        return false;
+
+    m_DocHead = document.left(bodyIndex + int(qstrlen("<w:body>")));
+    m_DocTail = document.mid(sectIndex);
+
+    foreach (const QZipReader::FileInfo &info, reader.fileInfoList()) {
+        if (!info.isFile || info.filePath == DOCUMENT_PART)
+            continue;
+        m_Zip.addFile(info.filePath, reader.fileData(info.filePath));
+    }
+    return true;
+}
+
+void DocxStreamWriter::writeDefaultParts()
+{
+    m_DocHead = documentHeadXml;
+    m_DocTail = documentTailXml;
+    m_Zip.addFile("[Content_Types].xml", QByteArray(contentTypesXml));
+    m_Zip.addFile("_rels/.rels", QByteArray(rootRelsXml));
+}
+
+void DocxStreamWriter::writeXml(const QByteArray &xml)
+{
+    if (mp_Fragment)
+        mp_Fragment->write(xml);
+    else
+        m_Zip.write(xml);
+}
+
+void DocxStreamWriter::writeParagraph(const QString &text, const QString &style)
+{
+    if (!m_Opened)
+        return;
+
+    // 表格之后的段落需要先结束表格
+    endTable();
+
+    QByteArray xml = "<w:p>";
+    if (!style.isEmpty())
+        xml += "<w:pPr><w:pStyle w:val=\"" + ZipStreamWriter::escapeXml(style).toUtf8() + "\"/></w:pPr>";
+    xml += runXml(text);
+    xml += "</w:p>";
+    writeXml(xml);
+}
+
+QByteArray DocxStreamWriter::runXml(const QString &text) const
+{
+    QByteArray xml = "<w:r>";
+    QStringList lines = text.split('\n');
+    for (int i = 0; i < lines.size(); ++i) {
+        if (i > 0)
+            xml += "<w:br/>";
+        if (!lines[i].isEmpty())
+            xml += "<w:t xml:space=\"preserve\">" + ZipStreamWriter::escapeXml(lines[i]).toUtf8() + "</w:t>";
+    }
+    xml += "</w:r>";
+    return xml;
+}
@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DOCXSTREAMWRITER_H
+#define DOCXSTREAMWRITER_H
+
+#include "ZipStreamWriter.h"
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QIODevice>
+
+/**
+ * @brief The DocxStreamWriter class
+ * 流式写出的docx文档
+ * 样式、主题等部件从模板复制,段落与表格直接写入包内的 word/document.xml 条目,不在内存中建立文档树
+ * 片段模式下正文写到指定设备,由主写出器通过 addFragment 按顺序合入,用于并行渲染各设备类别
+ */
+class DocxStreamWriter
+{
+public:
+    /**
+     * @brief DocxStreamWriter:构造函数
+     * @param filePath:输出文件路径
+     * @param templatePath:模板docx路径,读取失败时使用内置的最小部件
+     */
+    explicit DocxStreamWriter(const QString &filePath, const QString &templatePath = ":/template.docx");
+
+    /**
+     * @brief DocxStreamWriter:片段模式,正文写到 fragment,不生成文档包
+     * @param fragment:已打开的输出设备
+     */
+    explicit DocxStreamWriter(QIODevice *fragment);
+    ~DocxStreamWriter();
+
+    /**
+     * @brief addHeading:添加标题
+     * @param text:标题内容
+     * @param level:标题级别
+     */
+    void addHeading(const QString &text, int level = 1);
+
+    /**
+     * @brief addParagraph:添加段落,文本中的换行写为换行符
+     * @param text:段落内容
+     */
+    void addParagraph(const QString &text);
+
+    /**
+     * @brief beginTable:开始表格并写入表头,列数由表头决定
+     * @param header:表头
+     */
+    void beginTable(const QStringList &header);
+
+    /**
+     * @brief addTableRow:添加表格行,超出表头列数的内容被忽略
+     * @param cells:行内容
+     */
+    void addTableRow(const QStringList &cells);
+
+    /**
+     * @brief endTable:结束表格
+     */
+    void endTable();
+
+    /**
+     * @brief addFragment:追加片段模式写出的正文
+     * @param xml:正文片段
+     */
+    void addFragment(const QByteArray &xml);
+
+    /**
+     * @brief save:结束写入并关闭文件,片段模式下只结束未关闭的表格
+     * @return true:保存成功;false:保存失败
+     */
+    bool save();
+
+private:
+    /**
+     * @brief copyTemplate:复制模板中除 document.xml 外的部件,并取出 document.xml 的首尾
+     * @return true:模板可用;false:模板不可用
+     */
+    bool copyTemplate(const QString &templatePath);
+
+    /**
+     * @brief writeDefaultParts:写入内置的最小部件
+     */
+    void writeDefaultParts();
+
+    void writeXml(const QByteArray &xml);
+    void writeParagraph(const QString &text, const QString &style);
+    QByteArray runXml(const QString &text) const;
+
+private:
+    ZipStreamWriter   m_Zip;           //<! 输出的zip包
+    QIODevice        *mp_Fragment;     //<! 片段模式下的输出设备
+    bool              m_Opened;        //<! document.xml 条目是否已开始
+    QByteArray        m_DocHead;       //<! document.xml 中 <w:body> 之前的内容
+    QByteArray        m_DocTail;       //<! document.xml 中 <w:sectPr> 及之后的内容
+    int               m_TableCols;     //<! 当前表格列数,0表示不在表格中
+};
+
+#endif // DOCXSTREAMWRITER_H
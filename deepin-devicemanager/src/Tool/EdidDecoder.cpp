@@ -0,0 +1,343 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "EdidDecoder.h"
+
+// Qt库文件
+#include <QObject>
+#include <QDate>
+
+// 其它头文件
+#include <qmath.h>
+#include <string.h>
+
+#define EDID_BLOCK_SIZE         128
+#define EDID_DESCRIPTOR_OFFSET  54
+#define EDID_DESCRIPTOR_SIZE    18
+#define EDID_DESCRIPTOR_COUNT   4
+
+#define EXT_TAG_CEA             0x02
+#define EXT_TAG_DISPLAYID       0x70
+
+#define DESC_TAG_SERIAL         0xFF
+#define DESC_TAG_RANGE_LIMITS   0xFD
+#define DESC_TAG_NAME           0xFC
+
+#define CEA_TAG_EXTENDED        0x07
+#define CEA_EXT_TAG_HDR         0x06
+
+#define DISPLAYID_TAG_TILE      0x12    // DisplayID 1.3
+#define DISPLAYID2_TAG_TILE     0x28    // DisplayID 2.0
+
+static const uchar edidHeader[8] = {0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00};
+
+EdidDecoder::EdidDecoder()
+{
+    reset();
+}
+
+bool EdidDecoder::decode(const QByteArray &edid, QString &errorMsg)
+{
+    reset();
+
+    // 判断是否是合理的edid
+    if (edid.size() < EDID_BLOCK_SIZE || memcmp(edid.constData(), edidHeader, sizeof(edidHeader)) != 0) {
+        errorMsg = "Error edid info";
+        return false;
+    }
+
+    const uchar *data = reinterpret_cast<const uchar *>(edid.constData());
+    parseBaseBlock(data);
+    m_ChecksumValid = blockChecksum(data);
+
+    // 扩展块数量以实际读到的数据为准
+    const int blocks = edid.size() / EDID_BLOCK_SIZE;
+    m_ExtensionCount = qMin<int>(data[126], blocks - 1);
+    for (int i = 1; i <= m_ExtensionCount; ++i) {
+        const uchar *block = data + i * EDID_BLOCK_SIZE;
+        m_ChecksumValid = m_ChecksumValid && blockChecksum(block);
+
+        if (block[0] == EXT_TAG_CEA)
+            parseCeaBlock(block);
+        else if (block[0] == EXT_TAG_DISPLAYID)
+            parseDisplayIdBlock(block);
+    }
+
+    return true;
+}
+
+const QString &EdidDecoder::vendor() const
+{
+    return m_Vendor;
+}
+
+const QString &EdidDecoder::model() const
+{
+    return m_Model;
+}
+
+const QString &EdidDecoder::releaseDate() const
+{
+    return m_ReleaseDate;
+}
+
+const QString &EdidDecoder::screenSize() const
+{
+    return m_ScreenSize;
+}
+
+const QString &EdidDecoder::monitorName() const
+{
+    return m_MonitorName;
+}
+
+const QString &EdidDecoder::serialNumber() const
+{
+    return m_SerialNumber;
+}
+
+QString EdidDecoder::version() const
+{
+    return QString("%1.%2").arg(m_Version).arg(m_Revision);
+}
+
+int EdidDecoder::width() const
+{
+    return m_Width;
+}
+
+int EdidDecoder::height() const
+{
+    return m_Height;
+}
+
+int EdidDecoder::preferredWidth() const
+{
+    return m_PreferredWidth;
+}
+
+int EdidDecoder::preferredHeight() const
+{
+    return m_PreferredHeight;
+}
+
+int EdidDecoder::extensionCount() const
+{
+    return m_ExtensionCount;
+}
+
+bool EdidDecoder::checksumValid() const
+{
+    return m_ChecksumValid;
+}
+
+bool EdidDecoder::hasCea() const
+{
+    return m_HasCea;
+}
+
+const EdidDecoder::RangeLimits &EdidDecoder::rangeLimits() const
+{
+    return m_RangeLimits;
+}
+
+const EdidDecoder::HdrMetadata &EdidDecoder::hdr() const
+{
+    return m_Hdr;
+}
+
+const EdidDecoder::TileInfo &EdidDecoder::tile() const
+{
+    return m_Tile;
+}
+
+void EdidDecoder::reset()
+{
+    m_Vendor.clear();
+    m_Model.clear();
+    m_ReleaseDate.clear();
+    m_ScreenSize.clear();
+    m_MonitorName.clear();
+    m_SerialNumber.clear();
+    m_Version = 0;
+    m_Revision = 0;
+    m_Width = 0;
+    m_Height = 0;
+    m_PreferredWidth = 0;
+    m_PreferredHeight = 0;
+    m_ExtensionCount = 0;
+    m_ChecksumValid = false;
+    m_HasCea = false;
+    memset(&m_RangeLimits, 0, sizeof(m_RangeLimits));
+    memset(&m_Hdr, 0, sizeof(m_Hdr));
+    memset(&m_Tile, 0, sizeof(m_Tile));
+}
+
+void EdidDecoder::parseBaseBlock(const uchar *block)
+{
+    // 08h 09h 为厂商缩写,按(1,5,5,5)位存放三个字母
+    char name[4];
+    name[0] = char(((block[8] & 0x7C) >> 2) + '@');
+    name[1] = char(((block[8] & 0x03) << 3) + ((block[9] & 0xE0) >> 5) + '@');
+    name[2] = char((block[9] & 0x1F) + '@');
+    name[3] = 0;
+    m_Vendor = QString::fromLatin1(name);
+
+    // 0Ah 0Bh 为产品代码,与 EDIDParser 一样按原始字节顺序显示
+    m_Model = QString("%1%2").arg(int(block[10]), 2, 16, QLatin1Char('0')).arg(int(block[11]), 2, 16, QLatin1Char('0'));
+
+    // 10h 为生产周,11h 为年份;周为0或0xFF时只有年份
+    const int week = block[16];
+    QDate date(block[17] + 1990, 1, 1);
+    if (week != 0 && week != 0xFF)
+        date = date.addDays(week * 7 - 1);
+    m_ReleaseDate = date.toString("yyyy-MM");
+
+    m_Version = block[18];
+    m_Revision = block[19];
+
+    for (int i = 0; i < EDID_DESCRIPTOR_COUNT; ++i)
+        parseDescriptor(block + EDID_DESCRIPTOR_OFFSET + i * EDID_DESCRIPTOR_SIZE);
+
+    parseScreenSize(block);
+}
+
+void EdidDecoder::parseDescriptor(const uchar *desc)
+{
+    // 像素时钟非0为详细时序描述符,第一个即首选分辨率
+    if (desc[0] != 0 || desc[1] != 0) {
+        if (m_PreferredWidth == 0) {
+            m_PreferredWidth = desc[2] | ((desc[4] & 0xF0) << 4);
+            m_PreferredHeight = desc[5] | ((desc[7] & 0xF0) << 4);
+        }
+        return;
+    }
+
+    switch (desc[3]) {
+    case DESC_TAG_NAME:
+        m_MonitorName = descriptorText(desc);
+        break;
+    case DESC_TAG_SERIAL:
+        m_SerialNumber = descriptorText(desc);
+        break;
+    case DESC_TAG_RANGE_LIMITS: {
+        // edid 1.4 中 byte4 的低4位表示对应的频率需加255
+        const uchar offsets = desc[4];
+        m_RangeLimits.valid = true;
+        m_RangeLimits.minVRate = desc[5] + ((offsets & 0x03) == 0x03 ? 255 : 0);
+        m_RangeLimits.maxVRate = desc[6] + ((offsets & 0x02) ? 255 : 0);
+        m_RangeLimits.minHRate = desc[7] + ((offsets & 0x0C) == 0x0C ? 255 : 0);
+        m_RangeLimits.maxHRate = desc[8] + ((offsets & 0x08) ? 255 : 0);
+        m_RangeLimits.maxPixelClock = desc[9] * 10;
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void EdidDecoder::parseScreenSize(const uchar *block)
+{
+    // 第一个详细时序描述符中的图像尺寸,单位mm
+    const uchar *dtd = block + EDID_DESCRIPTOR_OFFSET;
+    if (dtd[0] != 0 || dtd[1] != 0) {
+        m_Width = dtd[12] | ((dtd[14] & 0xF0) << 4);
+        m_Height = dtd[13] | ((dtd[14] & 0x0F) << 8);
+    }
+
+    // 15h 16h 为屏幕大小(cm),与详细时序相差超10mm则用15h 16h的
+    const int width15 = block[21] * 10;
+    const int height16 = block[22] * 10;
+    if (m_Width + 10 < width15 || m_Height + 10 < height16) {
+        m_Width = width15;
+        m_Height = height16;
+    }
+
+    double inch = sqrt((m_Width / 2.54) * (m_Width / 2.54) + (m_Height / 2.54) * (m_Height / 2.54)) / 10;
+    m_ScreenSize = QString("%1 %2(%3mm X %4mm)").arg(QString::number(inch, '0', 1)).arg(QObject::tr("inch")).arg(m_Width).arg(m_Height);
+}
+
+void EdidDecoder::parseCeaBlock(const uchar *block)
+{
+    m_HasCea = true;
+
+    // byte2 为详细时序描述符的起始位置,之前为数据块集合
+    const int dtdOffset = block[2];
+    if (dtdOffset < 4 || dtdOffset >= EDID_BLOCK_SIZE)
+        return;
+
+    int pos = 4;
+    while (pos < dtdOffset) {
+        const int tag = block[pos] >> 5;
+        const int len = block[pos] & 0x1F;
+        if (pos + 1 + len > dtdOffset)
+            break;
+
+        const uchar *payload = block + pos + 1;
+        if (tag == CEA_TAG_EXTENDED && len >= 3 && payload[0] == CEA_EXT_TAG_HDR) {
+            m_Hdr.valid = true;
+            m_Hdr.eotf = payload[1];
+            m_Hdr.metadataType = payload[2];
+            m_Hdr.maxLuminance = len >= 4 ? payload[3] : 0;
+            m_Hdr.maxFrameAvg = len >= 5 ? payload[4] : 0;
+            m_Hdr.minLuminance = len >= 6 ? payload[5] : 0;
+        }
+        pos += 1 + len;
+    }
+}
+
+void EdidDecoder::parseDisplayIdBlock(const uchar *block)
+{
+    // block[1] 起为 DisplayID 段:版本、数据长度、产品类型、扩展数,随后为数据块
+    const int sectionBytes = block[2];
+    const int end = qMin(5 + sectionBytes, EDID_BLOCK_SIZE - 1);
+
+    int pos = 5;
+    while (pos + 3 <= end) {
+        const int tag = block[pos];
+        const int len = block[pos + 2];
+        if (pos + 3 + len > end)
+            break;
+
+        if (tag == DISPLAYID_TAG_TILE || tag == DISPLAYID2_TAG_TILE)
+            parseTile(block + pos + 3, len);
+        pos += 3 + len;
+    }
+}
+
+void EdidDecoder::parseTile(const uchar *payload, int len)
+{
+    // 拼接拓扑:能力(1) 拓扑(3) 单屏尺寸(4),数量与位置的高位存放在拓扑第3字节
+    if (len < 8)
+        return;
+
+    const uchar *topo = payload + 1;
+    const uchar *size = payload + 4;
+    m_Tile.valid = true;
+    m_Tile.hTiles = ((topo[0] >> 4) | ((topo[2] >> 2) & 0x30)) + 1;
+    m_Tile.vTiles = ((topo[0] & 0x0F) | (topo[2] & 0x30)) + 1;
+    m_Tile.hLocation = (topo[1] >> 4) | (((topo[2] >> 2) & 0x03) << 4);
+    m_Tile.vLocation = (topo[1] & 0x0F) | ((topo[2] & 0x03) << 4);
+    m_Tile.tileWidth = (size[0] | (size[1] << 8)) + 1;
+    m_Tile.tileHeight = (size[2] | (size[3] << 8)) + 1;
+}
+
+QString EdidDecoder::descriptorText(const uchar *desc)
+{
+    // 文本最长13字节,以换行结束,其后以空格填充
+    QByteArray text(reinterpret_cast<const char *>(desc + 5), 13);
+    int end = text.indexOf('\n');
+    if (end >= 0)
+        text.truncate(end);
+    return QString::fromLatin1(text).trimmed();
+}
+
+bool EdidDecoder::blockChecksum(const uchar *block)
+{
+    uchar sum = 0;
+    for (int i = 0; i < EDID_BLOCK_SIZE; ++i)
+        sum = uchar(sum + block[i]);
+    return sum == 0;
+}
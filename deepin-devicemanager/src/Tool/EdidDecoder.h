@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef EDIDDECODER_H
+#define EDIDDECODER_H
+
+#include <QString>
+#include <QByteArray>
+
+/**
+ * @brief The EdidDecoder class
+ * 直接在edid原始字节上解码,不经过十六进制文本
+ * 解析基本块、CEA-861 扩展块(HDR静态元数据)与 DisplayID 扩展块(拼接显示)
+ * 厂商、型号、日期与屏幕大小的结果与 EDIDParser 一致
+ */
+class EdidDecoder
+{
+public:
+    /**
+     * @brief The RangeLimits struct 显示范围限制描述符(0xFD)
+     */
+    struct RangeLimits {
+        bool    valid;              //<! 是否存在
+        int     minVRate;           //<! 最小场频,单位Hz
+        int     maxVRate;           //<! 最大场频,单位Hz
+        int     minHRate;           //<! 最小行频,单位kHz
+        int     maxHRate;           //<! 最大行频,单位kHz
+        int     maxPixelClock;      //<! 最大像素时钟,单位MHz
+    };
+
+    /**
+     * @brief The HdrMetadata struct CEA-861 HDR静态元数据块
+     */
+    struct HdrMetadata {
+        bool    valid;              //<! 是否存在
+        quint8  eotf;               //<! 支持的EOTF,见 HdrEotf
+        quint8  metadataType;       //<! 支持的静态元数据类型
+        quint8  maxLuminance;       //<! 最大亮度编码值,0表示未提供
+        quint8  maxFrameAvg;        //<! 最大帧平均亮度编码值
+        quint8  minLuminance;       //<! 最小亮度编码值
+    };
+
+    /**
+     * @brief The TileInfo struct DisplayID 拼接显示拓扑
+     */
+    struct TileInfo {
+        bool    valid;              //<! 是否存在
+        int     hTiles;             //<! 水平方向拼接数
+        int     vTiles;             //<! 垂直方向拼接数
+        int     hLocation;          //<! 本屏水平位置,从0开始
+        int     vLocation;          //<! 本屏垂直位置,从0开始
+        int     tileWidth;          //<! 单屏宽度,单位像素
+        int     tileHeight;         //<! 单屏高度,单位像素
+    };
+
+    enum HdrEotf {
+        EOTF_TraditionalSdr = 0x01,
+        EOTF_TraditionalHdr = 0x02,
+        EOTF_SmpteSt2084    = 0x04,
+        EOTF_Hlg            = 0x08
+    };
+
+    EdidDecoder();
+
+    /**
+     * @brief decode:解码edid
+     * @param edid:edid原始数据,长度至少为一个块(128字节)
+     * @param errorMsg:错误提示信息
+     * @return true:解码成功;false:不是有效的edid
+     */
+    bool decode(const QByteArray &edid, QString &errorMsg);
+
+    const QString &vendor() const;
+    const QString &model() const;
+    const QString &releaseDate() const;
+    const QString &screenSize() const;
+    const QString &monitorName() const;
+    const QString &serialNumber() const;
+
+    /**
+     * @brief version:edid版本,如 1.4
+     */
+    QString version() const;
+
+    int width() const;
+    int height() const;
+
+    /**
+     * @brief preferredWidth:首选分辨率的宽度,单位像素,0表示未提供
+     */
+    int preferredWidth() const;
+    int preferredHeight() const;
+
+    /**
+     * @brief extensionCount:已解码的扩展块数量
+     */
+    int extensionCount() const;
+
+    /**
+     * @brief checksumValid:所有已解码块的校验和是否正确
+     */
+    bool checksumValid() const;
+
+    /**
+     * @brief hasCea:是否包含 CEA-861 扩展块
+     */
+    bool hasCea() const;
+    const RangeLimits &rangeLimits() const;
+    const HdrMetadata &hdr() const;
+    const TileInfo &tile() const;
+
+private:
+    void reset();
+    void parseBaseBlock(const uchar *block);
+    void parseDescriptor(const uchar *desc);
+    void parseScreenSize(const uchar *block);
+    void parseCeaBlock(const uchar *block);
+    void parseDisplayIdBlock(const uchar *block);
+    void parseTile(const uchar *payload, int len);
+
+    /**
+     * @brief descriptorText:取出显示描述符中以换行结尾的文本
+     */
+    static QString descriptorText(const uchar *desc);
+    static bool blockChecksum(const uchar *block);
+
+private:
+    QString         m_Vendor;               //<! 厂商缩写
+    QString         m_Model;                //<! 产品代码
+    QString         m_ReleaseDate;          //<! 生产日期
+    QString         m_ScreenSize;           //<! 屏幕大小
+    QString         m_MonitorName;          //<! 显示器名称描述符
+    QString         m_SerialNumber;         //<! 序列号描述符
+    int             m_Version;              //<! 版本
+    int             m_Revision;             //<! 修订号
+    int             m_Width;                //<! 屏幕宽度,单位mm
+    int             m_Height;               //<! 屏幕高度,单位mm
+    int             m_PreferredWidth;       //<! 首选分辨率宽度
+    int             m_PreferredHeight;      //<! 首选分辨率高度
+    int             m_ExtensionCount;       //<! 扩展块数量
+    bool            m_ChecksumValid;        //<! 校验和是否正确
+    bool            m_HasCea;               //<! 是否包含CEA扩展
+    RangeLimits     m_RangeLimits;          //<! 范围限制
+    HdrMetadata     m_Hdr;                  //<! HDR静态元数据
+    TileInfo        m_Tile;                 //<! 拼接拓扑
+};
+
+#endif // EDIDDECODER_H
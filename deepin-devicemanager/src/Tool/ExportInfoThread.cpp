@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "ExportInfoThread.h"
+#include "DDLog.h"
+
+// Qt库文件
+#include <QFile>
+#include <QFileInfo>
+#include <QLoggingCategory>
+
+// 其它头文件
+#include <stdio.h>
+
+using namespace DDLog;
+
+ExportInfoThread::ExportInfoThread(QObject *parent)
+    : QThread(parent)
+    , m_Format(DeviceManager::EF_Txt)
+    , m_Canceled(0)
+{
+
+}
+
+void ExportInfoThread::setExportInfo(const QString &filePath, DeviceManager::ExportFormat format)
+{
+    m_FilePath = filePath;
+    m_Format = format;
+    m_Canceled.storeRelease(0);
+}
+
+void ExportInfoThread::cancel()
+{
+    m_Canceled.storeRelease(1);
+}
+
+void ExportInfoThread::run()
+{
+    // 临时文件与目标文件在同一目录,保证重命名是原子操作
+    const QString tmpPath = tempFilePath(m_FilePath);
+    QFile::remove(tmpPath);
+
+    DeviceManager::instance()->setExportObserver([this](int written, int total) {
+        emit progressChanged(written, total);
+        return m_Canceled.loadAcquire() == 0;
+    });
+    bool success = exportToFile(tmpPath);
+    DeviceManager::instance()->setExportObserver(nullptr);
+
+    // 导出完整写出后才到达的取消请求不再生效
+    bool canceled = !success && m_Canceled.loadAcquire() != 0;
+    if (success) {
+        // rename 会原子地替换已存在的目标文件,QFile::rename 不覆盖已有文件
+        if (::rename(QFile::encodeName(tmpPath).constData(), QFile::encodeName(m_FilePath).constData()) != 0) {
+            qCWarning(appLog) << "Failed to rename export file:" << tmpPath << "->" << m_FilePath;
+            success = false;
+        }
+    }
+
+    if (!success)
+        QFile::remove(tmpPath);
+
+    qCInfo(appLog) << "Export finished:" << m_FilePath << "success:" << success << "canceled:" << canceled;
+    emit exportFinished(success, canceled);
+}
+
+QString ExportInfoThread::tempFilePath(const QString &filePath)
+{
+    QFileInfo info(filePath);
+    return info.absolutePath() + "/." + info.fileName() + ".part";
+}
+
+bool ExportInfoThread::exportToFile(const QString &filePath)
+{
+    switch (m_Format) {
+    case DeviceManager::EF_Txt:
+        return DeviceManager::instance()->exportToTxt(filePath);
+    case DeviceManager::EF_Html:
+        return DeviceManager::instance()->exportToHtml(filePath);
+    case DeviceManager::EF_Doc:
+        return DeviceManager::instance()->exportToDoc(filePath);
+    case DeviceManager::EF_Xlsx:
+        return DeviceManager::instance()->exportToXlsx(filePath);
+    case DeviceManager::EF_Json:
+        return DeviceManager::instance()->exportToJson(filePath);
+    case DeviceManager::EF_Cbor:
+        return DeviceManager::instance()->exportToCbor(filePath);
+    }
+    return false;
+}
@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef EXPORTINFOTHREAD_H
+#define EXPORTINFOTHREAD_H
+
+#include "DeviceManager.h"
+
+#include <QThread>
+#include <QAtomicInt>
+
+/**
+ * @brief The ExportInfoThread class
+ * 在后台线程中导出设备信息
+ * 先写入同目录下的临时文件,导出成功后再重命名为目标文件,取消或失败时不会留下不完整的文件
+ */
+class ExportInfoThread : public QThread
+{
+    Q_OBJECT
+public:
+    explicit ExportInfoThread(QObject *parent = nullptr);
+
+    /**
+     * @brief setExportInfo:设置导出文件与格式,需在线程启动前调用
+     * @param filePath:目标文件路径
+     * @param format:导出格式
+     */
+    void setExportInfo(const QString &filePath, DeviceManager::ExportFormat format);
+
+    /**
+     * @brief filePath:目标文件路径
+     */
+    const QString &filePath() const { return m_FilePath; }
+
+    /**
+     * @brief cancel:取消导出,当前类别写完后停止
+     */
+    void cancel();
+
+    /**
+     * @brief run
+     */
+    virtual void run() override;
+
+    /**
+     * @brief tempFilePath:导出时使用的临时文件路径
+     * @param filePath:目标文件路径
+     */
+    static QString tempFilePath(const QString &filePath);
+
+signals:
+    /**
+     * @brief progressChanged:导出进度
+     * @param written:已写出的设备数
+     * @param total:设备总数
+     */
+    void progressChanged(int written, int total);
+
+    /**
+     * @brief exportFinished:导出结束
+     * @param success:是否导出成功
+     * @param canceled:是否被取消
+     */
+    void exportFinished(bool success, bool canceled);
+
+private:
+    /**
+     * @brief exportToFile:按格式导出到指定文件
+     */
+    bool exportToFile(const QString &filePath);
+
+private:
+    QString                        m_FilePath;    //<! 目标文件路径
+    DeviceManager::ExportFormat    m_Format;      //<! 导出格式
+    QAtomicInt                     m_Canceled;    //<! 是否已取消
+};
+
+#endif // EXPORTINFOTHREAD_H
@@ -0,0 +1,318 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "NetLinkMonitor.h"
+#include "DeviceManager.h"
+#include "DDLog.h"
+
+// Qt库文件
+#include <QSocketNotifier>
+#include <QFile>
+#include <QLoggingCategory>
+
+// 其它头文件
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+#define NETLINK_BUFFER_SIZE     32768
+
+using namespace DDLog;
+
+NetLinkMonitor *NetLinkMonitor::sInstance = nullptr;
+
+NetLinkMonitor::Link::Link()
+    : index(0)
+    , flags(0)
+    , operState(IF_OPER_UNKNOWN)
+    , speed(-1)
+{
+
+}
+
+NetLinkMonitor::NetLinkMonitor()
+    : mp_Notifier(nullptr)
+    , m_Socket(-1)
+    , m_Valid(false)
+{
+
+}
+
+NetLinkMonitor::~NetLinkMonitor()
+{
+    if (m_Socket >= 0)
+        close(m_Socket);
+}
+
+void NetLinkMonitor::start()
+{
+    if (m_Socket >= 0)
+        return;
+
+    // 先订阅再获取,避免错过获取期间的变化
+    m_Socket = socket(AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (m_Socket < 0) {
+        qCWarning(appLog) << "open netlink socket failed:" << strerror(errno);
+        return;
+    }
+
+    sockaddr_nl addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = RTMGRP_LINK;
+    if (bind(m_Socket, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+        qCWarning(appLog) << "bind netlink socket failed:" << strerror(errno);
+        close(m_Socket);
+        m_Socket = -1;
+        return;
+    }
+
+    mp_Notifier = new QSocketNotifier(m_Socket, QSocketNotifier::Read, this);
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    connect(mp_Notifier, SIGNAL(activated(int)), this, SLOT(slotReadyRead()));
+#else
+    connect(mp_Notifier, &QSocketNotifier::activated, this, &NetLinkMonitor::slotReadyRead);
+#endif
+
+    resync();
+}
+
+void NetLinkMonitor::apply()
+{
+    if (!m_Valid)
+        return;
+
+    foreach (const QString &name, DeviceManager::instance()->networkDriver()) {
+        const Link *info = link(name);
+        if (!info)
+            continue;
+        DeviceManager::instance()->correctNetworkLinkStatus(linkStatus(*info), name);
+        // 无线网卡等读不到速率时保留 lshw 的值
+        if (info->speed > 0)
+            DeviceManager::instance()->correctNetworkSpeed(speedString(info->speed), name);
+    }
+}
+
+const NetLinkMonitor::Link *NetLinkMonitor::link(const QString &name) const
+{
+    for (auto it = m_Links.constBegin(); it != m_Links.constEnd(); ++it) {
+        if (it.value().name == name)
+            return &it.value();
+    }
+    return nullptr;
+}
+
+bool NetLinkMonitor::dumpLinks(QMap<int, Link> &links)
+{
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (fd < 0)
+        return false;
+
+    struct {
+        nlmsghdr    header;
+        ifinfomsg   info;
+    } request;
+    memset(&request, 0, sizeof(request));
+    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(ifinfomsg));
+    request.header.nlmsg_type = RTM_GETLINK;
+    request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.header.nlmsg_seq = 1;
+    request.info.ifi_family = AF_UNSPEC;
+
+    sockaddr_nl kernel;
+    memset(&kernel, 0, sizeof(kernel));
+    kernel.nl_family = AF_NETLINK;
+    if (sendto(fd, &request, request.header.nlmsg_len, 0, reinterpret_cast<sockaddr *>(&kernel), sizeof(kernel)) < 0) {
+        close(fd);
+        return false;
+    }
+
+    // 回复分多个数据报,直到 NLMSG_DONE
+    QByteArray buffer(NETLINK_BUFFER_SIZE, 0);
+    bool done = false;
+    bool ok = true;
+    while (!done) {
+        ssize_t len = recv(fd, buffer.data(), size_t(buffer.size()), 0);
+        if (len < 0) {
+            if (errno == EINTR)
+                continue;
+            ok = false;
+            break;
+        }
+
+        int remain = int(len);
+        for (const nlmsghdr *header = reinterpret_cast<const nlmsghdr *>(buffer.constData());
+                NLMSG_OK(header, remain); header = NLMSG_NEXT(header, remain)) {
+            if (header->nlmsg_type == NLMSG_DONE || header->nlmsg_type == NLMSG_ERROR) {
+                ok = header->nlmsg_type == NLMSG_DONE;
+                done = true;
+                break;
+            }
+            parseMessages(reinterpret_cast<const char *>(header), int(header->nlmsg_len), links);
+        }
+    }
+
+    close(fd);
+    return ok;
+}
+
+int NetLinkMonitor::parseMessages(const char *data, int size, QMap<int, Link> &links)
+{
+    int count = 0;
+    int len = size;
+    for (const nlmsghdr *header = reinterpret_cast<const nlmsghdr *>(data);
+            NLMSG_OK(header, len); header = NLMSG_NEXT(header, len)) {
+        if (header->nlmsg_type == NLMSG_DONE || header->nlmsg_type == NLMSG_ERROR)
+            break;
+        if (header->nlmsg_type != RTM_NEWLINK && header->nlmsg_type != RTM_DELLINK)
+            continue;
+        if (header->nlmsg_len < NLMSG_LENGTH(sizeof(ifinfomsg)))
+            continue;
+
+        const ifinfomsg *info = static_cast<const ifinfomsg *>(NLMSG_DATA(header));
+        ++count;
+        if (header->nlmsg_type == RTM_DELLINK) {
+            links.remove(info->ifi_index);
+            continue;
+        }
+
+        // 只更新消息中带有的属性,速率保持不变
+        Link &link = links[info->ifi_index];
+        link.index = info->ifi_index;
+        link.flags = info->ifi_flags;
+
+        int attrLen = int(IFLA_PAYLOAD(header));
+        for (const rtattr *attr = IFLA_RTA(info); RTA_OK(attr, attrLen); attr = RTA_NEXT(attr, attrLen)) {
+            const char *value = static_cast<const char *>(RTA_DATA(attr));
+            int valueLen = int(RTA_PAYLOAD(attr));
+            switch (attr->rta_type) {
+            case IFLA_IFNAME:
+                link.name = QString::fromLatin1(value, int(strnlen(value, size_t(valueLen))));
+                break;
+            case IFLA_ADDRESS: {
+                QStringList bytes;
+                for (int i = 0; i < valueLen; ++i)
+                    bytes.append(QString("%1").arg(int(uchar(value[i])), 2, 16, QChar('0')));
+                link.mac = bytes.join(":");
+                break;
+            }
+            case IFLA_OPERSTATE:
+                if (valueLen >= 1)
+                    link.operState = uchar(value[0]);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    return count;
+}
+
+QString NetLinkMonitor::linkStatus(const Link &link)
+{
+    // 虚拟网卡等不报告运行状态的驱动以载波状态为准
+    if (link.operState == IF_OPER_UP)
+        return "yes";
+    if (link.operState == IF_OPER_UNKNOWN && (link.flags & IFF_UP) && (link.flags & IFF_LOWER_UP))
+        return "yes";
+    return "no";
+}
+
+QString NetLinkMonitor::speedString(int speed)
+{
+    if (speed <= 0)
+        return "";
+    if (speed % 1000 == 0)
+        return QString("%1Gbit/s").arg(speed / 1000);
+    return QString("%1Mbit/s").arg(speed);
+}
+
+int NetLinkMonitor::readSpeed(const QString &name)
+{
+    // 无连接时读取返回 EINVAL,无线网卡没有该文件
+    QFile file("/sys/class/net/" + name + "/speed");
+    if (!file.open(QIODevice::ReadOnly))
+        return -1;
+
+    bool ok = false;
+    int speed = file.readAll().trimmed().toInt(&ok);
+    return ok && speed > 0 ? speed : -1;
+}
+
+void NetLinkMonitor::slotReadyRead()
+{
+    QMap<int, Link> old = m_Links;
+    QByteArray buffer(NETLINK_BUFFER_SIZE, 0);
+    while (true) {
+        ssize_t len = recv(m_Socket, buffer.data(), size_t(buffer.size()), 0);
+        if (len < 0) {
+            if (errno == EINTR)
+                continue;
+            // 组播缓冲区溢出时消息已丢失,重新获取
+            if (errno == ENOBUFS) {
+                resync();
+                return;
+            }
+            break;
+        }
+        parseMessages(buffer.constData(), int(len), m_Links);
+    }
+
+    // 统计计数、MTU 等变化也会产生 RTM_NEWLINK,界面关心的状态不变时不通知
+    if (!linksChanged(old, m_Links))
+        return;
+    updateSpeed(old);
+    emit updated();
+}
+
+void NetLinkMonitor::resync()
+{
+    QMap<int, Link> links;
+    if (!dumpLinks(links)) {
+        qCWarning(appLog) << "RTM_GETLINK failed, network link status is not monitored";
+        return;
+    }
+
+    // 已有接口的速率在运行状态未变化时沿用
+    for (auto it = links.begin(); it != links.end(); ++it)
+        it.value().speed = m_Links.value(it.key()).speed;
+
+    QMap<int, Link> old = m_Links;
+    m_Links = links;
+    m_Valid = true;
+    updateSpeed(old);
+    emit updated();
+}
+
+bool NetLinkMonitor::linksChanged(const QMap<int, Link> &old, const QMap<int, Link> &links)
+{
+    if (old.size() != links.size())
+        return true;
+
+    for (auto it = links.constBegin(); it != links.constEnd(); ++it) {
+        auto prev = old.find(it.key());
+        if (prev == old.constEnd())
+            return true;
+        if (prev.value().name != it.value().name || prev.value().operState != it.value().operState
+                || prev.value().flags != it.value().flags || prev.value().mac != it.value().mac)
+            return true;
+    }
+    return false;
+}
+
+void NetLinkMonitor::updateSpeed(const QMap<int, Link> &old)
+{
+    for (auto it = m_Links.begin(); it != m_Links.end(); ++it) {
+        auto prev = old.find(it.key());
+        if (prev != old.end() && prev.value().name == it.value().name
+                && prev.value().operState == it.value().operState && prev.value().flags == it.value().flags)
+            continue;
+        it.value().speed = linkStatus(it.value()) == "yes" ? readSpeed(it.value().name) : -1;
+    }
+}
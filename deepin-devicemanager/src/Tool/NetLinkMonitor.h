@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef NETLINKMONITOR_H
+#define NETLINKMONITOR_H
+
+#include <QObject>
+#include <QMap>
+#include <QList>
+#include <QString>
+
+class QSocketNotifier;
+
+/**
+ * @brief The NetLinkMonitor class
+ * 网卡连接状态的缓存,只在界面线程中使用
+ * 启动时通过 rtnetlink RTM_GETLINK 获取所有网络接口,之后订阅 RTMGRP_LINK 组播,由 RTM_NEWLINK/RTM_DELLINK 更新,不启动任何进程
+ */
+class NetLinkMonitor : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief The Link struct
+     * 网络接口状态
+     */
+    struct Link {
+        Link();
+
+        int         index;          //<! 接口序号
+        QString     name;           //<! 接口名称,如 eth0
+        QString     mac;            //<! 物理地址,小写并以冒号分隔
+        uint        flags;          //<! IFF_UP、IFF_RUNNING、IFF_LOWER_UP 等
+        uint        operState;      //<! RFC 2863 运行状态,IF_OPER_*
+        int         speed;          //<! 协商速率 Mb/s,-1 表示未知
+    };
+
+    static NetLinkMonitor *instance()
+    {
+        if (!sInstance) {
+            sInstance = new NetLinkMonitor;
+        }
+        return sInstance;
+    }
+
+    ~NetLinkMonitor() override;
+
+    /**
+     * @brief start:订阅链路变化并获取所有接口
+     */
+    void start();
+
+    /**
+     * @brief apply:将缓存的连接状态和速率写入 DeviceManager 中的网卡
+     */
+    void apply();
+
+    /**
+     * @brief isValid:是否已获取到接口信息
+     */
+    bool isValid() const { return m_Valid; }
+
+    /**
+     * @brief links:所有网络接口,按接口序号排序
+     */
+    QList<Link> links() const { return m_Links.values(); }
+
+    /**
+     * @brief link:按名称查找接口
+     * @param name:接口名称
+     * @return 接口指针,没有时为空
+     */
+    const Link *link(const QString &name) const;
+
+    /**
+     * @brief dumpLinks:通过 RTM_GETLINK 同步获取所有接口,不读取速率
+     * @param links:接口序号到接口的映射
+     * @return 是否成功
+     */
+    static bool dumpLinks(QMap<int, Link> &links);
+
+    /**
+     * @brief parseMessages:解析 netlink 消息,RTM_NEWLINK 添加或更新接口,RTM_DELLINK 删除接口
+     * @param data:消息缓冲区
+     * @param size:缓冲区长度
+     * @param links:接口序号到接口的映射
+     * @return 解析到的链路消息数量,遇到 NLMSG_DONE 或 NLMSG_ERROR 时停止
+     */
+    static int parseMessages(const char *data, int size, QMap<int, Link> &links);
+
+    /**
+     * @brief linkStatus:转换为网卡【链接】属性的值
+     * @param link:接口
+     * @return "yes" 或 "no"
+     */
+    static QString linkStatus(const Link &link);
+
+    /**
+     * @brief speedString:转换为与 lshw 相同格式的速率,如 1Gbit/s
+     * @param speed:速率 Mb/s
+     * @return 速率,未知时为空
+     */
+    static QString speedString(int speed);
+
+    /**
+     * @brief readSpeed:读取 /sys/class/net/<name>/speed
+     * @param name:接口名称
+     * @return 速率 Mb/s,无连接或无线网卡时为 -1
+     */
+    static int readSpeed(const QString &name);
+
+signals:
+    /**
+     * @brief updated:接口状态变化
+     */
+    void updated();
+
+protected:
+    NetLinkMonitor();
+
+private slots:
+    /**
+     * @brief slotReadyRead:读取组播消息
+     */
+    void slotReadyRead();
+
+private:
+    /**
+     * @brief resync:重新获取所有接口,组播缓冲区溢出丢失消息时使用
+     */
+    void resync();
+
+    /**
+     * @brief linksChanged:接口的增删或名称、运行状态、标志、物理地址是否变化
+     * @param old:更新前的接口
+     * @param links:更新后的接口
+     * @return true:有变化;false:没有变化
+     */
+    static bool linksChanged(const QMap<int, Link> &old, const QMap<int, Link> &links);
+
+    /**
+     * @brief updateSpeed:运行状态变化的接口重新读取速率
+     * @param old:更新前的接口
+     */
+    void updateSpeed(const QMap<int, Link> &old);
+
+private:
+    static NetLinkMonitor     *sInstance;
+
+    QMap<int, Link>           m_Links;            //<! 接口序号到接口的映射
+    QSocketNotifier           *mp_Notifier;       //<! 组播套接字可读通知
+    int                       m_Socket;           //<! 订阅 RTMGRP_LINK 的套接字
+    bool                      m_Valid;            //<! 是否已获取到接口信息
+};
+
+#endif // NETLINKMONITOR_H
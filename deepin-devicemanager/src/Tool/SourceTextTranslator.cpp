@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "SourceTextTranslator.h"
+
+static thread_local bool sourceTextActive = false;
+
+SourceTextTranslator::SourceTextTranslator(QObject *parent)
+    : QTranslator(parent)
+{
+
+}
+
+QString SourceTextTranslator::translate(const char *context, const char *sourceText,
+                                        const char *disambiguation, int n) const
+{
+    Q_UNUSED(context)
+    Q_UNUSED(disambiguation)
+    Q_UNUSED(n)
+
+    // 返回空字符串时 QCoreApplication 继续使用其它翻译
+    if (!sourceTextActive)
+        return QString();
+    return QString::fromUtf8(sourceText);
+}
+
+bool SourceTextTranslator::isEmpty() const
+{
+    return false;
+}
+
+bool SourceTextTranslator::isActive()
+{
+    return sourceTextActive;
+}
+
+SourceTextTranslator::Scope::Scope()
+    : m_Previous(sourceTextActive)
+{
+    sourceTextActive = true;
+}
+
+SourceTextTranslator::Scope::~Scope()
+{
+    sourceTextActive = m_Previous;
+}
@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SOURCETEXTTRANSLATOR_H
+#define SOURCETEXTTRANSLATOR_H
+
+#include <QTranslator>
+
+/**
+ * @brief The SourceTextTranslator class
+ * 在当前线程的 Scope 内 tr() 返回原文,用于写出与界面语言无关的属性名
+ * 需在其它翻译之后安装,不在 Scope 内时不处理,由其它翻译继续翻译
+ */
+class SourceTextTranslator : public QTranslator
+{
+public:
+    explicit SourceTextTranslator(QObject *parent = nullptr);
+
+    QString translate(const char *context, const char *sourceText,
+                      const char *disambiguation = nullptr, int n = -1) const override;
+    bool isEmpty() const override;
+
+    /**
+     * @brief isActive:当前线程是否在 Scope 内
+     */
+    static bool isActive();
+
+    /**
+     * @brief The Scope class 作用域内当前线程的 tr() 返回原文
+     */
+    class Scope
+    {
+    public:
+        Scope();
+        ~Scope();
+
+    private:
+        bool    m_Previous;    //<! 进入作用域前的状态
+    };
+};
+
+#endif // SOURCETEXTTRANSLATOR_H
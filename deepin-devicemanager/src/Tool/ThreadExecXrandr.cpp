@@ -18,6 +18,10 @@
 #include <QRegularExpression>
 #include <DeviceManager.h>
 #include<QDateTime>
+
+#include <xcb/xcb.h>
+#include <xcb/randr.h>
+#include <stdlib.h>
 #ifdef OS_BUILD_V23
 const QString DISPLAY_SERVICE_NAME = "org.deepin.dde.Display1";
 const QString DISPLAY_SERVICE_PATH = "/org/deepin/dde/Display1";
@@ -40,23 +44,218 @@ const QString DISPLAY_PROPERTIES_INTERFACE = "org.freedesktop.DBus.Properties";
 const QString DISPLAY_MONITOR_INTERFACE = "com.deepin.daemon.Display.Monitor";
 #endif
 using namespace DDLog;
-ThreadExecXrandr::ThreadExecXrandr(bool gpu, bool isDXcbPlatform)
-    : m_Gpu(gpu), m_isDXcbPlatform(isDXcbPlatform)
+ThreadExecXrandr::ThreadExecXrandr(bool isDXcbPlatform)
+    : m_isDXcbPlatform(isDXcbPlatform)
 {
 
 }
 
 void ThreadExecXrandr::run()
 {
-    if (m_Gpu) {
-        getGpuInfoFromXrandr();
-    } else {           
-       if(Common::boardVendorType() == "PGUV") {
-           QList<QMap<QString, QString>> lstMap;
-           getResolutionRateFromDBus(lstMap);
-       }else 
-            getMonitorInfoFromXrandrVerbose();
+    m_GpuInfo.clear();
+    m_MonitorInfo.clear();
+    m_DbusMonitorInfo.clear();
+
+    // 直接查询RandR,无法连接X服务时再执行xrandr命令并解析输出
+    if (!loadFromRandr()) {
+        m_GpuInfo.clear();
+        m_MonitorInfo.clear();
+        loadXrandrInfo(m_GpuInfo, "xrandr");
+        if (Common::boardVendorType() != "PGUV")
+            loadXrandrVerboseInfo(m_MonitorInfo, "xrandr --verbose");
+    }
+
+    // 通过dbus获取最大最小分辨率
+    mergeResolutionFromDBus();
+
+    if (Common::boardVendorType() == "PGUV")
+        getResolutionRateFromDBus(m_DbusMonitorInfo);
+}
+
+void ThreadExecXrandr::applyToDeviceManager() const
+{
+    foreach (const auto &gpuInfo, m_GpuInfo) {
+        if (gpuInfo.size() < 1)
+            continue;
+        DeviceManager::instance()->setGpuInfoFromXrandr(gpuInfo);
+    }
+
+    if (Common::boardVendorType() == "PGUV") {
+        foreach (const auto &monitorInfo, m_DbusMonitorInfo)
+            DeviceManager::instance()->setMonitorInfoFromDbus(monitorInfo);
+        return;
+    }
+
+    foreach (const auto &monitorInfo, m_MonitorInfo) {
+        if (monitorInfo.size() < 1)
+            continue;
+        DeviceManager::instance()->setMonitorInfoFromXrandr(monitorInfo["mainInfo"], monitorInfo["edid"], monitorInfo["rate"]);
+    }
+}
+
+bool ThreadExecXrandr::loadFromRandr()
+{
+    // 使用独立的X连接,不占用界面线程的连接
+    xcb_connection_t *conn = xcb_connect(nullptr, nullptr);
+    bool ok = !xcb_connection_has_error(conn) && loadRandrInfo(conn, m_GpuInfo, m_MonitorInfo);
+    xcb_disconnect(conn);
+    return ok;
+}
+
+bool ThreadExecXrandr::loadRandrInfo(xcb_connection_t *conn, QList<QMap<QString, QString>> &gpuLst, QList<QMap<QString, QString>> &monitorLst)
+{
+    // 需要 RandR 1.3 的 GetScreenResourcesCurrent 与 GetOutputPrimary
+    xcb_randr_query_version_reply_t *version = xcb_randr_query_version_reply(conn, xcb_randr_query_version(conn, 1, 3), nullptr);
+    if (!version)
+        return false;
+    bool supported = version->major_version > 1 || (version->major_version == 1 && version->minor_version >= 3);
+    free(version);
+    if (!supported)
+        return false;
+
+    xcb_atom_t edidAtom = XCB_ATOM_NONE;
+    xcb_intern_atom_reply_t *atom = xcb_intern_atom_reply(conn, xcb_intern_atom(conn, 1, 4, "EDID"), nullptr);
+    if (atom) {
+        edidAtom = atom->atom;
+        free(atom);
+    }
+
+    xcb_screen_iterator_t screenIter = xcb_setup_roots_iterator(xcb_get_setup(conn));
+    for (; screenIter.rem; xcb_screen_next(&screenIter)) {
+        xcb_window_t root = screenIter.data->root;
+
+        // 先发出全部请求再依次取回复,每个屏幕只需一次往返
+        xcb_randr_get_screen_size_range_cookie_t rangeCookie = xcb_randr_get_screen_size_range(conn, root);
+        xcb_get_geometry_cookie_t geometryCookie = xcb_get_geometry(conn, root);
+        xcb_randr_get_output_primary_cookie_t primaryCookie = xcb_randr_get_output_primary(conn, root);
+        xcb_randr_get_screen_resources_current_cookie_t resCookie = xcb_randr_get_screen_resources_current(conn, root);
+
+        xcb_randr_get_screen_size_range_reply_t *range = xcb_randr_get_screen_size_range_reply(conn, rangeCookie, nullptr);
+        xcb_get_geometry_reply_t *geometry = xcb_get_geometry_reply(conn, geometryCookie, nullptr);
+        xcb_randr_get_output_primary_reply_t *primary = xcb_randr_get_output_primary_reply(conn, primaryCookie, nullptr);
+        xcb_randr_get_screen_resources_current_reply_t *res = xcb_randr_get_screen_resources_current_reply(conn, resCookie, nullptr);
+
+        // 与 xrandr 输出的 Screen 行相同的分辨率格式
+        QMap<QString, QString> gpuInfo;
+        if (range && geometry) {
+            gpuInfo.insert("minResolution", QString("%1 x %2").arg(range->min_width).arg(range->min_height));
+            gpuInfo.insert("curResolution", QString("%1 x %2").arg(geometry->width).arg(geometry->height));
+            gpuInfo.insert("maxResolution", QString("%1 x %2").arg(range->max_width).arg(range->max_height));
+        }
+        xcb_randr_output_t primaryOutput = primary ? primary->output : XCB_NONE;
+        free(range);
+        free(geometry);
+        free(primary);
+
+        if (!res) {
+            gpuLst.append(gpuInfo);
+            continue;
+        }
+
+        xcb_timestamp_t timestamp = res->config_timestamp;
+        xcb_randr_output_t *outputs = xcb_randr_get_screen_resources_current_outputs(res);
+        int outputCount = xcb_randr_get_screen_resources_current_outputs_length(res);
+        xcb_randr_mode_info_t *modes = xcb_randr_get_screen_resources_current_modes(res);
+        int modeCount = xcb_randr_get_screen_resources_current_modes_length(res);
+
+        QList<xcb_randr_get_output_info_cookie_t> outputCookies;
+        for (int i = 0; i < outputCount; ++i)
+            outputCookies.append(xcb_randr_get_output_info(conn, outputs[i], timestamp));
+
+        QList<xcb_randr_get_output_info_reply_t *> outputInfos;
+        for (int i = 0; i < outputCount; ++i)
+            outputInfos.append(xcb_randr_get_output_info_reply(conn, outputCookies[i], nullptr));
+
+        // 已连接输出的 crtc 与 edid 同样一次发出
+        QList<xcb_randr_get_crtc_info_cookie_t> crtcCookies;
+        QList<xcb_randr_get_output_property_cookie_t> edidCookies;
+        for (int i = 0; i < outputCount; ++i) {
+            xcb_randr_get_output_info_reply_t *info = outputInfos[i];
+            xcb_randr_get_crtc_info_cookie_t crtcCookie = {0};
+            xcb_randr_get_output_property_cookie_t edidCookie = {0};
+            if (info && info->connection != XCB_RANDR_CONNECTION_DISCONNECTED) {
+                if (info->crtc != XCB_NONE)
+                    crtcCookie = xcb_randr_get_crtc_info(conn, info->crtc, timestamp);
+                if (edidAtom != XCB_ATOM_NONE)
+                    edidCookie = xcb_randr_get_output_property(conn, outputs[i], edidAtom, XCB_ATOM_ANY, 0, 128, 0, 0);
+            }
+            crtcCookies.append(crtcCookie);
+            edidCookies.append(edidCookie);
+        }
+
+        for (int i = 0; i < outputCount; ++i) {
+            xcb_randr_get_output_info_reply_t *info = outputInfos[i];
+            xcb_randr_get_crtc_info_reply_t *crtc = crtcCookies[i].sequence ? xcb_randr_get_crtc_info_reply(conn, crtcCookies[i], nullptr) : nullptr;
+            xcb_randr_get_output_property_reply_t *edid = edidCookies[i].sequence ? xcb_randr_get_output_property_reply(conn, edidCookies[i], nullptr) : nullptr;
+            if (!info) {
+                free(crtc);
+                free(edid);
+                continue;
+            }
+
+            QString name = QString::fromUtf8(reinterpret_cast<const char *>(xcb_randr_get_output_info_name(info)), xcb_randr_get_output_info_name_length(info));
+
+            // 显卡支持的接口,与 xrandr 一样包括未连接的接口
+            if (name.startsWith("HDMI")) {
+                gpuInfo.insert("HDMI", "Enable");
+            } else if (name.startsWith("VGA")) {
+                gpuInfo.insert("VGA", "Enable");
+            } else if (name.startsWith("DP") || name.startsWith("DisplayPort")) {
+                gpuInfo.insert("DP", "Enable");
+            } else if (name.startsWith("eDP")) {
+                gpuInfo.insert("eDP", "Enable");
+            } else if (name.startsWith("DVI")) {
+                gpuInfo.insert("DVI", "Enable");
+            } else if (name.startsWith("DigitalOutput")) {
+                gpuInfo.insert("DigitalOutput", "Enable");
+            }
+
+            if (info->connection != XCB_RANDR_CONNECTION_DISCONNECTED) {
+                // 主要信息与 xrandr --verbose 的输出行格式一致,如 HDMI-1 connected primary 1920x1080+0+0 527mm x 296mm
+                QString mainInfo = name + " connected";
+                if (outputs[i] == primaryOutput)
+                    mainInfo += " primary";
+                QMap<QString, QString> monitorInfo;
+                if (crtc && crtc->mode != XCB_NONE) {
+                    mainInfo += QString(" %1x%2+%3+%4").arg(crtc->width).arg(crtc->height).arg(crtc->x).arg(crtc->y);
+                    for (int m = 0; m < modeCount; ++m) {
+                        if (modes[m].id != crtc->mode)
+                            continue;
+                        // 刷新率的计算与 xrandr 相同
+                        double vtotal = modes[m].vtotal;
+                        if (modes[m].mode_flags & XCB_RANDR_MODE_FLAG_DOUBLE_SCAN)
+                            vtotal *= 2;
+                        if (modes[m].mode_flags & XCB_RANDR_MODE_FLAG_INTERLACE)
+                            vtotal /= 2;
+                        if (modes[m].htotal > 0 && vtotal > 0)
+                            monitorInfo.insert("rate", QString::number(modes[m].dot_clock / (modes[m].htotal * vtotal), 'f', 2) + "Hz");
+                        break;
+                    }
+                }
+                mainInfo += QString(" %1mm x %2mm").arg(info->mm_width).arg(info->mm_height);
+                monitorInfo.insert("mainInfo", mainInfo);
+
+                // edid 按 xrandr --verbose 的格式每行16字节
+                if (edid && edid->format == 8) {
+                    QByteArray data(reinterpret_cast<const char *>(xcb_randr_get_output_property_data(edid)), xcb_randr_get_output_property_data_length(edid));
+                    QString edidStr;
+                    for (int pos = 0; pos < data.size(); pos += 16)
+                        edidStr += QString::fromLatin1(data.mid(pos, 16).toHex()) + "\n";
+                    if (!edidStr.isEmpty())
+                        monitorInfo.insert("edid", edidStr);
+                }
+                monitorLst.append(monitorInfo);
+            }
+
+            free(crtc);
+            free(edid);
+            free(info);
+        }
+
+        free(res);
+        gpuLst.append(gpuInfo);
     }
+    return true;
 }
 
 void ThreadExecXrandr::runCmd(QString &info, const QString &cmd)
@@ -231,20 +430,6 @@ void ThreadExecXrandr::getRefreshRateFromDBus(QList<QMap<QString, QString> > &ls
     }
 }
 
-void ThreadExecXrandr::getMonitorInfoFromXrandrVerbose()
-{
-    QList<QMap<QString, QString>> lstMap;
-    loadXrandrVerboseInfo(lstMap, "xrandr --verbose");
-
-    QList<QMap<QString, QString> >::const_iterator it = lstMap.begin();
-    for (; it != lstMap.end(); ++it) {
-        if ((*it).size() < 1)
-            continue;
-
-        DeviceManager::instance()->setMonitorInfoFromXrandr((*it)["mainInfo"], (*it)["edid"], (*it)["rate"]);
-    }
-}
-
 struct MonitorResolution {
     uint32_t index;
     uint16_t width;
@@ -337,15 +522,11 @@ void ThreadExecXrandr::getResolutionFromDBus(QMap<QString, QString> &lstMap)
     }
 }
 
-void ThreadExecXrandr::getGpuInfoFromXrandr()
+void ThreadExecXrandr::mergeResolutionFromDBus()
 {
-    QList<QMap<QString, QString>> lstMap;
-    loadXrandrInfo(lstMap, "xrandr");
-
-    // 通过dbus获取最大最小分辨率
     QMap<QString, QString> dbusMap;
     getResolutionFromDBus(dbusMap);
-    for (auto &lstInfo : lstMap) {
+    for (auto &lstInfo : m_GpuInfo) {
         if (dbusMap.contains("minResolution")) {
             lstInfo["minResolution"] = dbusMap["minResolution"];
         }
@@ -353,14 +534,6 @@ void ThreadExecXrandr::getGpuInfoFromXrandr()
             lstInfo["maxResolution"] = dbusMap["maxResolution"];
         }
     }
-
-    QList<QMap<QString, QString> >::const_iterator it = lstMap.begin();
-    for (; it != lstMap.end(); ++it) {
-        if ((*it).size() < 1)
-            continue;
-
-        DeviceManager::instance()->setGpuInfoFromXrandr(*it);
-    }
 }
 
 void ThreadExecXrandr::getResolutionRateFromDBus(QList<QMap<QString, QString> > &lstMap)
@@ -419,12 +592,4 @@ void ThreadExecXrandr::getResolutionRateFromDBus(QList<QMap<QString, QString> >
             lstMap.append(infoMap);
         }  //end of while
     }  //end of for
-
-    QList<QMap<QString, QString> >::const_iterator it = lstMap.begin();
-    for (; it != lstMap.end(); ++it) {
-        if ((*it).size() < 1)
-            continue;
-
-        DeviceManager::instance()->setMonitorInfoFromDbus(*it);
-    }
 }
@@ -7,21 +7,46 @@
 #define THREADEXECXRANDR_H
 
 #include <QThread>
+#include <QMap>
+#include <QList>
+#include <QStringList>
 
+struct xcb_connection_t;
+
+/**
+ * @brief The ThreadExecXrandr class
+ * 在后台获取显示适配器与显示器信息,优先通过 XCB 直接查询 RandR,无法连接X服务时执行 xrandr 命令
+ * run() 只收集信息,由 applyToDeviceManager 在界面线程中写入设备
+ */
 class ThreadExecXrandr : public QThread
 {
 public:
-    ThreadExecXrandr(bool gpu, bool isDXcbPlatform);
+    explicit ThreadExecXrandr(bool isDXcbPlatform);
 
     /**
      * @brief run
      */
     virtual void run() override;
+
+    /**
+     * @brief applyToDeviceManager:将获取的信息写入 DeviceManager 中的显示适配器与显示器
+     */
+    void applyToDeviceManager() const;
+
     /**
      * @brief getMonitorNumber
      */
     int getMonitorNumber() { return m_monitorLst.size(); }
 
+    /**
+     * @brief loadRandrInfo:通过 XCB 查询 RandR,结果格式与解析 xrandr / xrandr --verbose 输出的结果相同
+     * @param conn:X连接
+     * @param gpuLst:每个屏幕的分辨率范围与接口
+     * @param monitorLst:每个已连接输出的主要信息、edid与刷新率
+     * @return true:查询成功;false:X服务不支持RandR 1.3
+     */
+    static bool loadRandrInfo(xcb_connection_t *conn, QList<QMap<QString, QString>> &gpuLst, QList<QMap<QString, QString>> &monitorLst);
+
 private:
     /**
      * @brief runCmd
@@ -63,20 +88,23 @@ private:
     void getResolutionRateFromDBus(QList<QMap<QString, QString> > &lstMap);
 
     /**
-     * @brief getMonitorInfoFromXrandrVerbose:从xrandr --verbose获取显示设备信息
+     * @brief loadFromRandr:连接X服务并查询RandR
+     * @return true:查询成功;false:无法连接X服务或不支持RandR
      */
-    void getMonitorInfoFromXrandrVerbose();
+    bool loadFromRandr();
 
     /**
-     * @brief getGpuInfoFromXrandr:从xrandr获取显卡信息
+     * @brief mergeResolutionFromDBus:通过dbus获取的最大最小分辨率覆盖显卡信息
      */
-    void getGpuInfoFromXrandr();
+    void mergeResolutionFromDBus();
 
 
 private:
-    bool m_Gpu;                //<!  判断是否是gpu
     bool m_isDXcbPlatform;     //<!  判断是否是DXcbPlatform
     QStringList m_monitorLst;
+    QList<QMap<QString, QString>> m_GpuInfo;          //<! 显卡信息
+    QList<QMap<QString, QString>> m_MonitorInfo;      //<! 显示器信息,mainInfo/edid/rate
+    QList<QMap<QString, QString>> m_DbusMonitorInfo;  //<! 通过dbus获取的显示器信息
 };
 
 #endif // THREADEXECXRANDR_H
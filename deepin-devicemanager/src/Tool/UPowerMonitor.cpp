@@ -0,0 +1,417 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "UPowerMonitor.h"
+#include "DeviceManager.h"
+#include "DDLog.h"
+
+// Qt库文件
+#include <QDBusConnection>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QDBusObjectPath>
+#include <QDBusMetaType>
+#include <QDateTime>
+#include <QLoggingCategory>
+
+#define UPOWER_SERVICE          "org.freedesktop.UPower"
+#define UPOWER_PATH             "/org/freedesktop/UPower"
+#define UPOWER_INTERFACE        "org.freedesktop.UPower"
+#define DEVICE_INTERFACE        "org.freedesktop.UPower.Device"
+#define PROPERTIES_INTERFACE    "org.freedesktop.DBus.Properties"
+#define DEVICE_KIND_BATTERY     2       // UP_DEVICE_KIND_BATTERY
+#define NOTIFY_DELAY            200     // 一次更新会连续产生多个属性变化,合并后再通知
+
+using namespace DDLog;
+
+UPowerMonitor *UPowerMonitor::sInstance = nullptr;
+
+UPowerMonitor::Battery::Battery()
+    : type(0)
+    , state(0)
+    , technology(0)
+    , warningLevel(0)
+    , powerSupply(false)
+    , hasHistory(false)
+    , hasStatistics(false)
+    , isPresent(false)
+    , isRechargeable(false)
+    , energy(0)
+    , energyEmpty(0)
+    , energyFull(0)
+    , energyFullDesign(0)
+    , energyRate(0)
+    , voltage(0)
+    , percentage(0)
+    , capacity(0)
+    , temperature(0)
+    , timeToEmpty(0)
+    , timeToFull(0)
+    , updateTime(0)
+{
+
+}
+
+UPowerMonitor::Daemon::Daemon()
+    : onBattery(false)
+    , lidIsClosed(false)
+    , lidIsPresent(false)
+{
+
+}
+
+UPowerMonitor::UPowerMonitor()
+    : m_Pending(0)
+    , m_Started(false)
+    , m_Valid(false)
+{
+    qDBusRegisterMetaType<QList<QDBusObjectPath> >();
+
+    m_NotifyTimer.setSingleShot(true);
+    m_NotifyTimer.setInterval(NOTIFY_DELAY);
+    connect(&m_NotifyTimer, &QTimer::timeout, this, &UPowerMonitor::updated);
+}
+
+void UPowerMonitor::start()
+{
+    if (m_Started)
+        return;
+    m_Started = true;
+
+    QDBusConnection bus = QDBusConnection::systemBus();
+    if (!bus.isConnected()) {
+        qCWarning(appLog) << "system bus unavailable, battery info is not monitored";
+        return;
+    }
+
+    bus.connect(UPOWER_SERVICE, UPOWER_PATH, UPOWER_INTERFACE, "DeviceAdded",
+                this, SLOT(slotDeviceAdded(QDBusMessage)));
+    bus.connect(UPOWER_SERVICE, UPOWER_PATH, UPOWER_INTERFACE, "DeviceRemoved",
+                this, SLOT(slotDeviceRemoved(QDBusMessage)));
+    bus.connect(UPOWER_SERVICE, UPOWER_PATH, PROPERTIES_INTERFACE, "PropertiesChanged",
+                this, SLOT(slotPropertiesChanged(QString, QVariantMap, QStringList, QDBusMessage)));
+
+    QDBusMessage call = QDBusMessage::createMethodCall(UPOWER_SERVICE, UPOWER_PATH, UPOWER_INTERFACE, "EnumerateDevices");
+    QDBusPendingCallWatcher *watcher = watchCall(bus.asyncCall(call));
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher * w) {
+        QDBusPendingReply<QList<QDBusObjectPath> > reply = *w;
+        w->deleteLater();
+        if (reply.isError()) {
+            qCWarning(appLog) << "UPower EnumerateDevices failed:" << reply.error().message();
+            return;
+        }
+        foreach (const QDBusObjectPath &path, reply.value())
+            fetchDevice(path.path());
+    });
+
+    fetchDaemon();
+}
+
+void UPowerMonitor::refresh()
+{
+    QDBusConnection bus = QDBusConnection::systemBus();
+    foreach (const QString &path, m_Batteries.keys()) {
+        QDBusMessage call = QDBusMessage::createMethodCall(UPOWER_SERVICE, path, DEVICE_INTERFACE, "Refresh");
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(bus.asyncCall(call), this);
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [](QDBusPendingCallWatcher * w) {
+            if (w->isError())
+                qCWarning(appLog) << "call Refresh failure:" << w->error().message();
+            w->deleteLater();
+        });
+    }
+}
+
+void UPowerMonitor::apply()
+{
+    if (!m_Valid || m_Batteries.isEmpty())
+        return;
+
+    // 与 upower --dump 的解析结果保持相同的结构
+    QMap<QString, QMap<QString, QString>> mapInfo;
+    mapInfo.insert("upower", batteryInfo(m_Batteries.first()));
+    mapInfo.insert("Daemon", daemonInfo(m_Daemon));
+    DeviceManager::instance()->correctPowerInfo(mapInfo);
+}
+
+void UPowerMonitor::updateBattery(Battery &battery, const QVariantMap &properties)
+{
+    for (auto it = properties.constBegin(); it != properties.constEnd(); ++it) {
+        const QString &key = it.key();
+        const QVariant &value = it.value();
+        if (key == "NativePath")
+            battery.nativePath = value.toString();
+        else if (key == "Vendor")
+            battery.vendor = value.toString();
+        else if (key == "Model")
+            battery.model = value.toString();
+        else if (key == "Serial")
+            battery.serial = value.toString();
+        else if (key == "IconName")
+            battery.iconName = value.toString();
+        else if (key == "Type")
+            battery.type = value.toUInt();
+        else if (key == "State")
+            battery.state = value.toUInt();
+        else if (key == "Technology")
+            battery.technology = value.toUInt();
+        else if (key == "WarningLevel")
+            battery.warningLevel = value.toUInt();
+        else if (key == "PowerSupply")
+            battery.powerSupply = value.toBool();
+        else if (key == "HasHistory")
+            battery.hasHistory = value.toBool();
+        else if (key == "HasStatistics")
+            battery.hasStatistics = value.toBool();
+        else if (key == "IsPresent")
+            battery.isPresent = value.toBool();
+        else if (key == "IsRechargeable")
+            battery.isRechargeable = value.toBool();
+        else if (key == "Energy")
+            battery.energy = value.toDouble();
+        else if (key == "EnergyEmpty")
+            battery.energyEmpty = value.toDouble();
+        else if (key == "EnergyFull")
+            battery.energyFull = value.toDouble();
+        else if (key == "EnergyFullDesign")
+            battery.energyFullDesign = value.toDouble();
+        else if (key == "EnergyRate")
+            battery.energyRate = value.toDouble();
+        else if (key == "Voltage")
+            battery.voltage = value.toDouble();
+        else if (key == "Percentage")
+            battery.percentage = value.toDouble();
+        else if (key == "Capacity")
+            battery.capacity = value.toDouble();
+        else if (key == "Temperature")
+            battery.temperature = value.toDouble();
+        else if (key == "TimeToEmpty")
+            battery.timeToEmpty = value.toLongLong();
+        else if (key == "TimeToFull")
+            battery.timeToFull = value.toLongLong();
+        else if (key == "UpdateTime")
+            battery.updateTime = value.toULongLong();
+    }
+}
+
+void UPowerMonitor::updateDaemon(Daemon &daemon, const QVariantMap &properties)
+{
+    if (properties.contains("DaemonVersion"))
+        daemon.daemonVersion = properties.value("DaemonVersion").toString();
+    if (properties.contains("OnBattery"))
+        daemon.onBattery = properties.value("OnBattery").toBool();
+    if (properties.contains("LidIsClosed"))
+        daemon.lidIsClosed = properties.value("LidIsClosed").toBool();
+    if (properties.contains("LidIsPresent"))
+        daemon.lidIsPresent = properties.value("LidIsPresent").toBool();
+}
+
+// 数值格式与 upower --dump 一致
+static QString yesNo(bool value)
+{
+    return value ? "yes" : "no";
+}
+
+static QString number(double value, const QString &unit)
+{
+    return QString::number(value, 'g', 6) + unit;
+}
+
+static QString duration(qint64 seconds)
+{
+    if (seconds < 60)
+        return QString("%1 seconds").arg(seconds);
+    if (seconds < 60 * 60)
+        return number(seconds / 60.0, " minutes");
+    if (seconds < 24 * 60 * 60)
+        return number(seconds / 3600.0, " hours");
+    return number(seconds / 86400.0, " days");
+}
+
+QMap<QString, QString> UPowerMonitor::batteryInfo(const Battery &battery)
+{
+    static const QStringList states = { "unknown", "charging", "discharging", "empty",
+                                        "fully-charged", "pending-charge", "pending-discharge"
+                                      };
+    static const QStringList technologies = { "unknown", "lithium-ion", "lithium-polymer", "lithium-iron-phosphate",
+                                              "lead-acid", "nickel-cadmium", "nickel-metal-hydride"
+                                            };
+    static const QStringList warningLevels = { "unknown", "none", "discharging", "low", "critical", "action" };
+
+    QMap<QString, QString> mapInfo;
+    mapInfo.insert("Device", battery.path);
+    mapInfo.insert("native-path", battery.nativePath);
+    if (!battery.vendor.isEmpty())
+        mapInfo.insert("vendor", battery.vendor);
+    if (!battery.model.isEmpty())
+        mapInfo.insert("model", battery.model);
+    if (!battery.serial.isEmpty())
+        mapInfo.insert("serial", battery.serial);
+    mapInfo.insert("power supply", yesNo(battery.powerSupply));
+    if (battery.updateTime > 0)
+        mapInfo.insert("updated", QDateTime::fromSecsSinceEpoch(qint64(battery.updateTime)).toString());
+    mapInfo.insert("has history", yesNo(battery.hasHistory));
+    mapInfo.insert("has statistics", yesNo(battery.hasStatistics));
+    mapInfo.insert("present", yesNo(battery.isPresent));
+    mapInfo.insert("rechargeable", yesNo(battery.isRechargeable));
+    mapInfo.insert("state", states.value(int(battery.state), "unknown"));
+    mapInfo.insert("warning-level", warningLevels.value(int(battery.warningLevel), "unknown"));
+    mapInfo.insert("energy", number(battery.energy, " Wh"));
+    mapInfo.insert("energy-empty", number(battery.energyEmpty, " Wh"));
+    mapInfo.insert("energy-full", number(battery.energyFull, " Wh"));
+    mapInfo.insert("energy-full-design", number(battery.energyFullDesign, " Wh"));
+    mapInfo.insert("energy-rate", number(battery.energyRate, " W"));
+    mapInfo.insert("voltage", number(battery.voltage, " V"));
+    if (battery.timeToEmpty > 0)
+        mapInfo.insert("time to empty", duration(battery.timeToEmpty));
+    if (battery.timeToFull > 0)
+        mapInfo.insert("time to full", duration(battery.timeToFull));
+    mapInfo.insert("percentage", number(battery.percentage, "%"));
+    mapInfo.insert("capacity", number(battery.capacity, "%"));
+    if (battery.temperature > 0)
+        mapInfo.insert("temperature", number(battery.temperature, " degrees C"));
+    mapInfo.insert("technology", technologies.value(int(battery.technology), "unknown"));
+    if (!battery.iconName.isEmpty())
+        mapInfo.insert("icon-name", "'" + battery.iconName + "'");
+    return mapInfo;
+}
+
+QMap<QString, QString> UPowerMonitor::daemonInfo(const Daemon &daemon)
+{
+    QMap<QString, QString> mapInfo;
+    mapInfo.insert("daemon-version", daemon.daemonVersion);
+    mapInfo.insert("on-battery", yesNo(daemon.onBattery));
+    mapInfo.insert("lid-is-closed", yesNo(daemon.lidIsClosed));
+    mapInfo.insert("lid-is-present", yesNo(daemon.lidIsPresent));
+    if (!daemon.criticalAction.isEmpty())
+        mapInfo.insert("critical-action", daemon.criticalAction);
+    return mapInfo;
+}
+
+void UPowerMonitor::slotDeviceAdded(const QDBusMessage &msg)
+{
+    QString path = msg.arguments().value(0).value<QDBusObjectPath>().path();
+    if (!path.isEmpty())
+        fetchDevice(path);
+}
+
+void UPowerMonitor::slotDeviceRemoved(const QDBusMessage &msg)
+{
+    QString path = msg.arguments().value(0).value<QDBusObjectPath>().path();
+    if (!path.isEmpty())
+        removeDevice(path);
+}
+
+void UPowerMonitor::slotPropertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated, const QDBusMessage &msg)
+{
+    if (interface == UPOWER_INTERFACE) {
+        updateDaemon(m_Daemon, changed);
+        notifyUpdated();
+        return;
+    }
+
+    auto it = m_Batteries.find(msg.path());
+    if (interface != DEVICE_INTERFACE || it == m_Batteries.end())
+        return;
+
+    // 只更新变化的属性,失效的属性需要重新获取
+    updateBattery(it.value(), changed);
+    if (!invalidated.isEmpty())
+        fetchDevice(msg.path());
+    notifyUpdated();
+}
+
+void UPowerMonitor::fetchDevice(const QString &path)
+{
+    QDBusConnection bus = QDBusConnection::systemBus();
+
+    // 先订阅再获取,避免错过获取期间的变化
+    if (!m_Watched.contains(path)) {
+        bus.connect(UPOWER_SERVICE, path, PROPERTIES_INTERFACE, "PropertiesChanged",
+                    this, SLOT(slotPropertiesChanged(QString, QVariantMap, QStringList, QDBusMessage)));
+        m_Watched.append(path);
+    }
+
+    QDBusMessage call = QDBusMessage::createMethodCall(UPOWER_SERVICE, path, PROPERTIES_INTERFACE, "GetAll");
+    call << QString(DEVICE_INTERFACE);
+    QDBusPendingCallWatcher *watcher = watchCall(bus.asyncCall(call));
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, path](QDBusPendingCallWatcher * w) {
+        QDBusPendingReply<QVariantMap> reply = *w;
+        w->deleteLater();
+        if (reply.isError()) {
+            qCWarning(appLog) << "UPower GetAll failed:" << path << reply.error().message();
+            return;
+        }
+
+        // 只保留为系统供电的电池,排除无线鼠标、键盘等外设的电池
+        const QVariantMap properties = reply.value();
+        if (properties.value("Type").toUInt() != DEVICE_KIND_BATTERY || !properties.value("PowerSupply").toBool()) {
+            removeDevice(path);
+            return;
+        }
+
+        Battery &battery = m_Batteries[path];
+        battery.path = path;
+        updateBattery(battery, properties);
+        m_Valid = true;
+        notifyUpdated();
+    });
+}
+
+void UPowerMonitor::fetchDaemon()
+{
+    QDBusConnection bus = QDBusConnection::systemBus();
+
+    QDBusMessage call = QDBusMessage::createMethodCall(UPOWER_SERVICE, UPOWER_PATH, PROPERTIES_INTERFACE, "GetAll");
+    call << QString(UPOWER_INTERFACE);
+    QDBusPendingCallWatcher *watcher = watchCall(bus.asyncCall(call));
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher * w) {
+        QDBusPendingReply<QVariantMap> reply = *w;
+        w->deleteLater();
+        if (reply.isError())
+            return;
+        updateDaemon(m_Daemon, reply.value());
+        notifyUpdated();
+    });
+
+    call = QDBusMessage::createMethodCall(UPOWER_SERVICE, UPOWER_PATH, UPOWER_INTERFACE, "GetCriticalAction");
+    watcher = watchCall(bus.asyncCall(call));
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher * w) {
+        QDBusPendingReply<QString> reply = *w;
+        w->deleteLater();
+        if (reply.isError())
+            return;
+        m_Daemon.criticalAction = reply.value();
+        notifyUpdated();
+    });
+}
+
+void UPowerMonitor::removeDevice(const QString &path)
+{
+    if (m_Watched.removeOne(path)) {
+        QDBusConnection::systemBus().disconnect(UPOWER_SERVICE, path, PROPERTIES_INTERFACE, "PropertiesChanged",
+                                                this, SLOT(slotPropertiesChanged(QString, QVariantMap, QStringList, QDBusMessage)));
+    }
+
+    if (m_Batteries.remove(path) > 0)
+        notifyUpdated();
+}
+
+QDBusPendingCallWatcher *UPowerMonitor::watchCall(const QDBusPendingCall &call)
+{
+    // 返回结果处理完后 watcher 被删除,此时计数减一,获取设备时发出的请求在删除前已计入
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
+    ++m_Pending;
+    connect(watcher, &QObject::destroyed, this, [this]() {
+        if (--m_Pending == 0)
+            emit fetched();
+    });
+    return watcher;
+}
+
+void UPowerMonitor::notifyUpdated()
+{
+    if (!m_NotifyTimer.isActive())
+        m_NotifyTimer.start();
+}
@@ -0,0 +1,220 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef UPOWERMONITOR_H
+#define UPOWERMONITOR_H
+
+#include <QObject>
+#include <QTimer>
+#include <QMap>
+#include <QVariantMap>
+#include <QStringList>
+#include <QDBusMessage>
+
+class QDBusPendingCallWatcher;
+class QDBusPendingCall;
+
+/**
+ * @brief The UPowerMonitor class
+ * 电池信息的缓存,只在界面线程中使用
+ * 通过 org.freedesktop.UPower 的 DeviceAdded/DeviceRemoved 与设备的 PropertiesChanged 信号异步更新,不启动任何进程
+ */
+class UPowerMonitor : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief The Battery struct
+     * org.freedesktop.UPower.Device 中与电池有关的属性
+     */
+    struct Battery {
+        Battery();
+
+        QString     path;               //<! D-Bus 对象路径
+        QString     nativePath;         //<! sysfs 中的名称,如 BAT0
+        QString     vendor;             //<! 制造商
+        QString     model;              //<! 型号
+        QString     serial;             //<! 序列号
+        QString     iconName;           //<! 图标名称
+        uint        type;               //<! 设备类型,2 为电池
+        uint        state;              //<! 充放电状态
+        uint        technology;         //<! 电池技术
+        uint        warningLevel;       //<! 电量警告级别
+        bool        powerSupply;        //<! 是否为系统供电
+        bool        hasHistory;         //<! 是否有历史记录
+        bool        hasStatistics;      //<! 是否有统计信息
+        bool        isPresent;          //<! 电池是否存在
+        bool        isRechargeable;     //<! 是否可充电
+        double      energy;             //<! 当前能量 Wh
+        double      energyEmpty;        //<! 空电能量 Wh
+        double      energyFull;         //<! 满电能量 Wh
+        double      energyFullDesign;   //<! 设计能量 Wh
+        double      energyRate;         //<! 充放电功率 W
+        double      voltage;            //<! 电压 V
+        double      percentage;         //<! 电量百分比
+        double      capacity;           //<! 健康度百分比
+        double      temperature;        //<! 温度,0 表示未知
+        qint64      timeToEmpty;        //<! 预计放完电的秒数
+        qint64      timeToFull;         //<! 预计充满电的秒数
+        quint64     updateTime;         //<! 最近更新时间
+    };
+
+    /**
+     * @brief The Daemon struct
+     * org.freedesktop.UPower 守护进程的属性
+     */
+    struct Daemon {
+        Daemon();
+
+        QString     daemonVersion;      //<! 守护进程版本
+        QString     criticalAction;     //<! 电量耗尽时的操作
+        bool        onBattery;          //<! 是否使用电池供电
+        bool        lidIsClosed;        //<! 笔记本盖是否合上
+        bool        lidIsPresent;       //<! 是否有笔记本盖
+    };
+
+    static UPowerMonitor *instance()
+    {
+        if (!sInstance) {
+            sInstance = new UPowerMonitor;
+        }
+        return sInstance;
+    }
+
+    /**
+     * @brief start:订阅 UPower 信号并异步获取所有电池
+     */
+    void start();
+
+    /**
+     * @brief refresh:异步请求 UPower 重新读取电池信息,结果通过 PropertiesChanged 返回
+     */
+    void refresh();
+
+    /**
+     * @brief apply:将缓存的电池信息写入 DeviceManager,还未获取到电池时不做处理
+     */
+    void apply();
+
+    /**
+     * @brief isValid:是否已获取到电池信息
+     */
+    bool isValid() const { return m_Valid; }
+
+    /**
+     * @brief isFetching:是否还有未返回的获取请求
+     */
+    bool isFetching() const { return m_Pending > 0; }
+
+    /**
+     * @brief batteries:所有电池,按对象路径排序
+     */
+    QList<Battery> batteries() const { return m_Batteries.values(); }
+
+    /**
+     * @brief daemon:守护进程信息
+     */
+    const Daemon &daemon() const { return m_Daemon; }
+
+    /**
+     * @brief updateBattery:用 D-Bus 属性更新电池,属性中没有的字段保持不变
+     * @param battery:电池
+     * @param properties:org.freedesktop.UPower.Device 的属性
+     */
+    static void updateBattery(Battery &battery, const QVariantMap &properties);
+
+    /**
+     * @brief updateDaemon:用 D-Bus 属性更新守护进程信息
+     * @param daemon:守护进程信息
+     * @param properties:org.freedesktop.UPower 的属性
+     */
+    static void updateDaemon(Daemon &daemon, const QVariantMap &properties);
+
+    /**
+     * @brief batteryInfo:转换为与 upower --dump 相同的键值,供 DevicePower 使用
+     * @param battery:电池
+     * @return 电池信息map
+     */
+    static QMap<QString, QString> batteryInfo(const Battery &battery);
+
+    /**
+     * @brief daemonInfo:转换为与 upower --dump 相同的键值
+     * @param daemon:守护进程信息
+     * @return 守护进程信息map
+     */
+    static QMap<QString, QString> daemonInfo(const Daemon &daemon);
+
+signals:
+    /**
+     * @brief updated:电池信息变化
+     */
+    void updated();
+
+    /**
+     * @brief fetched:获取设备和守护进程信息的请求都已返回
+     */
+    void fetched();
+
+protected:
+    UPowerMonitor();
+
+private slots:
+    /**
+     * @brief slotDeviceAdded:UPower 新增设备
+     */
+    void slotDeviceAdded(const QDBusMessage &msg);
+
+    /**
+     * @brief slotDeviceRemoved:UPower 移除设备
+     */
+    void slotDeviceRemoved(const QDBusMessage &msg);
+
+    /**
+     * @brief slotPropertiesChanged:电池或守护进程属性变化,对象路径从消息中获取
+     */
+    void slotPropertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated, const QDBusMessage &msg);
+
+private:
+    /**
+     * @brief fetchDevice:异步获取设备的所有属性,不是电池的设备被忽略
+     * @param path:设备对象路径
+     */
+    void fetchDevice(const QString &path);
+
+    /**
+     * @brief fetchDaemon:异步获取守护进程属性与电量耗尽时的操作
+     */
+    void fetchDaemon();
+
+    /**
+     * @brief removeDevice:移除设备并取消订阅
+     * @param path:设备对象路径
+     */
+    void removeDevice(const QString &path);
+
+    /**
+     * @brief watchCall:监听获取请求并计数,全部返回后发出 fetched
+     * @param call:异步请求
+     * @return 请求的 watcher
+     */
+    QDBusPendingCallWatcher *watchCall(const QDBusPendingCall &call);
+
+    /**
+     * @brief notifyUpdated:合并短时间内的多个属性变化后发出 updated
+     */
+    void notifyUpdated();
+
+private:
+    static UPowerMonitor      *sInstance;
+
+    QMap<QString, Battery>    m_Batteries;        //<! 对象路径到电池的映射
+    QStringList               m_Watched;          //<! 已订阅 PropertiesChanged 的设备
+    Daemon                    m_Daemon;           //<! 守护进程信息
+    QTimer                    m_NotifyTimer;      //<! 合并属性变化通知
+    int                       m_Pending;          //<! 未返回的获取请求数
+    bool                      m_Started;          //<! 是否已开始监听
+    bool                      m_Valid;            //<! 是否已获取到电池信息
+};
+
+#endif // UPOWERMONITOR_H
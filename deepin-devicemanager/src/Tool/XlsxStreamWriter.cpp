@@ -0,0 +1,241 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "XlsxStreamWriter.h"
+
+// Qt库文件
+#include <QDataStream>
+
+static const char *contentTypesXml =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+    "<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+    "<Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+    "<Default Extension=\"xml\" ContentType=\"application/xml\"/>"
+    "<Override PartName=\"/xl/workbook.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.sheet.main+xml\"/>"
+    "<Override PartName=\"/xl/worksheets/sheet1.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml\"/>"
+    "<Override PartName=\"/xl/styles.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.styles+xml\"/>"
+    "<Override PartName=\"/xl/sharedStrings.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.sharedStrings+xml\"/>"
+    "</Types>";
+
+static const char *rootRelsXml =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+    "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+    "<Relationship Id=\"rId1\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument\" Target=\"xl/workbook.xml\"/>"
+    "</Relationships>";
+
+static const char *workbookXml =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+    "<workbook xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\" "
+    "xmlns:r=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships\">"
+    "<sheets><sheet name=\"Sheet1\" sheetId=\"1\" r:id=\"rId1\"/></sheets>"
+    "</workbook>";
+
+static const char *workbookRelsXml =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+    "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+    "<Relationship Id=\"rId1\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/worksheet\" Target=\"worksheets/sheet1.xml\"/>"
+    "<Relationship Id=\"rId2\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/styles\" Target=\"styles.xml\"/>"
+    "<Relationship Id=\"rId3\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/sharedStrings\" Target=\"sharedStrings.xml\"/>"
+    "</Relationships>";
+
+// cellXfs 的顺序与 XlsxStreamWriter::CellStyle 一致
+static const char *stylesXml =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+    "<styleSheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+    "<fonts count=\"4\">"
+    "<font><sz val=\"11\"/><name val=\"Calibri\"/><family val=\"2\"/></font>"
+    "<font><b/><sz val=\"11\"/><name val=\"Calibri\"/><family val=\"2\"/></font>"
+    "<font><sz val=\"10\"/><name val=\"Calibri\"/><family val=\"2\"/></font>"
+    "<font><b/><sz val=\"10\"/><name val=\"Calibri\"/><family val=\"2\"/></font>"
+    "</fonts>"
+    "<fills count=\"2\"><fill><patternFill patternType=\"none\"/></fill><fill><patternFill patternType=\"gray125\"/></fill></fills>"
+    "<borders count=\"1\"><border><left/><right/><top/><bottom/><diagonal/></border></borders>"
+    "<cellStyleXfs count=\"1\"><xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\"/></cellStyleXfs>"
+    "<cellXfs count=\"4\">"
+    "<xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\" xfId=\"0\"/>"
+    "<xf numFmtId=\"0\" fontId=\"1\" fillId=\"0\" borderId=\"0\" xfId=\"0\" applyFont=\"1\"/>"
+    "<xf numFmtId=\"0\" fontId=\"2\" fillId=\"0\" borderId=\"0\" xfId=\"0\" applyFont=\"1\"/>"
+    "<xf numFmtId=\"0\" fontId=\"3\" fillId=\"0\" borderId=\"0\" xfId=\"0\" applyFont=\"1\"/>"
+    "</cellXfs>"
+    "<cellStyles count=\"1\"><cellStyle name=\"Normal\" xfId=\"0\" builtinId=\"0\"/></cellStyles>"
+    "</styleSheet>";
+
+static const char *sheetHeadXml =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+    "<worksheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\" "
+    "xmlns:r=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships\">"
+    "<sheetData>";
+
+static const char *sheetTailXml = "</sheetData></worksheet>";
+
+XlsxStreamWriter::XlsxStreamWriter(const QString &filePath)
+    : m_FragmentMode(false)
+    , m_NextRow(1)
+    , m_Zip(filePath)
+    , m_Opened(false)
+    , m_CurRow(0)
+    , m_StringRefs(0)
+{
+    // 工作表是唯一随行增长的部件,第一个写入;其余部件在 save 时写入
+    if (m_Zip.isOpen())
+        m_Opened = m_Zip.beginEntry("xl/worksheets/sheet1.xml") && m_Zip.write(sheetHeadXml);
+}
+
+XlsxStreamWriter::XlsxStreamWriter()
+    : m_FragmentMode(true)
+    , m_NextRow(1)
+    , m_Zip(QString())
+    , m_Opened(false)
+    , m_CurRow(0)
+    , m_StringRefs(0)
+{
+
+}
+
+XlsxStreamWriter::~XlsxStreamWriter()
+{
+
+}
+
+int XlsxStreamWriter::nextRow()
+{
+    return m_NextRow++;
+}
+
+void XlsxStreamWriter::write(int row, int col, const QString &text, CellStyle style)
+{
+    if (row < 1 || col < 1 || row < m_CurRow)
+        return;
+
+    // 片段模式只记录单元格,行号在合入时偏移
+    if (m_FragmentMode) {
+        QDataStream stream(&m_Fragment, QIODevice::WriteOnly | QIODevice::Append);
+        stream << qint32(row) << qint32(col) << qint32(style) << text;
+        m_CurRow = row;
+        return;
+    }
+
+    // 换行时将上一行写出
+    if (row != m_CurRow) {
+        flushRow();
+        m_CurRow = row;
+    }
+
+    const QString ref = columnName(col) + QString::number(row);
+    m_RowXml += "<c r=\"" + ref.toLatin1() + "\" s=\"" + QByteArray::number(int(style)) + "\"";
+    if (text.isEmpty()) {
+        m_RowXml += "/>";
+        return;
+    }
+    m_RowXml += " t=\"s\"><v>" + QByteArray::number(sharedStringIndex(text)) + "</v></c>";
+}
+
+bool XlsxStreamWriter::save()
+{
+    if (!m_Opened)
+        return false;
+
+    flushRow();
+    m_Opened = false;
+    bool ok = m_Zip.write(sheetTailXml) && m_Zip.endEntry()
+              && m_Zip.addFile("[Content_Types].xml", QByteArray(contentTypesXml))
+              && m_Zip.addFile("_rels/.rels", QByteArray(rootRelsXml))
+              && m_Zip.addFile("xl/workbook.xml", QByteArray(workbookXml))
+              && m_Zip.addFile("xl/_rels/workbook.xml.rels", QByteArray(workbookRelsXml))
+              && m_Zip.addFile("xl/styles.xml", QByteArray(stylesXml))
+              && m_Zip.addFile("xl/sharedStrings.xml", sharedStringsXml());
+    return m_Zip.close() && ok;
+}
+
+QByteArray XlsxStreamWriter::takeFragment()
+{
+    // 以行号0结束,随后记录片段占用的行数
+    QDataStream stream(&m_Fragment, QIODevice::WriteOnly | QIODevice::Append);
+    stream << qint32(0) << qint32(m_NextRow - 1);
+
+    QByteArray fragment = m_Fragment;
+    m_Fragment.clear();
+    m_CurRow = 0;
+    m_NextRow = 1;
+    return fragment;
+}
+
+void XlsxStreamWriter::appendFragment(const QByteArray &fragment)
+{
+    const int offset = m_NextRow - 1;
+    QDataStream stream(fragment);
+    while (!stream.atEnd()) {
+        qint32 row = 0;
+        stream >> row;
+        if (row == 0)
+            break;
+
+        qint32 col = 0;
+        qint32 style = 0;
+        QString text;
+        stream >> col >> style >> text;
+        write(row + offset, col, text, CellStyle(style));
+    }
+
+    qint32 rowCount = 0;
+    stream >> rowCount;
+    m_NextRow = offset + rowCount + 1;
+}
+
+int XlsxStreamWriter::sharedStringCount() const
+{
+    return m_Strings.size();
+}
+
+void XlsxStreamWriter::flushRow()
+{
+    if (m_CurRow < 1 || m_RowXml.isEmpty())
+        return;
+
+    if (m_Opened)
+        m_Zip.write("<row r=\"" + QByteArray::number(m_CurRow) + "\">" + m_RowXml + "</row>");
+    m_RowXml.clear();
+}
+
+int XlsxStreamWriter::sharedStringIndex(const QString &text)
+{
+    ++m_StringRefs;
+    QHash<QString, int>::const_iterator it = m_StringIndex.constFind(text);
+    if (it != m_StringIndex.constEnd())
+        return it.value();
+
+    int index = m_Strings.size();
+    m_Strings.append(text);
+    m_StringIndex.insert(text, index);
+    return index;
+}
+
+QString XlsxStreamWriter::columnName(int col)
+{
+    QString name;
+    while (col > 0) {
+        int mod = (col - 1) % 26;
+        name.prepend(QChar('A' + mod));
+        col = (col - 1) / 26;
+    }
+    return name;
+}
+
+QByteArray XlsxStreamWriter::sharedStringsXml() const
+{
+    QByteArray xml;
+    xml += "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n";
+    xml += "<sst xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\" count=\""
+           + QByteArray::number(m_StringRefs) + "\" uniqueCount=\"" + QByteArray::number(m_Strings.size()) + "\">";
+    foreach (const QString &text, m_Strings) {
+        // 首尾空白需要 xml:space 保留
+        if (!text.isEmpty() && (text.at(0).isSpace() || text.at(text.size() - 1).isSpace()))
+            xml += "<si><t xml:space=\"preserve\">" + ZipStreamWriter::escapeXml(text).toUtf8() + "</t></si>";
+        else
+            xml += "<si><t>" + ZipStreamWriter::escapeXml(text).toUtf8() + "</t></si>";
+    }
+    xml += "</sst>";
+    return xml;
+}
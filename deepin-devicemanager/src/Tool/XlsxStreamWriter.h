@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef XLSXSTREAMWRITER_H
+#define XLSXSTREAMWRITER_H
+
+#include "ZipStreamWriter.h"
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+
+/**
+ * @brief The XlsxStreamWriter class
+ * 按行流式写出的单工作表xlsx
+ * 单元格不在内存中建表,行写完即以 sheet xml 形式直接写入包内的 sheet1.xml 条目,字符串通过哈希表去重后写入 sharedStrings
+ * 行号必须递增,同一行的单元格需连续写入
+ * 片段模式下单元格按相对行号序列化到内存,由主写出器通过 appendFragment 按顺序合入,用于并行渲染各设备类别
+ */
+class XlsxStreamWriter
+{
+public:
+    /**
+     * @brief The CellStyle enum 单元格样式,与 styles.xml 中 cellXfs 的顺序一致
+     */
+    enum CellStyle {
+        CS_Normal    = 0,    //<! 默认字体
+        CS_Bold      = 1,    //<! 加粗
+        CS_Small     = 2,    //<! 10号字
+        CS_SmallBold = 3     //<! 10号字加粗
+    };
+
+    explicit XlsxStreamWriter(const QString &filePath);
+
+    /**
+     * @brief XlsxStreamWriter:片段模式,不输出文件
+     */
+    XlsxStreamWriter();
+    ~XlsxStreamWriter();
+
+    /**
+     * @brief nextRow:获取当前行号并移到下一行
+     * @return 当前行号,从1开始
+     */
+    int nextRow();
+
+    /**
+     * @brief write:写入单元格
+     * @param row:行号,从1开始,不能小于上一次写入的行号
+     * @param col:列号,从1开始
+     * @param text:单元格内容
+     * @param style:单元格样式
+     */
+    void write(int row, int col, const QString &text, CellStyle style = CS_Normal);
+
+    /**
+     * @brief save:结束写入并打包为xlsx文件
+     * @return true:保存成功;false:保存失败
+     */
+    bool save();
+
+    /**
+     * @brief takeFragment:取出片段模式下写入的内容
+     * @return 序列化的片段
+     */
+    QByteArray takeFragment();
+
+    /**
+     * @brief appendFragment:将片段追加到当前行之后,行号按片段内的相对行号偏移
+     * @param fragment:takeFragment 取出的片段
+     */
+    void appendFragment(const QByteArray &fragment);
+
+    /**
+     * @brief sharedStringCount:去重后的字符串个数
+     */
+    int sharedStringCount() const;
+
+private:
+    /**
+     * @brief flushRow:将缓存的当前行写到临时文件
+     */
+    void flushRow();
+
+    /**
+     * @brief sharedStringIndex:获取字符串在 sharedStrings 中的索引,不存在时添加
+     */
+    int sharedStringIndex(const QString &text);
+
+    /**
+     * @brief columnName:列号转为列名,1->A,27->AA
+     */
+    static QString columnName(int col);
+
+    QByteArray sharedStringsXml() const;
+
+private:
+    bool                  m_FragmentMode;    //<! 是否为片段模式
+    QByteArray            m_Fragment;        //<! 片段模式下序列化的单元格
+    int                   m_NextRow;         //<! nextRow 返回的行号
+    ZipStreamWriter       m_Zip;             //<! 输出的zip包
+    bool                  m_Opened;          //<! sheet1.xml 条目是否已开始
+    int                   m_CurRow;          //<! 当前缓存的行号
+    QByteArray            m_RowXml;          //<! 当前行已写入的单元格
+    QHash<QString, int>   m_StringIndex;     //<! 字符串到 sharedStrings 索引
+    QStringList           m_Strings;         //<! 按索引排列的字符串
+    int                   m_StringRefs;      //<! 字符串单元格总数
+};
+
+#endif // XLSXSTREAMWRITER_H
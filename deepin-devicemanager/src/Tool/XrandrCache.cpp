@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "XrandrCache.h"
+#include "ThreadExecXrandr.h"
+#include "DDLog.h"
+
+// Qt库文件
+#include <QSocketNotifier>
+#include <QLoggingCategory>
+
+// 其它头文件
+#include <xcb/xcb.h>
+#include <xcb/randr.h>
+#include <stdlib.h>
+
+#define INVALIDATE_DELAY 300    // 显示器插拔会连续产生多个事件,合并后再获取
+
+using namespace DDLog;
+
+XrandrCache *XrandrCache::sInstance = nullptr;
+
+XrandrCache::XrandrCache()
+    : mp_Thread(nullptr)
+    , mp_Connection(nullptr)
+    , mp_Notifier(nullptr)
+    , m_EventBase(0)
+    , m_MonitorNumber(-1)
+    , m_Valid(false)
+    , m_Dirty(false)
+{
+    m_InvalidateTimer.setSingleShot(true);
+    m_InvalidateTimer.setInterval(INVALIDATE_DELAY);
+    connect(&m_InvalidateTimer, &QTimer::timeout, this, &XrandrCache::invalidate);
+}
+
+XrandrCache::~XrandrCache()
+{
+    if (mp_Thread) {
+        mp_Thread->wait();
+        delete mp_Thread;
+        mp_Thread = nullptr;
+    }
+    if (mp_Connection) {
+        xcb_disconnect(mp_Connection);
+        mp_Connection = nullptr;
+    }
+}
+
+void XrandrCache::start(bool isDXcbPlatform)
+{
+    if (mp_Thread)
+        return;
+
+    mp_Thread = new ThreadExecXrandr(isDXcbPlatform);
+    connect(mp_Thread, &QThread::finished, this, &XrandrCache::slotProbeFinished);
+
+    if (!initRandrEvents())
+        qCWarning(appLog) << "RandR events unavailable, display info is only probed once";
+
+    probe();
+}
+
+void XrandrCache::probe()
+{
+    if (!mp_Thread || m_Valid || mp_Thread->isRunning())
+        return;
+
+    mp_Thread->start();
+}
+
+void XrandrCache::apply()
+{
+    // 线程运行时成员正在被写入
+    if (!m_Valid || mp_Thread->isRunning())
+        return;
+
+    mp_Thread->applyToDeviceManager();
+}
+
+void XrandrCache::slotProbeFinished()
+{
+    mp_Thread->wait();
+
+    // 获取过程中显示配置又发生了变化,结果已过时
+    if (m_Dirty) {
+        m_Dirty = false;
+        mp_Thread->start();
+        return;
+    }
+
+    m_Valid = true;
+    int monitorNumber = mp_Thread->getMonitorNumber();
+    bool monitorChanged = m_MonitorNumber >= 0 && monitorNumber != m_MonitorNumber;
+    m_MonitorNumber = monitorNumber;
+
+    emit updated();
+    if (monitorChanged)
+        emit monitorNumberChanged();
+}
+
+void XrandrCache::slotRandrEvent()
+{
+    bool changed = false;
+    xcb_generic_event_t *event = nullptr;
+    while ((event = xcb_poll_for_event(mp_Connection))) {
+        const int type = event->response_type & ~0x80;
+        if (type == m_EventBase + XCB_RANDR_SCREEN_CHANGE_NOTIFY) {
+            changed = true;
+        } else if (type == m_EventBase + XCB_RANDR_NOTIFY) {
+            const xcb_randr_notify_event_t *notify = reinterpret_cast<const xcb_randr_notify_event_t *>(event);
+            if (notify->subCode == XCB_RANDR_NOTIFY_OUTPUT_CHANGE)
+                changed = true;
+        }
+        free(event);
+    }
+
+    // X连接断开后不再监听
+    if (xcb_connection_has_error(mp_Connection))
+        mp_Notifier->setEnabled(false);
+
+    if (changed)
+        m_InvalidateTimer.start();
+}
+
+bool XrandrCache::initRandrEvents()
+{
+    mp_Connection = xcb_connect(nullptr, nullptr);
+    if (xcb_connection_has_error(mp_Connection)) {
+        xcb_disconnect(mp_Connection);
+        mp_Connection = nullptr;
+        return false;
+    }
+
+    const xcb_query_extension_reply_t *ext = xcb_get_extension_data(mp_Connection, &xcb_randr_id);
+    if (!ext || !ext->present) {
+        xcb_disconnect(mp_Connection);
+        mp_Connection = nullptr;
+        return false;
+    }
+    m_EventBase = ext->first_event;
+
+    // 只订阅屏幕与输出的变化
+    xcb_screen_iterator_t screenIter = xcb_setup_roots_iterator(xcb_get_setup(mp_Connection));
+    for (; screenIter.rem; xcb_screen_next(&screenIter)) {
+        xcb_randr_select_input(mp_Connection, screenIter.data->root,
+                               XCB_RANDR_NOTIFY_MASK_SCREEN_CHANGE | XCB_RANDR_NOTIFY_MASK_OUTPUT_CHANGE);
+    }
+    xcb_flush(mp_Connection);
+
+    mp_Notifier = new QSocketNotifier(xcb_get_file_descriptor(mp_Connection), QSocketNotifier::Read, this);
+    connect(mp_Notifier, &QSocketNotifier::activated, this, &XrandrCache::slotRandrEvent);
+    return true;
+}
+
+void XrandrCache::invalidate()
+{
+    m_Valid = false;
+    if (mp_Thread->isRunning())
+        m_Dirty = true;
+    else
+        mp_Thread->start();
+}
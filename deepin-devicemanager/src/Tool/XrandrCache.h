@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef XRANDRCACHE_H
+#define XRANDRCACHE_H
+
+#include <QObject>
+#include <QTimer>
+
+class ThreadExecXrandr;
+class QSocketNotifier;
+struct xcb_connection_t;
+
+/**
+ * @brief The XrandrCache class
+ * 显示适配器与显示器信息的缓存,只在界面线程中使用
+ * 信息由 ThreadExecXrandr 在后台获取,缓存只在收到 RRScreenChangeNotify / RROutputChangeNotify 时失效,界面不等待获取结果
+ */
+class XrandrCache : public QObject
+{
+    Q_OBJECT
+public:
+    static XrandrCache *instance()
+    {
+        if (!sInstance) {
+            sInstance = new XrandrCache;
+        }
+        return sInstance;
+    }
+
+    /**
+     * @brief start:监听RandR事件并开始第一次获取
+     * @param isDXcbPlatform:是否是DXcbPlatform
+     */
+    void start(bool isDXcbPlatform);
+
+    /**
+     * @brief probe:缓存无效且没有正在获取时在后台重新获取,立即返回
+     */
+    void probe();
+
+    /**
+     * @brief apply:将缓存的信息写入 DeviceManager,缓存无效时不做处理
+     */
+    void apply();
+
+    /**
+     * @brief isValid:缓存是否有效
+     */
+    bool isValid() const { return m_Valid; }
+
+signals:
+    /**
+     * @brief updated:获取到新的显示信息
+     */
+    void updated();
+
+    /**
+     * @brief monitorNumberChanged:显示器数量变化
+     */
+    void monitorNumberChanged();
+
+protected:
+    XrandrCache();
+    ~XrandrCache();
+
+private slots:
+    /**
+     * @brief slotProbeFinished:后台获取结束
+     */
+    void slotProbeFinished();
+
+    /**
+     * @brief slotRandrEvent:读取X连接上的RandR事件
+     */
+    void slotRandrEvent();
+
+private:
+    /**
+     * @brief initRandrEvents:连接X服务并订阅屏幕与输出变化事件
+     * @return true:订阅成功;false:无法连接X服务或不支持RandR
+     */
+    bool initRandrEvents();
+
+    /**
+     * @brief invalidate:缓存失效并重新获取
+     */
+    void invalidate();
+
+private:
+    static XrandrCache    *sInstance;
+
+    ThreadExecXrandr      *mp_Thread;          //<! 获取显示信息的线程
+    xcb_connection_t      *mp_Connection;      //<! 接收RandR事件的X连接
+    QSocketNotifier       *mp_Notifier;        //<! X连接可读通知
+    QTimer                m_InvalidateTimer;   //<! 合并短时间内的多个事件
+    int                   m_EventBase;         //<! RandR事件的起始编号
+    int                   m_MonitorNumber;     //<! 上次获取的显示器数量,-1表示还未获取
+    bool                  m_Valid;             //<! 缓存是否有效
+    bool                  m_Dirty;             //<! 获取过程中缓存已失效,结束后需要重新获取
+};
+
+#endif // XRANDRCACHE_H
@@ -0,0 +1,236 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "ZipStreamWriter.h"
+
+// Qt库文件
+#include <QDateTime>
+#include <QtEndian>
+
+// zip 格式签名
+#define ZIP_LOCAL_HEADER_SIG    0x04034b50
+#define ZIP_CENTRAL_HEADER_SIG  0x02014b50
+#define ZIP_END_OF_CENTRAL_SIG  0x06054b50
+#define ZIP_VERSION             20
+#define ZIP_FLAG_UTF8           0x0800
+#define ZIP_CRC_OFFSET          14
+
+static void appendUInt16(QByteArray &buf, quint16 value)
+{
+    uchar data[2];
+    qToLittleEndian<quint16>(value, data);
+    buf.append(reinterpret_cast<const char *>(data), 2);
+}
+
+static void appendUInt32(QByteArray &buf, quint32 value)
+{
+    uchar data[4];
+    qToLittleEndian<quint32>(value, data);
+    buf.append(reinterpret_cast<const char *>(data), 4);
+}
+
+ZipStreamWriter::ZipStreamWriter(const QString &filePath)
+    : m_File(filePath)
+    , m_Opened(false)
+    , m_InEntry(false)
+    , m_Error(false)
+    , m_DosTime(0)
+    , m_DosDate(0)
+{
+    if (!filePath.isEmpty())
+        m_Opened = m_File.open(QIODevice::WriteOnly | QIODevice::Truncate);
+
+    const QDateTime now = QDateTime::currentDateTime();
+    const QDate date = now.date();
+    const QTime time = now.time();
+    m_DosTime = quint16((time.hour() << 11) | (time.minute() << 5) | (time.second() / 2));
+    m_DosDate = quint16(((date.year() - 1980) << 9) | (date.month() << 5) | date.day());
+}
+
+ZipStreamWriter::~ZipStreamWriter()
+{
+    if (m_File.isOpen())
+        m_File.close();
+}
+
+bool ZipStreamWriter::isOpen() const
+{
+    return m_Opened;
+}
+
+bool ZipStreamWriter::addFile(const QString &name, const QByteArray &data)
+{
+    return beginEntry(name) && write(data) && endEntry();
+}
+
+bool ZipStreamWriter::beginEntry(const QString &name)
+{
+    if (!m_Opened || m_InEntry || m_Error)
+        return false;
+
+    m_CurEntry.name = name.toUtf8();
+    m_CurEntry.crc = 0;
+    m_CurEntry.size = 0;
+    m_CurEntry.offset = quint32(m_File.pos());
+
+    // CRC与大小先写0,结束条目时回填
+    if (m_File.write(localHeader(m_CurEntry)) < 0) {
+        m_Error = true;
+        return false;
+    }
+    m_InEntry = true;
+    return true;
+}
+
+bool ZipStreamWriter::write(const QByteArray &data)
+{
+    if (!m_InEntry || m_Error)
+        return false;
+
+    if (data.isEmpty())
+        return true;
+
+    if (m_File.write(data) != data.size()) {
+        m_Error = true;
+        return false;
+    }
+    m_CurEntry.crc = crc32(m_CurEntry.crc, data.constData(), data.size());
+    m_CurEntry.size += quint32(data.size());
+    return true;
+}
+
+bool ZipStreamWriter::endEntry()
+{
+    if (!m_InEntry)
+        return false;
+    m_InEntry = false;
+    if (m_Error)
+        return false;
+
+    // 回填本地文件头中的CRC与大小
+    QByteArray patch;
+    appendUInt32(patch, m_CurEntry.crc);
+    appendUInt32(patch, m_CurEntry.size);
+    appendUInt32(patch, m_CurEntry.size);
+
+    const qint64 end = m_File.pos();
+    if (!m_File.seek(m_CurEntry.offset + ZIP_CRC_OFFSET) || m_File.write(patch) != patch.size() || !m_File.seek(end)) {
+        m_Error = true;
+        return false;
+    }
+
+    m_Entries.append(m_CurEntry);
+    return true;
+}
+
+bool ZipStreamWriter::close()
+{
+    if (!m_Opened)
+        return false;
+
+    if (m_InEntry)
+        endEntry();
+
+    if (!m_Error) {
+        QByteArray central;
+        foreach (const ZipEntry &entry, m_Entries)
+            central += centralHeader(entry);
+
+        QByteArray end;
+        appendUInt32(end, ZIP_END_OF_CENTRAL_SIG);
+        appendUInt16(end, 0);
+        appendUInt16(end, 0);
+        appendUInt16(end, quint16(m_Entries.size()));
+        appendUInt16(end, quint16(m_Entries.size()));
+        appendUInt32(end, quint32(central.size()));
+        appendUInt32(end, quint32(m_File.pos()));
+        appendUInt16(end, 0);
+
+        if (m_File.write(central) != central.size() || m_File.write(end) != end.size())
+            m_Error = true;
+    }
+
+    m_File.close();
+    m_Opened = false;
+    return !m_Error;
+}
+
+quint32 ZipStreamWriter::crc32(quint32 crc, const char *data, qint64 len)
+{
+    // 局部静态对象的初始化是线程安全的
+    struct CrcTable {
+        quint32 value[256];
+        CrcTable()
+        {
+            for (quint32 i = 0; i < 256; ++i) {
+                quint32 c = i;
+                for (int k = 0; k < 8; ++k)
+                    c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+                value[i] = c;
+            }
+        }
+    };
+    static const CrcTable table;
+
+    crc = ~crc;
+    for (qint64 i = 0; i < len; ++i)
+        crc = table.value[(crc ^ uchar(data[i])) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+QString ZipStreamWriter::escapeXml(const QString &text)
+{
+    QString str;
+    str.reserve(text.size());
+    foreach (const QChar &ch, text) {
+        // xml 1.0 不允许除 \t \n \r 以外的控制字符
+        if (ch.unicode() < 0x20 && ch != '\t' && ch != '\n' && ch != '\r')
+            continue;
+        str.append(ch);
+    }
+    return str.toHtmlEscaped();
+}
+
+QByteArray ZipStreamWriter::localHeader(const ZipEntry &entry) const
+{
+    QByteArray header;
+    appendUInt32(header, ZIP_LOCAL_HEADER_SIG);
+    appendUInt16(header, ZIP_VERSION);
+    appendUInt16(header, ZIP_FLAG_UTF8);
+    appendUInt16(header, 0);                // 存储方式
+    appendUInt16(header, m_DosTime);
+    appendUInt16(header, m_DosDate);
+    appendUInt32(header, entry.crc);
+    appendUInt32(header, entry.size);
+    appendUInt32(header, entry.size);
+    appendUInt16(header, quint16(entry.name.size()));
+    appendUInt16(header, 0);
+    header += entry.name;
+    return header;
+}
+
+QByteArray ZipStreamWriter::centralHeader(const ZipEntry &entry) const
+{
+    QByteArray header;
+    appendUInt32(header, ZIP_CENTRAL_HEADER_SIG);
+    appendUInt16(header, ZIP_VERSION);
+    appendUInt16(header, ZIP_VERSION);
+    appendUInt16(header, ZIP_FLAG_UTF8);
+    appendUInt16(header, 0);
+    appendUInt16(header, m_DosTime);
+    appendUInt16(header, m_DosDate);
+    appendUInt32(header, entry.crc);
+    appendUInt32(header, entry.size);
+    appendUInt32(header, entry.size);
+    appendUInt16(header, quint16(entry.name.size()));
+    appendUInt16(header, 0);
+    appendUInt16(header, 0);
+    appendUInt16(header, 0);
+    appendUInt16(header, 0);
+    appendUInt32(header, 0);
+    appendUInt32(header, entry.offset);
+    header += entry.name;
+    return header;
+}
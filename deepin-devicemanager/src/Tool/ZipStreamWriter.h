@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ZIPSTREAMWRITER_H
+#define ZIPSTREAMWRITER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QList>
+#include <QFile>
+
+/**
+ * @brief The ZipStreamWriter class
+ * 流式写出的zip包(OPC包),条目以存储方式(不压缩)写入
+ * 条目内容边写边计算CRC,结束条目时回填本地文件头,不需要在内存中缓存整个条目
+ */
+class ZipStreamWriter
+{
+public:
+    explicit ZipStreamWriter(const QString &filePath);
+    ~ZipStreamWriter();
+
+    /**
+     * @brief isOpen:输出文件是否可写
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief addFile:写入一个完整的条目
+     * @param name:条目在包内的路径
+     * @param data:条目内容
+     * @return true:写入成功;false:写入失败
+     */
+    bool addFile(const QString &name, const QByteArray &data);
+
+    /**
+     * @brief beginEntry:开始一个条目,之后通过 write 追加内容
+     * @param name:条目在包内的路径
+     * @return true:成功;false:失败
+     */
+    bool beginEntry(const QString &name);
+
+    /**
+     * @brief write:向当前条目追加内容
+     * @param data:内容
+     * @return true:成功;false:失败
+     */
+    bool write(const QByteArray &data);
+
+    /**
+     * @brief endEntry:结束当前条目,回填CRC与大小
+     * @return true:成功;false:失败
+     */
+    bool endEntry();
+
+    /**
+     * @brief close:写中央目录并关闭文件
+     * @return true:成功;false:失败
+     */
+    bool close();
+
+    /**
+     * @brief crc32:计算CRC-32
+     * @param crc:上一段数据的CRC,首段传0
+     */
+    static quint32 crc32(quint32 crc, const char *data, qint64 len);
+
+    /**
+     * @brief escapeXml:转义部件xml中的文本,并去掉xml不允许的控制字符
+     * @param text:文本
+     * @return 转义后的文本
+     */
+    static QString escapeXml(const QString &text);
+
+private:
+    struct ZipEntry {
+        QByteArray name;      //<! 条目路径(UTF-8)
+        quint32    crc;       //<! 内容CRC-32
+        quint32    size;      //<! 内容大小
+        quint32    offset;    //<! 本地文件头偏移
+    };
+
+    QByteArray localHeader(const ZipEntry &entry) const;
+    QByteArray centralHeader(const ZipEntry &entry) const;
+
+private:
+    QFile            m_File;          //<! 输出文件
+    bool             m_Opened;        //<! 输出文件是否可写
+    bool             m_InEntry;       //<! 是否有未结束的条目
+    bool             m_Error;         //<! 写入过程中是否出错
+    quint16          m_DosTime;       //<! 条目修改时间
+    quint16          m_DosDate;       //<! 条目修改日期
+    ZipEntry         m_CurEntry;      //<! 当前条目
+    QList<ZipEntry>  m_Entries;       //<! 已写入的条目
+};
+
+#endif // ZIPSTREAMWRITER_H
@@ -160,6 +160,14 @@ void DeviceListView::clearItem()
     mp_ItemModel->clear();
 }
 
+void DeviceListView::setItemFilter(const QStringList &names)
+{
+    for (int row = 0; row < mp_ItemModel->rowCount(); ++row) {
+        QString text = mp_ItemModel->item(row)->data(Qt::DisplayRole).toString();
+        setRowHidden(row, !names.isEmpty() && !names.contains(text));
+    }
+}
+
 void DeviceListView::paintEvent(QPaintEvent *event)
 {
     // 让背景色适合主题颜色
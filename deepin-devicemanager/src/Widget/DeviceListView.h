@@ -75,6 +75,12 @@ public:
      */
     void clearItem();
 
+    /**
+     * @brief setItemFilter : 只显示指定的item,过滤时隐藏分隔线
+     * @param names : 显示的item文本,为空时显示全部
+     */
+    void setItemFilter(const QStringList &names);
+
 protected:
     /**@brief:事件重写*/
     void paintEvent(QPaintEvent *event) override;
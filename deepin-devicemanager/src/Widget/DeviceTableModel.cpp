@@ -0,0 +1,198 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 项目自身文件
+#include "DeviceTableModel.h"
+#include "DeviceInfo.h"
+#include "DeviceInput.h"
+#include "DeviceNetwork.h"
+
+DeviceTableModel::DeviceTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_CanEnable(false)
+{
+
+}
+
+void DeviceTableModel::setDevices(const QList<DeviceBaseInfo *> &lst)
+{
+    if (lst.isEmpty() || !lst.first()) {
+        clear();
+        return;
+    }
+
+    // 表头最后一项为是否可禁用的标记
+    QStringList header = lst.first()->getTableHeader();
+    bool canEnable = !header.isEmpty() && header.last() == "yes";
+    if (!header.isEmpty())
+        header.removeLast();
+
+    // 表头变化时(切换了设备类型)重置模型
+    if (header != m_Header) {
+        beginResetModel();
+        m_Devices = lst;
+        m_Header = header;
+        m_CanEnable = canEnable;
+        m_Rows = QVector<RowData>(lst.size());
+        endResetModel();
+        return;
+    }
+
+    // 同类设备只增删末尾的行,已有行逐行比较
+    m_CanEnable = canEnable;
+    const int oldCount = m_Devices.size();
+    const int newCount = lst.size();
+    if (newCount < oldCount) {
+        beginRemoveRows(QModelIndex(), newCount, oldCount - 1);
+        m_Devices = lst;
+        m_Rows.resize(newCount);
+        endRemoveRows();
+    } else if (newCount > oldCount) {
+        beginInsertRows(QModelIndex(), oldCount, newCount - 1);
+        m_Devices = lst;
+        m_Rows.resize(newCount);
+        endInsertRows();
+    } else {
+        m_Devices = lst;
+    }
+
+    updateLoadedRows();
+}
+
+void DeviceTableModel::releaseDevices()
+{
+    for (int i = 0; i < m_Devices.size(); ++i)
+        m_Devices[i] = nullptr;
+}
+
+void DeviceTableModel::refreshRow(int row)
+{
+    if (row < 0 || row >= m_Rows.size())
+        return;
+
+    // 设备状态变化后表格数据的缓存需要重新生成
+    DeviceBaseInfo *info = m_Devices[row];
+    if (info)
+        info->invalidateAttribs();
+    m_Rows[row] = loadRow(info);
+    emit dataChanged(index(row, 0), index(row, columnCount() - 1));
+}
+
+void DeviceTableModel::clear()
+{
+    beginResetModel();
+    m_Devices.clear();
+    m_Header.clear();
+    m_CanEnable = false;
+    m_Rows.clear();
+    endResetModel();
+}
+
+DeviceBaseInfo *DeviceTableModel::device(int row) const
+{
+    return m_Devices.value(row, nullptr);
+}
+
+bool DeviceTableModel::canEnable() const
+{
+    return m_CanEnable;
+}
+
+int DeviceTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_Rows.size();
+}
+
+int DeviceTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_Header.size();
+}
+
+QVariant DeviceTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_Rows.size() || index.column() >= m_Header.size())
+        return QVariant();
+
+    const RowData &rowData = materialize(index.row());
+    if (role == Qt::DisplayRole)
+        return rowData.cells.value(index.column());
+
+    // 右键菜单控制信息只放在第0列,没有的信息返回无效值
+    int menuIndex = role - Qt::UserRole;
+    if (index.column() == 0 && menuIndex >= 0 && menuIndex < rowData.menuControl.size())
+        return rowData.menuControl[menuIndex];
+
+    return QVariant();
+}
+
+QVariant DeviceTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole && section >= 0 && section < m_Header.size())
+        return m_Header[section];
+
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+Qt::ItemFlags DeviceTableModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return Qt::NoItemFlags;
+
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+}
+
+DeviceTableModel::RowData DeviceTableModel::loadRow(DeviceBaseInfo *device)
+{
+    RowData rowData;
+    rowData.loaded = true;
+    if (!device)
+        return rowData;
+
+    rowData.cells = device->getTableData();
+
+    rowData.menuControl.append(device->canUninstall() ? "true" : "false");
+    rowData.menuControl.append(device->canEnable() ? "true" : "false");
+    DeviceInput *input = dynamic_cast<DeviceInput *>(device);
+    if (input) {
+        rowData.menuControl.append(input->canWakeupMachine() ? "true" : "false");
+        rowData.menuControl.append(input->wakeupPath());
+    }
+
+    DeviceNetwork *network = dynamic_cast<DeviceNetwork *>(device);
+    if (network)
+        rowData.menuControl.append(network->logicalName());
+
+    return rowData;
+}
+
+const DeviceTableModel::RowData &DeviceTableModel::materialize(int row) const
+{
+    RowData &rowData = m_Rows[row];
+    if (!rowData.loaded)
+        rowData = loadRow(m_Devices.value(row, nullptr));
+    return rowData;
+}
+
+void DeviceTableModel::updateLoadedRows()
+{
+    // 未读取的行在视图访问时才读取,不需要通知
+    const int lastColumn = columnCount() - 1;
+    int first = -1;
+    for (int row = 0; row <= m_Rows.size(); ++row) {
+        bool changed = false;
+        if (row < m_Rows.size() && m_Rows[row].loaded && m_Devices[row]) {
+            RowData rowData = loadRow(m_Devices[row]);
+            changed = rowData.cells != m_Rows[row].cells || rowData.menuControl != m_Rows[row].menuControl;
+            if (changed)
+                m_Rows[row] = rowData;
+        }
+
+        if (changed && first < 0) {
+            first = row;
+        } else if (!changed && first >= 0) {
+            emit dataChanged(index(first, 0), index(row - 1, lastColumn));
+            first = -1;
+        }
+    }
+}
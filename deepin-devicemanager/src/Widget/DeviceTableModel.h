@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DEVICETABLEMODEL_H
+#define DEVICETABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QStringList>
+#include <QVector>
+#include <QList>
+
+class DeviceBaseInfo;
+
+/**
+ * @brief The DeviceTableModel class
+ * 多设备页面上方表格的模型,直接读取设备对象
+ * 某行第一次被视图访问时才读取设备的表格数据;再次设置设备列表时只对内容变化的行发出 dataChanged
+ * 第0列的 Qt::UserRole + n 为右键菜单控制信息:是否可卸载驱动、是否可禁用、唤醒信息
+ */
+class DeviceTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    explicit DeviceTableModel(QObject *parent = nullptr);
+
+    /**
+     * @brief setDevices:设置设备列表,表头不变时增量更新
+     * @param lst:设备列表
+     */
+    void setDevices(const QList<DeviceBaseInfo *> &lst);
+
+    /**
+     * @brief releaseDevices:不再访问设备对象,已读取的内容保留显示,用于设备对象被释放前
+     */
+    void releaseDevices();
+
+    /**
+     * @brief refreshRow:重新读取某行设备的表格数据
+     * @param row:行号
+     */
+    void refreshRow(int row);
+
+    /**
+     * @brief updateLoadedRows:重新读取已读取的行,对变化的连续行合并发出 dataChanged
+     */
+    void updateLoadedRows();
+
+    /**
+     * @brief clear:清空表格
+     */
+    void clear();
+
+    /**
+     * @brief device:获取某行的设备
+     * @param row:行号
+     * @return 设备,已释放或越界时为空
+     */
+    DeviceBaseInfo *device(int row) const;
+
+    /**
+     * @brief canEnable:该类设备是否可以禁用
+     */
+    bool canEnable() const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+private:
+    struct RowData {
+        RowData() : loaded(false) {}
+        bool            loaded;         //<! 是否已读取
+        QStringList     cells;          //<! 表格数据
+        QStringList     menuControl;    //<! 右键菜单控制信息
+    };
+
+    /**
+     * @brief loadRow:读取某行设备的表格数据
+     * @return 行数据,设备已释放时返回空行
+     */
+    static RowData loadRow(DeviceBaseInfo *device);
+
+    /**
+     * @brief materialize:按需读取某行
+     */
+    const RowData &materialize(int row) const;
+
+private:
+    QList<DeviceBaseInfo *>     m_Devices;      //<! 设备列表
+    QStringList                 m_Header;       //<! 表头,不含是否可禁用标记
+    bool                        m_CanEnable;    //<! 是否可以禁用
+    mutable QVector<RowData>    m_Rows;         //<! 行缓存
+};
+
+#endif // DEVICETABLEMODEL_H
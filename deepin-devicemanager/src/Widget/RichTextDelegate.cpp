@@ -18,6 +18,8 @@
 #include <QLoggingCategory>
 #include <DFontSizeManager>
 #include <QPainterPath>
+#include <QGuiApplication>
+#include <QAbstractItemModel>
 
 // 其它头文件
 #include "DetailTreeView.h"
@@ -26,6 +28,8 @@ DWIDGET_USE_NAMESPACE
 
 RichTextDelegate::RichTextDelegate(QObject *parent)
     : QStyledItemDelegate(parent)
+    , m_LayoutCache(1000)
+    , mp_Model(nullptr)
 {
 
 }
@@ -214,19 +218,13 @@ void RichTextDelegate::paint(QPainter *painter, const QStyleOptionViewItem &opti
     painter->fillPath(path, background);
 
     QStringList lstStr = opt.text.split("\n");
+    //设置文本左边空6px的位置。1. 文本长度减6
+    QTextDocument *textDoc = textDocument(index, opt.text, option.rect.width() - 6);
     if (lstStr.size() > 1) {
-        QTextDocument  textDoc;
-        //设置文字居中显示
-        textDoc.setTextWidth(option.rect.width() - 6);//设置文本左边空6px的位置。1. 文本长度减6
-        //设置文本内容
-        QDomDocument doc;
-        getDocFromLst(doc, lstStr);
-        textDoc.setHtml(doc.toString());
-
         // bug111063中 社区版与专业版使用同一代码，主板界面展示效果不同
         // PageBoardInfo 中计算行高方式与html中计算行高方式不同，导致每行下方出现截断或空白
         // 此处获取html整体高度后再对PageBoardInfo设置行高，则不会再出现截断或空白
-        dynamic_cast<PageSingleInfo *>(this->parent())->setRowHeight(index.row(), textDoc.size().toSize().height() + 6);
+        dynamic_cast<PageSingleInfo *>(this->parent())->setRowHeight(index.row(), textDoc->size().toSize().height() + 6);
 
         QAbstractTextDocumentLayout::PaintContext   paintContext;
         paintContext.palette.setCurrentColorGroup(cg);
@@ -237,24 +235,9 @@ void RichTextDelegate::paint(QPainter *painter, const QStyleOptionViewItem &opti
         painter->save();
         painter->translate(point);
         painter->setClipRect(textRect.translated(-point));
-        textDoc.documentLayout()->draw(painter, paintContext);
+        textDoc->documentLayout()->draw(painter, paintContext);
         painter->restore();
     } else {
-        QTextDocument  textDoc;
-        //设置文字居中显示
-        textDoc.setTextWidth(option.rect.width() - 6);//设置文本左边空6px的位置。1. 文本长度减6
-        //设置文本内容
-        QDomDocument doc;
-        QDomElement p = doc.createElement("p");
-        p.setAttribute("width", "100%");
-        p.setAttribute("border", "0");
-        p.setAttribute("style", "text-align:left;");
-        p.setAttribute("style", "font-weight:504;");
-        QDomText nameText = doc.createTextNode(opt.text);
-        p.appendChild(nameText);
-        doc.appendChild(p);
-        textDoc.setHtml(doc.toString());
-
         QAbstractTextDocumentLayout::PaintContext   paintContext;
         paintContext.palette.setCurrentColorGroup(cg);
         QRect  textRect = style->subElementRect(QStyle::SE_ItemViewItemText,  &opt);
@@ -264,7 +247,7 @@ void RichTextDelegate::paint(QPainter *painter, const QStyleOptionViewItem &opti
         painter->save();
         painter->translate(point);
         painter->setClipRect(textRect.translated(-point));
-        textDoc.documentLayout()->draw(painter, paintContext);
+        textDoc->documentLayout()->draw(painter, paintContext);
         painter->restore();
     }
 
@@ -306,6 +289,81 @@ void RichTextDelegate::initStyleOption(QStyleOptionViewItem *option, const QMode
         option->text = index.data().toString();
 }
 
+void RichTextDelegate::clearCache() const
+{
+    m_LayoutCache.clear();
+}
+
+QTextDocument *RichTextDelegate::textDocument(const QModelIndex &index, const QString &text, int width) const
+{
+    watchModel(index.model());
+
+    // 文本、宽度、字体都未变化时复用已排版的文档
+    QFont font = QGuiApplication::font();
+    int fontSize = DFontSizeManager::instance()->t8().pixelSize();
+    QPair<int, int> key(index.row(), index.column());
+    TextLayout *layout = m_LayoutCache.object(key);
+    if (layout && layout->text == text && layout->width == width
+            && layout->fontSize == fontSize && layout->font == font)
+        return &layout->doc;
+
+    layout = new TextLayout;
+    layout->text = text;
+    layout->width = width;
+    layout->font = font;
+    layout->fontSize = fontSize;
+    layout->doc.setDefaultFont(font);
+    layout->doc.setTextWidth(width);
+
+    //设置文本内容
+    QDomDocument doc;
+    QStringList lstStr = text.split("\n");
+    if (lstStr.size() > 1) {
+        getDocFromLst(doc, lstStr);
+    } else {
+        QDomElement p = doc.createElement("p");
+        p.setAttribute("width", "100%");
+        p.setAttribute("border", "0");
+        p.setAttribute("style", "text-align:left;");
+        p.setAttribute("style", "font-weight:504;");
+        QDomText nameText = doc.createTextNode(text);
+        p.appendChild(nameText);
+        doc.appendChild(p);
+    }
+    layout->doc.setHtml(doc.toString());
+
+    m_LayoutCache.insert(key, layout);
+    return &layout->doc;
+}
+
+void RichTextDelegate::watchModel(const QAbstractItemModel *model) const
+{
+    if (model == mp_Model)
+        return;
+
+    // 切换模型时缓存的行列已无意义
+    if (mp_Model)
+        disconnect(mp_Model, nullptr, this, nullptr);
+    clearCache();
+    mp_Model = model;
+    if (!mp_Model)
+        return;
+
+    auto onChanged = [this]() { clearCache(); };
+    connect(mp_Model, &QAbstractItemModel::dataChanged, this, onChanged);
+    connect(mp_Model, &QAbstractItemModel::modelReset, this, onChanged);
+    connect(mp_Model, &QAbstractItemModel::layoutChanged, this, onChanged);
+    connect(mp_Model, &QAbstractItemModel::rowsInserted, this, onChanged);
+    connect(mp_Model, &QAbstractItemModel::rowsRemoved, this, onChanged);
+    connect(mp_Model, &QAbstractItemModel::rowsMoved, this, onChanged);
+    connect(mp_Model, &QAbstractItemModel::columnsInserted, this, onChanged);
+    connect(mp_Model, &QAbstractItemModel::columnsRemoved, this, onChanged);
+    connect(mp_Model, &QObject::destroyed, this, [this]() {
+        mp_Model = nullptr;
+        clearCache();
+    });
+}
+
 void RichTextDelegate::getDocFromLst(QDomDocument &doc, const QStringList &lst)const
 {
     QDomElement table = doc.createElement("table");
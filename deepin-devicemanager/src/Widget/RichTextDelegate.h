@@ -9,10 +9,17 @@
 #include <QObject>
 #include <QStyledItemDelegate>
 #include <QDomDocument>
+#include <QTextDocument>
+#include <QCache>
+#include <QPair>
+#include <QFont>
+
+class QAbstractItemModel;
 
 /**
  * @brief The RichTextDelegate class
  * 封装富文本标签
+ * 排版好的 QTextDocument 按单元格缓存,文本、宽度、字体不变时直接绘制;模型变化时清空缓存
  */
 class RichTextDelegate : public QStyledItemDelegate
 {
@@ -20,6 +27,11 @@ class RichTextDelegate : public QStyledItemDelegate
 public:
     explicit RichTextDelegate(QObject *parent);
 
+    /**
+     * @brief clearCache:清空排版缓存
+     */
+    void clearCache() const;
+
 protected:
     void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
     QWidget *createEditor(QWidget *, const QStyleOptionViewItem &, const QModelIndex &) const override;
@@ -27,10 +39,36 @@ protected:
     void initStyleOption(QStyleOptionViewItem *option, const QModelIndex &index) const override;
 
 private:
+    struct TextLayout {
+        QString         text;       //<! 单元格文本
+        int             width;      //<! 排版宽度
+        QFont           font;       //<! 排版时的应用字体
+        int             fontSize;   //<! 排版时的t8字号
+        QTextDocument   doc;        //<! 排版好的文档
+    };
+
+    /**
+     * @brief textDocument:获取单元格排版好的文档,缓存失效时重新生成
+     * @param index:单元格
+     * @param text:单元格文本,多行时以表格显示
+     * @param width:排版宽度
+     * @return 文档,下次调用前有效
+     */
+    QTextDocument *textDocument(const QModelIndex &index, const QString &text, int width) const;
+
+    /**
+     * @brief watchModel:关注模型变化,切换模型时清空缓存
+     */
+    void watchModel(const QAbstractItemModel *model) const;
+
     void getDocFromLst(QDomDocument &doc, const QStringList &lst)const;
     void addRow(QDomDocument &doc, QDomElement &table, const QPair<QString, QString> &pair,const int &rowWidth)const;
     void addTd1(QDomDocument &doc, QDomElement &tr, const QString &value,const int &rowWidth)const;
     void addTd2(QDomDocument &doc, QDomElement &tr, const QString &value)const;
+
+private:
+    mutable QCache<QPair<int, int>, TextLayout>    m_LayoutCache;  //<! 排版缓存,键为(行,列)
+    mutable const QAbstractItemModel               *mp_Model;      //<! 当前关注的模型
 };
 
 #endif // RICHTEXTDELEGATE_H
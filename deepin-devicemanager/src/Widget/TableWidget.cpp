@@ -8,6 +8,7 @@
 #include "MacroDefinition.h"
 #include "logviewitemdelegate.h"
 #include "logtreeview.h"
+#include "DeviceTableModel.h"
 #include "DBusWakeupInterface.h"
 
 // Dtk头文件
@@ -91,26 +92,25 @@ TableWidget::~TableWidget()
     }
 }
 
-void TableWidget::setHeaderLabels(const QStringList &lst)
+void TableWidget::setDevices(const QList<DeviceBaseInfo *> &lst)
 {
-    QStringList headers;
-    for (int i = 0; i < lst.size(); i++) {
-        if (i < lst.size() - 1) {
-            headers.append(lst[i]);
-        } else {
-            m_Enable = lst[i] == "yes" ? true : false;
-        }
+    if (mp_Table) {
+        mp_Table->setDevices(lst);
+        m_Enable = mp_Table->deviceModel()->canEnable();
     }
+}
 
+void TableWidget::releaseDevices()
+{
     if (mp_Table) {
-        mp_Table->setHeaderLabels(headers);
+        mp_Table->releaseDevices();
     }
 }
 
-void TableWidget::setItem(int row, int column, DStandardItem *item)
+void TableWidget::updateLoadedRows()
 {
     if (mp_Table) {
-        mp_Table->setItem(row, column, item);
+        mp_Table->updateLoadedRows();
     }
 }
 
@@ -243,10 +243,10 @@ void TableWidget::slotShowMenu(const QPoint &point)
     // 主板、内存、cpu等没有驱动，无需右键按钮
     // 选中item状态下才有卸载、更新按钮
     bool canUninstall = true , canEnable = true;
-    QStandardItem* item = mp_Table->item(row,0);
-    if(item){ // 获取该设备是否可以更新卸载驱动
-        canUninstall = item->data(Qt::UserRole).toString()=="true" ? true : false;
-        canEnable = item->data(Qt::UserRole+1).toString()=="true" ? true : false;
+    QModelIndex item = mp_Table->model()->index(row, 0);
+    if(item.isValid()){ // 获取该设备是否可以更新卸载驱动
+        canUninstall = item.data(Qt::UserRole).toString()=="true" ? true : false;
+        canEnable = item.data(Qt::UserRole+1).toString()=="true" ? true : false;
     }
     if(!canEnable){
         mp_Enable->setEnabled(false);
@@ -257,7 +257,7 @@ void TableWidget::slotShowMenu(const QPoint &point)
         mp_Menu->addAction(mp_removeDriver);
     }
 
-    QVariant canWakeup = item->data(Qt::UserRole+2);
+    QVariant canWakeup = item.data(Qt::UserRole+2);
     if(canWakeup.isValid()){
         mp_Menu->addSeparator();
 
@@ -276,7 +276,7 @@ void TableWidget::slotShowMenu(const QPoint &point)
         }else{ // 简述右键菜单处理
             bool canWakeupBool = str == "true" ? true : false;
             if(canWakeupBool){
-                QString wakeupPath = item->data(Qt::UserRole+3).toString();
+                QString wakeupPath = item.data(Qt::UserRole+3).toString();
                 QFile file(wakeupPath);
                 bool isWakeup = false;
                 if(file.open(QIODevice::ReadOnly)){
@@ -7,14 +7,13 @@
 #define HEADERTABLEVIEW_H
 
 #include <DTableView>
-#include <DStandardItem>
 #include <DHeaderView>
 
-#include <QStandardItemModel>
 #include <QObject>
 #include <QHBoxLayout>
 
 class LogTreeView;
+class DeviceBaseInfo;
 
 using namespace Dtk::Widget;
 
@@ -30,18 +29,20 @@ public:
     ~TableWidget() override;
 
     /**
-     * @brief setHeaderLabels : 设置table的表头
-     * @param lst ：表头的内容
+     * @brief setDevices : 设置表格中的设备,表头取自第一个设备
+     * @param lst ：设备列表
      */
-    void setHeaderLabels(const QStringList &lst);
+    void setDevices(const QList<DeviceBaseInfo *> &lst);
 
     /**
-     * @brief setItem : 设置表格的item
-     * @param row : item设置到哪一行
-     * @param column : item设置到哪一列
-     * @param item ：需要设置的item
+     * @brief releaseDevices : 设备对象释放前调用,表格保留已显示的内容
      */
-    void setItem(int row, int column, DStandardItem *item);
+    void releaseDevices();
+
+    /**
+     * @brief updateLoadedRows : 设备属性变化后只更新已显示的行
+     */
+    void updateLoadedRows();
 
     /**
      * @brief setColumnAverage
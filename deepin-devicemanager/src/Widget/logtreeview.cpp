@@ -19,6 +19,7 @@
 
 #include "MacroDefinition.h"
 #include "TableWidget.h"
+#include "DeviceTableModel.h"
 
 DWIDGET_USE_NAMESPACE
 
@@ -32,26 +33,30 @@ LogTreeView::LogTreeView(QWidget *parent)
     initUI();
 }
 
-void LogTreeView::setHeaderLabels(const QStringList &lst)
+void LogTreeView::setDevices(const QList<DeviceBaseInfo *> &lst)
 {
     if (mp_Model) {
-        mp_Model->setHorizontalHeaderLabels(lst);
+        mp_Model->setDevices(lst);
     }
 }
 
-void LogTreeView::setItem(int row, int column, QStandardItem *item)
+void LogTreeView::releaseDevices()
 {
     if (mp_Model) {
-        mp_Model->setItem(row, column, item);
+        mp_Model->releaseDevices();
     }
 }
 
-QStandardItem *LogTreeView::item(int row, int column)
+void LogTreeView::updateLoadedRows()
 {
-    if(mp_Model && mp_Model->rowCount() > row && mp_Model->columnCount() > column){
-        return mp_Model->item(row,column);
+    if (mp_Model) {
+        mp_Model->updateLoadedRows();
     }
-    return nullptr;
+}
+
+DeviceTableModel *LogTreeView::deviceModel() const
+{
+    return mp_Model;
 }
 
 void LogTreeView::setColumnAverage()
@@ -77,12 +82,9 @@ bool LogTreeView::currentRowEnable()
     if (row < 0) {
         return false;
     }
-    QStandardItem *item = mp_Model->item(row, 0);
-    if (item) {
-        QString str = item->text();
-        if (str.startsWith("(" + tr("Disable") + ")")) {
-            return false;
-        }
+    QString str = index.sibling(row, 0).data().toString();
+    if (str.startsWith("(" + tr("Disable") + ")")) {
+        return false;
     }
     return true;
 }
@@ -90,18 +92,15 @@ bool LogTreeView::currentRowEnable()
 bool LogTreeView::currentRowAvailable()
 {
     QModelIndex index = currentIndex();
-     int row = index.row();
-     if (row < 0) {
-         return false;
-     }
-     QStandardItem *item = mp_Model->item(row, 0);
-     if (item) {
-         QString str = item->text();
-         if (str.startsWith("(" + tr("Unavailable") + ")")) {
-             return false;
-         }
-     }
-     return true;
+    int row = index.row();
+    if (row < 0) {
+        return false;
+    }
+    QString str = index.sibling(row, 0).data().toString();
+    if (str.startsWith("(" + tr("Unavailable") + ")")) {
+        return false;
+    }
+    return true;
 }
 
 int LogTreeView::currentRow()
@@ -112,17 +111,10 @@ int LogTreeView::currentRow()
 
 void LogTreeView::updateCurItemEnable(int row, int enable)
 {
-    QStandardItem *item = mp_Model->item(row, 0);
-    if (item) {
-        QString str = item->text();
-        if (enable) {
-            str.replace("(" + tr("Disable") + ")", "");
-        } else {
-            str = "(" + tr("Disable") + ")" + str;
-        }
-
-        item->setText(str);
-    }
+    Q_UNUSED(enable)
+    // 禁用标记由设备的表格数据生成,重新读取该行即可
+    if (mp_Model)
+        mp_Model->refreshRow(row);
 }
 
 void LogTreeView::clear()
@@ -147,8 +139,8 @@ int LogTreeView::RowNum() const
 
 void LogTreeView::initUI()
 {
-    // 模型
-    mp_Model = new QStandardItemModel(this);
+    // 模型,直接读取设备对象
+    mp_Model = new DeviceTableModel(this);
     setModel(mp_Model);
 
     // Item 代理
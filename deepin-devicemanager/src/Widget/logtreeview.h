@@ -8,10 +8,12 @@
 
 #include <DTreeView>
 #include <QKeyEvent>
-#include <QStandardItem>
 #include "logviewheaderview.h"
 #include "logviewitemdelegate.h"
 
+class DeviceBaseInfo;
+class DeviceTableModel;
+
 class LogTreeView : public Dtk::Widget::DTreeView
 {
     Q_OBJECT
@@ -19,26 +21,26 @@ public:
     explicit LogTreeView(QWidget *parent = nullptr);
 
     /**
-     * @brief setHeaderLabels : 设置table的表头
-     * @param lst ：表头的内容
+     * @brief setDevices : 设置表格中的设备,同类设备增量更新
+     * @param lst : 设备列表
      */
-    void setHeaderLabels(const QStringList &lst);
+    void setDevices(const QList<DeviceBaseInfo *> &lst);
 
     /**
-     * @brief setItem : 设置表格的item
-     * @param row : item设置到哪一行
-     * @param column : item设置到哪一列
-     * @param item ：需要设置的item
+     * @brief releaseDevices : 设备对象释放前调用,表格保留已显示的内容
      */
-    void setItem(int row, int column, QStandardItem *item);
+    void releaseDevices();
 
     /**
-     * @brief item 获取表格的item
-     * @param row 哪一行
-     * @param column 哪一列
-     * @return
+     * @brief updateLoadedRows : 设备属性变化后只更新已显示的行
+     */
+    void updateLoadedRows();
+
+    /**
+     * @brief deviceModel : 获取表格模型
+     * @return 表格模型
      */
-    QStandardItem *item(int row, int column);
+    DeviceTableModel *deviceModel() const;
 
     /**
      * @brief setColumnAverage : 设置表头等宽
@@ -64,7 +66,7 @@ public:
     int currentRow();
 
     /**
-     * @brief updateCurItemEnable : 判断当前行是否是被禁用状态
+     * @brief updateCurItemEnable : 设备启用/禁用后重新读取该行
      * @param row
      * @param enable
      */
@@ -101,7 +103,7 @@ protected:
 private:
     int           m_RowCount;          // 表格行数
 
-    QStandardItemModel         *mp_Model;
+    DeviceTableModel           *mp_Model;
     LogViewItemDelegate        *mp_ItemDelegate;
     LogViewHeaderView          *mp_HeaderView;
 
@@ -15,6 +15,10 @@
 #include <QFile>
 #include <QLoggingCategory>
 #include <QRegularExpression>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSettings>
+#include <QStandardPaths>
 
 #include <sys/utsname.h>
 
@@ -29,17 +33,95 @@ static QMap<QString, QString> mapArch = {   {"aarch64", "arm64"}
     , {"loongarch64", "loongarch64"}
 };
 
-static bool initBoardVendorFlag = false;
 static QString boardVendorKey = "";
+static bool boardVendorProbed = false;     // 本次探测是否真正读取到了机型信息,未读取到时不持久化
 int Common::specialComType = -1;
 
-QString Common::getArch()
+// 平台特征信息缓存文件版本,探测逻辑变化时需要递增
+#define PLATFORM_PROFILE_VERSION 2
+
+static QMutex profileMutex;
+static PlatformProfile platformProfileCache = {QString(), QString(), -1};
+static bool platformProfileReady = false;
+
+static QString platformProfilePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+           + "/deepin/deepin-devicemanager/platform_profile.conf";
+}
+
+static QString machineId()
 {
-    QString arch;
-    struct utsname utsbuf;
-    if (-1 != uname(&utsbuf)) {
-        arch = QString::fromLocal8Bit(utsbuf.machine);
+    QFile file("/etc/machine-id");
+    if (!file.open(QIODevice::ReadOnly))
+        return QString();
+    QString id = QString::fromLatin1(file.readAll()).trimmed();
+    file.close();
+    return id;
+}
+
+static QString dmiIdentity()
+{
+    // 更换主板或升级固件后 machine-id 不变,需要同时比对 DMI 信息;这些文件普通用户可读
+    QStringList values;
+    const QStringList names = {"board_vendor", "board_name", "product_name", "bios_version"};
+    foreach (const QString &name, names) {
+        QFile file("/sys/class/dmi/id/" + name);
+        if (file.open(QIODevice::ReadOnly)) {
+            values.append(QString::fromLatin1(file.readAll()).trimmed());
+            file.close();
+        } else {
+            values.append(QString());
+        }
     }
+    return values.join("|");
+}
+
+static bool loadPlatformProfile(PlatformProfile &profile)
+{
+    const QString id = machineId();
+    if (id.isEmpty() || !QFile::exists(platformProfilePath()))
+        return false;
+
+    // 机器、主板固件、架构、特殊机型配置任一变化则缓存失效,重新探测
+    QSettings settings(platformProfilePath(), QSettings::IniFormat);
+    if (settings.value("Version").toInt() != PLATFORM_PROFILE_VERSION
+            || settings.value("MachineId").toString() != id
+            || settings.value("DmiIdentity").toString() != dmiIdentity()
+            || settings.value("Arch").toString() != profile.arch
+            || settings.value("SpecialComType", -1).toInt() != profile.specialComType
+            || !settings.contains("BoardVendorKey"))
+        return false;
+
+    profile.boardVendorKey = settings.value("BoardVendorKey").toString();
+    return true;
+}
+
+static void savePlatformProfile(const PlatformProfile &profile)
+{
+    const QString id = machineId();
+    if (id.isEmpty())
+        return;
+
+    QSettings settings(platformProfilePath(), QSettings::IniFormat);
+    settings.setValue("Version", PLATFORM_PROFILE_VERSION);
+    settings.setValue("MachineId", id);
+    settings.setValue("DmiIdentity", dmiIdentity());
+    settings.setValue("Arch", profile.arch);
+    settings.setValue("SpecialComType", profile.specialComType);
+    settings.setValue("BoardVendorKey", profile.boardVendorKey);
+    settings.sync();
+}
+
+QString Common::getArch()
+{
+    // 架构在进程生命周期内不会变化,只调用一次 uname
+    static const QString arch = []() -> QString {
+        struct utsname utsbuf;
+        if (-1 != uname(&utsbuf))
+            return QString::fromLocal8Bit(utsbuf.machine);
+        return QString();
+    }();
     return arch;
 }
 
@@ -117,6 +199,7 @@ static QString readDmidecode11_String4(void)
 
 QString Common::checkBoardVendorFlag()
 {
+    boardVendorProbed = false;
     if(specialComType != -1){
         switch (specialComType) {
         case NormalCom:
@@ -149,6 +232,7 @@ QString Common::checkBoardVendorFlag()
         if (info.isEmpty()) {
             getDeviceInfo(info, "dmidecode_spn.txt");
         }
+        boardVendorProbed = !info.isEmpty();
         if (info.contains("KLVV", Qt::CaseInsensitive) || info.contains("L540", Qt::CaseInsensitive)) {
             boardVendorKey = "KLVV";
         } else if (info.contains("KLVU", Qt::CaseInsensitive)) {
@@ -168,13 +252,43 @@ QString Common::checkBoardVendorFlag()
         qCInfo(appLog) << "boardVendorKey:" <<  boardVendorKey;
     }
     qCInfo(appLog) << "Current special computer type is " << boardVendorKey;
-    initBoardVendorFlag = true;
     return boardVendorKey;
 }
 
 QString Common::boardVendorType()
 {
-    return initBoardVendorFlag ? boardVendorKey : checkBoardVendorFlag();
+    return platformProfile().boardVendorKey;
+}
+
+const PlatformProfile &Common::platformProfile()
+{
+    initPlatformProfile();
+    return platformProfileCache;
+}
+
+void Common::initPlatformProfile()
+{
+    QMutexLocker locker(&profileMutex);
+    if (platformProfileReady)
+        return;
+
+    PlatformProfile profile;
+    profile.arch = getArch();
+    profile.specialComType = specialComType;
+
+    // 配置了特殊机型时直接映射,无需探测;否则优先使用本机持久化的探测结果
+    if (specialComType != -1) {
+        profile.boardVendorKey = checkBoardVendorFlag();
+    } else if (loadPlatformProfile(profile)) {
+        qCInfo(appLog) << "Load platform profile from cache, board vendor type is " << profile.boardVendorKey;
+    } else {
+        profile.boardVendorKey = checkBoardVendorFlag();
+        if (boardVendorProbed)
+            savePlatformProfile(profile);
+    }
+
+    platformProfileCache = profile;
+    platformProfileReady = true;
 }
 
 QByteArray Common::executeClientCmd(const QString &cmd, const QStringList &args, const QString &workPath, int msecsWaiting/* = 30000*/, bool useEnv/* = true*/)
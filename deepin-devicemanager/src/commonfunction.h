@@ -10,6 +10,16 @@
 #include <QString>
 #include <QStringList>
 
+/**
+ * @brief The PlatformProfile struct
+ * 平台特征信息(架构、主板厂商类型、特殊机型),启动时探测一次并按机器持久化
+ */
+struct PlatformProfile {
+    QString arch;           //<! uname 获取的系统架构
+    QString boardVendorKey; //<! 主板厂商类型 KLVV/KLVU/PGUV/PGUW/PGUX,普通机型为空
+    int specialComType;     //<! 特殊机型配置值,-1 表示未配置
+};
+
 class Common
 {
 public:
@@ -32,6 +42,17 @@ public:
 
     static QString boardVendorType();
 
+    /**
+     * @brief platformProfile 获取平台特征信息,首次调用时从缓存加载或探测
+     * @return 平台特征信息
+     */
+    static const PlatformProfile &platformProfile();
+
+    /**
+     * @brief initPlatformProfile 启动时初始化平台特征信息,须在 specialComType 设置之后调用
+     */
+    static void initPlatformProfile();
+
     /**
      * @brief specialComType
      * special computer type:PGUW(value:1),KLVV/L540(value:2),KLVU(value:3),PGUV/W585(value:4)
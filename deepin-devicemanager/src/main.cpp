@@ -12,6 +12,8 @@
 #include "environments.h"
 #include "DebugTimeManager.h"
 #include "SingleDeviceManager.h"
+#include "DeviceDumper.h"
+#include "SourceTextTranslator.h"
 #include "DDLog.h"
 #include <DApplication>
 #include <DWidgetUtil>
@@ -60,6 +62,11 @@ int main(int argc, char *argv[])
         notify(argc, argv);
         return -1;
     }
+
+    // /usr/bin/deepin-devicemanager --dump json|txt [--type cpu,disk]
+    if (DeviceDumper::isDumpCmd(argc, argv))
+        return DeviceDumper::exec(argc, argv);
+
     #if (DTK_VERSION >= DTK_VERSION_CHECK(5, 6, 8, 0))
         Dtk::Core::DLogManager::registerJournalAppender();
     #else
@@ -74,9 +81,11 @@ int main(int argc, char *argv[])
     }
 
     PERF_PRINT_BEGIN("POINT-01", "");
+    STARTUP_TRACE("main");
 
     QGuiApplication::setAttribute(Qt::AA_UseHighDpiPixmaps);
     SingleDeviceManager app(argc, argv);
+    STARTUP_TRACE("application created");
     app.setAutoActivateWindows(true);
 
     // 保证进程唯一性
@@ -84,6 +93,8 @@ int main(int argc, char *argv[])
     /*if (DGuiApplicationHelper::instance()->setSingleInstance("deepin-devicemanager",
                                                              DGuiApplicationHelper::UserScope))*/ {
         app.loadTranslator();
+        // 导出 json/cbor 时属性名使用原文,需在其它翻译之后安装
+        app.installTranslator(new SourceTextTranslator(&app));
         app.setOrganizationName("deepin");
         app.setApplicationName("deepin-devicemanager");
         app.setApplicationDisplayName(QObject::tr("Device Manager"));
@@ -101,6 +112,7 @@ int main(int argc, char *argv[])
                                                                                 Authority::AllowUserInteraction);
         if (result != Authority::Yes)
             return 0;
+        STARTUP_TRACE("authorization checked");
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
         DApplicationSettings settinAgs;
 #endif
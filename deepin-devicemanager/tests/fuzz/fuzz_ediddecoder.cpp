@@ -0,0 +1,26 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "EdidDecoder.h"
+
+#include <QByteArray>
+
+#include <stdint.h>
+#include <stddef.h>
+
+// libFuzzer 入口:任意字节作为edid解码,解码过程中不能越界访问
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    const QByteArray edid = QByteArray::fromRawData(reinterpret_cast<const char *>(data), int(size));
+
+    EdidDecoder decoder;
+    QString errorMsg;
+    if (decoder.decode(edid, errorMsg)) {
+        decoder.version();
+        decoder.tile();
+        decoder.hdr();
+        decoder.rangeLimits();
+    }
+    return 0;
+}
@@ -5,6 +5,7 @@
 
 #include "DeviceInfo.h"
 #include "DeviceAudio.h"
+#include "commonfunction.h"
 
 #include "xlsxdocument.h"
 #include "ut_Head.h"
@@ -130,3 +131,50 @@ TEST_F(UT_DeviceInfo, UT_DeviceInfo_mapInfoToList)
 
     EXPECT_EQ(1, m_deviceBaseInfo->m_LstOtherInfo.size());
 }
+
+TEST_F(UT_DeviceInfo, UT_DeviceInfo_attribsCache)
+{
+    m_deviceBaseInfo = dynamic_cast<DeviceBaseInfo *>(audio);
+    m_deviceBaseInfo->getBaseAttribs();
+    m_deviceBaseInfo->getOtherAttribs();
+    m_deviceBaseInfo->getTableData();
+    EXPECT_TRUE(m_deviceBaseInfo->m_BaseInfoLoaded);
+    EXPECT_TRUE(m_deviceBaseInfo->m_OtherInfoLoaded);
+    EXPECT_TRUE(m_deviceBaseInfo->m_TableDataLoaded);
+
+    // 属性未变化时不重新生成
+    m_deviceBaseInfo->m_LstBaseInfo.append(QPair<QString, QString>("Name", "cached"));
+    EXPECT_EQ(1, m_deviceBaseInfo->getBaseAttribs().size());
+
+    QMap<QString, QString> mapinfo;
+    mapinfo.insert("Vendor", "Intel Corporation");
+    m_deviceBaseInfo->setAttribute(mapinfo, "Vendor", m_deviceBaseInfo->m_Vendor);
+    EXPECT_FALSE(m_deviceBaseInfo->m_BaseInfoLoaded);
+    EXPECT_FALSE(m_deviceBaseInfo->m_OtherInfoLoaded);
+    EXPECT_FALSE(m_deviceBaseInfo->m_TableDataLoaded);
+    ASSERT_EQ(1, m_deviceBaseInfo->getBaseAttribs().size());
+    EXPECT_STREQ("Intel Corporation", m_deviceBaseInfo->getBaseAttribs()[0].second.toStdString().c_str());
+}
+
+static int modinfoCount = 0;
+QByteArray ut_deviceinfo_executeClientCmd(const QString &, const QStringList &, const QString &, int, bool)
+{
+    ++modinfoCount;
+    return "filename:       /lib/modules/snd-hda-intel.ko\nversion:        1.0.1\n";
+}
+
+TEST_F(UT_DeviceInfo, UT_DeviceInfo_getDriverVersion)
+{
+    Stub stub;
+    stub.set(ADDR(Common, executeClientCmd), ut_deviceinfo_executeClientCmd);
+    modinfoCount = 0;
+
+    m_deviceBaseInfo = dynamic_cast<DeviceBaseInfo *>(audio);
+    EXPECT_STREQ("1.0.1", m_deviceBaseInfo->getDriverVersion().toStdString().c_str());
+    EXPECT_STREQ("1.0.1", m_deviceBaseInfo->getDriverVersion().toStdString().c_str());
+    EXPECT_EQ(1, modinfoCount);
+
+    m_deviceBaseInfo->invalidateAttribs();
+    m_deviceBaseInfo->getDriverVersion();
+    EXPECT_EQ(2, modinfoCount);
+}
@@ -29,6 +29,10 @@
 #include <QPaintEvent>
 #include <QPainter>
 #include <QIODevice>
+#include <QElapsedTimer>
+#include <QDir>
+#include <QThread>
+#include <QAtomicInt>
 
 #include <gtest/gtest.h>
 
@@ -487,6 +491,225 @@ TEST_F(UT_DeviceManager, UT_DeviceManager_addAudioDevice)
     delete a;
 }
 
+TEST_F(UT_DeviceManager, UT_DeviceManager_getAudioDevice)
+{
+    DeviceAudio *a = new DeviceAudio;
+    a->m_UniqueID = "1.1:1.1";
+    DeviceAudio *b = new DeviceAudio;
+    b->m_SysPath = "/devices/pci0000:00/0000:00:1f.3";
+    b->m_VID_PID = "0x10ec0269";
+    DeviceManager::instance()->addAudioDevice(a);
+    DeviceManager::instance()->addAudioDevice(b);
+
+    EXPECT_EQ(a, DeviceManager::instance()->getAudioDevice("1.1:1.0"));
+    EXPECT_EQ(b, DeviceManager::instance()->getAudioDevice("/devices/pci0000:00/0000:00:1f.3"));
+    EXPECT_EQ(b, DeviceManager::instance()->getAudioDevice("0x10ec0269"));
+    EXPECT_FALSE(DeviceManager::instance()->getAudioDevice("1.1:1.1"));
+
+    DeviceManager::instance()->delAudioDevice(a);
+    EXPECT_FALSE(DeviceManager::instance()->getAudioDevice("1.1:1.0"));
+
+    DeviceManager::instance()->m_ListDeviceAudio.clear();
+    delete a;
+    delete b;
+}
+
+TEST_F(UT_DeviceManager, UT_DeviceManager_getAudioDevice_keysChanged)
+{
+    DeviceAudio *a = new DeviceAudio;
+    DeviceManager::instance()->addAudioDevice(a);
+    EXPECT_FALSE(DeviceManager::instance()->getAudioDevice("/devices/pci0000:00/0000:00:1f.3"));
+
+    // 加入后再补充的 sysfs 路径和唯一值也能查找到
+    QMap<QString, QString> mapInfo;
+    mapInfo.insert("SysFS ID", "/devices/pci0000:00/0000:00:1f.3");
+    a->setAttribute(mapInfo, "SysFS ID", a->m_SysPath);
+    EXPECT_EQ(a, DeviceManager::instance()->getAudioDevice("/devices/pci0000:00/0000:00:1f.3"));
+
+    a->m_UniqueID = "2.1:1.1";
+    a->invalidateAttribs();
+    EXPECT_EQ(a, DeviceManager::instance()->getAudioDevice("2.1:1.0"));
+
+    DeviceManager::instance()->m_ListDeviceAudio.clear();
+    DeviceManager::instance()->m_IndexAudio.clear();
+    delete a;
+}
+
+TEST_F(UT_DeviceManager, UT_DeviceManager_findTomlDevices)
+{
+    DeviceAudio *a = new DeviceAudio;
+    a->m_Modalias = "PCI:v00008086d0000A3C8sv00001849sd0000A3C8bc06sc01i00";
+    DeviceAudio *b = new DeviceAudio;
+    b->m_VID = "0x10EC";
+    b->m_PID = "0x0269";
+    b->m_VID_PID = "0x10ec0269";
+    QList<DeviceBaseInfo *> lst;
+    lst << a << b;
+    DeviceIndex index;
+    index.rebuild(lst);
+
+    QList<QMap<QString, QString>> tomlMapLst;
+    QMap<QString, QString> mapInfo;
+    mapInfo.insert("Modalias", "pci:v00008086d0000A3C8sv00001849sd0000A3C8bc06sc01i00");
+    tomlMapLst.append(mapInfo);
+    mapInfo.clear();
+    mapInfo.insert("Vendor_ID", "0x10ec");
+    mapInfo.insert("Product_ID", "0x0269");
+    tomlMapLst.append(mapInfo);
+    mapInfo.clear();
+    mapInfo.insert("Modalias", "audio:v10ecd0269");
+    tomlMapLst.append(mapInfo);
+    QList<TomlRule> rules = DeviceManager::instance()->compileTomlRules(tomlMapLst);
+    ASSERT_EQ(3, rules.size());
+
+    QList<DeviceBaseInfo *> found = DeviceManager::instance()->findTomlDevices(DT_Audio, index, rules[0]);
+    EXPECT_EQ(1, found.size());
+    EXPECT_EQ(a, found.value(0));
+
+    found = DeviceManager::instance()->findTomlDevices(DT_Audio, index, rules[1]);
+    EXPECT_EQ(1, found.size());
+    EXPECT_EQ(b, found.value(0));
+
+    found = DeviceManager::instance()->findTomlDevices(DT_Audio, index, rules[2]);
+    EXPECT_EQ(1, found.size());
+    EXPECT_EQ(b, found.value(0));
+
+    delete a;
+    delete b;
+}
+
+static DeviceOthers *ut_tomlDevice(const QString &vid, const QString &pid, const QString &vidAndPid, const QString &modalias = "")
+{
+    DeviceOthers *device = new DeviceOthers;
+    device->m_VID = vid;
+    device->m_PID = pid;
+    device->m_VID_PID = vidAndPid;
+    device->m_Modalias = modalias;
+    return device;
+}
+
+TEST_F(UT_DeviceManager, UT_DeviceManager_findTomlDevices_matchesLinearScan)
+{
+    // VID/PID 与 VIDAndPID 不一致、只有 VIDAndPID、大小写不同、VIDAndPID 过短等情况
+    QList<DeviceBaseInfo *> lst;
+    lst << ut_tomlDevice("0x10ec", "0x0269", "0x8086a3c8");
+    lst << ut_tomlDevice("", "", "0x10ec0269");
+    lst << ut_tomlDevice("", "", "10EC0269");
+    lst << ut_tomlDevice("", "", "046dc52b", "usb:v046dpc52bd0100");
+    lst << ut_tomlDevice("", "", "abc");
+    lst << ut_tomlDevice("0x8086", "", "0x80861234");
+    for (int i = 0; i < 200; ++i) {
+        QString vid = QString("%1").arg(i, 4, 16, QChar('0'));
+        QString pid = QString("%1").arg(i + 0x1000, 4, 16, QChar('0'));
+        if (i % 2)
+            lst << ut_tomlDevice("0x" + vid, "0x" + pid, "0x" + pid + vid);
+        else
+            lst << ut_tomlDevice("", "", "0x" + vid + pid, QString("usb:v%1p%2").arg(vid).arg(pid));
+    }
+    DeviceIndex index;
+    index.rebuild(lst);
+
+    QList<QMap<QString, QString>> tomlMapLst;
+    auto addRule = [&tomlMapLst](const QString & key1, const QString & value1, const QString & key2 = "", const QString & value2 = "") {
+        QMap<QString, QString> mapInfo;
+        mapInfo.insert(key1, value1);
+        if (!key2.isEmpty())
+            mapInfo.insert(key2, value2);
+        tomlMapLst.append(mapInfo);
+    };
+    addRule("Vendor_ID", "0x10ec", "Product_ID", "0x0269");
+    addRule("Vendor_ID", "10EC", "Product_ID", "269");
+    addRule("Vendor_ID", "ab", "Product_ID", "c");
+    addRule("Modalias", "others:v8086da3c8");
+    addRule("Modalias", "others:vabc");
+    addRule("Modalias", "usb:v046dpc52bd0100");
+    for (int i = 0; i < 200; i += 7) {
+        QString vid = QString("%1").arg(i, 4, 16, QChar('0'));
+        QString pid = QString("%1").arg(i + 0x1000, 4, 16, QChar('0'));
+        addRule("Vendor_ID", "0x" + vid, "Product_ID", "0x" + pid);
+        addRule("Modalias", QString("others:v%1d%2").arg(vid).arg(pid));
+    }
+    QList<TomlRule> rules = DeviceManager::instance()->compileTomlRules(tomlMapLst);
+
+    // 索引查找的结果与逐一比较所有设备的结果一致
+    for (int j = 0; j < rules.size(); ++j) {
+        QList<DeviceBaseInfo *> expected;
+        foreach (DeviceBaseInfo *device, lst) {
+            if (DeviceManager::instance()->findByModalias(DT_Others, device, rules[j].modalias)
+                    || DeviceManager::instance()->findByVIDPID(DT_Others, device, rules[j].vid, rules[j].pid)
+                    || DeviceManager::instance()->findByVendorName(DT_Others, device, rules[j].vendor, rules[j].name))
+                expected.append(device);
+        }
+        EXPECT_EQ(expected, DeviceManager::instance()->findTomlDevices(DT_Others, index, rules[j])) << "rule " << j;
+    }
+
+    // VID/PID 精确匹配第一个设备,只有 VIDAndPID 的设备按包含关系匹配
+    QList<DeviceBaseInfo *> found = DeviceManager::instance()->findTomlDevices(DT_Others, index, rules[0]);
+    ASSERT_EQ(3, found.size());
+    EXPECT_EQ(lst[0], found[0]);
+    EXPECT_EQ(lst[1], found[1]);
+    EXPECT_EQ(lst[2], found[2]);
+
+    // 自定义 modalias 按 VIDAndPID 匹配,与 VID 字段无关
+    found = DeviceManager::instance()->findTomlDevices(DT_Others, index, rules[3]);
+    ASSERT_EQ(1, found.size());
+    EXPECT_EQ(lst[0], found[0]);
+
+    // VIDAndPID 过短的设备仍能匹配
+    found = DeviceManager::instance()->findTomlDevices(DT_Others, index, rules[2]);
+    ASSERT_EQ(1, found.size());
+    EXPECT_EQ(lst[4], found[0]);
+    found = DeviceManager::instance()->findTomlDevices(DT_Others, index, rules[4]);
+    EXPECT_TRUE(found.contains(lst[4]));
+
+    qDeleteAll(lst);
+}
+
+// 性能对比只输出耗时,默认不运行,使用 --gtest_also_run_disabled_tests 运行
+TEST_F(UT_DeviceManager, DISABLED_UT_DeviceManager_tomlDeviceSet_benchmark)
+{
+    // 1000 个设备,5000 条 toml 规则,其中一半命中已有设备
+    DeviceManager::instance()->m_ListDeviceOthers.clear();
+    DeviceManager::instance()->m_IndexOthers.clear();
+    for (int i = 0; i < 1000; ++i) {
+        DeviceOthers *device = new DeviceOthers;
+        device->m_VID = QString("0x%1").arg(i, 4, 16, QChar('0'));
+        device->m_PID = QString("0x%1").arg(i + 0x1000, 4, 16, QChar('0'));
+        device->m_VID_PID = device->m_VID + device->m_PID.mid(2);
+        device->m_Modalias = QString("usb:v%1p%2").arg(device->m_VID.mid(2)).arg(device->m_PID.mid(2));
+        DeviceManager::instance()->m_ListDeviceOthers.append(device);
+    }
+
+    QList<QMap<QString, QString>> tomlMapLst;
+    for (int i = 0; i < 5000; ++i) {
+        QMap<QString, QString> mapInfo;
+        switch (i % 4) {
+        case 0: mapInfo.insert("Modalias", QString("usb:v%1p%2").arg(i % 2000, 4, 16, QChar('0')).arg(i % 2000 + 0x1000, 4, 16, QChar('0'))); break;
+        case 1: mapInfo.insert("Vendor_ID", QString("0x%1").arg(i % 2000, 4, 16, QChar('0')));
+                mapInfo.insert("Product_ID", QString("0x%1").arg(i % 2000 + 0x1000, 4, 16, QChar('0'))); break;
+        case 2: mapInfo.insert("Modalias", QString("others:v%1d%2").arg(i % 2000, 4, 16, QChar('0')).arg(i % 2000 + 0x1000, 4, 16, QChar('0'))); break;
+        default: mapInfo.insert("Vendor", QString("vendor%1").arg(i));
+                 mapInfo.insert("Name", QString("name%1").arg(i)); break;
+        }
+        mapInfo.insert("Description", QString("toml%1").arg(i));
+        tomlMapLst.append(mapInfo);
+    }
+    QMap<QString, QList<QMap<QString, QString>>> cmdInfo;
+    cmdInfo.insert("tomlOtherDevices", tomlMapLst);
+    DeviceManager::instance()->m_cmdInfo = cmdInfo;
+
+    QElapsedTimer timer;
+    timer.start();
+    DeviceManager::instance()->tomlDeviceSet(DT_Others);
+    qInfo() << "tomlDeviceSet with 5000 rules and 1000 devices:" << timer.elapsed() << "ms";
+
+    foreach (auto device, DeviceManager::instance()->m_ListDeviceOthers)
+        delete device;
+    DeviceManager::instance()->m_ListDeviceOthers.clear();
+    DeviceManager::instance()->m_IndexOthers.clear();
+    DeviceManager::instance()->m_cmdInfo.clear();
+}
+
 TEST_F(UT_DeviceManager, UT_DeviceManager_setAudioInfoFromLshw)
 {
 //    QMap<QString, QString> mapinfo;
@@ -818,3 +1041,363 @@ TEST_F(UT_DeviceManager, UT_DeviceManager_setCpuNum)
     DeviceManager::instance()->m_CpuNum = 0;
 }
 
+
+TEST_F(UT_DeviceManager, UT_DeviceManager_mergeLastGeneration)
+{
+    DeviceManager::instance()->m_ListDeviceAudio.clear();
+    DeviceManager::instance()->m_LastGeneration.clear();
+
+    DeviceAudio *a = new DeviceAudio;
+    a->m_UniqueID = "1.1:1.0";
+    a->m_Name = "USB Audio";
+    DeviceAudio *b = new DeviceAudio;
+    b->m_UniqueID = "2.1:1.0";
+    b->m_Name = "HDA Intel PCH";
+    a->markGenerated();
+    b->markGenerated();
+    a->m_DriverVersion = "1.0";
+    a->m_DriverVersionLoaded = true;
+    DeviceManager::instance()->m_LastGeneration[DT_Audio] << a << b;
+
+    // 新生成的 a1 与 a 内容一致,b1 与 b 名称相同但厂商变化,c1 为新设备
+    QMap<QString, QString> mapVendor;
+    mapVendor.insert("Vendor", "Intel Corporation");
+    DeviceAudio *a1 = new DeviceAudio;
+    a1->m_UniqueID = "1.1:1.0";
+    a1->m_Name = "USB Audio";
+    DeviceAudio *b1 = new DeviceAudio;
+    b1->m_UniqueID = "2.1:1.0";
+    b1->m_Name = "HDA Intel PCH";
+    b1->setAttribute(mapVendor, "Vendor", b1->m_Vendor);
+    DeviceAudio *c1 = new DeviceAudio;
+    c1->m_UniqueID = "3.1:1.0";
+    c1->m_Name = "HDMI Audio";
+    DeviceManager::instance()->m_ListDeviceAudio << a1 << b1 << c1;
+
+    DeviceManager::instance()->mergeLastGeneration();
+    const QList<DeviceBaseInfo *> &lst = DeviceManager::instance()->m_ListDeviceAudio;
+    ASSERT_EQ(3, lst.size());
+    EXPECT_EQ(a, lst[0]);
+    EXPECT_EQ(b1, lst[1]);
+    EXPECT_EQ(c1, lst[2]);
+    EXPECT_TRUE(DeviceManager::instance()->m_LastGeneration.isEmpty());
+    EXPECT_EQ(a, DeviceManager::instance()->getAudioDevice("1.1:1.0"));
+
+    // 比对时不生成显示信息,复用的设备重新读取驱动版本
+    EXPECT_FALSE(b1->m_BaseInfoLoaded);
+    EXPECT_FALSE(b1->m_TableDataLoaded);
+    EXPECT_FALSE(a->m_DriverVersionLoaded);
+
+    foreach (DeviceBaseInfo *device, lst)
+        delete device;
+    DeviceManager::instance()->m_ListDeviceAudio.clear();
+    DeviceManager::instance()->m_IndexAudio.clear();
+}
+
+TEST_F(UT_DeviceManager, UT_DeviceManager_clear_keepsShownGeneration)
+{
+    DeviceManager::instance()->m_ListDeviceAudio.clear();
+    DeviceManager::instance()->m_LastGeneration.clear();
+
+    DeviceAudio *a = new DeviceAudio;
+    a->m_UniqueID = "1.1:1.0";
+    DeviceManager::instance()->m_ListDeviceAudio << a;
+    DeviceManager::instance()->clear();
+    ASSERT_EQ(1, DeviceManager::instance()->m_LastGeneration[DT_Audio].size());
+
+    // 未合并时再次生成并清空,界面显示的设备继续暂存,中间生成的设备被释放而不是累积
+    DeviceAudio *a1 = new DeviceAudio;
+    a1->m_UniqueID = "1.1:1.0";
+    DeviceManager::instance()->m_ListDeviceAudio << a1;
+    DeviceManager::instance()->clear();
+    ASSERT_EQ(1, DeviceManager::instance()->m_LastGeneration[DT_Audio].size());
+    EXPECT_EQ(a, DeviceManager::instance()->m_LastGeneration[DT_Audio][0]);
+    EXPECT_TRUE(DeviceManager::instance()->m_ListDeviceAudio.isEmpty());
+
+    // 本次没有生成设备时保留暂存的设备
+    DeviceManager::instance()->clear();
+    ASSERT_EQ(1, DeviceManager::instance()->m_LastGeneration[DT_Audio].size());
+    EXPECT_EQ(a, DeviceManager::instance()->m_LastGeneration[DT_Audio][0]);
+
+    DeviceManager::instance()->clearLastGeneration();
+}
+
+TEST_F(UT_DeviceManager, UT_DeviceManager_deviceClassChanged)
+{
+    DeviceManager::instance()->setDeviceListClass();
+    DeviceManager::instance()->setDeviceListClass();
+    EXPECT_FALSE(DeviceManager::instance()->deviceClassChanged(QObject::tr("CPU")));
+    EXPECT_FALSE(DeviceManager::instance()->deviceClassChanged(QObject::tr("Overview")));
+
+    DeviceCpu *cpu = new DeviceCpu;
+    DeviceManager::instance()->m_ListDeviceCPU.append(cpu);
+    DeviceManager::instance()->setDeviceListClass();
+    EXPECT_TRUE(DeviceManager::instance()->deviceClassChanged(QObject::tr("CPU")));
+    EXPECT_TRUE(DeviceManager::instance()->deviceClassChanged(QObject::tr("Overview")));
+    EXPECT_FALSE(DeviceManager::instance()->deviceClassChanged(QObject::tr("Memory")));
+
+    DeviceManager::instance()->m_ListDeviceCPU.clear();
+    DeviceManager::instance()->setDeviceListClass();
+    delete cpu;
+}
+
+TEST_F(UT_DeviceManager, UT_DeviceManager_searchIndex)
+{
+    EXPECT_EQ(QStringList() << "snd" << "hda" << "intel", DeviceSearchIndex::tokenize("snd_hda_intel  SND"));
+
+    DeviceAudio *a = new DeviceAudio;
+    a->m_Name = "HDA Intel PCH";
+    a->m_Driver = "snd_hda_intel";
+    a->m_Modalias = "pci:v00008086d0000A3C8sv00001849sd0000A3C8bc06sc01i00";
+    DeviceAudio *b = new DeviceAudio;
+    b->m_Name = "USB Audio";
+    b->m_Driver = "snd-usb-audio";
+
+    DeviceSearchIndex index;
+    index.insert(a);
+    index.insert(b);
+    EXPECT_EQ(2, index.size());
+
+    // 子串匹配,多个关键字取交集
+    EXPECT_EQ(QSet<DeviceBaseInfo *>() << a << b, index.find("SND"));
+    EXPECT_EQ(QSet<DeviceBaseInfo *>() << a, index.find("a3c8"));
+    EXPECT_EQ(QSet<DeviceBaseInfo *>() << a, index.find("snd_hda_intel"));
+    EXPECT_EQ(QSet<DeviceBaseInfo *>() << b, index.find("usb snd"));
+    EXPECT_TRUE(index.find("usb intel").isEmpty());
+    EXPECT_TRUE(index.find("  ").isEmpty());
+
+    // 设备内容变化后重新登记,未变化的设备不重新切分
+    EXPECT_FALSE(index.update(a));
+    b->m_Driver = "btusb";
+    b->invalidateAttribs();
+    EXPECT_TRUE(index.update(b));
+    EXPECT_FALSE(index.update(b));
+    EXPECT_EQ(QSet<DeviceBaseInfo *>() << a, index.find("snd"));
+
+    index.retain(QList<DeviceBaseInfo *>() << b);
+    EXPECT_FALSE(index.contains(a));
+    EXPECT_TRUE(index.find("intel").isEmpty());
+
+    delete a;
+    delete b;
+}
+
+TEST_F(UT_DeviceManager, UT_DeviceManager_searchDevices)
+{
+    DeviceManager::instance()->m_ListDeviceAudio.clear();
+    DeviceManager::instance()->m_LastGeneration.clear();
+    DeviceManager::instance()->m_SearchIndex.clear();
+
+    DeviceAudio *a = new DeviceAudio;
+    a->m_UniqueID = "1.1:1.0";
+    a->m_Name = "USB Audio";
+    a->m_Driver = "snd-usb-audio";
+    DeviceAudio *b = new DeviceAudio;
+    b->m_UniqueID = "2.1:1.0";
+    b->m_Name = "HDA Intel PCH";
+    b->m_Driver = "snd_hda_intel";
+    DeviceManager::instance()->m_ListDeviceAudio << a << b;
+    DeviceManager::instance()->setDeviceListClass();
+
+    // 刷新时不建立索引,也不生成显示信息,空的搜索内容同样不建立索引
+    EXPECT_EQ(0, DeviceManager::instance()->m_SearchIndex.size());
+    EXPECT_FALSE(a->m_BaseInfoLoaded);
+    EXPECT_TRUE(DeviceManager::instance()->searchDevices("  ").isEmpty());
+    EXPECT_EQ(0, DeviceManager::instance()->m_SearchIndex.size());
+
+    QMap<QString, QList<DeviceBaseInfo *>> result = DeviceManager::instance()->searchDevices("intel");
+    ASSERT_EQ(1, result.size());
+    EXPECT_EQ(QList<DeviceBaseInfo *>() << b, result.value(QObject::tr("Sound Adapter")));
+
+    EXPECT_EQ(2, DeviceManager::instance()->m_SearchIndex.size());
+
+    // 刷新后复用的设备不重新切分,新设备在搜索时登记,消失的设备移除
+    DeviceManager::instance()->clear();
+    DeviceAudio *a1 = new DeviceAudio;
+    a1->m_UniqueID = "1.1:1.0";
+    a1->m_Name = "USB Audio";
+    a1->m_Driver = "snd-usb-audio";
+    DeviceAudio *c1 = new DeviceAudio;
+    c1->m_UniqueID = "3.1:1.0";
+    c1->m_Name = "HDMI Audio";
+    c1->m_Driver = "snd_hda_intel";
+    DeviceManager::instance()->m_ListDeviceAudio << a1 << c1;
+    DeviceManager::instance()->setDeviceListClass();
+
+    EXPECT_EQ(1, DeviceManager::instance()->m_SearchIndex.size());
+    EXPECT_TRUE(DeviceManager::instance()->m_SearchIndex.contains(a));
+    EXPECT_FALSE(c1->m_BaseInfoLoaded);
+    result = DeviceManager::instance()->searchDevices("intel");
+    EXPECT_EQ(QList<DeviceBaseInfo *>() << c1, result.value(QObject::tr("Sound Adapter")));
+    EXPECT_TRUE(DeviceManager::instance()->searchDevices("PCH").isEmpty());
+    EXPECT_EQ(2, DeviceManager::instance()->m_SearchIndex.size());
+
+    // 显示期间被修改的设备在搜索时重新登记
+    c1->m_Driver = "snd-usb-audio";
+    c1->invalidateAttribs();
+    EXPECT_TRUE(DeviceManager::instance()->searchDevices("intel").isEmpty());
+    result = DeviceManager::instance()->searchDevices("usb audio");
+    EXPECT_EQ(QList<DeviceBaseInfo *>() << a << c1, result.value(QObject::tr("Sound Adapter")));
+
+    foreach (DeviceBaseInfo *device, DeviceManager::instance()->m_ListDeviceAudio)
+        delete device;
+    DeviceManager::instance()->m_ListDeviceAudio.clear();
+    DeviceManager::instance()->m_IndexAudio.clear();
+    DeviceManager::instance()->m_SearchIndex.clear();
+    DeviceManager::instance()->setDeviceListClass();
+}
+
+// 导出用的合成设备清单,多个类别各 count 个设备
+static QList<DeviceBaseInfo *> ut_exportFixture(int count)
+{
+    QList<DeviceBaseInfo *> all;
+    for (int i = 0; i < count; ++i) {
+        DeviceCpu *cpu = new DeviceCpu;
+        cpu->m_Name = QString("Processor %1").arg(i);
+        cpu->m_Vendor = "GenuineIntel";
+        DeviceManager::instance()->m_ListDeviceCPU.append(cpu);
+
+        DeviceInput *keyboard = new DeviceInput;
+        keyboard->m_Name = QString("Keyboard %1").arg(i);
+        keyboard->m_Vendor = "Logitech";
+        DeviceManager::instance()->m_ListDeviceKeyboard.append(keyboard);
+
+        DeviceOtherPCI *pci = new DeviceOtherPCI;
+        pci->m_Name = QString("PCI Bridge %1").arg(i);
+        pci->m_Vendor = "Intel Corporation";
+        DeviceManager::instance()->m_ListDeviceOtherPCI.append(pci);
+
+        DeviceOthers *other = new DeviceOthers;
+        other->m_Name = QString("USB <Device> %1").arg(i);
+        other->m_Vendor = QString("Vendor & %1").arg(i % 50);
+        DeviceManager::instance()->m_ListDeviceOthers.append(other);
+
+        all << cpu << keyboard << pci << other;
+    }
+    return all;
+}
+
+static void ut_exportFixtureClear(const QList<DeviceBaseInfo *> &all)
+{
+    DeviceManager::instance()->m_ListDeviceCPU.clear();
+    DeviceManager::instance()->m_ListDeviceKeyboard.clear();
+    DeviceManager::instance()->m_ListDeviceOtherPCI.clear();
+    DeviceManager::instance()->m_ListDeviceOthers.clear();
+    qDeleteAll(all);
+    DeviceManager::instance()->setExportThreadCount(QThread::idealThreadCount());
+}
+
+TEST_F(UT_DeviceManager, UT_DeviceManager_renderCategories_order)
+{
+    QList<DeviceBaseInfo *> all = ut_exportFixture(20);
+
+    // 并行渲染的结果与串行渲染逐字节一致
+    QList<DeviceManager::ExportFormat> formats;
+    formats << DeviceManager::EF_Txt << DeviceManager::EF_Html << DeviceManager::EF_Doc << DeviceManager::EF_Xlsx;
+    foreach (DeviceManager::ExportFormat format, formats) {
+        QByteArray serial;
+        DeviceManager::instance()->setExportThreadCount(1);
+        DeviceManager::instance()->renderCategories(format, [&serial](const QByteArray & fragment) {
+            serial += fragment;
+        });
+
+        QByteArray parallel;
+        DeviceManager::instance()->setExportThreadCount(4);
+        DeviceManager::instance()->renderCategories(format, [&parallel](const QByteArray & fragment) {
+            parallel += fragment;
+        });
+
+        EXPECT_FALSE(serial.isEmpty());
+        EXPECT_TRUE(serial == parallel);
+    }
+
+    ut_exportFixtureClear(all);
+}
+
+static QAtomicInt ut_renderedCategories;
+static QByteArray ut_renderCategory(DeviceManager::ExportFormat, const DeviceManager::ExportCategory &category)
+{
+    ut_renderedCategories.ref();
+    return category.title.toUtf8();
+}
+
+TEST_F(UT_DeviceManager, UT_DeviceManager_renderCategories_window)
+{
+    QList<DeviceBaseInfo *> all = ut_exportFixture(2);
+    Stub stub;
+    stub.set(ADDR(DeviceManager, renderCategory), ut_renderCategory);
+
+    // 已渲染未写出的片段不超过线程数
+    ut_renderedCategories = 0;
+    int written = 0;
+    int ahead = 0;
+    DeviceManager::instance()->setExportThreadCount(2);
+    DeviceManager::instance()->renderCategories(DeviceManager::EF_Txt, [&written, &ahead](const QByteArray &) {
+        ++written;
+        ahead = qMax(ahead, int(ut_renderedCategories) - written);
+    });
+
+    EXPECT_EQ(written, DeviceManager::instance()->exportCategories().size());
+    EXPECT_LE(ahead, 2);
+
+    ut_exportFixtureClear(all);
+}
+
+// 性能对比只输出耗时,默认不运行,使用 --gtest_also_run_disabled_tests 运行
+TEST_F(UT_DeviceManager, DISABLED_UT_DeviceManager_export_benchmark)
+{
+    QList<DeviceBaseInfo *> all = ut_exportFixture(2500);
+    QString path = QDir::tempPath() + "/ut_devicemanager_export";
+
+    QList<QPair<QString, std::function<bool(const QString &)>>> exporters;
+    exporters.append(qMakePair(QString("txt"), std::function<bool(const QString &)>([](const QString & file) {
+        return DeviceManager::instance()->exportToTxt(file);
+    })));
+    exporters.append(qMakePair(QString("html"), std::function<bool(const QString &)>([](const QString & file) {
+        return DeviceManager::instance()->exportToHtml(file);
+    })));
+    exporters.append(qMakePair(QString("docx"), std::function<bool(const QString &)>([](const QString & file) {
+        return DeviceManager::instance()->exportToDoc(file);
+    })));
+    exporters.append(qMakePair(QString("xlsx"), std::function<bool(const QString &)>([](const QString & file) {
+        return DeviceManager::instance()->exportToXlsx(file);
+    })));
+
+    for (int i = 0; i < exporters.size(); ++i) {
+        const QString file = path + "." + exporters[i].first;
+        QElapsedTimer timer;
+
+        DeviceManager::instance()->setExportThreadCount(1);
+        timer.start();
+        exporters[i].second(file);
+        qint64 serialMs = timer.elapsed();
+
+        DeviceManager::instance()->setExportThreadCount(QThread::idealThreadCount());
+        timer.restart();
+        exporters[i].second(file);
+        qint64 parallelMs = timer.elapsed();
+
+        qInfo() << "export" << exporters[i].first << "with" << all.size() << "devices, serial:" << serialMs
+                << "ms, parallel(" << QThread::idealThreadCount() << "threads):" << parallelMs << "ms, speedup:"
+                << (parallelMs > 0 ? double(serialMs) / parallelMs : 0.0);
+        QFile::remove(file);
+    }
+
+    ut_exportFixtureClear(all);
+}
+
+TEST_F(UT_DeviceManager, UT_DeviceManager_prepareExport)
+{
+    QList<DeviceBaseInfo *> all = ut_exportFixture(2);
+
+    // 导出前生成全部属性缓存,导出线程只读取
+    DeviceManager::instance()->prepareExport();
+    foreach (DeviceBaseInfo *device, all) {
+        EXPECT_TRUE(device->m_BaseInfoLoaded);
+        EXPECT_TRUE(device->m_OtherInfoLoaded);
+        EXPECT_TRUE(device->m_TableDataLoaded);
+        EXPECT_FALSE(device->m_TableHeader.isEmpty());
+    }
+
+    ut_exportFixtureClear(all);
+}
@@ -8,6 +8,7 @@
 #include "GenerateDevicePool.h"
 #include "DBusInterface.h"
 #include "DeviceManager.h"
+#include "DBusEnableInterface.h"
 #include "ut_Head.h"
 #include "stub.h"
 
@@ -539,3 +540,29 @@ TEST_F(UT_CmdTool, UT_CmdTool_getDeviceInfo)
     m_cmdTool->getDeviceInfo(deviceInfo, "dmidecode2");
     EXPECT_STREQ("Manufacturer: LENOVO\nProduct Name: 3133\nVersion: NOK\n", deviceInfo.toStdString().c_str());
 }
+
+bool ut_cmdtool_getDisabledRecords(void *obj, EnableDeviceRecordList &removed, EnableDeviceRecordList &authorized)
+{
+    EnableDeviceRecord record;
+    record.hclass = "mouse";
+    record.name = "Logitech USB Optical Mouse";
+    record.path = "/devices/pci0000:00/0000:00:14.0/usb1/1-8/1-8:1.0";
+    record.uniqueId = "Hfmv.Ndwb4jxzSvF";
+    record.driver = "usbhid";
+    authorized.clear();
+    authorized.append(record);
+    removed.clear();
+    return true;
+}
+
+TEST_F(UT_CmdTool, UT_CmdTool_getMulHwinfoInfo_records)
+{
+    Stub stub;
+    stub.set(ADDR(DBusEnableInterface, getDisabledRecords), ut_cmdtool_getDisabledRecords);
+
+    m_cmdTool->m_cmdInfo.clear();
+    m_cmdTool->getMulHwinfoInfo("");
+    ASSERT_EQ(1, m_cmdTool->m_cmdInfo["hwinfo_mouse"].size());
+    EXPECT_STREQ("Hfmv.Ndwb4jxzSvF", m_cmdTool->m_cmdInfo["hwinfo_mouse"][0]["unique_id"].toStdString().c_str());
+    EXPECT_STREQ("/devices/pci0000:00/0000:00:14.0/usb1/1-8/1-8:1.0", m_cmdTool->m_cmdInfo["hwinfo_mouse"][0]["path"].toStdString().c_str());
+}
@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "DeviceFactory.h"
+#include "commonfunction.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <gtest/gtest.h>
+
+class UT_DeviceFactory : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+    }
+    void TearDown()
+    {
+    }
+};
+
+TEST_F(UT_DeviceFactory, UT_DeviceFactory_generatorKey_arch)
+{
+    PlatformProfile profile = {"x86_64", "", -1};
+    EXPECT_STREQ("x86_64", DeviceFactory::generatorKey(profile).toStdString().c_str());
+    profile.arch = "mips64";
+    EXPECT_STREQ("mips64", DeviceFactory::generatorKey(profile).toStdString().c_str());
+    profile.arch = "aarch64";
+    EXPECT_STREQ("arm", DeviceFactory::generatorKey(profile).toStdString().c_str());
+}
+
+TEST_F(UT_DeviceFactory, UT_DeviceFactory_generatorKey_boardVendor)
+{
+    PlatformProfile profile = {"aarch64", "PGUW", -1};
+    EXPECT_STREQ("PGUW", DeviceFactory::generatorKey(profile).toStdString().c_str());
+    profile.boardVendorKey = "KLVU";
+    EXPECT_STREQ("KLVU", DeviceFactory::generatorKey(profile).toStdString().c_str());
+    profile.boardVendorKey = "UNKNOWN";
+    EXPECT_STREQ("hw", DeviceFactory::generatorKey(profile).toStdString().c_str());
+}
@@ -0,0 +1,130 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "DeviceSnapshot.h"
+#include "DeviceManager.h"
+#include "DeviceSnapshotInfo.h"
+#include "DeviceAudio.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QDir>
+#include <QFile>
+#include <QDataStream>
+
+#include <gtest/gtest.h>
+
+static QByteArray snapshotBootId = "boot-1";
+
+QByteArray ut_devicesnapshot_bootId()
+{
+    return snapshotBootId;
+}
+
+class UT_DeviceSnapshot : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        snapshotBootId = "boot-1";
+        m_Path = QDir::tempPath() + "/ut_device_snapshot.bin";
+        clearDevices();
+    }
+    void TearDown()
+    {
+        QFile::remove(m_Path);
+        clearDevices();
+        DeviceManager::instance()->setCpuNum(1);
+    }
+    void clearDevices()
+    {
+        DeviceManager::instance()->clear();
+        DeviceManager::instance()->clearLastGeneration();
+    }
+    QString m_Path;
+};
+
+TEST_F(UT_DeviceSnapshot, UT_DeviceSnapshot_saveAndLoad)
+{
+    Stub stub;
+    stub.set(ADDR(DeviceSnapshot, bootId), ut_devicesnapshot_bootId);
+
+    DeviceAudio *audio = new DeviceAudio;
+    audio->m_Name = "HDA Intel PCH";
+    audio->m_Vendor = "Intel Corporation";
+    audio->m_UniqueID = "2.1:1.0";
+    DeviceAudio *unopened = new DeviceAudio;
+    unopened->m_Name = "USB Audio";
+    unopened->m_Vendor = "C-Media Electronics Inc.";
+    unopened->m_UniqueID = "1.1:1.0";
+    DeviceManager::instance()->m_ListDeviceAudio << audio << unopened;
+    DeviceManager::instance()->setCpuNum(2);
+    const QList<QPair<QString, QString> > baseAttribs = audio->getBaseAttribs();
+    const QStringList tableData = audio->getTableData();
+
+    EXPECT_TRUE(DeviceSnapshot::save(m_Path));
+    // 没有打开过的设备不保留保存时生成的显示信息
+    EXPECT_FALSE(unopened->m_BaseInfoLoaded);
+    EXPECT_FALSE(unopened->m_TableDataLoaded);
+    EXPECT_TRUE(unopened->m_LstBaseInfo.isEmpty());
+    EXPECT_TRUE(unopened->m_TableHeader.isEmpty());
+    const QList<QPair<QString, QString> > unopenedAttribs = unopened->getBaseAttribs();
+    // 快照中包含只有 root 可读的信息,只允许当前用户读写
+    EXPECT_EQ(QFileDevice::ReadOwner | QFileDevice::WriteOwner,
+              QFile::permissions(m_Path) & (QFileDevice::ReadOwner | QFileDevice::WriteOwner | QFileDevice::ReadGroup | QFileDevice::ReadOther));
+    clearDevices();
+    DeviceManager::instance()->setCpuNum(1);
+
+    // 加载的是生成后的设备,不需要再次生成
+    EXPECT_TRUE(DeviceSnapshot::load(m_Path));
+    ASSERT_EQ(2, DeviceManager::instance()->m_ListDeviceAudio.size());
+    DeviceSnapshotInfo *device = qobject_cast<DeviceSnapshotInfo *>(DeviceManager::instance()->m_ListDeviceAudio[0]);
+    ASSERT_TRUE(device);
+    EXPECT_STREQ("HDA Intel PCH", device->name().toStdString().c_str());
+    EXPECT_STREQ("2.1:1.0", device->uniqueID().toStdString().c_str());
+    EXPECT_EQ(2, DeviceManager::instance()->cpuNum());
+
+    // 详细属性在使用时才从映射内存中读取
+    EXPECT_FALSE(device->m_BaseInfoLoaded);
+    EXPECT_EQ(baseAttribs, device->getBaseAttribs());
+    EXPECT_EQ(tableData, device->getTableData());
+    EXPECT_FALSE(device->canEnable());
+    EXPECT_EQ(EDS_Faild, device->setEnable(false));
+
+    DeviceSnapshotInfo *other = qobject_cast<DeviceSnapshotInfo *>(DeviceManager::instance()->m_ListDeviceAudio[1]);
+    ASSERT_TRUE(other);
+    EXPECT_EQ(unopenedAttribs, other->getBaseAttribs());
+}
+
+TEST_F(UT_DeviceSnapshot, UT_DeviceSnapshot_bootIdChanged)
+{
+    Stub stub;
+    stub.set(ADDR(DeviceSnapshot, bootId), ut_devicesnapshot_bootId);
+
+    EXPECT_TRUE(DeviceSnapshot::save(m_Path));
+    snapshotBootId = "boot-2";
+    EXPECT_FALSE(DeviceSnapshot::load(m_Path));
+    EXPECT_FALSE(QFile::exists(m_Path));
+}
+
+TEST_F(UT_DeviceSnapshot, UT_DeviceSnapshot_versionChanged)
+{
+    Stub stub;
+    stub.set(ADDR(DeviceSnapshot, bootId), ut_devicesnapshot_bootId);
+
+    // 写入旧版本格式的快照
+    QFile file(m_Path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_11);
+    out << quint32(0x444D534E) << quint32(0) << snapshotBootId;
+    file.close();
+
+    EXPECT_FALSE(DeviceSnapshot::load(m_Path));
+}
+
+TEST_F(UT_DeviceSnapshot, UT_DeviceSnapshot_missing)
+{
+    EXPECT_FALSE(DeviceSnapshot::load(m_Path));
+}
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "DrmEdidCollector.h"
+
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+
+#include <gtest/gtest.h>
+
+static const char *drmEdidHex = "00ffffffffffff005a63384001010101"
+                                "0d1e010380351d782ece65a657519f27"
+                                "0f5054bfef80b300a940a9c095009040"
+                                "8180814081c0023a801871382d40582c"
+                                "45000f282100001e000000ff00565351"
+                                "3230313332313330320a000000fd0032"
+                                "4b185311000a202020202020000000fc"
+                                "005641323433302d4648440a20200141";
+
+static void writeAttribute(const QString &dirPath, const QString &name, const QByteArray &data)
+{
+    QDir().mkpath(dirPath);
+    QFile file(dirPath + "/" + name);
+    file.open(QIODevice::WriteOnly);
+    file.write(data);
+    file.close();
+}
+
+class UT_DrmEdidCollector : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        // 构造 drm 类目录:一个已连接的 HDMI、一个未连接的 VGA,以及非接口目录
+        const QString root = m_SysfsDir.path();
+        writeAttribute(root + "/card0-HDMI-A-1", "status", "connected\n");
+        writeAttribute(root + "/card0-HDMI-A-1", "enabled", "enabled\n");
+        writeAttribute(root + "/card0-HDMI-A-1", "edid", QByteArray::fromHex(drmEdidHex));
+        writeAttribute(root + "/card0-VGA-1", "status", "disconnected\n");
+        writeAttribute(root + "/card0-VGA-1", "enabled", "disabled\n");
+        writeAttribute(root + "/card0-VGA-1", "edid", QByteArray());
+        QDir().mkpath(root + "/card0");
+        QDir().mkpath(root + "/renderD128");
+
+        m_Collector = new DrmEdidCollector(root);
+    }
+    void TearDown()
+    {
+        delete m_Collector;
+    }
+    QTemporaryDir m_SysfsDir;
+    DrmEdidCollector *m_Collector = nullptr;
+};
+
+TEST_F(UT_DrmEdidCollector, UT_DrmEdidCollector_connectors)
+{
+    QList<DrmEdidCollector::Connector> lstConnector = m_Collector->connectors();
+    ASSERT_EQ(2, lstConnector.size());
+    EXPECT_STREQ("card0", lstConnector[0].card.toStdString().c_str());
+    EXPECT_STREQ("HDMI-A-1", lstConnector[0].name.toStdString().c_str());
+    EXPECT_STREQ("connected", lstConnector[0].status.toStdString().c_str());
+    EXPECT_TRUE(lstConnector[0].enabled);
+    EXPECT_EQ(128, lstConnector[0].edid.size());
+    EXPECT_STREQ("VGA-1", lstConnector[1].name.toStdString().c_str());
+    EXPECT_FALSE(lstConnector[1].enabled);
+}
+
+TEST_F(UT_DrmEdidCollector, UT_DrmEdidCollector_connectedMonitors)
+{
+    QList<DrmEdidCollector::Connector> lstMonitor = m_Collector->connectedMonitors();
+    ASSERT_EQ(1, lstMonitor.size());
+    EXPECT_STREQ("HDMI-A-1", lstMonitor[0].name.toStdString().c_str());
+
+    EXPECT_TRUE(m_Collector->connectedMonitors(QStringList() << "VGA-1").isEmpty());
+    EXPECT_TRUE(DrmEdidCollector("/nonexistent").connectors().isEmpty());
+}
+
+TEST_F(UT_DrmEdidCollector, UT_DrmEdidCollector_monitorInfo)
+{
+    QList<DrmEdidCollector::Connector> lstMonitor = m_Collector->connectedMonitors();
+    ASSERT_EQ(1, lstMonitor.size());
+
+    QMap<QString, QString> mapInfo;
+    EXPECT_TRUE(DrmEdidCollector::monitorInfo(lstMonitor[0], mapInfo));
+    EXPECT_STREQ("VSC", mapInfo["Vendor"].toStdString().c_str());
+    EXPECT_STREQ("HDMI-A-1", mapInfo["Display Input"].toStdString().c_str());
+
+    DrmEdidCollector::Connector broken = lstMonitor[0];
+    broken.edid[0] = 0x12;
+    mapInfo.clear();
+    EXPECT_FALSE(DrmEdidCollector::monitorInfo(broken, mapInfo));
+}
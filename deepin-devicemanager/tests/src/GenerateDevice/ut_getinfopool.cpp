@@ -75,3 +75,41 @@ TEST_F(UT_GetInfoPool, UT_GetInfoPool_setFramework)
     EXPECT_STREQ("x86", m_readFilePool->m_Arch.toStdString().c_str());
 }
 
+
+static int loadCmdInfoCount = 0;
+static QString rawDeviceInfo = "test info";
+bool ut_getDeviceInfo_hash(void *obj, QString &deviceInfo, const QString &file)
+{
+    deviceInfo = rawDeviceInfo;
+    return true;
+}
+void ut_loadCmdInfo_count(void *obj, const QString &key, const QString &debugFile)
+{
+    ++loadCmdInfoCount;
+}
+TEST_F(UT_GetInfoPool, UT_GetInfoPool_skipUnchanged)
+{
+    Stub stub;
+    stub.set(ADDR(CmdTool, getDeviceInfo), ut_getDeviceInfo_hash);
+    stub.set(ADDR(CmdTool, loadCmdInfo), ut_loadCmdInfo_count);
+    loadCmdInfoCount = 0;
+    rawDeviceInfo = "test info";
+
+    CmdTask lshwTask("lshw", "lshw.txt", "", m_readFilePool);
+    lshwTask.run();
+    lshwTask.run();
+    EXPECT_EQ(1, loadCmdInfoCount);
+    EXPECT_TRUE(m_readFilePool->m_CurSkippedKeys.contains("lshw"));
+
+    // 原始输出变化后重新解析
+    rawDeviceInfo = "changed info";
+    lshwTask.run();
+    EXPECT_EQ(2, loadCmdInfoCount);
+
+    // 依赖其它数据源的命令每次都解析
+    CmdTask printerTask("printer", "printer.txt", "", m_readFilePool);
+    printerTask.run();
+    printerTask.run();
+    EXPECT_EQ(4, loadCmdInfoCount);
+    EXPECT_EQ(1, m_readFilePool->m_CurSkippedKeys.size());
+}
@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "GpuProbe.h"
+#include "CmdTool.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <gtest/gtest.h>
+
+static int runCmdCount = 0;
+
+QString ut_gpuprobe_runCmd(void *obj, const QString &program, const QStringList &args)
+{
+    Q_UNUSED(obj);
+    ++runCmdCount;
+    const QString cmd = (QStringList() << program << args).join(" ");
+    if (cmd == "nvidia-settings -q GPUMemoryInterface")
+        return "  Attribute 'GPUMemoryInterface' (uos-PC:0.0): 128.\n"
+               "    'GPUMemoryInterface' is an integer attribute.\n";
+    return "output of " + cmd;
+}
+
+bool ut_gpuprobe_nvidiaDriverLoaded()
+{
+    return true;
+}
+
+class UT_GpuProbe : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        runCmdCount = 0;
+        GpuProbe::instance()->clear();
+    }
+    void TearDown()
+    {
+        GpuProbe::instance()->setTtl(60000);
+        GpuProbe::instance()->clear();
+    }
+};
+
+TEST_F(UT_GpuProbe, UT_GpuProbe_output_cached)
+{
+    Stub stub;
+    stub.set(ADDR(GpuProbe, runCmd), ut_gpuprobe_runCmd);
+
+    EXPECT_STREQ("output of nvidia-smi -L", GpuProbe::instance()->output("nvidia-smi", QStringList() << "-L").toStdString().c_str());
+    EXPECT_STREQ("output of nvidia-smi -L", GpuProbe::instance()->output("nvidia-smi", QStringList() << "-L").toStdString().c_str());
+    EXPECT_EQ(1, runCmdCount);
+
+    GpuProbe::instance()->output("nvidia-settings", QStringList() << "-q" << "VideoRam");
+    EXPECT_EQ(2, runCmdCount);
+}
+
+TEST_F(UT_GpuProbe, UT_GpuProbe_output_expired)
+{
+    Stub stub;
+    stub.set(ADDR(GpuProbe, runCmd), ut_gpuprobe_runCmd);
+
+    GpuProbe::instance()->setTtl(0);
+    GpuProbe::instance()->output("nvidia-smi", QStringList() << "-L");
+    GpuProbe::instance()->output("nvidia-smi", QStringList() << "-L");
+    EXPECT_EQ(2, runCmdCount);
+}
+
+TEST_F(UT_GpuProbe, UT_GpuProbe_loadNvidiaWidthInfo)
+{
+    Stub stub;
+    stub.set(ADDR(GpuProbe, runCmd), ut_gpuprobe_runCmd);
+    stub.set(ADDR(GpuProbe, nvidiaDriverLoaded), ut_gpuprobe_nvidiaDriverLoaded);
+
+    CmdTool tool;
+    tool.loadCmdInfo("nvidia_width", "nvidia_width.txt");
+    ASSERT_EQ(1, tool.cmdInfo()["nvidia_width"].size());
+    EXPECT_STREQ("128 bits", tool.cmdInfo()["nvidia_width"][0]["Width"].toStdString().c_str());
+}
@@ -7,6 +7,7 @@
 #include "LoadInfoThread.h"
 #include "ThreadExecXrandr.h"
 #include "GenerateDevicePool.h"
+#include "commonfunction.h"
 #include "ut_Head.h"
 #include "stub.h"
 
@@ -14,6 +15,11 @@
 #include <QPaintEvent>
 #include <QPainter>
 
+#include <xcb/xcb.h>
+#include <xcb/randr.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include <gtest/gtest.h>
 
 class UT_LoadInfoThread : public UT_HEAD
@@ -30,12 +36,306 @@ public:
     LoadInfoThread *m_loadInfoThread;
 };
 
+static void ut_ThreadExecXrandr_runCmd(void *obj, QString &info, const QString &cmd)
+{
+    Q_UNUSED(obj);
+    if (cmd == "xrandr") {
+        info = "Screen 0: minimum 320 x 200, current 1920 x 1080, maximum 16384 x 16384\n"
+               "HDMI-1 connected primary 1920x1080+0+0 (normal left inverted right x axis y axis) 527mm x 296mm\n"
+               "   1920x1080     60.00*+\n"
+               "VGA-1 disconnected (normal left inverted right x axis y axis)\n";
+    } else {
+        info = "Screen 0: minimum 320 x 200, current 1920 x 1080, maximum 16384 x 16384\n"
+               "HDMI-1 connected primary 1920x1080+0+0 (0x48) normal (normal left inverted right x axis y axis) 527mm x 296mm\n"
+               "\tEDID: \n"
+               "\t\t00ffffffffffff0010ac5fa04c4c4d41\n"
+               "\t\t1e1d0104a5351e783ae245a8554da326\n"
+               "\tBroadcast RGB: Automatic \n"
+               "  1920x1080 (0x48) 148.500MHz +HSync +VSync *current +preferred\n"
+               "        h: width  1920 start 2008 end 2052 total 2200 skew    0 clock  67.50KHz\n"
+               "        v: height 1080 start 1084 end 1089 total 1125           clock  60.00Hz\n"
+               "VGA-1 disconnected (normal left inverted right x axis y axis)\n";
+    }
+}
+
+static bool ut_ThreadExecXrandr_loadFromRandr()
+{
+    return false;
+}
+
+static void ut_ThreadExecXrandr_getResolutionFromDBus()
+{
+}
+
+// 模拟的 RandR 服务: 一个屏幕,HDMI-1 已连接并为主输出,VGA-1 未连接
+#define UT_RANDR_HDMI  0x41
+#define UT_RANDR_VGA   0x42
+#define UT_RANDR_CRTC  0x3f
+#define UT_RANDR_MODE  0x48
+#define UT_RANDR_EDID  0x5a
+
+static int ut_randrMinor = 6;
+static int ut_randrEdidRequests = 0;
+static xcb_screen_t ut_randrScreen;
+static xcb_randr_output_t ut_randrOutputs[] = {UT_RANDR_HDMI, UT_RANDR_VGA};
+static xcb_randr_mode_info_t ut_randrModes[1];
+static uint8_t ut_randrEdid[32] = {
+    0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x10, 0xac, 0x5f, 0xa0, 0x4c, 0x4c, 0x4d, 0x41,
+    0x1e, 0x1d, 0x01, 0x04, 0xa5, 0x35, 0x1e, 0x78, 0x3a, 0xe2, 0x45, 0xa8, 0x55, 0x4d, 0xa3, 0x26
+};
+
+template<typename Reply>
+static Reply *ut_randrReply(unsigned int sequence)
+{
+    // 与 xcb 一样返回 malloc 分配的回复,由被测代码 free
+    Reply *reply = static_cast<Reply *>(calloc(1, sizeof(Reply)));
+    reply->sequence = uint16_t(sequence);
+    return reply;
+}
+
+static xcb_randr_query_version_cookie_t ut_xcb_randr_query_version(xcb_connection_t *, uint32_t, uint32_t)
+{
+    xcb_randr_query_version_cookie_t cookie = {1};
+    return cookie;
+}
+
+static xcb_randr_query_version_reply_t *ut_xcb_randr_query_version_reply(xcb_connection_t *, xcb_randr_query_version_cookie_t cookie, xcb_generic_error_t **)
+{
+    xcb_randr_query_version_reply_t *reply = ut_randrReply<xcb_randr_query_version_reply_t>(cookie.sequence);
+    reply->major_version = 1;
+    reply->minor_version = uint32_t(ut_randrMinor);
+    return reply;
+}
+
+static xcb_intern_atom_cookie_t ut_xcb_intern_atom(xcb_connection_t *, uint8_t, uint16_t, const char *)
+{
+    xcb_intern_atom_cookie_t cookie = {1};
+    return cookie;
+}
+
+static xcb_intern_atom_reply_t *ut_xcb_intern_atom_reply(xcb_connection_t *, xcb_intern_atom_cookie_t cookie, xcb_generic_error_t **)
+{
+    xcb_intern_atom_reply_t *reply = ut_randrReply<xcb_intern_atom_reply_t>(cookie.sequence);
+    reply->atom = UT_RANDR_EDID;
+    return reply;
+}
+
+static const xcb_setup_t *ut_xcb_get_setup(xcb_connection_t *)
+{
+    return nullptr;
+}
+
+static xcb_screen_iterator_t ut_xcb_setup_roots_iterator(const xcb_setup_t *)
+{
+    ut_randrScreen.root = 0x1e3;
+    xcb_screen_iterator_t iter;
+    iter.data = &ut_randrScreen;
+    iter.rem = 1;
+    iter.index = 0;
+    return iter;
+}
+
+static void ut_xcb_screen_next(xcb_screen_iterator_t *iter)
+{
+    --iter->rem;
+}
+
+static xcb_randr_get_screen_size_range_cookie_t ut_xcb_randr_get_screen_size_range(xcb_connection_t *, xcb_window_t)
+{
+    xcb_randr_get_screen_size_range_cookie_t cookie = {1};
+    return cookie;
+}
+
+static xcb_randr_get_screen_size_range_reply_t *ut_xcb_randr_get_screen_size_range_reply(xcb_connection_t *, xcb_randr_get_screen_size_range_cookie_t cookie, xcb_generic_error_t **)
+{
+    xcb_randr_get_screen_size_range_reply_t *reply = ut_randrReply<xcb_randr_get_screen_size_range_reply_t>(cookie.sequence);
+    reply->min_width = 320;
+    reply->min_height = 200;
+    reply->max_width = 16384;
+    reply->max_height = 16384;
+    return reply;
+}
+
+static xcb_get_geometry_cookie_t ut_xcb_get_geometry(xcb_connection_t *, xcb_drawable_t)
+{
+    xcb_get_geometry_cookie_t cookie = {1};
+    return cookie;
+}
+
+static xcb_get_geometry_reply_t *ut_xcb_get_geometry_reply(xcb_connection_t *, xcb_get_geometry_cookie_t cookie, xcb_generic_error_t **)
+{
+    xcb_get_geometry_reply_t *reply = ut_randrReply<xcb_get_geometry_reply_t>(cookie.sequence);
+    reply->width = 1920;
+    reply->height = 1080;
+    return reply;
+}
+
+static xcb_randr_get_output_primary_cookie_t ut_xcb_randr_get_output_primary(xcb_connection_t *, xcb_window_t)
+{
+    xcb_randr_get_output_primary_cookie_t cookie = {1};
+    return cookie;
+}
+
+static xcb_randr_get_output_primary_reply_t *ut_xcb_randr_get_output_primary_reply(xcb_connection_t *, xcb_randr_get_output_primary_cookie_t cookie, xcb_generic_error_t **)
+{
+    xcb_randr_get_output_primary_reply_t *reply = ut_randrReply<xcb_randr_get_output_primary_reply_t>(cookie.sequence);
+    reply->output = UT_RANDR_HDMI;
+    return reply;
+}
+
+static xcb_randr_get_screen_resources_current_cookie_t ut_xcb_randr_get_screen_resources_current(xcb_connection_t *, xcb_window_t)
+{
+    xcb_randr_get_screen_resources_current_cookie_t cookie = {1};
+    return cookie;
+}
+
+static xcb_randr_get_screen_resources_current_reply_t *ut_xcb_randr_get_screen_resources_current_reply(xcb_connection_t *, xcb_randr_get_screen_resources_current_cookie_t cookie, xcb_generic_error_t **)
+{
+    return ut_randrReply<xcb_randr_get_screen_resources_current_reply_t>(cookie.sequence);
+}
+
+static xcb_randr_output_t *ut_xcb_randr_get_screen_resources_current_outputs(const xcb_randr_get_screen_resources_current_reply_t *)
+{
+    return ut_randrOutputs;
+}
+
+static int ut_xcb_randr_get_screen_resources_current_outputs_length(const xcb_randr_get_screen_resources_current_reply_t *)
+{
+    return 2;
+}
+
+static xcb_randr_mode_info_t *ut_xcb_randr_get_screen_resources_current_modes(const xcb_randr_get_screen_resources_current_reply_t *)
+{
+    // 1920x1080 60Hz,与 xrandr --verbose 中 0x48 模式的时序相同
+    memset(ut_randrModes, 0, sizeof(ut_randrModes));
+    ut_randrModes[0].id = UT_RANDR_MODE;
+    ut_randrModes[0].width = 1920;
+    ut_randrModes[0].height = 1080;
+    ut_randrModes[0].dot_clock = 148500000;
+    ut_randrModes[0].htotal = 2200;
+    ut_randrModes[0].vtotal = 1125;
+    return ut_randrModes;
+}
+
+static int ut_xcb_randr_get_screen_resources_current_modes_length(const xcb_randr_get_screen_resources_current_reply_t *)
+{
+    return 1;
+}
+
+static xcb_randr_get_output_info_cookie_t ut_xcb_randr_get_output_info(xcb_connection_t *, xcb_randr_output_t output, xcb_timestamp_t)
+{
+    // 用请求序号区分输出
+    xcb_randr_get_output_info_cookie_t cookie = {output};
+    return cookie;
+}
+
+static xcb_randr_get_output_info_reply_t *ut_xcb_randr_get_output_info_reply(xcb_connection_t *, xcb_randr_get_output_info_cookie_t cookie, xcb_generic_error_t **)
+{
+    xcb_randr_get_output_info_reply_t *reply = ut_randrReply<xcb_randr_get_output_info_reply_t>(cookie.sequence);
+    if (UT_RANDR_HDMI == cookie.sequence) {
+        reply->crtc = UT_RANDR_CRTC;
+        reply->mm_width = 527;
+        reply->mm_height = 296;
+        reply->connection = XCB_RANDR_CONNECTION_CONNECTED;
+    } else {
+        reply->crtc = XCB_NONE;
+        reply->connection = XCB_RANDR_CONNECTION_DISCONNECTED;
+    }
+    return reply;
+}
+
+static uint8_t *ut_xcb_randr_get_output_info_name(const xcb_randr_get_output_info_reply_t *reply)
+{
+    static char hdmi[] = "HDMI-1";
+    static char vga[] = "VGA-1";
+    return reinterpret_cast<uint8_t *>(UT_RANDR_HDMI == reply->sequence ? hdmi : vga);
+}
+
+static int ut_xcb_randr_get_output_info_name_length(const xcb_randr_get_output_info_reply_t *reply)
+{
+    return UT_RANDR_HDMI == reply->sequence ? 6 : 5;
+}
+
+static xcb_randr_get_crtc_info_cookie_t ut_xcb_randr_get_crtc_info(xcb_connection_t *, xcb_randr_crtc_t crtc, xcb_timestamp_t)
+{
+    xcb_randr_get_crtc_info_cookie_t cookie = {crtc};
+    return cookie;
+}
+
+static xcb_randr_get_crtc_info_reply_t *ut_xcb_randr_get_crtc_info_reply(xcb_connection_t *, xcb_randr_get_crtc_info_cookie_t cookie, xcb_generic_error_t **)
+{
+    xcb_randr_get_crtc_info_reply_t *reply = ut_randrReply<xcb_randr_get_crtc_info_reply_t>(cookie.sequence);
+    reply->width = 1920;
+    reply->height = 1080;
+    reply->mode = UT_RANDR_MODE;
+    return reply;
+}
+
+static xcb_randr_get_output_property_cookie_t ut_xcb_randr_get_output_property(xcb_connection_t *, xcb_randr_output_t output, xcb_atom_t, xcb_atom_t,
+                                                                                uint32_t, uint32_t, uint8_t, uint8_t)
+{
+    ++ut_randrEdidRequests;
+    xcb_randr_get_output_property_cookie_t cookie = {output};
+    return cookie;
+}
+
+static xcb_randr_get_output_property_reply_t *ut_xcb_randr_get_output_property_reply(xcb_connection_t *, xcb_randr_get_output_property_cookie_t cookie, xcb_generic_error_t **)
+{
+    xcb_randr_get_output_property_reply_t *reply = ut_randrReply<xcb_randr_get_output_property_reply_t>(cookie.sequence);
+    reply->format = 8;
+    reply->num_items = sizeof(ut_randrEdid);
+    return reply;
+}
+
+static uint8_t *ut_xcb_randr_get_output_property_data(const xcb_randr_get_output_property_reply_t *)
+{
+    return ut_randrEdid;
+}
+
+static int ut_xcb_randr_get_output_property_data_length(const xcb_randr_get_output_property_reply_t *reply)
+{
+    return int(reply->num_items);
+}
+
+static void ut_stubRandr(Stub &stub)
+{
+    stub.set(xcb_randr_query_version, ut_xcb_randr_query_version);
+    stub.set(xcb_randr_query_version_reply, ut_xcb_randr_query_version_reply);
+    stub.set(xcb_intern_atom, ut_xcb_intern_atom);
+    stub.set(xcb_intern_atom_reply, ut_xcb_intern_atom_reply);
+    stub.set(xcb_get_setup, ut_xcb_get_setup);
+    stub.set(xcb_setup_roots_iterator, ut_xcb_setup_roots_iterator);
+    stub.set(xcb_screen_next, ut_xcb_screen_next);
+    stub.set(xcb_randr_get_screen_size_range, ut_xcb_randr_get_screen_size_range);
+    stub.set(xcb_randr_get_screen_size_range_reply, ut_xcb_randr_get_screen_size_range_reply);
+    stub.set(xcb_get_geometry, ut_xcb_get_geometry);
+    stub.set(xcb_get_geometry_reply, ut_xcb_get_geometry_reply);
+    stub.set(xcb_randr_get_output_primary, ut_xcb_randr_get_output_primary);
+    stub.set(xcb_randr_get_output_primary_reply, ut_xcb_randr_get_output_primary_reply);
+    stub.set(xcb_randr_get_screen_resources_current, ut_xcb_randr_get_screen_resources_current);
+    stub.set(xcb_randr_get_screen_resources_current_reply, ut_xcb_randr_get_screen_resources_current_reply);
+    stub.set(xcb_randr_get_screen_resources_current_outputs, ut_xcb_randr_get_screen_resources_current_outputs);
+    stub.set(xcb_randr_get_screen_resources_current_outputs_length, ut_xcb_randr_get_screen_resources_current_outputs_length);
+    stub.set(xcb_randr_get_screen_resources_current_modes, ut_xcb_randr_get_screen_resources_current_modes);
+    stub.set(xcb_randr_get_screen_resources_current_modes_length, ut_xcb_randr_get_screen_resources_current_modes_length);
+    stub.set(xcb_randr_get_output_info, ut_xcb_randr_get_output_info);
+    stub.set(xcb_randr_get_output_info_reply, ut_xcb_randr_get_output_info_reply);
+    stub.set(xcb_randr_get_output_info_name, ut_xcb_randr_get_output_info_name);
+    stub.set(xcb_randr_get_output_info_name_length, ut_xcb_randr_get_output_info_name_length);
+    stub.set(xcb_randr_get_crtc_info, ut_xcb_randr_get_crtc_info);
+    stub.set(xcb_randr_get_crtc_info_reply, ut_xcb_randr_get_crtc_info_reply);
+    stub.set(xcb_randr_get_output_property, ut_xcb_randr_get_output_property);
+    stub.set(xcb_randr_get_output_property_reply, ut_xcb_randr_get_output_property_reply);
+    stub.set(xcb_randr_get_output_property_data, ut_xcb_randr_get_output_property_data);
+    stub.set(xcb_randr_get_output_property_data_length, ut_xcb_randr_get_output_property_data_length);
+}
+
 class UT_ThreadExecXrandr : public UT_HEAD
 {
 public:
     void SetUp()
     {
-        m_threadExecXrandr = new ThreadExecXrandr(true, true);
+        m_threadExecXrandr = new ThreadExecXrandr(true);
     }
     void TearDown()
     {
@@ -55,3 +355,70 @@ public:
 //}
 
 
+
+TEST_F(UT_ThreadExecXrandr, UT_ThreadExecXrandr_run_fallback)
+{
+    // 无法连接X服务时执行 xrandr 命令,结果格式与 RandR 查询一致
+    Stub stub;
+    stub.set(ADDR(ThreadExecXrandr, loadFromRandr), ut_ThreadExecXrandr_loadFromRandr);
+    stub.set(ADDR(ThreadExecXrandr, runCmd), ut_ThreadExecXrandr_runCmd);
+    stub.set(ADDR(ThreadExecXrandr, getResolutionFromDBus), ut_ThreadExecXrandr_getResolutionFromDBus);
+    m_threadExecXrandr->run();
+
+    ASSERT_EQ(1, m_threadExecXrandr->m_GpuInfo.size());
+    const QMap<QString, QString> &gpu = m_threadExecXrandr->m_GpuInfo[0];
+    EXPECT_EQ("320 x 200", gpu["minResolution"]);
+    EXPECT_EQ("1920 x 1080", gpu["curResolution"]);
+    EXPECT_EQ("Enable", gpu["HDMI"]);
+    EXPECT_EQ("Enable", gpu["VGA"]);
+
+    if (Common::boardVendorType() != "PGUV") {
+        ASSERT_EQ(1, m_threadExecXrandr->m_MonitorInfo.size());
+        const QMap<QString, QString> &monitor = m_threadExecXrandr->m_MonitorInfo[0];
+        EXPECT_TRUE(monitor["mainInfo"].startsWith("HDMI-1 connected primary 1920x1080+0+0"));
+        EXPECT_EQ("60.00Hz", monitor["rate"]);
+        EXPECT_EQ(2, monitor["edid"].count("\n"));
+    }
+}
+
+TEST_F(UT_ThreadExecXrandr, UT_ThreadExecXrandr_loadRandrInfo)
+{
+    // RandR 查询结果与 xrandr 输出的解析结果格式相同
+    Stub stub;
+    ut_stubRandr(stub);
+    ut_randrMinor = 6;
+    ut_randrEdidRequests = 0;
+
+    QList<QMap<QString, QString>> gpuLst;
+    QList<QMap<QString, QString>> monitorLst;
+    ASSERT_TRUE(ThreadExecXrandr::loadRandrInfo(nullptr, gpuLst, monitorLst));
+
+    ASSERT_EQ(1, gpuLst.size());
+    EXPECT_EQ("320 x 200", gpuLst[0]["minResolution"]);
+    EXPECT_EQ("1920 x 1080", gpuLst[0]["curResolution"]);
+    EXPECT_EQ("16384 x 16384", gpuLst[0]["maxResolution"]);
+    EXPECT_EQ("Enable", gpuLst[0]["HDMI"]);
+    EXPECT_EQ("Enable", gpuLst[0]["VGA"]);
+
+    // 只查询已连接输出的 edid
+    EXPECT_EQ(1, ut_randrEdidRequests);
+    ASSERT_EQ(1, monitorLst.size());
+    EXPECT_EQ("HDMI-1 connected primary 1920x1080+0+0 527mm x 296mm", monitorLst[0]["mainInfo"]);
+    EXPECT_EQ("60.00Hz", monitorLst[0]["rate"]);
+    EXPECT_EQ("00ffffffffffff0010ac5fa04c4c4d41\n1e1d0104a5351e783ae245a8554da326\n", monitorLst[0]["edid"]);
+}
+
+TEST_F(UT_ThreadExecXrandr, UT_ThreadExecXrandr_loadRandrInfo_oldVersion)
+{
+    // RandR 低于 1.3 时由调用者回退到 xrandr 命令
+    Stub stub;
+    ut_stubRandr(stub);
+    ut_randrMinor = 2;
+
+    QList<QMap<QString, QString>> gpuLst;
+    QList<QMap<QString, QString>> monitorLst;
+    EXPECT_FALSE(ThreadExecXrandr::loadRandrInfo(nullptr, gpuLst, monitorLst));
+    EXPECT_TRUE(gpuLst.isEmpty());
+    EXPECT_TRUE(monitorLst.isEmpty());
+    ut_randrMinor = 6;
+}
@@ -10,6 +10,8 @@
 #include "DeviceWidget.h"
 #include "PageListView.h"
 #include "DeviceListView.h"
+#include "UPowerMonitor.h"
+#include "NetLinkMonitor.h"
 #include "ut_Head.h"
 #include "stub.h"
 
@@ -123,3 +125,74 @@ TEST_F(MainWindow_UT, MainWindow_UT_loadingFinishSlot)
     m_mainWindow->slotLoadingFinish("finish");
     EXPECT_TRUE(m_mainWindow->mp_DeviceWidget->mp_ListView->mp_ListView->mp_ItemModel->rowCount() > 0);
 }
+
+TEST_F(MainWindow_UT, MainWindow_UT_initDriverPages)
+{
+    // 驱动界面在第一次使用时创建
+    EXPECT_EQ(nullptr, m_mainWindow->mp_DriverManager);
+    EXPECT_EQ(2, m_mainWindow->mp_MainStackWidget->count());
+    m_mainWindow->initDriverPages();
+    EXPECT_NE(nullptr, m_mainWindow->mp_DriverManager);
+    EXPECT_EQ(4, m_mainWindow->mp_MainStackWidget->count());
+    m_mainWindow->initDriverPages();
+    EXPECT_EQ(4, m_mainWindow->mp_MainStackWidget->count());
+}
+
+static int ut_upowerApplyCount = 0;
+static void ut_upowerApply()
+{
+    ++ut_upowerApplyCount;
+}
+
+static bool ut_isExporting()
+{
+    return true;
+}
+
+TEST_F(MainWindow_UT, MainWindow_UT_batteryDeferredByExport)
+{
+    stub.set(ADDR(UPowerMonitor, apply), ut_upowerApply);
+    stub.set(ADDR(MainWindow, isExporting), ut_isExporting);
+    m_mainWindow->initExportThread();
+    m_mainWindow->m_refreshing = false;
+    ut_upowerApplyCount = 0;
+
+    // 导出期间电池变化不写入设备,导出结束后写入
+    m_mainWindow->slotBatteryUpdated();
+    EXPECT_EQ(0, ut_upowerApplyCount);
+    EXPECT_TRUE(m_mainWindow->m_BatteryDeferred);
+
+    stub.reset(ADDR(MainWindow, isExporting));
+    m_mainWindow->slotExportFinished(true, false);
+    EXPECT_EQ(1, ut_upowerApplyCount);
+    EXPECT_FALSE(m_mainWindow->m_BatteryDeferred);
+
+    // 导出期间没有变化时不重复写入
+    m_mainWindow->slotExportFinished(true, false);
+    EXPECT_EQ(1, ut_upowerApplyCount);
+}
+
+static int ut_netlinkApplyCount = 0;
+static void ut_netlinkApply()
+{
+    ++ut_netlinkApplyCount;
+}
+
+TEST_F(MainWindow_UT, MainWindow_UT_networkDeferredByExport)
+{
+    stub.set(ADDR(NetLinkMonitor, apply), ut_netlinkApply);
+    stub.set(ADDR(MainWindow, isExporting), ut_isExporting);
+    m_mainWindow->initExportThread();
+    m_mainWindow->m_refreshing = false;
+    ut_netlinkApplyCount = 0;
+
+    // 导出期间网卡状态变化不写入设备,导出结束后写入
+    m_mainWindow->slotNetworkUpdated();
+    EXPECT_EQ(0, ut_netlinkApplyCount);
+    EXPECT_TRUE(m_mainWindow->m_NetworkDeferred);
+
+    stub.reset(ADDR(MainWindow, isExporting));
+    m_mainWindow->slotExportFinished(true, false);
+    EXPECT_EQ(1, ut_netlinkApplyCount);
+    EXPECT_FALSE(m_mainWindow->m_NetworkDeferred);
+}
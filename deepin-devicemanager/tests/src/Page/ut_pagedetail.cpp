@@ -142,6 +142,45 @@ TEST_F(PageDetail_UT, PageDetail_UT_addWidgets)
     delete m_tBrowser;
 }
 
+static int ut_pagedetail_updateInfoCount = 0;
+static void ut_pagedetail_updateInfo()
+{
+    ++ut_pagedetail_updateInfoCount;
+}
+
+static QRegion ut_pagedetail_visibleRegion()
+{
+    return QRegion(0, 0, 10, 10);
+}
+
+TEST_F(PageDetail_UT, PageDetail_UT_updateVisibleInfo)
+{
+    Stub stub;
+    stub.set(ADDR(TextBrowser, updateInfo), ut_pagedetail_updateInfo);
+
+    DeviceBios *device = new DeviceBios;
+    DeviceBios *other = new DeviceBios;
+    m_pageDetail->showDeviceInfo(QList<DeviceBaseInfo *>() << device << other);
+    ut_pagedetail_updateInfoCount = 0;
+
+    // 未显示的详细信息只标记为过时
+    m_pageDetail->updateVisibleInfo();
+    EXPECT_EQ(0, ut_pagedetail_updateInfoCount);
+    EXPECT_EQ(2, m_pageDetail->m_StaleTextBrowser.size());
+
+    // 变为可见时重新生成一次
+    stub.set(ADDR(QWidget, visibleRegion), ut_pagedetail_visibleRegion);
+    m_pageDetail->mp_ScrollArea->verticalScrollBar()->valueChanged(0);
+    EXPECT_EQ(2, ut_pagedetail_updateInfoCount);
+    EXPECT_TRUE(m_pageDetail->m_StaleTextBrowser.isEmpty());
+    m_pageDetail->slotUpdateStaleInfo();
+    EXPECT_EQ(2, ut_pagedetail_updateInfoCount);
+
+    m_pageDetail->clearWidget();
+    delete device;
+    delete other;
+}
+
 TEST_F(PageDetail_UT, PageDetail_UT_slotBtnClicked)
 {
     m_pageDetail->slotBtnClicked();
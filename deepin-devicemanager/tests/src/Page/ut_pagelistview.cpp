@@ -40,6 +40,26 @@ TEST_F(PageListView_UT, PageListView_UT_updateListItems)
     EXPECT_EQ(0, m_pageListView->mp_ListView->mp_ItemModel->rowCount());
 }
 
+TEST_F(PageListView_UT, PageListView_UT_setItemFilter)
+{
+    QList<QPair<QString, QString>> list;
+    list.append(QPair<QString, QString>("Overview", "overview##Overview"));
+    list.append(QPair<QString, QString>("Separator", "Separator##Separator"));
+    list.append(QPair<QString, QString>("Mouse", "mouse##Mouse"));
+    list.append(QPair<QString, QString>("Keyboard", "keyboard##Keyboard"));
+    m_pageListView->setItemFilter(QStringList() << "Overview" << "Keyboard");
+    m_pageListView->updateListItems(list);
+
+    // 列表重建后保持过滤,分隔线隐藏
+    EXPECT_FALSE(m_pageListView->mp_ListView->isRowHidden(0));
+    EXPECT_TRUE(m_pageListView->mp_ListView->isRowHidden(1));
+    EXPECT_TRUE(m_pageListView->mp_ListView->isRowHidden(2));
+    EXPECT_FALSE(m_pageListView->mp_ListView->isRowHidden(3));
+
+    m_pageListView->setItemFilter(QStringList());
+    EXPECT_FALSE(m_pageListView->mp_ListView->isRowHidden(2));
+}
+
 TEST_F(PageListView_UT, PageListView_UT_currentIndex)
 {
     ASSERT_EQ(m_pageListView->currentIndex(), "");
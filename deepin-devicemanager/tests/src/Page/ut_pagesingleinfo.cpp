@@ -53,6 +53,33 @@ TEST_F(UT_PageSingleInfo, UT_PageSingleInfo_updateInfo)
     delete device;
 }
 
+TEST_F(UT_PageSingleInfo, UT_PageSingleInfo_updateDeviceData)
+{
+    DeviceInput *device = new DeviceInput;
+    device->m_Name = "name";
+    device->m_Vendor = "vendor";
+    m_PageSingleInfo->updateInfo(QList<DeviceBaseInfo *>() << device);
+
+    int row = -1;
+    for (int i = 0; i < m_PageSingleInfo->mp_Content->rowCount(); ++i) {
+        QTableWidgetItem *item = m_PageSingleInfo->mp_Content->item(i, 1);
+        if (item && item->text() == "vendor")
+            row = i;
+    }
+    ASSERT_GE(row, 0);
+    QTableWidgetItem *item = m_PageSingleInfo->mp_Content->item(row, 1);
+
+    // 属性项不变时只更新单元格,不重建表格
+    device->m_Vendor = "new vendor";
+    device->invalidateAttribs();
+    m_PageSingleInfo->updateDeviceData();
+    EXPECT_EQ(item, m_PageSingleInfo->mp_Content->item(row, 1));
+    EXPECT_STREQ("new vendor", item->text().toStdString().c_str());
+
+    m_PageSingleInfo->clearWidgets();
+    delete device;
+}
+
 TEST_F(UT_PageSingleInfo, UT_PageSingleInfo_setLabel)
 {
     m_PageSingleInfo->setLabel("test");
@@ -0,0 +1,180 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "CpuFreqSampler.h"
+#include "CpuFreqReadThread.h"
+#include "DeviceCpu.h"
+#include "DeviceManager.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+#include <QSignalSpy>
+#include <QCoreApplication>
+
+#include <gtest/gtest.h>
+
+static void ut_writeCpuFreq(const QString &root, int cpu, qint64 khz)
+{
+    const QString dirPath = QString("%1/cpu%2/cpufreq").arg(root).arg(cpu);
+    QDir().mkpath(dirPath);
+    QFile file(dirPath + "/scaling_cur_freq");
+    file.open(QIODevice::WriteOnly);
+    file.write(QByteArray::number(khz) + "\n");
+    file.close();
+}
+
+class UT_CpuFreqSampler : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        // 构造 cpu 目录:cpu10 排在 cpu2 之前,cpu3 离线没有 cpufreq,以及非处理器目录
+        const QString root = m_SysfsDir.path();
+        ut_writeCpuFreq(root, 0, 800000);
+        ut_writeCpuFreq(root, 1, 1200000);
+        ut_writeCpuFreq(root, 2, 3600000);
+        ut_writeCpuFreq(root, 10, 2000000);
+        QDir().mkpath(root + "/cpu3");
+        QDir().mkpath(root + "/cpufreq");
+        QDir().mkpath(root + "/cpuidle");
+
+        m_Sampler = CpuFreqSampler::instance();
+        m_Sampler->setRoot(root);
+    }
+    void TearDown()
+    {
+        m_Sampler->setRoot("/sys/devices/system/cpu");
+    }
+    QTemporaryDir m_SysfsDir;
+    CpuFreqSampler *m_Sampler = nullptr;
+};
+
+TEST_F(UT_CpuFreqSampler, UT_CpuFreqSampler_start)
+{
+    QSignalSpy spy(m_Sampler, &CpuFreqSampler::sampled);
+    ASSERT_TRUE(m_Sampler->start());
+    EXPECT_TRUE(m_Sampler->isRunning());
+    // 第一次采样在后台线程中读取
+    ASSERT_TRUE(spy.wait(1000));
+
+    const QVector<CpuFreqSampler::Core> &cores = m_Sampler->cores();
+    ASSERT_EQ(4, cores.size());
+    EXPECT_EQ(0, cores[0].cpu);
+    EXPECT_EQ(2, cores[2].cpu);
+    EXPECT_EQ(10, cores[3].cpu);
+    EXPECT_EQ(800000, cores[0].cur);
+    EXPECT_EQ(1u, cores[0].count);
+
+    m_Sampler->stop();
+    EXPECT_FALSE(m_Sampler->isRunning());
+    EXPECT_EQ(-1, m_Sampler->cores()[0].fd);
+}
+
+TEST_F(UT_CpuFreqSampler, UT_CpuFreqSampler_sample)
+{
+    QSignalSpy spy(m_Sampler, &CpuFreqSampler::sampled);
+    ASSERT_TRUE(m_Sampler->start());
+    ASSERT_TRUE(spy.wait(1000));
+
+    // 已打开的文件读取到新写入的值
+    ut_writeCpuFreq(m_SysfsDir.path(), 0, 2400000);
+    m_Sampler->sample();
+    ut_writeCpuFreq(m_SysfsDir.path(), 0, 1000000);
+    m_Sampler->sample();
+
+    const CpuFreqSampler::Core &core = m_Sampler->cores()[0];
+    EXPECT_EQ(1000000, core.cur);
+    EXPECT_EQ(800000, core.min);
+    EXPECT_EQ(2400000, core.max);
+    EXPECT_EQ(1400000, core.avg());
+    EXPECT_EQ(3u, core.count);
+
+    // 再次启动时重新统计
+    m_Sampler->stop();
+    ASSERT_TRUE(m_Sampler->start());
+    ASSERT_TRUE(spy.wait(1000));
+    EXPECT_EQ(1u, m_Sampler->cores()[0].count);
+    EXPECT_EQ(1000000, m_Sampler->cores()[0].max);
+    m_Sampler->stop();
+}
+
+TEST_F(UT_CpuFreqSampler, UT_CpuFreqSampler_stopWhileReading)
+{
+    ASSERT_TRUE(m_Sampler->start());
+    ASSERT_TRUE(m_Sampler->m_Reading);
+
+    // 后台线程正在读取的文件在读取结束后才关闭,过时的结果不写入统计
+    m_Sampler->stop();
+    EXPECT_EQ(-1, m_Sampler->cores()[0].fd);
+    EXPECT_EQ(4, m_Sampler->m_StaleFds.size());
+    m_Sampler->mp_Thread->wait();
+    QCoreApplication::processEvents();
+    EXPECT_FALSE(m_Sampler->m_Reading);
+    EXPECT_TRUE(m_Sampler->m_StaleFds.isEmpty());
+    EXPECT_EQ(0u, m_Sampler->cores()[0].count);
+
+    // 读取未结束时不重复启动
+    ASSERT_TRUE(m_Sampler->start());
+    m_Sampler->requestSample();
+    EXPECT_TRUE(m_Sampler->m_Reading);
+    m_Sampler->stop();
+    m_Sampler->mp_Thread->wait();
+    QCoreApplication::processEvents();
+}
+
+TEST_F(UT_CpuFreqSampler, UT_CpuFreqSampler_readFrequencies)
+{
+    ASSERT_TRUE(m_Sampler->start());
+    QVector<int> fds;
+    fds << m_Sampler->cores()[1].fd << -1 << m_Sampler->cores()[3].fd;
+    EXPECT_EQ(QVector<qint64>() << 1200000 << -1 << 2000000, CpuFreqSampler::readFrequencies(fds));
+    m_Sampler->stop();
+    m_Sampler->mp_Thread->wait();
+    QCoreApplication::processEvents();
+}
+
+TEST_F(UT_CpuFreqSampler, UT_CpuFreqSampler_noCpufreq)
+{
+    QTemporaryDir empty;
+    QDir().mkpath(empty.path() + "/cpu0");
+    m_Sampler->setRoot(empty.path());
+    EXPECT_FALSE(m_Sampler->start());
+    EXPECT_FALSE(m_Sampler->isRunning());
+}
+
+TEST_F(UT_CpuFreqSampler, UT_CpuFreqSampler_setInterval)
+{
+    m_Sampler->setInterval(500);
+    EXPECT_EQ(500, m_Sampler->interval());
+    m_Sampler->setInterval(10);
+    EXPECT_EQ(100, m_Sampler->interval());
+    m_Sampler->setInterval(1000);
+}
+
+TEST_F(UT_CpuFreqSampler, UT_CpuFreqSampler_apply)
+{
+    DeviceCpu *cpu = new DeviceCpu;
+    cpu->m_PhysicalID = "2";
+    DeviceManager::instance()->m_ListDeviceCPU.append(cpu);
+
+    QSignalSpy spy(m_Sampler, &CpuFreqSampler::sampled);
+    ASSERT_TRUE(m_Sampler->start());
+    ASSERT_TRUE(spy.wait(1000));
+    ut_writeCpuFreq(m_SysfsDir.path(), 2, 1200000);
+    m_Sampler->sample();
+    m_Sampler->apply();
+    m_Sampler->stop();
+
+    EXPECT_STREQ("1200 MHz", cpu->m_CurFrequency.toStdString().c_str());
+    EXPECT_STREQ("1200 / 2400 / 3600 MHz", cpu->m_SampledFrequency.toStdString().c_str());
+    cpu->loadOtherDeviceInfo();
+    ASSERT_EQ(2, cpu->m_LstOtherInfo.size());
+    EXPECT_STREQ("1200 MHz", cpu->m_LstOtherInfo.at(0).second.toStdString().c_str());
+
+    DeviceManager::instance()->m_ListDeviceCPU.clear();
+    delete cpu;
+}
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "DeviceDumper.h"
+#include "DeviceManager.h"
+#include "DeviceMemory.h"
+#include "ThreadExecXrandr.h"
+#include "NetLinkMonitor.h"
+#include "UPowerMonitor.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QBuffer>
+#include <QSignalSpy>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+#include <gtest/gtest.h>
+
+class UT_DeviceDumper : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+    }
+    void TearDown()
+    {
+    }
+};
+
+TEST_F(UT_DeviceDumper, UT_DeviceDumper_isDumpCmd)
+{
+    char arg0[] = "deepin-devicemanager";
+    char arg1[] = "--dump";
+    char arg2[] = "json";
+    char *dumpArgv[] = {arg0, arg1, arg2};
+    EXPECT_TRUE(DeviceDumper::isDumpCmd(3, dumpArgv));
+
+    char *guiArgv[] = {arg0};
+    EXPECT_FALSE(DeviceDumper::isDumpCmd(1, guiArgv));
+}
+
+TEST_F(UT_DeviceDumper, UT_DeviceDumper_categories)
+{
+    QStringList unknown;
+    EXPECT_EQ(18, DeviceDumper::categories(QStringList(), unknown).size());
+
+    QList<DeviceDumper::DumpCategory> lst = DeviceDumper::categories({"disk", "CPU", "bios"}, unknown);
+    EXPECT_TRUE(unknown.isEmpty());
+    ASSERT_EQ(3, lst.size());
+    // 按导出顺序排列
+    EXPECT_EQ(DT_Cpu, lst[0].type);
+    EXPECT_EQ(DT_Bios, lst[1].type);
+    EXPECT_EQ(DT_Storage, lst[2].type);
+
+    DeviceDumper::categories({"cpu", "gadget"}, unknown);
+    ASSERT_EQ(1, unknown.size());
+    EXPECT_STREQ("gadget", unknown[0].toStdString().c_str());
+}
+
+TEST_F(UT_DeviceDumper, UT_DeviceDumper_dumpJson)
+{
+    DeviceMemory *memory = new DeviceMemory;
+    QMap<QString, QString> mapInfo;
+    mapInfo.insert("product", "DDR4 16GB");
+    mapInfo.insert("vendor", "Samsung");
+    memory->setInfoFromLshw(mapInfo);
+    DeviceManager::instance()->addMemoryDevice(memory);
+
+    QStringList unknown;
+    DeviceDumper dumper("json", DeviceDumper::categories({"memory"}, unknown));
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    EXPECT_TRUE(dumper.dump(buffer));
+
+    // 与界面导出的 json 格式相同
+    QJsonObject root = QJsonDocument::fromJson(buffer.data()).object();
+    EXPECT_EQ(1, root.value("version").toInt());
+    QJsonArray devices = root.value("devices").toArray();
+    ASSERT_EQ(1, devices.size());
+    EXPECT_STREQ("memory", devices[0].toObject().value("type").toString().toStdString().c_str());
+    EXPECT_TRUE(devices[0].toObject().value("base").isObject());
+
+    DeviceManager::instance()->m_ListDeviceMemory.clear();
+    delete memory;
+}
+
+TEST_F(UT_DeviceDumper, UT_DeviceDumper_dumpTxt)
+{
+    QStringList unknown;
+    DeviceDumper dumper("txt", DeviceDumper::categories({"cdrom"}, unknown));
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    EXPECT_TRUE(dumper.dump(buffer));
+    EXPECT_TRUE(buffer.data().contains("No CD-ROM found"));
+}
+
+static QStringList ut_dumperCalls;
+static void ut_xrandrApply()
+{
+    ut_dumperCalls.append("xrandr");
+}
+static void ut_upowerApply()
+{
+    ut_dumperCalls.append("upower");
+}
+static void ut_netlinkApply()
+{
+    ut_dumperCalls.append("netlink");
+}
+static bool ut_dump()
+{
+    ut_dumperCalls.append("dump");
+    return true;
+}
+
+TEST_F(UT_DeviceDumper, UT_DeviceDumper_slotTryDump)
+{
+    Stub stub;
+    stub.set(ADDR(ThreadExecXrandr, applyToDeviceManager), ut_xrandrApply);
+    stub.set(ADDR(UPowerMonitor, apply), ut_upowerApply);
+    stub.set(ADDR(NetLinkMonitor, apply), ut_netlinkApply);
+    stub.set(ADDR(DeviceDumper, dump), ut_dump);
+    ut_dumperCalls.clear();
+
+    QStringList unknown;
+    DeviceDumper dumper("txt", DeviceDumper::categories({"network"}, unknown));
+    QSignalSpy spy(&dumper, &DeviceDumper::finished);
+
+    // 显示信息还未获取时不输出
+    dumper.slotLoadingFinish("finish");
+    EXPECT_TRUE(ut_dumperCalls.isEmpty());
+    EXPECT_EQ(0, spy.count());
+
+    // 写入显示、电池和网卡信息后再输出,只输出一次
+    dumper.m_XrandrFinished = true;
+    dumper.slotTryDump();
+    dumper.slotTryDump();
+    EXPECT_EQ(QStringList({"xrandr", "upower", "netlink", "dump"}), ut_dumperCalls);
+    ASSERT_EQ(1, spy.count());
+    EXPECT_EQ(0, spy.at(0).at(0).toInt());
+}
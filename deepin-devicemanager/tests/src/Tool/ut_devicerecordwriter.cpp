@@ -0,0 +1,176 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "DeviceRecordWriter.h"
+#include "SourceTextTranslator.h"
+#include "DeviceCpu.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QCborValue>
+#include <QCborMap>
+#include <QCborArray>
+
+#include <gtest/gtest.h>
+
+class UT_DeviceRecordWriter : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        m_Cpu = new DeviceCpu;
+        m_Cpu->m_Name = "Intel \"Core\"\ti7\n";
+        m_Cpu->m_Vendor = "GenuineIntel";
+        m_Cpu->m_UniqueID = "cpu-0";
+        m_Cpu->m_Driver = "intel_cpufreq";
+    }
+    void TearDown()
+    {
+        delete m_Cpu;
+    }
+    DeviceCpu *m_Cpu;
+};
+
+// 将 Name 翻译为中文的翻译
+class UT_NameTranslator : public QTranslator
+{
+public:
+    QString translate(const char *, const char *sourceText, const char *, int) const override
+    {
+        return QByteArray(sourceText) == "Name" ? QString::fromUtf8("名称") : QString();
+    }
+    bool isEmpty() const override
+    {
+        return false;
+    }
+};
+
+TEST_F(UT_DeviceRecordWriter, UT_DeviceRecordWriter_json)
+{
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+
+    DeviceRecordWriter writer(&buffer, DeviceRecordWriter::RF_Json);
+    writer.writeDevice("cpu", m_Cpu);
+    writer.writeDevice("cpu", m_Cpu);
+    EXPECT_TRUE(writer.finish());
+    EXPECT_EQ(2, writer.deviceCount());
+
+    // 输出为合法json,特殊字符被转义
+    QJsonParseError error;
+    QJsonObject root = QJsonDocument::fromJson(data, &error).object();
+    ASSERT_EQ(QJsonParseError::NoError, error.error);
+    EXPECT_EQ(1, root.value("version").toInt());
+
+    QJsonArray devices = root.value("devices").toArray();
+    ASSERT_EQ(2, devices.size());
+    QJsonObject cpu = devices.at(0).toObject();
+    EXPECT_EQ("cpu", cpu.value("type").toString());
+    EXPECT_EQ(m_Cpu->m_Name, cpu.value("name").toString());
+    EXPECT_EQ("cpu-0", cpu.value("uniqueId").toString());
+    EXPECT_EQ("intel_cpufreq", cpu.value("driver").toString());
+    EXPECT_TRUE(cpu.value("enable").isBool());
+    EXPECT_EQ(m_Cpu->getBaseAttribs().size(), cpu.value("base").toObject().size());
+    EXPECT_TRUE(cpu.value("other").isObject());
+}
+
+TEST_F(UT_DeviceRecordWriter, UT_DeviceRecordWriter_jsonEmpty)
+{
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+
+    DeviceRecordWriter writer(&buffer, DeviceRecordWriter::RF_Json);
+    EXPECT_TRUE(writer.finish());
+    EXPECT_TRUE(QJsonDocument::fromJson(data).object().value("devices").toArray().isEmpty());
+}
+
+TEST_F(UT_DeviceRecordWriter, UT_DeviceRecordWriter_cbor)
+{
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+
+    DeviceRecordWriter writer(&buffer, DeviceRecordWriter::RF_Cbor);
+    writer.writeDevice("cpu", m_Cpu);
+    EXPECT_TRUE(writer.finish());
+
+    // 以自描述标签开头
+    EXPECT_TRUE(data.startsWith("\xd9\xd9\xf7"));
+
+    QCborParserError error;
+    QCborValue value = QCborValue::fromCbor(data, &error);
+    ASSERT_EQ(QCborError::NoError, error.error.c);
+    ASSERT_TRUE(value.isTag());
+
+    QCborMap root = value.taggedValue().toMap();
+    EXPECT_EQ(1, root.value(QLatin1String("version")).toInteger());
+    QCborArray devices = root.value(QLatin1String("devices")).toArray();
+    ASSERT_EQ(1, devices.size());
+    QCborMap cpu = devices.at(0).toMap();
+    EXPECT_EQ(m_Cpu->m_Name, cpu.value(QLatin1String("name")).toString());
+    EXPECT_EQ("cpu-0", cpu.value(QLatin1String("uniqueId")).toString());
+    EXPECT_EQ(m_Cpu->getBaseAttribs().size(), cpu.value(QLatin1String("base")).toMap().size());
+
+    // 与json相比更紧凑
+    QByteArray json;
+    QBuffer jsonBuffer(&json);
+    jsonBuffer.open(QIODevice::WriteOnly);
+    DeviceRecordWriter jsonWriter(&jsonBuffer, DeviceRecordWriter::RF_Json);
+    jsonWriter.writeDevice("cpu", m_Cpu);
+    jsonWriter.finish();
+    EXPECT_LT(data.size(), json.size());
+}
+
+TEST_F(UT_DeviceRecordWriter, UT_DeviceRecordWriter_sourceKeys)
+{
+    UT_NameTranslator nameTranslator;
+    SourceTextTranslator sourceTranslator;
+    QCoreApplication::installTranslator(&nameTranslator);
+    QCoreApplication::installTranslator(&sourceTranslator);
+
+    // 界面显示翻译后的属性名
+    ASSERT_FALSE(m_Cpu->getBaseAttribs().isEmpty());
+    EXPECT_EQ(QString::fromUtf8("名称"), m_Cpu->getBaseAttribs().first().first);
+
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    DeviceRecordWriter writer(&buffer, DeviceRecordWriter::RF_Json);
+    writer.writeDevice("cpu", m_Cpu);
+    EXPECT_TRUE(writer.finish());
+
+    // 记录中使用原文,缓存的显示信息不变
+    QJsonObject base = QJsonDocument::fromJson(data).object().value("devices").toArray().at(0).toObject().value("base").toObject();
+    EXPECT_EQ(m_Cpu->m_Name, base.value("Name").toString());
+    EXPECT_FALSE(base.contains(QString::fromUtf8("名称")));
+    EXPECT_EQ(QString::fromUtf8("名称"), m_Cpu->getBaseAttribs().first().first);
+    EXPECT_FALSE(SourceTextTranslator::isActive());
+
+    QCoreApplication::removeTranslator(&sourceTranslator);
+    QCoreApplication::removeTranslator(&nameTranslator);
+}
+
+TEST_F(UT_DeviceRecordWriter, UT_DeviceRecordWriter_makeKeysUnique)
+{
+    QList<QPair<QString, QString>> attribs;
+    attribs << qMakePair(QString("Speed"), QString("1"))
+            << qMakePair(QString("Speed"), QString("2"))
+            << qMakePair(QString("Speed"), QString("3"))
+            << qMakePair(QString("Vendor"), QString("Intel"));
+    DeviceRecordWriter::makeKeysUnique(attribs);
+
+    ASSERT_EQ(4, attribs.size());
+    EXPECT_EQ("Speed", attribs[0].first);
+    EXPECT_EQ("Speed (2)", attribs[1].first);
+    EXPECT_EQ("Speed (3)", attribs[2].first);
+    EXPECT_EQ("Vendor", attribs[3].first);
+    EXPECT_EQ("3", attribs[2].second);
+}
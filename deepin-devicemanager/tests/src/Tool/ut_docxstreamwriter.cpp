@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "DocxStreamWriter.h"
+#include "ZipStreamWriter.h"
+#include "DeviceManager.h"
+#include "DeviceOthers.h"
+#include "MacroDefinition.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QDir>
+#include <QFile>
+#include <QBuffer>
+#include <private/qzipreader_p.h>
+
+#include <gtest/gtest.h>
+
+class UT_DocxStreamWriter : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        m_Path = QDir::tempPath() + "/ut_docxstreamwriter.docx";
+    }
+    void TearDown()
+    {
+        QFile::remove(m_Path);
+    }
+    QString m_Path;
+};
+
+TEST_F(UT_DocxStreamWriter, UT_DocxStreamWriter_save)
+{
+    // 模板不存在时使用内置部件
+    DocxStreamWriter writer(m_Path, "/nonexistent/template.docx");
+    writer.addHeading("[CPU]", 2);
+    writer.addParagraph("Name:  Intel <Core> & i7");
+    writer.beginTable(QStringList() << "Name" << "Vendor");
+    writer.addTableRow(QStringList() << "cpu0" << "Intel" << "dropped");
+    writer.addParagraph("\n");
+    EXPECT_TRUE(writer.save());
+
+    // 用 QZipReader 读回校验
+    QZipReader reader(m_Path);
+    EXPECT_EQ(QZipReader::NoError, reader.status());
+    EXPECT_FALSE(reader.fileData("[Content_Types].xml").isEmpty());
+    EXPECT_FALSE(reader.fileData("_rels/.rels").isEmpty());
+
+    QString document = QString::fromUtf8(reader.fileData("word/document.xml"));
+    EXPECT_TRUE(document.startsWith("<?xml"));
+    EXPECT_TRUE(document.endsWith("</w:document>"));
+    EXPECT_TRUE(document.contains("<w:pStyle w:val=\"2\"/>"));
+    EXPECT_TRUE(document.contains("Intel &lt;Core&gt; &amp; i7"));
+    EXPECT_EQ(2, document.count("<w:gridCol "));
+    EXPECT_TRUE(document.contains("cpu0"));
+    EXPECT_FALSE(document.contains("dropped"));
+    EXPECT_TRUE(document.indexOf("</w:tbl>") < document.lastIndexOf("<w:br/>"));
+}
+
+TEST_F(UT_DocxStreamWriter, UT_ZipStreamWriter_crc32)
+{
+    QByteArray data("123456789");
+    EXPECT_EQ(0xCBF43926u, ZipStreamWriter::crc32(0, data.constData(), data.size()));
+
+    // 分段计算与整体计算一致
+    quint32 crc = ZipStreamWriter::crc32(0, data.constData(), 4);
+    EXPECT_EQ(0xCBF43926u, ZipStreamWriter::crc32(crc, data.constData() + 4, data.size() - 4));
+}
+
+TEST_F(UT_DocxStreamWriter, UT_ZipStreamWriter_escapeXml)
+{
+    EXPECT_STREQ("a &lt;b&gt; &amp; &quot;c&quot;\td", ZipStreamWriter::escapeXml(QString("a <b> & \"c\"\td\x01")).toStdString().c_str());
+}
+
+TEST_F(UT_DocxStreamWriter, UT_DeviceManager_exportToHtml)
+{
+    DeviceManager::instance()->m_ListDeviceOthers.clear();
+    for (int i = 0; i < 2; ++i) {
+        DeviceOthers *device = new DeviceOthers;
+        device->m_Name = QString("USB <Device> %1").arg(i);
+        device->m_Vendor = "Vendor & Co";
+        DeviceManager::instance()->m_ListDeviceOthers.append(device);
+    }
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    DeviceManager::instance()->overviewToHtml(buffer);
+    EXPORT_TO_HTML(buffer, DeviceManager::instance()->m_ListDeviceOthers, QString("Other Devices"), QString("No other devices found"));
+
+    QString html = QString::fromUtf8(buffer.data());
+    EXPECT_TRUE(html.contains("<h2>[Other Devices]</h2>"));
+    EXPECT_TRUE(html.contains("Vendor &amp; Co"));
+    EXPECT_FALSE(html.contains("<Device>"));
+    EXPECT_EQ(html.count("<tr><td style="), 2);
+
+    foreach (auto device, DeviceManager::instance()->m_ListDeviceOthers)
+        delete device;
+    DeviceManager::instance()->m_ListDeviceOthers.clear();
+}
@@ -0,0 +1,222 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "EdidDecoder.h"
+#include "EDIDParser.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QElapsedTimer>
+#include <QDebug>
+
+#include <gtest/gtest.h>
+
+// 与 ut_edidparser 相同的显示器:基本块 + CEA-861 扩展块
+static const char *decoderEdidHex = "00ffffffffffff005a63384001010101"
+                                    "0d1e010380351d782ece65a657519f27"
+                                    "0f5054bfef80b300a940a9c095009040"
+                                    "8180814081c0023a801871382d40582c"
+                                    "45000f282100001e000000ff00565351"
+                                    "3230313332313330320a000000fd0032"
+                                    "4b185311000a202020202020000000fc"
+                                    "005641323433302d4648440a20200141"
+                                    "020320f14d9005040302121113141e1d"
+                                    "1f0123097f078301000065030c001000"
+                                    "023a801871382d40582c45000f282100"
+                                    "001e011d8018711c1620582c25000f28"
+                                    "2100009e011d007251d01e206e285500"
+                                    "0f282100001e8c0ad08a20e02d10103e"
+                                    "96000f28210000188c0ad09020403120"
+                                    "0c4055000f28210000180000000000d6";
+
+static void fixChecksum(QByteArray &edid, int block)
+{
+    uchar sum = 0;
+    for (int i = block * 128; i < block * 128 + 127; ++i)
+        sum = uchar(sum + uchar(edid[i]));
+    edid[block * 128 + 127] = char(uchar(0x100 - sum));
+}
+
+static QByteArray hexLines(const QByteArray &edid)
+{
+    QByteArray hex;
+    for (int i = 0; i < edid.size(); i += 16)
+        hex += edid.mid(i, 16).toHex() + "\n";
+    return hex;
+}
+
+/**
+ * @brief syntheticEdid:基本块 + 带HDR静态元数据的CEA块 + 带拼接拓扑的DisplayID块
+ */
+static QByteArray syntheticEdid()
+{
+    QByteArray edid = QByteArray::fromHex(decoderEdidHex).left(128);
+    edid[126] = 2;
+
+    QByteArray cea(128, 0);
+    const char ceaData[] = {0x02, 0x03, 11, 0x00,
+                            char(0xE6), 0x06, 0x05, 0x01, 0x78, 0x5A, 0x20
+                           };
+    cea.replace(0, sizeof(ceaData), QByteArray(ceaData, sizeof(ceaData)));
+
+    QByteArray displayId(128, 0);
+    const char displayIdData[] = {0x70, 0x12, 25, 0x00, 0x00,
+                                  0x12, 0x00, 22, char(0x82), 0x10, 0x10, 0x00, 0x7F, 0x07, 0x6F, 0x08
+                                 };
+    displayId.replace(0, sizeof(displayIdData), QByteArray(displayIdData, sizeof(displayIdData)));
+
+    edid += cea + displayId;
+    for (int i = 0; i < 3; ++i)
+        fixChecksum(edid, i);
+    return edid;
+}
+
+class UT_EdidDecoder : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        m_Edid = QByteArray::fromHex(decoderEdidHex);
+    }
+    void TearDown()
+    {
+    }
+    QByteArray m_Edid;
+    EdidDecoder m_Decoder;
+};
+
+TEST_F(UT_EdidDecoder, UT_EdidDecoder_decode_invalid)
+{
+    QString errorMsg;
+    EXPECT_FALSE(m_Decoder.decode(QByteArray(), errorMsg));
+    EXPECT_FALSE(m_Decoder.decode(m_Edid.mid(1), errorMsg));
+    EXPECT_FALSE(errorMsg.isEmpty());
+}
+
+TEST_F(UT_EdidDecoder, UT_EdidDecoder_decode_sameAsParser)
+{
+    QString errorMsg;
+    ASSERT_TRUE(m_Decoder.decode(m_Edid, errorMsg));
+
+    EDIDParser parser;
+    parser.setEdid(QString::fromLatin1(hexLines(m_Edid)), errorMsg);
+    EXPECT_EQ(parser.vendor(), m_Decoder.vendor());
+    EXPECT_EQ(parser.model(), m_Decoder.model());
+    EXPECT_EQ(parser.releaseDate(), m_Decoder.releaseDate());
+    EXPECT_EQ(parser.screenSize(), m_Decoder.screenSize());
+    EXPECT_EQ(parser.width(), m_Decoder.width());
+    EXPECT_EQ(parser.height(), m_Decoder.height());
+}
+
+TEST_F(UT_EdidDecoder, UT_EdidDecoder_decode_baseBlock)
+{
+    QString errorMsg;
+    ASSERT_TRUE(m_Decoder.decode(m_Edid, errorMsg));
+    EXPECT_STREQ("VSC", m_Decoder.vendor().toStdString().c_str());
+    EXPECT_STREQ("3840", m_Decoder.model().toStdString().c_str());
+    EXPECT_STREQ("1.3", m_Decoder.version().toStdString().c_str());
+    EXPECT_STREQ("VA2430-FHD", m_Decoder.monitorName().toStdString().c_str());
+    EXPECT_STREQ("VSQ201321302", m_Decoder.serialNumber().toStdString().c_str());
+    EXPECT_EQ(1920, m_Decoder.preferredWidth());
+    EXPECT_EQ(1080, m_Decoder.preferredHeight());
+    EXPECT_EQ(1, m_Decoder.extensionCount());
+    EXPECT_TRUE(m_Decoder.hasCea());
+    EXPECT_FALSE(m_Decoder.hdr().valid);
+    EXPECT_FALSE(m_Decoder.tile().valid);
+
+    const EdidDecoder::RangeLimits &range = m_Decoder.rangeLimits();
+    EXPECT_TRUE(range.valid);
+    EXPECT_EQ(50, range.minVRate);
+    EXPECT_EQ(75, range.maxVRate);
+    EXPECT_EQ(24, range.minHRate);
+    EXPECT_EQ(83, range.maxHRate);
+    EXPECT_EQ(170, range.maxPixelClock);
+}
+
+TEST_F(UT_EdidDecoder, UT_EdidDecoder_decode_extensions)
+{
+    QString errorMsg;
+    ASSERT_TRUE(m_Decoder.decode(syntheticEdid(), errorMsg));
+    EXPECT_EQ(2, m_Decoder.extensionCount());
+    EXPECT_TRUE(m_Decoder.checksumValid());
+
+    const EdidDecoder::HdrMetadata &hdr = m_Decoder.hdr();
+    EXPECT_TRUE(hdr.valid);
+    EXPECT_TRUE(hdr.eotf & EdidDecoder::EOTF_SmpteSt2084);
+    EXPECT_FALSE(hdr.eotf & EdidDecoder::EOTF_Hlg);
+    EXPECT_EQ(0x78, hdr.maxLuminance);
+    EXPECT_EQ(0x20, hdr.minLuminance);
+
+    const EdidDecoder::TileInfo &tile = m_Decoder.tile();
+    EXPECT_TRUE(tile.valid);
+    EXPECT_EQ(2, tile.hTiles);
+    EXPECT_EQ(1, tile.vTiles);
+    EXPECT_EQ(1, tile.hLocation);
+    EXPECT_EQ(0, tile.vLocation);
+    EXPECT_EQ(1920, tile.tileWidth);
+    EXPECT_EQ(2160, tile.tileHeight);
+}
+
+TEST_F(UT_EdidDecoder, UT_EdidDecoder_decode_truncated)
+{
+    // 扩展块数量大于实际数据时只解码已有的块;数据块长度越界时停止解析
+    QByteArray edid = syntheticEdid().left(128 + 64);
+    QString errorMsg;
+    EXPECT_TRUE(m_Decoder.decode(edid, errorMsg));
+    EXPECT_EQ(0, m_Decoder.extensionCount());
+
+    edid = syntheticEdid();
+    edid[128 + 2] = char(0x7F);
+    edid[128 + 4] = char(0xFF);
+    EXPECT_TRUE(m_Decoder.decode(edid, errorMsg));
+    EXPECT_FALSE(m_Decoder.checksumValid());
+}
+
+TEST_F(UT_EdidDecoder, UT_EdidDecoder_decode_reuse)
+{
+    // 同一个解码器依次解码不同的 edid,每次结果都与 EDIDParser 一致,不残留上次的状态
+    QList<QByteArray> edids;
+    edids << syntheticEdid() << m_Edid << syntheticEdid().left(128);
+    QString errorMsg;
+    EdidDecoder decoder;
+    foreach (const QByteArray &edid, edids) {
+        ASSERT_TRUE(decoder.decode(edid, errorMsg));
+
+        EDIDParser parser;
+        parser.setEdid(QString::fromLatin1(hexLines(edid)), errorMsg);
+        EXPECT_EQ(parser.vendor(), decoder.vendor());
+        EXPECT_EQ(parser.model(), decoder.model());
+        EXPECT_EQ(parser.releaseDate(), decoder.releaseDate());
+        EXPECT_EQ(parser.screenSize(), decoder.screenSize());
+        EXPECT_EQ(parser.width(), decoder.width());
+        EXPECT_EQ(parser.height(), decoder.height());
+    }
+    EXPECT_EQ(0, decoder.extensionCount());
+    EXPECT_FALSE(decoder.tile().valid);
+}
+
+// 性能对比只输出耗时,默认不运行,使用 --gtest_also_run_disabled_tests 运行
+TEST_F(UT_EdidDecoder, DISABLED_UT_EdidDecoder_decode_benchmark)
+{
+    const int count = 10000;
+    const QString hex = QString::fromLatin1(hexLines(m_Edid));
+    QString errorMsg;
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < count; ++i) {
+        EdidDecoder decoder;
+        decoder.decode(m_Edid, errorMsg);
+    }
+    qint64 decoderMs = timer.elapsed();
+
+    timer.restart();
+    for (int i = 0; i < count; ++i) {
+        EDIDParser parser;
+        parser.setEdid(hex, errorMsg);
+    }
+    qint64 parserMs = timer.elapsed();
+
+    qInfo() << "decode edid" << count << "times, EdidDecoder:" << decoderMs << "ms, EDIDParser:" << parserMs << "ms";
+}
@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ExportInfoThread.h"
+#include "DeviceManager.h"
+#include "DeviceCpu.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QDir>
+#include <QFile>
+
+#include <gtest/gtest.h>
+
+class UT_ExportInfoThread : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        m_Path = QDir::tempPath() + "/ut_exportinfothread.txt";
+        m_Thread = new ExportInfoThread;
+
+        m_Cpu = new DeviceCpu;
+        m_Cpu->m_Name = "Processor 0";
+        DeviceManager::instance()->m_ListDeviceCPU.append(m_Cpu);
+    }
+    void TearDown()
+    {
+        DeviceManager::instance()->m_ListDeviceCPU.clear();
+        delete m_Cpu;
+        delete m_Thread;
+        QFile::remove(m_Path);
+    }
+    QString m_Path;
+    ExportInfoThread *m_Thread;
+    DeviceCpu *m_Cpu;
+};
+
+TEST_F(UT_ExportInfoThread, UT_ExportInfoThread_run)
+{
+    // 已存在的目标文件被整体替换
+    QFile old(m_Path);
+    ASSERT_TRUE(old.open(QIODevice::WriteOnly));
+    old.write("old content");
+    old.close();
+
+    int lastWritten = -1;
+    int lastTotal = -1;
+    bool finished = false;
+    bool exportSuccess = false;
+    QObject::connect(m_Thread, &ExportInfoThread::progressChanged, [&](int written, int total) {
+        lastWritten = written;
+        lastTotal = total;
+    });
+    QObject::connect(m_Thread, &ExportInfoThread::exportFinished, [&](bool success, bool canceled) {
+        finished = true;
+        exportSuccess = success && !canceled;
+    });
+
+    // 在当前线程中直接执行,信号同步送达
+    m_Thread->setExportInfo(m_Path, DeviceManager::EF_Txt);
+    m_Thread->run();
+
+    EXPECT_TRUE(finished);
+    EXPECT_TRUE(exportSuccess);
+    EXPECT_EQ(1, lastTotal);
+    EXPECT_EQ(1, lastWritten);
+    EXPECT_FALSE(QFile::exists(ExportInfoThread::tempFilePath(m_Path)));
+
+    QFile file(m_Path);
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    QString content = QString::fromUtf8(file.readAll());
+    EXPECT_FALSE(content.contains("old content"));
+    EXPECT_TRUE(content.contains("Processor 0"));
+}
+
+TEST_F(UT_ExportInfoThread, UT_ExportInfoThread_cancel)
+{
+    bool exportCanceled = false;
+    QObject::connect(m_Thread, &ExportInfoThread::exportFinished, [&](bool success, bool canceled) {
+        exportCanceled = !success && canceled;
+    });
+
+    // 第一次进度回调即取消,不留下任何文件
+    m_Thread->setExportInfo(m_Path, DeviceManager::EF_Doc);
+    QObject::connect(m_Thread, &ExportInfoThread::progressChanged, [this](int, int) {
+        m_Thread->cancel();
+    });
+    m_Thread->run();
+
+    EXPECT_TRUE(exportCanceled);
+    EXPECT_FALSE(QFile::exists(m_Path));
+    EXPECT_FALSE(QFile::exists(ExportInfoThread::tempFilePath(m_Path)));
+}
@@ -0,0 +1,301 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "NetLinkMonitor.h"
+#include "DeviceNetwork.h"
+#include "DeviceManager.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QSignalSpy>
+
+#include <gtest/gtest.h>
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/if.h>
+#include <linux/if_link.h>
+#include <sys/socket.h>
+#include <sched.h>
+#include <unistd.h>
+#include <string.h>
+#include <thread>
+
+// 追加一个属性,长度按 4 字节对齐
+static void ut_addAttr(QByteArray &msg, ushort type, const QByteArray &data)
+{
+    rtattr attr;
+    attr.rta_len = ushort(RTA_LENGTH(data.size()));
+    attr.rta_type = type;
+    msg.append(reinterpret_cast<const char *>(&attr), sizeof(attr));
+    msg.append(data);
+    msg.append(QByteArray(int(RTA_ALIGN(attr.rta_len)) - attr.rta_len, 0));
+}
+
+static QByteArray ut_linkMessage(ushort type, int index, uint flags, ushort msgFlags = 0)
+{
+    QByteArray msg(int(NLMSG_LENGTH(sizeof(ifinfomsg))), 0);
+    nlmsghdr *header = reinterpret_cast<nlmsghdr *>(msg.data());
+    header->nlmsg_type = type;
+    header->nlmsg_flags = msgFlags;
+    ifinfomsg *info = static_cast<ifinfomsg *>(NLMSG_DATA(header));
+    info->ifi_family = AF_UNSPEC;
+    info->ifi_index = index;
+    info->ifi_flags = flags;
+    info->ifi_change = flags;
+    return msg;
+}
+
+static void ut_finishMessage(QByteArray &msg)
+{
+    reinterpret_cast<nlmsghdr *>(msg.data())->nlmsg_len = quint32(msg.size());
+}
+
+class UT_NetLinkMonitor : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+    }
+    void TearDown()
+    {
+    }
+};
+
+TEST_F(UT_NetLinkMonitor, UT_NetLinkMonitor_parseMessages)
+{
+    QByteArray msg = ut_linkMessage(RTM_NEWLINK, 2, IFF_UP | IFF_RUNNING | IFF_LOWER_UP);
+    ut_addAttr(msg, IFLA_IFNAME, QByteArray("enp2s0", 7));
+    ut_addAttr(msg, IFLA_ADDRESS, QByteArray::fromHex("001b21aabbcc"));
+    ut_addAttr(msg, IFLA_OPERSTATE, QByteArray(1, char(IF_OPER_UP)));
+    ut_finishMessage(msg);
+
+    QByteArray down = ut_linkMessage(RTM_NEWLINK, 3, IFF_UP);
+    ut_addAttr(down, IFLA_IFNAME, QByteArray("wlp3s0", 7));
+    ut_addAttr(down, IFLA_OPERSTATE, QByteArray(1, char(IF_OPER_DORMANT)));
+    ut_finishMessage(down);
+
+    // 一个数据报中带多个消息
+    QByteArray buffer = msg + down;
+    QMap<int, NetLinkMonitor::Link> links;
+    EXPECT_EQ(2, NetLinkMonitor::parseMessages(buffer.constData(), buffer.size(), links));
+    ASSERT_EQ(2, links.size());
+    EXPECT_STREQ("enp2s0", links[2].name.toStdString().c_str());
+    EXPECT_STREQ("00:1b:21:aa:bb:cc", links[2].mac.toStdString().c_str());
+    EXPECT_STREQ("yes", NetLinkMonitor::linkStatus(links[2]).toStdString().c_str());
+    EXPECT_STREQ("no", NetLinkMonitor::linkStatus(links[3]).toStdString().c_str());
+
+    // 只带运行状态的消息不改变名称和地址
+    links[2].speed = 1000;
+    QByteArray change = ut_linkMessage(RTM_NEWLINK, 2, IFF_UP);
+    ut_addAttr(change, IFLA_OPERSTATE, QByteArray(1, char(IF_OPER_DOWN)));
+    ut_finishMessage(change);
+    EXPECT_EQ(1, NetLinkMonitor::parseMessages(change.constData(), change.size(), links));
+    EXPECT_STREQ("enp2s0", links[2].name.toStdString().c_str());
+    EXPECT_STREQ("00:1b:21:aa:bb:cc", links[2].mac.toStdString().c_str());
+    EXPECT_EQ(1000, links[2].speed);
+    EXPECT_STREQ("no", NetLinkMonitor::linkStatus(links[2]).toStdString().c_str());
+
+    QByteArray del = ut_linkMessage(RTM_DELLINK, 3, 0);
+    ut_finishMessage(del);
+    EXPECT_EQ(1, NetLinkMonitor::parseMessages(del.constData(), del.size(), links));
+    EXPECT_FALSE(links.contains(3));
+
+    // 截断的消息被忽略
+    QMap<int, NetLinkMonitor::Link> none;
+    EXPECT_EQ(0, NetLinkMonitor::parseMessages(msg.constData(), 8, none));
+    EXPECT_TRUE(none.isEmpty());
+}
+
+TEST_F(UT_NetLinkMonitor, UT_NetLinkMonitor_linksChanged)
+{
+    QMap<int, NetLinkMonitor::Link> old;
+    old[2].index = 2;
+    old[2].name = "enp2s0";
+    old[2].mac = "00:1b:21:aa:bb:cc";
+    old[2].flags = IFF_UP | IFF_RUNNING | IFF_LOWER_UP;
+    old[2].operState = IF_OPER_UP;
+
+    // 速率不参与比较,由 updateSpeed 处理
+    QMap<int, NetLinkMonitor::Link> links = old;
+    links[2].speed = 1000;
+    EXPECT_FALSE(NetLinkMonitor::linksChanged(old, links));
+
+    links = old;
+    links[2].operState = IF_OPER_DOWN;
+    EXPECT_TRUE(NetLinkMonitor::linksChanged(old, links));
+
+    links = old;
+    links[2].mac = "00:1b:21:aa:bb:cd";
+    EXPECT_TRUE(NetLinkMonitor::linksChanged(old, links));
+
+    links = old;
+    links.remove(2);
+    links[3] = old[2];
+    EXPECT_TRUE(NetLinkMonitor::linksChanged(old, links));
+}
+
+TEST_F(UT_NetLinkMonitor, UT_NetLinkMonitor_slotReadyRead)
+{
+    int fds[2];
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds));
+
+    NetLinkMonitor monitor;
+    monitor.m_Socket = fds[0];
+    QSignalSpy spy(&monitor, &NetLinkMonitor::updated);
+
+    QByteArray msg = ut_linkMessage(RTM_NEWLINK, 2, IFF_UP);
+    ut_addAttr(msg, IFLA_IFNAME, QByteArray("enp2s0", 7));
+    ut_addAttr(msg, IFLA_OPERSTATE, QByteArray(1, char(IF_OPER_DOWN)));
+    ut_finishMessage(msg);
+
+    // 新接口通知一次
+    ASSERT_EQ(msg.size(), int(send(fds[1], msg.constData(), size_t(msg.size()), 0)));
+    monitor.slotReadyRead();
+    EXPECT_EQ(1, spy.count());
+
+    // 相同状态的 RTM_NEWLINK 不再通知
+    ASSERT_EQ(msg.size(), int(send(fds[1], msg.constData(), size_t(msg.size()), 0)));
+    monitor.slotReadyRead();
+    EXPECT_EQ(1, spy.count());
+
+    close(fds[1]);
+}
+
+TEST_F(UT_NetLinkMonitor, UT_NetLinkMonitor_speedString)
+{
+    EXPECT_STREQ("1Gbit/s", NetLinkMonitor::speedString(1000).toStdString().c_str());
+    EXPECT_STREQ("10Gbit/s", NetLinkMonitor::speedString(10000).toStdString().c_str());
+    EXPECT_STREQ("100Mbit/s", NetLinkMonitor::speedString(100).toStdString().c_str());
+    EXPECT_STREQ("2500Mbit/s", NetLinkMonitor::speedString(2500).toStdString().c_str());
+    EXPECT_TRUE(NetLinkMonitor::speedString(-1).isEmpty());
+}
+
+TEST_F(UT_NetLinkMonitor, UT_NetLinkMonitor_dumpLinks)
+{
+    // 任何网络命名空间中都有回环接口
+    QMap<int, NetLinkMonitor::Link> links;
+    ASSERT_TRUE(NetLinkMonitor::dumpLinks(links));
+    bool found = false;
+    foreach (const NetLinkMonitor::Link &link, links) {
+        if (link.name == "lo")
+            found = true;
+    }
+    EXPECT_TRUE(found);
+}
+
+TEST_F(UT_NetLinkMonitor, UT_NetLinkMonitor_apply)
+{
+    NetLinkMonitor *monitor = NetLinkMonitor::instance();
+    NetLinkMonitor::Link link;
+    link.index = 2;
+    link.name = "enp2s0";
+    link.operState = IF_OPER_UP;
+    link.speed = 1000;
+    monitor->m_Links.insert(link.index, link);
+    monitor->m_Valid = true;
+
+    DeviceNetwork *network = new DeviceNetwork;
+    network->m_LogicalName = "enp2s0";
+    network->m_Link = "no";
+    network->m_Speed = "100Mbit/s";
+    DeviceManager::instance()->m_ListDeviceNetwork.append(network);
+
+    monitor->apply();
+    EXPECT_STREQ("yes", network->m_Link.toStdString().c_str());
+    EXPECT_STREQ("1Gbit/s", network->m_Speed.toStdString().c_str());
+
+    DeviceManager::instance()->m_ListDeviceNetwork.clear();
+    delete network;
+    monitor->m_Links.clear();
+    monitor->m_Valid = false;
+}
+
+TEST_F(UT_NetLinkMonitor, UT_NetLinkMonitor_dummyInNamespace)
+{
+    // 在独立的网络命名空间中创建 dummy 接口,只影响该线程;没有权限时跳过
+    bool supported = false;
+    bool dumped = false;
+    bool added = false;
+    bool removed = false;
+    QString status;
+    QString mac;
+
+    std::thread worker([&]() {
+        if (unshare(CLONE_NEWNET) != 0)
+            return;
+
+        int monitor = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+        sockaddr_nl addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.nl_family = AF_NETLINK;
+        addr.nl_groups = RTMGRP_LINK;
+        if (monitor < 0 || bind(monitor, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0)
+            return;
+
+        auto request = [](QByteArray msg) {
+            int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+            ut_finishMessage(msg);
+            bool ok = send(fd, msg.constData(), size_t(msg.size()), 0) == msg.size();
+            char ack[4096];
+            ssize_t len = ok ? recv(fd, ack, sizeof(ack), 0) : -1;
+            close(fd);
+            const nlmsghdr *header = reinterpret_cast<const nlmsghdr *>(ack);
+            return len > 0 && header->nlmsg_type == NLMSG_ERROR
+                   && static_cast<const nlmsgerr *>(NLMSG_DATA(header))->error == 0;
+        };
+
+        QByteArray kind;
+        ut_addAttr(kind, IFLA_INFO_KIND, QByteArray("dummy", 6));
+        QByteArray create = ut_linkMessage(RTM_NEWLINK, 0, IFF_UP, NLM_F_REQUEST | NLM_F_CREATE | NLM_F_EXCL | NLM_F_ACK);
+        ut_addAttr(create, IFLA_IFNAME, QByteArray("utdummy0", 9));
+        ut_addAttr(create, IFLA_LINKINFO, kind);
+        if (!request(create)) {
+            close(monitor);
+            return;
+        }
+        supported = true;
+
+        QMap<int, NetLinkMonitor::Link> links;
+        dumped = NetLinkMonitor::dumpLinks(links);
+        foreach (const NetLinkMonitor::Link &link, links) {
+            if (link.name == "utdummy0") {
+                status = NetLinkMonitor::linkStatus(link);
+                mac = link.mac;
+            }
+        }
+
+        char buffer[32768];
+        QMap<int, NetLinkMonitor::Link> events;
+        ssize_t len;
+        while ((len = recv(monitor, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0)
+            NetLinkMonitor::parseMessages(buffer, int(len), events);
+        foreach (const NetLinkMonitor::Link &link, events) {
+            if (link.name == "utdummy0")
+                added = true;
+        }
+
+        QByteArray del = ut_linkMessage(RTM_DELLINK, 0, 0, NLM_F_REQUEST | NLM_F_ACK);
+        ut_addAttr(del, IFLA_IFNAME, QByteArray("utdummy0", 9));
+        if (request(del)) {
+            while ((len = recv(monitor, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0)
+                NetLinkMonitor::parseMessages(buffer, int(len), events);
+            removed = true;
+            foreach (const NetLinkMonitor::Link &link, events) {
+                if (link.name == "utdummy0")
+                    removed = false;
+            }
+        }
+        close(monitor);
+    });
+    worker.join();
+
+    if (!supported)
+        GTEST_SKIP() << "network namespace or dummy interface unavailable";
+    EXPECT_TRUE(dumped);
+    EXPECT_TRUE(added);
+    EXPECT_TRUE(removed);
+    EXPECT_STREQ("yes", status.toStdString().c_str());
+    EXPECT_EQ(17, mac.size());
+}
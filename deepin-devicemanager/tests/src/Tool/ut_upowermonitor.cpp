@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "UPowerMonitor.h"
+#include "DevicePower.h"
+#include "DeviceManager.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QVariantMap>
+
+#include <gtest/gtest.h>
+
+class UT_UPowerMonitor : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        m_Properties.insert("Type", uint(2));
+        m_Properties.insert("PowerSupply", true);
+        m_Properties.insert("NativePath", "BAT0");
+        m_Properties.insert("Vendor", "SMP");
+        m_Properties.insert("Model", "5B10W13930");
+        m_Properties.insert("Serial", "1234");
+        m_Properties.insert("IsPresent", true);
+        m_Properties.insert("IsRechargeable", true);
+        m_Properties.insert("State", uint(2));
+        m_Properties.insert("WarningLevel", uint(1));
+        m_Properties.insert("Energy", 40.5);
+        m_Properties.insert("EnergyFull", 50.0);
+        m_Properties.insert("EnergyFullDesign", 57.0);
+        m_Properties.insert("EnergyRate", 7.25);
+        m_Properties.insert("Voltage", 12.3);
+        m_Properties.insert("Percentage", 81.0);
+        m_Properties.insert("Capacity", 87.7193);
+        m_Properties.insert("Technology", uint(2));
+        m_Properties.insert("IconName", "battery-full-symbolic");
+        m_Properties.insert("TimeToEmpty", qint64(20000));
+    }
+    void TearDown()
+    {
+    }
+
+    QVariantMap m_Properties;
+};
+
+TEST_F(UT_UPowerMonitor, UT_UPowerMonitor_updateBattery)
+{
+    UPowerMonitor::Battery battery;
+    UPowerMonitor::updateBattery(battery, m_Properties);
+    EXPECT_EQ(2u, battery.type);
+    EXPECT_TRUE(battery.powerSupply);
+    EXPECT_STREQ("BAT0", battery.nativePath.toStdString().c_str());
+    EXPECT_DOUBLE_EQ(81.0, battery.percentage);
+    EXPECT_EQ(20000, battery.timeToEmpty);
+
+    // PropertiesChanged 只带变化的属性,其它字段保持不变
+    QVariantMap changed;
+    changed.insert("Percentage", 80.0);
+    changed.insert("State", uint(1));
+    UPowerMonitor::updateBattery(battery, changed);
+    EXPECT_DOUBLE_EQ(80.0, battery.percentage);
+    EXPECT_EQ(1u, battery.state);
+    EXPECT_DOUBLE_EQ(12.3, battery.voltage);
+    EXPECT_STREQ("1234", battery.serial.toStdString().c_str());
+}
+
+TEST_F(UT_UPowerMonitor, UT_UPowerMonitor_batteryInfo)
+{
+    UPowerMonitor::Battery battery;
+    battery.path = "/org/freedesktop/UPower/devices/battery_BAT0";
+    UPowerMonitor::updateBattery(battery, m_Properties);
+
+    QMap<QString, QString> mapInfo = UPowerMonitor::batteryInfo(battery);
+    EXPECT_STREQ("BAT0", mapInfo["native-path"].toStdString().c_str());
+    EXPECT_STREQ("yes", mapInfo["power supply"].toStdString().c_str());
+    EXPECT_STREQ("discharging", mapInfo["state"].toStdString().c_str());
+    EXPECT_STREQ("none", mapInfo["warning-level"].toStdString().c_str());
+    EXPECT_STREQ("40.5 Wh", mapInfo["energy"].toStdString().c_str());
+    EXPECT_STREQ("7.25 W", mapInfo["energy-rate"].toStdString().c_str());
+    EXPECT_STREQ("12.3 V", mapInfo["voltage"].toStdString().c_str());
+    EXPECT_STREQ("81%", mapInfo["percentage"].toStdString().c_str());
+    EXPECT_STREQ("87.7193%", mapInfo["capacity"].toStdString().c_str());
+    EXPECT_STREQ("lithium-polymer", mapInfo["technology"].toStdString().c_str());
+    EXPECT_STREQ("'battery-full-symbolic'", mapInfo["icon-name"].toStdString().c_str());
+    EXPECT_STREQ("5.55556 hours", mapInfo["time to empty"].toStdString().c_str());
+    EXPECT_FALSE(mapInfo.contains("temperature"));
+    EXPECT_FALSE(mapInfo.contains("time to full"));
+}
+
+TEST_F(UT_UPowerMonitor, UT_UPowerMonitor_daemonInfo)
+{
+    QVariantMap properties;
+    properties.insert("DaemonVersion", "0.99.11");
+    properties.insert("OnBattery", true);
+    properties.insert("LidIsPresent", true);
+
+    UPowerMonitor::Daemon daemon;
+    UPowerMonitor::updateDaemon(daemon, properties);
+    daemon.criticalAction = "HybridSleep";
+
+    QMap<QString, QString> mapInfo = UPowerMonitor::daemonInfo(daemon);
+    EXPECT_STREQ("0.99.11", mapInfo["daemon-version"].toStdString().c_str());
+    EXPECT_STREQ("yes", mapInfo["on-battery"].toStdString().c_str());
+    EXPECT_STREQ("no", mapInfo["lid-is-closed"].toStdString().c_str());
+    EXPECT_STREQ("yes", mapInfo["lid-is-present"].toStdString().c_str());
+    EXPECT_STREQ("HybridSleep", mapInfo["critical-action"].toStdString().c_str());
+}
+
+TEST_F(UT_UPowerMonitor, UT_UPowerMonitor_apply)
+{
+    UPowerMonitor *monitor = UPowerMonitor::instance();
+    UPowerMonitor::Battery battery;
+    battery.path = "/org/freedesktop/UPower/devices/battery_BAT0";
+    UPowerMonitor::updateBattery(battery, m_Properties);
+    monitor->m_Batteries.insert(battery.path, battery);
+    monitor->m_Valid = true;
+
+    DevicePower *p = new DevicePower;
+    DeviceManager::instance()->m_ListDevicePower.append(p);
+
+    // 写入的键值与 upower --dump 的解析结果一致
+    monitor->apply();
+    EXPECT_STREQ("1234", p->m_SerialNumber.toStdString().c_str());
+    EXPECT_STREQ("12.3 V", p->m_Voltage.toStdString().c_str());
+    EXPECT_STREQ("87.7193%", p->m_Capacity.toStdString().c_str());
+
+    DeviceManager::instance()->m_ListDevicePower.clear();
+    delete p;
+    monitor->m_Batteries.clear();
+    monitor->m_Valid = false;
+}
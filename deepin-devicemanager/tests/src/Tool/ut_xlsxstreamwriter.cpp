@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "XlsxStreamWriter.h"
+#include "DeviceManager.h"
+#include "DeviceOthers.h"
+#include "xlsxdocument.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QElapsedTimer>
+
+#include <gtest/gtest.h>
+
+class UT_XlsxStreamWriter : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        m_Path = QDir::tempPath() + "/ut_xlsxstreamwriter.xlsx";
+    }
+    void TearDown()
+    {
+        QFile::remove(m_Path);
+    }
+    QString m_Path;
+};
+
+TEST_F(UT_XlsxStreamWriter, UT_XlsxStreamWriter_save)
+{
+    XlsxStreamWriter writer(m_Path);
+    writer.write(1, 1, "[CPU]", XlsxStreamWriter::CS_Bold);
+    writer.write(2, 1, "Name", XlsxStreamWriter::CS_Small);
+    writer.write(2, 2, "Intel <Core> & i7", XlsxStreamWriter::CS_Small);
+    writer.write(4, 1, "Name", XlsxStreamWriter::CS_Small);
+    writer.write(4, 28, " padded ");
+    // 行号回退的写入被忽略
+    writer.write(3, 1, "ignored");
+    EXPECT_TRUE(writer.save());
+    EXPECT_EQ(4, writer.sharedStringCount());
+
+    // 用 QXlsx 读回校验
+    QXlsx::Document xlsx(m_Path);
+    EXPECT_STREQ("[CPU]", xlsx.read(1, 1).toString().toStdString().c_str());
+    EXPECT_STREQ("Intel <Core> & i7", xlsx.read(2, 2).toString().toStdString().c_str());
+    EXPECT_STREQ("Name", xlsx.read(4, 1).toString().toStdString().c_str());
+    EXPECT_STREQ(" padded ", xlsx.read(4, 28).toString().toStdString().c_str());
+    EXPECT_FALSE(xlsx.read(3, 1).isValid());
+}
+
+TEST_F(UT_XlsxStreamWriter, UT_XlsxStreamWriter_columnName)
+{
+    EXPECT_STREQ("A", XlsxStreamWriter::columnName(1).toStdString().c_str());
+    EXPECT_STREQ("Z", XlsxStreamWriter::columnName(26).toStdString().c_str());
+    EXPECT_STREQ("AA", XlsxStreamWriter::columnName(27).toStdString().c_str());
+    EXPECT_STREQ("AZ", XlsxStreamWriter::columnName(52).toStdString().c_str());
+}
+
+TEST_F(UT_XlsxStreamWriter, UT_XlsxStreamWriter_streamRows)
+{
+    // 已结束的行直接写入输出文件,不在内存中累积整个工作表
+    XlsxStreamWriter writer(m_Path);
+    for (int row = 1; row <= 2000; ++row)
+        writer.write(row, 1, QString("Row %1").arg(row));
+    EXPECT_LT(qint64(2000 * 10), QFileInfo(m_Path).size());
+    EXPECT_TRUE(writer.save());
+
+    QXlsx::Document xlsx(m_Path);
+    EXPECT_STREQ("Row 2000", xlsx.read(2000, 1).toString().toStdString().c_str());
+}
+
+// 性能对比只输出耗时,默认不运行,使用 --gtest_also_run_disabled_tests 运行
+TEST_F(UT_XlsxStreamWriter, DISABLED_UT_XlsxStreamWriter_exportToXlsx_benchmark)
+{
+    // 10000 个合成设备
+    DeviceManager::instance()->m_ListDeviceOthers.clear();
+    for (int i = 0; i < 10000; ++i) {
+        DeviceOthers *device = new DeviceOthers;
+        device->m_Name = QString("USB Device %1").arg(i);
+        device->m_Vendor = QString("Vendor %1").arg(i % 50);
+        device->m_Model = QString("Model %1").arg(i % 200);
+        device->m_Version = "1.00";
+        device->m_BusInfo = QString("usb@1:%1").arg(i);
+        device->m_Driver = "usbhid";
+        device->m_Speed = "12Mbit/s";
+        DeviceManager::instance()->m_ListDeviceOthers.append(device);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    DeviceManager::instance()->exportToXlsx(m_Path);
+    qint64 streamMs = timer.elapsed();
+
+    // 同样的单元格通过 QXlsx::Document 写出作为对比
+    timer.restart();
+    QXlsx::Document xlsx;
+    QXlsx::Format format;
+    format.setFontSize(10);
+    int row = 1;
+    foreach (DeviceBaseInfo *device, DeviceManager::instance()->m_ListDeviceOthers) {
+        xlsx.write(row++, 1, device->subTitle(), format);
+        foreach (auto item, device->getBaseAttribs()) {
+            xlsx.write(row, 1, item.first, format);
+            xlsx.write(row++, 2, item.second, format);
+        }
+        ++row;
+    }
+    xlsx.saveAs(m_Path + ".qxlsx.xlsx");
+    qint64 qxlsxMs = timer.elapsed();
+    QFile::remove(m_Path + ".qxlsx.xlsx");
+
+    qInfo() << "exportToXlsx with 10000 devices, stream writer:" << streamMs << "ms, QXlsx::Document:" << qxlsxMs << "ms";
+
+    foreach (auto device, DeviceManager::instance()->m_ListDeviceOthers)
+        delete device;
+    DeviceManager::instance()->m_ListDeviceOthers.clear();
+}
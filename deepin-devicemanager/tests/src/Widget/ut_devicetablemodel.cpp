@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "DeviceTableModel.h"
+#include "DeviceInput.h"
+#include "ut_Head.h"
+#include "stub.h"
+
+#include <QSignalSpy>
+
+#include <gtest/gtest.h>
+
+class UT_DeviceTableModel : public UT_HEAD
+{
+public:
+    void SetUp()
+    {
+        m_Model = new DeviceTableModel;
+        for (int i = 0; i < 3; ++i)
+            m_Devices.append(createDevice(i));
+    }
+    void TearDown()
+    {
+        delete m_Model;
+        qDeleteAll(m_Devices);
+        m_Devices.clear();
+    }
+
+    static DeviceInput *createDevice(int i)
+    {
+        DeviceInput *device = new DeviceInput;
+        device->m_Name = QString("Mouse %1").arg(i);
+        device->m_Vendor = "Logitech";
+        device->m_Model = QString("M%1").arg(i);
+        return device;
+    }
+
+    DeviceTableModel *m_Model = nullptr;
+    QList<DeviceBaseInfo *> m_Devices;
+};
+
+TEST_F(UT_DeviceTableModel, UT_DeviceTableModel_setDevices)
+{
+    m_Model->setDevices(m_Devices);
+    EXPECT_EQ(3, m_Model->rowCount());
+    EXPECT_EQ(3, m_Model->columnCount());
+    EXPECT_STREQ("Name", m_Model->headerData(0, Qt::Horizontal).toString().toStdString().c_str());
+
+    // 行在访问时才读取
+    EXPECT_FALSE(m_Model->m_Rows[1].loaded);
+    EXPECT_STREQ("Mouse 1", m_Model->index(1, 0).data().toString().toStdString().c_str());
+    EXPECT_STREQ("M1", m_Model->index(1, 2).data().toString().toStdString().c_str());
+    EXPECT_TRUE(m_Model->m_Rows[1].loaded);
+    EXPECT_FALSE(m_Model->m_Rows[2].loaded);
+
+    // 右键菜单控制信息
+    EXPECT_STREQ("false", m_Model->index(1, 0).data(Qt::UserRole + 2).toString().toStdString().c_str());
+    EXPECT_FALSE(m_Model->index(1, 1).data(Qt::UserRole).isValid());
+    EXPECT_EQ(m_Devices[2], m_Model->device(2));
+    EXPECT_EQ(nullptr, m_Model->device(3));
+}
+
+TEST_F(UT_DeviceTableModel, UT_DeviceTableModel_setDevices_incremental)
+{
+    m_Model->setDevices(m_Devices);
+    m_Model->index(0, 0).data();
+    m_Model->index(1, 0).data();
+
+    QSignalSpy resetSpy(m_Model, &DeviceTableModel::modelReset);
+    QSignalSpy changedSpy(m_Model, &DeviceTableModel::dataChanged);
+    QSignalSpy insertSpy(m_Model, &DeviceTableModel::rowsInserted);
+
+    // 同样的设备不发出任何通知
+    m_Model->setDevices(m_Devices);
+    EXPECT_EQ(0, resetSpy.count());
+    EXPECT_EQ(0, changedSpy.count());
+
+    // 只有已读取且内容变化的行发出 dataChanged,新增的行在末尾插入
+    m_Devices[1]->m_Name = "Renamed";
+    m_Devices[1]->invalidateAttribs();
+    m_Devices[2]->m_Name = "Unloaded";
+    m_Devices[2]->invalidateAttribs();
+    m_Devices.append(createDevice(3));
+    m_Model->setDevices(m_Devices);
+    EXPECT_EQ(0, resetSpy.count());
+    ASSERT_EQ(1, changedSpy.count());
+    EXPECT_EQ(1, changedSpy[0][0].toModelIndex().row());
+    EXPECT_EQ(1, changedSpy[0][1].toModelIndex().row());
+    EXPECT_EQ(1, insertSpy.count());
+    EXPECT_EQ(4, m_Model->rowCount());
+    EXPECT_STREQ("Renamed", m_Model->index(1, 0).data().toString().toStdString().c_str());
+}
+
+TEST_F(UT_DeviceTableModel, UT_DeviceTableModel_releaseDevices)
+{
+    m_Model->setDevices(m_Devices);
+    m_Model->index(0, 0).data();
+    m_Model->releaseDevices();
+
+    // 释放后保留已读取的内容,未读取的行为空
+    EXPECT_EQ(nullptr, m_Model->device(0));
+    EXPECT_STREQ("Mouse 0", m_Model->index(0, 0).data().toString().toStdString().c_str());
+    EXPECT_TRUE(m_Model->index(2, 0).data().toString().isEmpty());
+
+    // 新的设备列表到来后只更新变化的行
+    QSignalSpy resetSpy(m_Model, &DeviceTableModel::modelReset);
+    QSignalSpy changedSpy(m_Model, &DeviceTableModel::dataChanged);
+    m_Model->setDevices(m_Devices);
+    EXPECT_EQ(0, resetSpy.count());
+    EXPECT_EQ(1, changedSpy.count());
+    EXPECT_STREQ("Mouse 2", m_Model->index(2, 0).data().toString().toStdString().c_str());
+}
+
+TEST_F(UT_DeviceTableModel, UT_DeviceTableModel_refreshRow)
+{
+    m_Model->setDevices(m_Devices);
+    m_Model->index(0, 0).data();
+
+    QSignalSpy changedSpy(m_Model, &DeviceTableModel::dataChanged);
+    m_Devices[0]->m_Enable = false;
+    m_Model->refreshRow(0);
+    EXPECT_EQ(1, changedSpy.count());
+    EXPECT_TRUE(m_Model->index(0, 0).data().toString().startsWith("(Disable)"));
+
+    m_Model->clear();
+    EXPECT_EQ(0, m_Model->rowCount());
+    EXPECT_EQ(0, m_Model->columnCount());
+}
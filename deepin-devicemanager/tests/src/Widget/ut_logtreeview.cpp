@@ -4,6 +4,8 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "logtreeview.h"
+#include "DeviceTableModel.h"
+#include "DeviceInput.h"
 #include "ut_Head.h"
 #include "stub.h"
 
@@ -23,21 +25,24 @@ public:
     void SetUp()
     {
         m_logTreeView = new LogTreeView;
-        QStandardItem *item = new QStandardItem("Disable");
-        m_logTreeView->mp_Model->setItem(0, 0, item);
-        m_logTreeView->setModel(m_logTreeView->mp_Model);
+        m_device = new DeviceInput;
+        m_device->m_Name = "item1";
+        m_device->m_Vendor = "item2";
+        m_logTreeView->setDevices(QList<DeviceBaseInfo *>() << m_device);
     }
     void TearDown()
     {
         delete m_logTreeView;
+        delete m_device;
     }
     LogTreeView *m_logTreeView;
+    DeviceInput *m_device;
 };
 
-TEST_F(UT_LogTreeView, UT_LogTreeView_setHeaderLabels)
+TEST_F(UT_LogTreeView, UT_LogTreeView_setDevices)
 {
-    m_logTreeView->setHeaderLabels(QStringList() << "lables");
-    EXPECT_EQ(m_logTreeView->header()->count(),1);
+    EXPECT_EQ(m_logTreeView->header()->count(), 3);
+    EXPECT_EQ(m_logTreeView->deviceModel()->rowCount(), 1);
 }
 
 int ut_row()
@@ -55,19 +60,13 @@ TEST_F(UT_LogTreeView, UT_LogTreeView_currentRowEnable)
 
 TEST_F(UT_LogTreeView, UT_LogTreeView_updateCurItemEnable)
 {
-    Stub stub;
-    m_logTreeView->mp_Model->setColumnCount(2);
-    m_logTreeView->mp_Model->insertRow(0);
-    QStandardItem *item1 = new QStandardItem("item1");
-    QStandardItem *item2 = new QStandardItem("item2");
-    m_logTreeView->mp_Model->setItem(0,0,item1);
-    m_logTreeView->mp_Model->setItem(0,1,item2);
+    m_device->m_Enable = false;
     m_logTreeView->updateCurItemEnable(0, 0);
-    EXPECT_STREQ("(Disable)item1",m_logTreeView->mp_Model->item(0,0)->text().toStdString().c_str());
+    EXPECT_STREQ("(Disable)item1", m_logTreeView->mp_Model->index(0, 0).data().toString().toStdString().c_str());
+    m_device->m_Enable = true;
     m_logTreeView->updateCurItemEnable(0, 1);
-    EXPECT_STREQ("item2",m_logTreeView->mp_Model->item(0,1)->text().toStdString().c_str());
-    delete item1;
-    delete item2;
+    EXPECT_STREQ("item1", m_logTreeView->mp_Model->index(0, 0).data().toString().toStdString().c_str());
+    EXPECT_STREQ("item2", m_logTreeView->mp_Model->index(0, 1).data().toString().toStdString().c_str());
 }
 
 TEST_F(UT_LogTreeView, UT_LogTreeView_paintEvent)
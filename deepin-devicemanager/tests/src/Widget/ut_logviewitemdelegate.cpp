@@ -13,6 +13,7 @@
 #include <QCoreApplication>
 #include <QPaintEvent>
 #include <QPainter>
+#include <QStandardItemModel>
 
 #include <gtest/gtest.h>
 
@@ -15,6 +15,10 @@
 #include <QPaintEvent>
 #include <QPainter>
 #include <QWidget>
+#include <QStandardItemModel>
+#include <QImage>
+#include <QElapsedTimer>
+#include <QDebug>
 
 #include <DStyle>
 #include <DApplication>
@@ -118,3 +122,74 @@ TEST_F(UT_RichTextDelegate, UT_RichTextDelegate_RichTextDelegate_getDocFromLst)
                                 << "first");
     EXPECT_FALSE(doc.isNull());
 }
+
+TEST_F(UT_RichTextDelegate, UT_RichTextDelegate_RichTextDelegate_layoutCache)
+{
+    Stub stub;
+    stub.set(ADDR(DApplication, style), ut_richtextdelegate_style);
+
+    QStandardItemModel model(2, 2);
+    model.setItem(0, 1, new QStandardItem("value"));
+    QImage image(300, 200, QImage::Format_ARGB32);
+    QPainter painter(&image);
+    QStyleOptionViewItem option;
+    option.rect = QRect(0, 40, 150, 40);
+    QModelIndex index = model.index(0, 1);
+
+    // 重复绘制同一单元格复用已排版的文档
+    m_rtDelegate->paint(&painter, option, index);
+    RichTextDelegate::TextLayout *layout = m_rtDelegate->m_LayoutCache.object(qMakePair(0, 1));
+    ASSERT_TRUE(layout);
+    QTextDocument *doc = &layout->doc;
+    m_rtDelegate->paint(&painter, option, index);
+    EXPECT_EQ(doc, &m_rtDelegate->m_LayoutCache.object(qMakePair(0, 1))->doc);
+    EXPECT_EQ(1, m_rtDelegate->m_LayoutCache.size());
+
+    // 宽度变化时重新排版
+    option.rect.setWidth(200);
+    m_rtDelegate->paint(&painter, option, index);
+    EXPECT_EQ(194, int(m_rtDelegate->m_LayoutCache.object(qMakePair(0, 1))->doc.textWidth()));
+
+    // 模型变化时清空缓存
+    model.item(0, 1)->setText("changed");
+    EXPECT_EQ(0, m_rtDelegate->m_LayoutCache.size());
+    m_rtDelegate->paint(&painter, option, index);
+    EXPECT_STREQ("changed", m_rtDelegate->m_LayoutCache.object(qMakePair(0, 1))->text.toStdString().c_str());
+    painter.end();
+}
+
+// 性能对比只输出耗时,默认不运行,使用 --gtest_also_run_disabled_tests 运行
+TEST_F(UT_RichTextDelegate, DISABLED_UT_RichTextDelegate_RichTextDelegate_paint_benchmark)
+{
+    Stub stub;
+    stub.set(ADDR(DApplication, style), ut_richtextdelegate_style);
+
+    // 5000 行的表格,首次绘制与再次绘制(滚动回来)的耗时
+    const int rows = 5000;
+    QStandardItemModel model(rows, 2);
+    for (int row = 0; row < rows; ++row) {
+        model.setItem(row, 0, new QStandardItem(QString("Name %1").arg(row)));
+        model.setItem(row, 1, new QStandardItem(QString("Value of device attribute %1").arg(row)));
+    }
+
+    QImage image(400, 200, QImage::Format_ARGB32);
+    QPainter painter(&image);
+    QStyleOptionViewItem option;
+    m_rtDelegate->m_LayoutCache.setMaxCost(rows * 2);
+
+    QElapsedTimer timer;
+    qint64 passMs[2] = {0, 0};
+    for (int pass = 0; pass < 2; ++pass) {
+        timer.restart();
+        for (int row = 0; row < rows; ++row) {
+            for (int column = 0; column < 2; ++column) {
+                option.rect = QRect(column * 200, 40, 200, 40);
+                m_rtDelegate->paint(&painter, option, model.index(row, column));
+            }
+        }
+        passMs[pass] = timer.elapsed();
+    }
+    painter.end();
+
+    qInfo() << "paint" << rows << "rows, first:" << passMs[0] << "ms, cached:" << passMs[1] << "ms";
+}
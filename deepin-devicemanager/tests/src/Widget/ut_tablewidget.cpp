@@ -7,6 +7,7 @@
 #include "logtreeview.h"
 #include "DeviceInfo.h"
 #include "DeviceInput.h"
+#include "DeviceTableModel.h"
 #include "ut_Head.h"
 
 #include <QCoreApplication>
@@ -22,28 +23,31 @@ public:
     void SetUp()
     {
         m_tableWidget = new TableWidget;
+        m_device = new DeviceInput;
+        m_device->m_Name = "item";
     }
     void TearDown()
     {
         delete m_tableWidget;
+        delete m_device;
     }
     TableWidget *m_tableWidget;
+    DeviceInput *m_device;
 };
 
-TEST_F(UT_TableWidget, UT_TableWidget_setHeaderLabels)
+TEST_F(UT_TableWidget, UT_TableWidget_setDevices)
 {
-    m_tableWidget->setHeaderLabels(QStringList() << "item1" << "item2");
-    EXPECT_EQ(m_tableWidget->mp_Table->header()->count(),1);
+    m_tableWidget->setDevices(QList<DeviceBaseInfo *>() << m_device);
+    EXPECT_EQ(m_tableWidget->mp_Table->header()->count(),3);
 }
 
 TEST_F(UT_TableWidget, UT_TableWidget_setItem)
 {
-    DStandardItem *item = new DStandardItem("item");
-    m_tableWidget->setItem(0, 0, item);
+    m_tableWidget->setDevices(QList<DeviceBaseInfo *>() << m_device);
     m_tableWidget->setColumnAverage();
     m_tableWidget->updateCurItemEnable(0, true);
-    EXPECT_STREQ(m_tableWidget->mp_Table->mp_Model->item(0,0)->text().toStdString().c_str(),"item");
-    delete item;
+    EXPECT_STREQ(m_tableWidget->mp_Table->mp_Model->index(0,0).data().toString().toStdString().c_str(),"item");
+    m_tableWidget->releaseDevices();
     m_tableWidget->clear();
     EXPECT_EQ(m_tableWidget->mp_Table->mp_Model->rowCount(),0);
     m_tableWidget->setRowNum(1);
@@ -67,14 +71,10 @@ TEST_F(UT_TableWidget, UT_TableWidget_slotActionExport)
 
 TEST_F(UT_TableWidget, UT_TableWidget_slotItemClicked)
 {
-    DStandardItem *item = new DStandardItem("item");
-    m_tableWidget->mp_Table->mp_Model->insertRow(0);
-    m_tableWidget->mp_Table->mp_Model->insertColumn(0);
-    m_tableWidget->setItem(0, 0, item);
-    QModelIndex index = m_tableWidget->mp_Table->mp_Model->item(0)->index();
+    m_tableWidget->setDevices(QList<DeviceBaseInfo *>() << m_device);
+    QModelIndex index = m_tableWidget->mp_Table->mp_Model->index(0, 0);
     m_tableWidget->slotItemClicked(index);
     EXPECT_EQ(m_tableWidget->mp_Table->mp_Model->rowCount(),1);
-    delete item;
 }
 
 TEST_F(UT_TableWidget, UT_TableWidget_initWidget)
@@ -39,3 +39,20 @@ TEST(DebugTimeManager_Test, DebugTimeManager_UT_003)
     ASSERT_TRUE(dtm->m_MapPoint.isEmpty());
     delete dtm;
 }
+
+TEST(DebugTimeManager_Test, DebugTimeManager_UT_004)
+{
+    DebugTimeManager *dtm = new DebugTimeManager();
+    dtm->traceStartup("main");
+    dtm->traceStartup("first paint");
+    QStringList report = dtm->startupReport();
+    ASSERT_EQ(2, report.size());
+    ASSERT_TRUE(report.at(1).endsWith("first paint"));
+
+    // 报告输出后不再记录
+    dtm->finishStartup();
+    ASSERT_TRUE(dtm->startupFinished());
+    dtm->traceStartup("devices shown");
+    ASSERT_EQ(2, dtm->m_StartupStages.size());
+    delete dtm;
+}
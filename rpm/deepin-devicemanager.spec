@@ -22,6 +22,7 @@ BuildRequires: qt5-rpm-macros
 BuildRequires: qt5-qtbase-devel
 BuildRequires: qt5-qttools-devel
 BuildRequires: cups-devel
+BuildRequires: libxcb-devel
 BuildRequires: pkgconfig(dframeworkdbus)
 BuildRequires: zeromq3-devel
 BuildRequires: gtest-devel